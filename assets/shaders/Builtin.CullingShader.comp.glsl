@@ -0,0 +1,78 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(local_size_x = 64) in;
+
+struct InstanceObject {
+    mat4 model;
+    vec4 boundingSphere; // Model space center and radius.
+    uint indexCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint reserved_0;
+};
+
+// Matches VkDrawIndexedIndirectCommand.
+struct DrawCommand {
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer InstanceObjects {
+    InstanceObject instanceObjects[];
+};
+
+layout(std430, set = 0, binding = 1) writeonly buffer DrawCommands {
+    DrawCommand drawCommands[];
+};
+
+layout(std430, set = 0, binding = 2) buffer DrawCount {
+    uint drawCount;
+};
+
+layout(push_constant) uniform PushConstants {
+    vec4 frustumPlanes[6]; // 96 bytes, normals point inward
+    uint firstInstance;    // 4 bytes
+    uint instanceCount;    // 4 bytes
+} pushConstants;
+
+void main() {
+    if (gl_GlobalInvocationID.x >= pushConstants.instanceCount) {
+        return;
+    }
+
+    uint instanceIndex = pushConstants.firstInstance + gl_GlobalInvocationID.x;
+
+    // Instances of stale geometry have nothing to draw.
+    if (instanceObjects[instanceIndex].indexCount == 0u) {
+        return;
+    }
+
+    mat4 model = instanceObjects[instanceIndex].model;
+    vec4 boundingSphere = instanceObjects[instanceIndex].boundingSphere;
+
+    // The largest axis scale keeps the sphere conservative under non-uniform scaling.
+    float scale = max(length(model[0].xyz), max(length(model[1].xyz), length(model[2].xyz)));
+    vec3 center = (model * vec4(boundingSphere.xyz, 1.0)).xyz;
+    float radius = boundingSphere.w * scale;
+
+    for (int i = 0; i < 6; i++) {
+        if (dot(pushConstants.frustumPlanes[i].xyz, center) + pushConstants.frustumPlanes[i].w < -radius) {
+            return;
+        }
+    }
+
+    // Survivors are compacted in no particular order, the draw reads the count back from the buffer.
+    uint drawIndex = atomicAdd(drawCount, 1u);
+
+    drawCommands[drawIndex] = DrawCommand(
+        instanceObjects[instanceIndex].indexCount,
+        1u,
+        instanceObjects[instanceIndex].firstIndex,
+        instanceObjects[instanceIndex].vertexOffset,
+        instanceIndex
+    );
+}
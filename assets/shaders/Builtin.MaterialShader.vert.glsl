@@ -9,10 +9,19 @@ layout(set = 0, binding = 0) uniform GlobalUniformObject {
     mat4 view;
 } globalUniformObject;
 
-layout(push_constant) uniform PushConstants {
-    // Only guaranteed a total of 128 bytes.
-    mat4 model; // 64 bytes
-} pushConstants;
+struct InstanceObject {
+    mat4 model;
+    vec4 boundingSphere;
+    uint indexCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint reserved_0;
+};
+
+// Indexed by the instance index, every draw starts at its own object.
+layout(std430, set = 0, binding = 1) readonly buffer InstanceObjects {
+    InstanceObject instanceObjects[];
+};
 
 layout(location = 0) out int outMode;
 
@@ -23,5 +32,5 @@ layout(location = 1) out struct DataTransferObject {
 
 void main() {
     outDataTransferObject.texCoord = inTexCoord;
-    gl_Position = globalUniformObject.projection * globalUniformObject.view * pushConstants.model * vec4(inPosition, 1.0);
+    gl_Position = globalUniformObject.projection * globalUniformObject.view * instanceObjects[gl_InstanceIndex].model * vec4(inPosition, 1.0);
 }
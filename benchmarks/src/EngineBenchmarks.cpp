@@ -0,0 +1,444 @@
+#include "core/Event.hpp"
+#include "core/Input.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Logger.hpp"
+#include "core/Vfs.hpp"
+#include "math/MathTypes.hpp"
+#include "renderer/IRendererBackend.hpp"
+#include "renderer/RendererFrontend.hpp"
+#include "resources/CookedMesh.hpp"
+#include "resources/TextureUtils.hpp"
+#include "scene/Camera.hpp"
+#include "systems/GeometrySystem.hpp"
+#include "systems/TextureSystem.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace beige;
+
+// Events only notify from their owner, like Input does.
+class BenchmarkEvent final : public core::Event<int32_t> {
+public:
+    auto notify(const int32_t value) -> void {
+        notifyListeners(value);
+    }
+};
+
+/**
+ * Stands in for the Vulkan backend so the systems above the renderer run without a device, textures and geometry
+ * only exist as their CPU side objects. Counts the objects it was asked to draw.
+ */
+class NullBackend final : public renderer::IBackend {
+public:
+    auto onResized(const uint16_t width, const uint16_t height) -> void override { }
+
+    auto beginFrame(const float deltaTime) -> bool override {
+        return true;
+    }
+
+    auto updateGlobalState(
+        const glm::mat4x4& projection,
+        const glm::mat4x4& view,
+        const glm::vec3& viewPosition,
+        const glm::vec4& ambientColor,
+        const int32_t mode
+    ) -> void override { }
+
+    auto endFrame(const float deltaTime) -> bool override {
+        return true;
+    }
+
+    auto beginRenderPass() -> void override { }
+    auto endRenderPass() -> void override { }
+
+    auto updateObject(
+        const renderer::GeometryRenderData& geometryRenderData,
+        const resources::TexturePool& texturePool
+    ) -> void override {
+        m_drawnObjectCount++;
+    }
+
+    auto cullInstances(
+        const std::vector<renderer::GeometryRenderData>& instances,
+        const std::vector<glm::vec4>& boundingSpheres,
+        const std::array<float, 24u>& frustumPlanes
+    ) -> bool override {
+        return false;
+    }
+
+    auto drawInstances(
+        const renderer::GeometryRenderData& geometryRenderData,
+        const resources::TexturePool& texturePool
+    ) -> void override { }
+
+    auto getFrameTimings() const -> renderer::FrameTimings override {
+        return renderer::FrameTimings { 0.0f, 0.0f };
+    }
+
+    auto getMaxFramesInFlight() const -> uint32_t override {
+        return 2u;
+    }
+
+    auto acquireObjectResources() -> std::optional<resources::ObjectId> override {
+        return m_objectCount++;
+    }
+
+    auto createTexture(
+        const std::string& name,
+        const int32_t width,
+        const int32_t height,
+        const int32_t channelCount,
+        const resources::TextureFormat format,
+        const void* pixels,
+        const uint32_t mipLevelCount,
+        const bool hasTransparency
+    ) -> std::shared_ptr<resources::ITexture> override {
+        return std::make_shared<resources::ITexture>(name, width, height, channelCount, pixels, hasTransparency);
+    }
+
+    auto createPendingTexture(const std::string& name) -> std::shared_ptr<resources::ITexture> override {
+        return std::make_shared<resources::ITexture>(name, 0, 0, 4, nullptr, false);
+    }
+
+    auto uploadTextures(const std::vector<renderer::TextureUpload>& textureUploads) -> uint64_t override {
+        return 0u;
+    }
+
+    auto completeUploads(const bool wait) -> uint64_t override {
+        return 0u;
+    }
+
+    auto destroyTexture(std::shared_ptr<resources::ITexture> texture) -> void override { }
+    auto setDefaultTexture(std::shared_ptr<resources::ITexture> texture) -> void override { }
+
+    auto supportsTextureFormat(const resources::TextureFormat format) const -> bool override {
+        return format == resources::TextureFormat::Rgba8;
+    }
+
+    auto reloadShaders() -> bool override {
+        return true;
+    }
+
+    auto createGeometry(
+        const std::vector<math::Vertex3D>& vertices,
+        const std::vector<uint32_t>& indices,
+        const std::vector<resources::GeometryLod>& lods
+    ) -> resources::GeometryHandle override {
+        return resources::GeometryHandle { m_geometryCount++, 1u };
+    }
+
+    auto destroyGeometry(const resources::GeometryHandle geometry) -> void override { }
+
+    auto getDrawnObjectCount() const -> uint64_t {
+        return m_drawnObjectCount;
+    }
+
+private:
+    resources::ObjectId m_objectCount { 0u };
+    uint32_t m_geometryCount { 0u };
+    uint64_t m_drawnObjectCount { 0u };
+};
+
+auto makeTextureNames(const uint32_t count) -> std::vector<std::string> {
+    std::vector<std::string> names(count);
+
+    for (uint32_t i { 0u }; i < count; i++) {
+        names[i] = "benchmark/texture_" + std::to_string(i);
+    }
+
+    return names;
+}
+
+auto subscribeUnsubscribe(benchmark::State& state) -> void {
+    const uint32_t listenerCount { static_cast<uint32_t>(state.range(0)) };
+    BenchmarkEvent event;
+
+    for (uint32_t i { 0u }; i < listenerCount; i++) {
+        event.subscribe([](const int32_t& value) -> void { benchmark::DoNotOptimize(value); });
+    }
+
+    for (auto _ : state) {
+        const BenchmarkEvent::Subscription subscription {
+            event.subscribe([](const int32_t& value) -> void { benchmark::DoNotOptimize(value); })
+        };
+        event.unsubscribe(subscription);
+    }
+}
+
+auto notifyListeners(benchmark::State& state) -> void {
+    const uint32_t listenerCount { static_cast<uint32_t>(state.range(0)) };
+    BenchmarkEvent event;
+    int32_t sum { 0 };
+
+    for (uint32_t i { 0u }; i < listenerCount; i++) {
+        event.subscribe([&sum](const int32_t& value) -> void { sum += value; });
+    }
+
+    for (auto _ : state) {
+        event.notify(1);
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * listenerCount);
+}
+
+// Writes to the console and console.log like the engine does, so it measures both.
+auto logMessages(benchmark::State& state) -> void {
+    const std::string message(static_cast<std::size_t>(state.range(0)), 'x');
+
+    for (auto _ : state) {
+        core::Logger::info(message);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Queues the events of a frame like the platform layer does and applies them like the frame does.
+auto updateInput(benchmark::State& state) -> void {
+    const uint32_t eventCount { static_cast<uint32_t>(state.range(0)) };
+    std::shared_ptr<core::Input> input { core::Input::getInstance() };
+    double time { 0.0 };
+
+    for (auto _ : state) {
+        for (uint32_t i { 0u }; i < eventCount; i++) {
+            const core::InputEvent event {
+                time,                                   // time
+                core::InputEventType::Key,              // type
+                static_cast<uint32_t>(0x41u + i % 26u), // code
+                0,                                      // x
+                0,                                      // y
+                i % 2u == 0u                            // isPressed
+            };
+
+            input->pushEvent(event);
+        }
+
+        core::Input::update(time);
+        time += 1.0 / 60.0;
+    }
+
+    state.SetItemsProcessed(state.iterations() * eventCount);
+}
+
+// Every texture is acquired once during setup, the files do not exist so they stay pending and every timed
+// acquire is a registry hit.
+auto acquireTextures(benchmark::State& state, const bool isById) -> void {
+    const uint32_t textureCount { static_cast<uint32_t>(state.range(0)) };
+    const std::shared_ptr<core::JobSystem> jobSystem { std::make_shared<core::JobSystem>(1u) };
+    const std::shared_ptr<const core::Vfs> vfs { std::make_shared<const core::Vfs>() };
+    const std::shared_ptr<renderer::Frontend> rendererFrontend {
+        std::make_shared<renderer::Frontend>(std::make_unique<NullBackend>(), 720u, jobSystem)
+    };
+    systems::Texture textureSystem { rendererFrontend, jobSystem, vfs };
+
+    const std::vector<std::string> names { makeTextureNames(textureCount) };
+    std::vector<systems::Texture::NameId> nameIds(textureCount);
+
+    for (uint32_t i { 0u }; i < textureCount; i++) {
+        nameIds[i] = textureSystem.internName(names[i]);
+        textureSystem.acquire(nameIds[i], true);
+    }
+
+    jobSystem->waitIdle();
+
+    uint32_t index { 0u };
+
+    for (auto _ : state) {
+        const resources::TextureHandle handle {
+            isById ? textureSystem.acquire(nameIds[index], true) : textureSystem.acquire(names[index], true)
+        };
+        benchmark::DoNotOptimize(handle);
+
+        index = index + 1u == textureCount ? 0u : index + 1u;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+auto acquireTexturesById(benchmark::State& state) -> void {
+    acquireTextures(state, true);
+}
+
+auto acquireTexturesByName(benchmark::State& state) -> void {
+    acquireTextures(state, false);
+}
+
+auto generateDefaultTexture(benchmark::State& state) -> void {
+    const uint32_t dimension { static_cast<uint32_t>(state.range(0)) };
+
+    for (auto _ : state) {
+        const std::vector<std::byte> pixels { resources::TextureUtils::generateCheckerboard(dimension) };
+        benchmark::DoNotOptimize(pixels.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * dimension * dimension * 4u);
+}
+
+// Dequantizes a cooked mesh and packs vertices and indices into one staging allocation, as a geometry upload does.
+auto packVertices(benchmark::State& state) -> void {
+    const uint32_t vertexCount { static_cast<uint32_t>(state.range(0)) };
+    const uint32_t indexCount { vertexCount * 3u };
+
+    resources::CookedMeshHeader header { };
+    header.vertexCount = vertexCount;
+    header.indexCount = indexCount;
+    header.positionMin = { -1.0f, -1.0f, -1.0f };
+    header.positionMax = { 1.0f, 1.0f, 1.0f };
+    header.texCoordMin = { 0.0f, 0.0f };
+    header.texCoordMax = { 1.0f, 1.0f };
+
+    std::mt19937 engine { 10u };
+    std::uniform_int_distribution<uint32_t> distribution { 0u, 0xFFFFu };
+    std::vector<resources::CookedMeshVertex> cookedVertices(vertexCount);
+
+    for (resources::CookedMeshVertex& cookedVertex : cookedVertices) {
+        for (uint16_t& component : cookedVertex.position) {
+            component = static_cast<uint16_t>(distribution(engine));
+        }
+        for (uint16_t& component : cookedVertex.texCoord) {
+            component = static_cast<uint16_t>(distribution(engine));
+        }
+        cookedVertex.normal = { 0, 127 };
+    }
+
+    std::vector<uint32_t> indices(indexCount);
+    for (uint32_t i { 0u }; i < indexCount; i++) {
+        indices[i] = i % vertexCount;
+    }
+
+    const uint64_t vertexSize { sizeof(math::Vertex3D) * vertexCount };
+    const uint64_t indexSize { sizeof(uint32_t) * indexCount };
+    std::vector<math::Vertex3D> vertices(vertexCount);
+    std::vector<std::byte> staging(vertexSize + indexSize);
+
+    for (auto _ : state) {
+        systems::Geometry::unpackCookedVertices(
+            header,
+            reinterpret_cast<const std::byte*>(cookedVertices.data()),
+            vertices.data()
+        );
+        std::memcpy(staging.data(), vertices.data(), vertexSize);
+        std::memcpy(staging.data() + vertexSize, indices.data(), indexSize);
+
+        benchmark::DoNotOptimize(staging.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * vertexCount);
+    state.SetBytesProcessed(state.iterations() * (vertexSize + indexSize));
+}
+
+// Submits a grid of cubes like render-bench does, everything above the backend runs: culling, level of detail
+// selection, marking textures as used and one updateObject() per visible object.
+auto drawFrame(benchmark::State& state) -> void {
+    const uint32_t objectCount { static_cast<uint32_t>(state.range(0)) };
+    const uint32_t materialCount { 16u };
+    const std::shared_ptr<core::JobSystem> jobSystem { std::make_shared<core::JobSystem>() };
+
+    std::unique_ptr<NullBackend> backend { std::make_unique<NullBackend>() };
+    const NullBackend* nullBackend { backend.get() };
+    renderer::Frontend frontend { std::move(backend), 720u, jobSystem };
+
+    const std::vector<std::byte> pixels { resources::TextureUtils::generateCheckerboard(64u) };
+    std::vector<resources::TextureHandle> textures(materialCount);
+    std::vector<resources::ObjectId> materials(materialCount);
+
+    for (uint32_t i { 0u }; i < materialCount; i++) {
+        textures[i] = frontend.getTexturePool().allocate(
+            frontend.createTexture(
+                "benchmark/texture_" + std::to_string(i),
+                64,
+                64,
+                4,
+                resources::TextureFormat::Rgba8,
+                pixels.data(),
+                1u,
+                false
+            )
+        );
+        materials[i] = frontend.acquireObjectResources().value();
+    }
+
+    // A unit cube, the frontend only needs the positions for its bounds.
+    std::vector<math::Vertex3D> vertices(8u);
+    for (uint32_t i { 0u }; i < 8u; i++) {
+        vertices[i].position = glm::vec3(i & 1u ? 0.5f : -0.5f, i & 2u ? 0.5f : -0.5f, i & 4u ? 0.5f : -0.5f);
+    }
+
+    const resources::GeometryHandle cube { frontend.createGeometry(vertices, { 0u, 1u, 2u }, { }) };
+
+    // A square grid in the z = 0 plane, the camera backs off until all of it is in view.
+    const uint32_t gridSize { static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(objectCount)))) };
+    const float spacing { 2.0f };
+    const float gridExtent { static_cast<float>(gridSize) * spacing };
+
+    renderer::Packet packet {
+        1.0f / 60.0f, // deltaTime
+        { },          // geometries
+        { },          // visibleGeometries
+        { },          // cullingStats
+        { }           // instances
+    };
+
+    packet.geometries.resize(objectCount);
+
+    for (uint32_t i { 0u }; i < objectCount; i++) {
+        glm::mat4x4 model { 1.0f };
+        model[3] = glm::vec4(
+            (static_cast<float>(i % gridSize) + 0.5f) * spacing - gridExtent * 0.5f,
+            (static_cast<float>(i / gridSize) + 0.5f) * spacing - gridExtent * 0.5f,
+            0.0f,
+            1.0f
+        );
+
+        packet.geometries[i] = {
+            { i, 0u },                      // entity
+            materials[i % materialCount],   // objectId
+            cube,                           // geometry
+            0u,                             // lod
+            model,                          // model
+            { textures[i % materialCount] } // textures
+        };
+    }
+
+    scene::Camera camera;
+    camera.setAspectRatio(16.0f / 9.0f);
+    camera.setPosition(glm::vec3(0.0f, 0.0f, gridExtent * 1.5f + 2.0f));
+    camera.update();
+    frontend.setCamera(camera);
+
+    for (auto _ : state) {
+        frontend.drawFrame(packet);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(nullBackend->getDrawnObjectCount()));
+    state.counters["drawn"] = benchmark::Counter(
+        static_cast<double>(nullBackend->getDrawnObjectCount()),
+        benchmark::Counter::kAvgIterations
+    );
+}
+
+} // namespace
+
+BENCHMARK(subscribeUnsubscribe)->Arg(0)->Arg(64);
+BENCHMARK(notifyListeners)->Arg(1)->Arg(16)->Arg(256);
+BENCHMARK(logMessages)->Arg(32)->Arg(256);
+BENCHMARK(updateInput)->Arg(16)->Arg(256)->Arg(1024);
+BENCHMARK(acquireTexturesById)->Arg(64)->Arg(4096);
+BENCHMARK(acquireTexturesByName)->Arg(64)->Arg(4096);
+BENCHMARK(generateDefaultTexture)->Arg(256)->Arg(1024);
+BENCHMARK(packVertices)->Arg(1024)->Arg(65536);
+BENCHMARK(drawFrame)->Arg(1024)->Arg(16384)->Arg(65536);
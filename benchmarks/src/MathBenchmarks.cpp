@@ -0,0 +1,410 @@
+#include "math/Simd.hpp"
+#include "math/SimdTypes.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace beige::math;
+
+constexpr uint32_t global_planeCount { 6u };
+
+auto makeRandomVectors(const uint32_t count, const uint32_t seed) -> std::vector<glm::vec4> {
+    std::mt19937 engine { seed };
+    std::uniform_real_distribution<float> distribution { -10.0f, 10.0f };
+    std::vector<glm::vec4> vectors(count);
+
+    for (glm::vec4& vector : vectors) {
+        vector = glm::vec4(distribution(engine), distribution(engine), distribution(engine), distribution(engine));
+    }
+
+    return vectors;
+}
+
+auto makeRandomMatrices(const uint32_t count, const uint32_t seed) -> std::vector<glm::mat4x4> {
+    const std::vector<glm::vec4> columns { makeRandomVectors(count * 4u, seed) };
+    std::vector<glm::mat4x4> matrices(count);
+
+    for (uint32_t i { 0u }; i < count; i++) {
+        matrices[i] = glm::mat4x4(columns[i * 4u + 0u], columns[i * 4u + 1u], columns[i * 4u + 2u], columns[i * 4u + 3u]);
+    }
+
+    return matrices;
+}
+
+// Spheres with a positive radius, and planes of a box around the origin which keep about half of them.
+auto makeSpheres(const uint32_t count) -> std::vector<glm::vec4> {
+    std::vector<glm::vec4> spheres { makeRandomVectors(count, 3u) };
+
+    for (glm::vec4& sphere : spheres) {
+        sphere.w = std::abs(sphere.w) * 0.1f;
+    }
+
+    return spheres;
+}
+
+auto makePlanes() -> std::vector<glm::vec4> {
+    return {
+        glm::vec4(1.0f, 0.0f, 0.0f, 8.0f),
+        glm::vec4(-1.0f, 0.0f, 0.0f, 8.0f),
+        glm::vec4(0.0f, 1.0f, 0.0f, 8.0f),
+        glm::vec4(0.0f, -1.0f, 0.0f, 8.0f),
+        glm::vec4(0.0f, 0.0f, 1.0f, 8.0f),
+        glm::vec4(0.0f, 0.0f, -1.0f, 8.0f)
+    };
+}
+
+auto toSimd(const std::vector<glm::vec4>& values) -> std::vector<simd::Vec4> {
+    std::vector<simd::Vec4> simdValues(values.size());
+
+    for (std::size_t i { 0u }; i < values.size(); i++) {
+        simdValues[i] = simd::fromGlm(values[i]);
+    }
+
+    return simdValues;
+}
+
+auto toSimd(const std::vector<glm::mat4x4>& values) -> std::vector<simd::Mat4> {
+    std::vector<simd::Mat4> simdValues(values.size());
+
+    for (std::size_t i { 0u }; i < values.size(); i++) {
+        simdValues[i] = simd::fromGlm(values[i]);
+    }
+
+    return simdValues;
+}
+
+// The second argument is the Simd::Level, levels the CPU does not support are skipped.
+auto setLevel(benchmark::State& state) -> bool {
+    const Simd::Level level { static_cast<Simd::Level>(state.range(1)) };
+
+    if (level > Simd::getSupportedLevel()) {
+        state.SkipWithError("Not supported by this CPU");
+        return false;
+    }
+
+    Simd::setLevel(level);
+    state.SetLabel(Simd::getLevelName(level));
+
+    return true;
+}
+
+auto addLevels(benchmark::internal::Benchmark* benchmark) -> void {
+    for (const int64_t count : { 1024, 65536 }) {
+        for (int64_t level { 0 }; level <= static_cast<int64_t>(Simd::Level::Avx2); level++) {
+            benchmark->Args({ count, level });
+        }
+    }
+}
+
+// Square images, the first argument is their width and height in pixels and the second the Simd::Level.
+auto addImageLevels(benchmark::internal::Benchmark* benchmark) -> void {
+    for (const int64_t dimension : { 256, 2048 }) {
+        for (int64_t level { 0 }; level <= static_cast<int64_t>(Simd::Level::Avx2); level++) {
+            benchmark->Args({ dimension, level });
+        }
+    }
+}
+
+auto makeRandomBytes(const uint64_t count, const uint32_t seed) -> std::vector<uint8_t> {
+    std::mt19937 engine { seed };
+    std::uniform_int_distribution<uint32_t> distribution { 0u, 255u };
+    std::vector<uint8_t> bytes(count);
+
+    for (uint8_t& byte : bytes) {
+        byte = static_cast<uint8_t>(distribution(engine));
+    }
+
+    return bytes;
+}
+
+auto transformPointsGlm(benchmark::State& state) -> void {
+    const uint32_t count { static_cast<uint32_t>(state.range(0)) };
+    const glm::mat4x4 matrix { makeRandomMatrices(1u, 1u).front() };
+    const std::vector<glm::vec4> points { makeRandomVectors(count, 2u) };
+    std::vector<glm::vec4> results(count);
+
+    for (auto _ : state) {
+        for (uint32_t i { 0u }; i < count; i++) {
+            results[i] = matrix * points[i];
+        }
+
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+auto transformPointsSimd(benchmark::State& state) -> void {
+    if (!setLevel(state)) {
+        return;
+    }
+
+    const uint32_t count { static_cast<uint32_t>(state.range(0)) };
+    const simd::Mat4 matrix { simd::fromGlm(makeRandomMatrices(1u, 1u).front()) };
+    const std::vector<simd::Vec4> points { toSimd(makeRandomVectors(count, 2u)) };
+    std::vector<simd::Vec4> results(count);
+
+    for (auto _ : state) {
+        simd::transformPoints(matrix, points.data(), results.data(), count);
+
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+auto multiplyMatricesGlm(benchmark::State& state) -> void {
+    const uint32_t count { static_cast<uint32_t>(state.range(0)) };
+    const std::vector<glm::mat4x4> lhs { makeRandomMatrices(count, 4u) };
+    const std::vector<glm::mat4x4> rhs { makeRandomMatrices(count, 5u) };
+    std::vector<glm::mat4x4> results(count);
+
+    for (auto _ : state) {
+        for (uint32_t i { 0u }; i < count; i++) {
+            results[i] = lhs[i] * rhs[i];
+        }
+
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+auto multiplyMatricesSimd(benchmark::State& state) -> void {
+    if (!setLevel(state)) {
+        return;
+    }
+
+    const uint32_t count { static_cast<uint32_t>(state.range(0)) };
+    const std::vector<simd::Mat4> lhs { toSimd(makeRandomMatrices(count, 4u)) };
+    const std::vector<simd::Mat4> rhs { toSimd(makeRandomMatrices(count, 5u)) };
+    std::vector<simd::Mat4> results(count);
+
+    for (auto _ : state) {
+        simd::multiplyMatrices(lhs.data(), rhs.data(), results.data(), count);
+
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+auto cullSpheresGlm(benchmark::State& state) -> void {
+    const uint32_t count { static_cast<uint32_t>(state.range(0)) };
+    const std::vector<glm::vec4> planes { makePlanes() };
+    const std::vector<glm::vec4> spheres { makeSpheres(count) };
+    std::vector<uint32_t> visibleIndices(count);
+
+    for (auto _ : state) {
+        uint32_t visibleCount { 0u };
+
+        for (uint32_t i { 0u }; i < count; i++) {
+            const glm::vec4 center { glm::vec3(spheres[i]), 1.0f };
+            bool isVisible { true };
+
+            for (uint32_t plane { 0u }; plane < global_planeCount && isVisible; plane++) {
+                isVisible = glm::dot(planes[plane], center) > -spheres[i].w;
+            }
+
+            visibleIndices[visibleCount] = i;
+            visibleCount += isVisible ? 1u : 0u;
+        }
+
+        benchmark::DoNotOptimize(visibleCount);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+auto cullSpheresSimd(benchmark::State& state) -> void {
+    if (!setLevel(state)) {
+        return;
+    }
+
+    const uint32_t count { static_cast<uint32_t>(state.range(0)) };
+    const std::vector<simd::Vec4> planes { toSimd(makePlanes()) };
+    const std::vector<simd::Vec4> spheres { toSimd(makeSpheres(count)) };
+    std::vector<uint32_t> visibleIndices(count);
+
+    for (auto _ : state) {
+        const uint32_t visibleCount { simd::cullSpheres(planes.data(), global_planeCount, spheres.data(), count, visibleIndices.data()) };
+
+        benchmark::DoNotOptimize(visibleCount);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// An opaque image, so the whole of it is scanned like most textures are.
+auto hasTransparency(benchmark::State& state) -> void {
+    if (!setLevel(state)) {
+        return;
+    }
+
+    const uint64_t pixelCount { static_cast<uint64_t>(state.range(0) * state.range(0)) };
+    const std::vector<uint8_t> pixels(pixelCount * 4u, 255u);
+
+    for (auto _ : state) {
+        const bool isTransparent { Simd::hasTransparency(pixels.data(), pixelCount) };
+        benchmark::DoNotOptimize(isTransparent);
+    }
+
+    state.SetBytesProcessed(state.iterations() * pixelCount * 4u);
+}
+
+auto expandRgbToRgba(benchmark::State& state) -> void {
+    if (!setLevel(state)) {
+        return;
+    }
+
+    const uint64_t pixelCount { static_cast<uint64_t>(state.range(0) * state.range(0)) };
+    const std::vector<uint8_t> source { makeRandomBytes(pixelCount * 3u, 10u) };
+    std::vector<uint8_t> destination(pixelCount * 4u);
+
+    for (auto _ : state) {
+        Simd::expandRgbToRgba(source.data(), destination.data(), pixelCount);
+
+        benchmark::DoNotOptimize(destination.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * pixelCount * 4u);
+}
+
+auto flipVertically(benchmark::State& state) -> void {
+    if (!setLevel(state)) {
+        return;
+    }
+
+    const uint32_t dimension { static_cast<uint32_t>(state.range(0)) };
+    std::vector<uint8_t> pixels { makeRandomBytes(static_cast<uint64_t>(dimension) * dimension * 4u, 11u) };
+
+    for (auto _ : state) {
+        Simd::flipVertically(pixels.data(), dimension * 4u, dimension);
+
+        benchmark::DoNotOptimize(pixels.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(pixels.size()));
+}
+
+// Premultiplying again changes nothing once every alpha is 255, so the timed runs keep working on mixed alphas.
+auto premultiplyAlpha(benchmark::State& state) -> void {
+    if (!setLevel(state)) {
+        return;
+    }
+
+    const uint64_t pixelCount { static_cast<uint64_t>(state.range(0) * state.range(0)) };
+    const std::vector<uint8_t> source { makeRandomBytes(pixelCount * 4u, 12u) };
+    std::vector<uint8_t> pixels(source.size());
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        pixels = source;
+        state.ResumeTiming();
+
+        Simd::premultiplyAlpha(pixels.data(), pixelCount);
+
+        benchmark::DoNotOptimize(pixels.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * pixelCount * 4u);
+}
+
+auto downsampleBox(benchmark::State& state) -> void {
+    if (!setLevel(state)) {
+        return;
+    }
+
+    const uint32_t dimension { static_cast<uint32_t>(state.range(0)) };
+    const std::vector<uint8_t> source { makeRandomBytes(static_cast<uint64_t>(dimension) * dimension * 4u, 13u) };
+    std::vector<uint8_t> destination(source.size() / 4u);
+
+    for (auto _ : state) {
+        Simd::downsampleBox(source.data(), dimension, dimension, destination.data());
+
+        benchmark::DoNotOptimize(destination.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(source.size()));
+}
+
+// Single values, the inline operations against glm without the batch kernels.
+auto transformPointGlm(benchmark::State& state) -> void {
+    const glm::mat4x4 matrix { makeRandomMatrices(1u, 6u).front() };
+    glm::vec4 point { makeRandomVectors(1u, 7u).front() };
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(matrix);
+        point = matrix * point;
+        benchmark::DoNotOptimize(point);
+    }
+}
+
+auto transformPointSimd(benchmark::State& state) -> void {
+    const simd::Mat4 matrix { simd::fromGlm(makeRandomMatrices(1u, 6u).front()) };
+    simd::Vec4 point { simd::fromGlm(makeRandomVectors(1u, 7u).front()) };
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(matrix);
+        point = matrix * point;
+        benchmark::DoNotOptimize(point);
+    }
+}
+
+auto multiplyMatrixGlm(benchmark::State& state) -> void {
+    const glm::mat4x4 lhs { makeRandomMatrices(1u, 8u).front() };
+    glm::mat4x4 result { makeRandomMatrices(1u, 9u).front() };
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs);
+        result = lhs * result;
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+auto multiplyMatrixSimd(benchmark::State& state) -> void {
+    const simd::Mat4 lhs { simd::fromGlm(makeRandomMatrices(1u, 8u).front()) };
+    simd::Mat4 result { simd::fromGlm(makeRandomMatrices(1u, 9u).front()) };
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs);
+        result = lhs * result;
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+} // namespace
+
+BENCHMARK(transformPointsGlm)->Arg(1024)->Arg(65536);
+BENCHMARK(transformPointsSimd)->Apply(addLevels);
+BENCHMARK(multiplyMatricesGlm)->Arg(1024)->Arg(65536);
+BENCHMARK(multiplyMatricesSimd)->Apply(addLevels);
+BENCHMARK(cullSpheresGlm)->Arg(1024)->Arg(65536);
+BENCHMARK(cullSpheresSimd)->Apply(addLevels);
+BENCHMARK(hasTransparency)->Apply(addImageLevels);
+BENCHMARK(expandRgbToRgba)->Apply(addImageLevels);
+BENCHMARK(flipVertically)->Apply(addImageLevels);
+BENCHMARK(premultiplyAlpha)->Apply(addImageLevels);
+BENCHMARK(downsampleBox)->Apply(addImageLevels);
+BENCHMARK(transformPointGlm);
+BENCHMARK(transformPointSimd);
+BENCHMARK(multiplyMatrixGlm);
+BENCHMARK(multiplyMatrixSimd);
@@ -4,8 +4,10 @@
 #include "core/App.hpp"
 #include "core/Logger.hpp"
 
+#include <cstdlib>
 #include <memory>
 #include <iostream>
+#include <string>
 
 namespace beige {
 
@@ -13,12 +15,60 @@ extern const std::unique_ptr<IGame> createGame();
 
 } // namespace beige
 
-int main() {
+namespace {
+
+// --record-input <path> records the input of the run, --replay-input <path> replays a recording.
+// --benchmark <frames> writes frame statistics at exit, to the path of --benchmark-output <path> if given.
+// --memory-report logs what every memory tag allocated each frame.
+auto parseLaunchOptions(const int argumentCount, char** arguments) -> beige::core::LaunchOptions {
+    beige::core::LaunchOptions launchOptions { };
+
+    for (int i { 1 }; i < argumentCount; i++) {
+        const std::string argument { arguments[i] };
+        const bool hasValue { i + 1 < argumentCount };
+
+        if (argument == "--record-input" && hasValue) {
+            launchOptions.recordInputPath = arguments[++i];
+        }
+        else if (argument == "--replay-input" && hasValue) {
+            launchOptions.replayInputPath = arguments[++i];
+        }
+        else if (argument == "--benchmark" && hasValue) {
+            char* end { nullptr };
+            const unsigned long frameCount { std::strtoul(arguments[i + 1], &end, 10) };
+
+            if (end == arguments[i + 1] || *end != '\0') {
+                beige::core::Logger::warn("Ignoring --benchmark, " + std::string(arguments[i + 1]) + " is no frame count.");
+            }
+            else {
+                launchOptions.isBenchmark = true;
+                launchOptions.benchmarkFrameCount = static_cast<uint32_t>(frameCount);
+            }
+
+            i++;
+        }
+        else if (argument == "--benchmark-output" && hasValue) {
+            launchOptions.benchmarkOutputPath = arguments[++i];
+        }
+        else if (argument == "--memory-report") {
+            launchOptions.isMemoryReport = true;
+        }
+        else {
+            beige::core::Logger::warn("Ignoring unknown or incomplete argument " + argument + ".");
+        }
+    }
+
+    return launchOptions;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
     std::unique_ptr<beige::core::App> app;
 
     try {
         std::unique_ptr<beige::IGame> game { beige::createGame() };
-        app = std::make_unique<beige::core::App>(std::move(game));
+        app = std::make_unique<beige::core::App>(std::move(game), parseLaunchOptions(argc, argv));
     } catch (const std::exception& exception) {
         const std::string exceptionMessage { exception.what() };
         beige::core::Logger::fatal("Application failed to create: " + exceptionMessage);
@@ -2,15 +2,19 @@
 
 #include "Defines.hpp"
 #include "core/AppTypes.hpp"
+#include "ecs/World.hpp"
+#include "scene/Camera.hpp"
+#include "scene/TransformHierarchy.hpp"
 
 #include <glm/glm.hpp>
 
+#include <memory>
+
 namespace beige {
 
 class BEIGE_API IGame {
 public:
     struct State {
-        glm::mat4x4 view;
         glm::vec3 cameraPosition;
         glm::vec3 cameraEuler;
         glm::vec3 cameraUp;
@@ -25,7 +29,10 @@ public:
 
     IGame(const core::AppConfig& appConfig) :
     m_appConfig { appConfig },
-    m_state { } { }
+    m_state { },
+    m_world { nullptr },
+    m_transformHierarchy { nullptr },
+    m_camera { ecs::global_invalidEntity } { }
 
     virtual ~IGame() = default;
 
@@ -36,9 +43,23 @@ public:
     auto getAppConfig() const -> const core::AppConfig& { return m_appConfig; }
     auto getState() const -> const State& { return m_state; }
 
+    // Handed over by the app before the first update, entities in it with a mesh renderer are drawn.
+    auto setWorld(std::shared_ptr<ecs::World> world) -> void { m_world = world; }
+
+    // Handed over with the world, entities with a transform node follow their node.
+    auto setTransformHierarchy(std::shared_ptr<scene::TransformHierarchy> transformHierarchy) -> void {
+        m_transformHierarchy = transformHierarchy;
+    }
+
+    // The entity with the scene::Camera the frames are drawn with, created by the app.
+    auto setCamera(const ecs::Entity camera) -> void { m_camera = camera; }
+
 protected:
     core::AppConfig m_appConfig;
     State m_state;
+    std::shared_ptr<ecs::World> m_world;
+    std::shared_ptr<scene::TransformHierarchy> m_transformHierarchy;
+    ecs::Entity m_camera;
 };
 
 } // namespace beige
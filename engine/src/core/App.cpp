@@ -1,13 +1,24 @@
 #include "App.hpp"
 
 #include "Logger.hpp"
+#include "Memory.hpp"
+#include "../ecs/Components.hpp"
 
 #include <algorithm>
+#include <unordered_map>
 
 namespace beige {
 namespace core {
 
-App::App(std::unique_ptr<IGame> game) :
+App::App(std::unique_ptr<IGame> game, const LaunchOptions& launchOptions) :
+m_launchOptions { launchOptions },
+m_frameStats {
+    std::make_unique<FrameStats>(
+        launchOptions.benchmarkFrameCount > 0u ? launchOptions.benchmarkFrameCount : m_frameStatsCapacity
+    )
+},
+m_lastMemoryStats { },
+m_lastHeapStats { },
 m_isRunning { true },
 m_isSuspended { false },
 m_lastTime { 0.0f },
@@ -16,16 +27,33 @@ m_windowHeight { game->getAppConfig().startHeight },
 m_input { Input::getInstance() },
 m_platform { std::make_shared<platform::Platform>(game->getAppConfig()) },
 m_clock { std::make_unique<Clock>(m_platform) },
+m_jobSystem { std::make_shared<JobSystem>() },
+m_vfs { mountAssets() },
+m_world { std::make_shared<ecs::World>(m_jobSystem) },
+m_transformHierarchy { std::make_shared<scene::TransformHierarchy>(m_jobSystem) },
+m_camera { m_world->create() },
 m_rendererFrontend {
     std::make_shared<renderer::Frontend>(
         game->getAppConfig().name,
         m_windowWidth,
         m_windowHeight,
-        m_platform
+        m_platform,
+        m_jobSystem,
+        m_vfs
     )
 },
-m_textureSystem { std::make_unique<systems::Texture>(m_rendererFrontend) },
-m_game { std::move(game) } {
+m_textureSystem { std::make_unique<systems::Texture>(m_rendererFrontend, m_jobSystem, m_vfs) },
+m_geometrySystem { std::make_unique<systems::Geometry>(m_rendererFrontend, m_vfs) },
+m_game { std::move(game) },
+m_assetWatcher { std::make_unique<platform::FileWatcher>(std::string(m_assetDirectory)) } {
+    scene::Camera camera;
+    camera.setAspectRatio(static_cast<float>(m_windowWidth) / static_cast<float>(m_windowHeight));
+    m_world->add(m_camera, camera);
+
+    m_game->setWorld(m_world);
+    m_game->setTransformHierarchy(m_transformHierarchy);
+    m_game->setCamera(m_camera);
+
     m_keyEventSubscriptions.push_back(
         m_input->KeyEvent::subscribe(
             [&](const KeyEventCode& keyEventCode, const Key& key) -> void {
@@ -94,6 +122,10 @@ m_game { std::move(game) } {
                                 m_isSuspended = false;
                             }
 
+                            m_world->get<scene::Camera>(m_camera)->setAspectRatio(
+                                static_cast<float>(m_windowWidth) / static_cast<float>(m_windowHeight)
+                            );
+
                             m_game->onResize(m_windowWidth, m_windowHeight);
                             m_rendererFrontend->onResized(m_windowWidth, m_windowHeight);
                         }
@@ -131,12 +163,42 @@ App::~App() {
 }
 
 auto App::run() -> bool {
+    // TODO: Temporary, stands in for a level load.
+    m_textureSystem->preload({ "wall", "grass", "dirt" });
+
+    const scene::TransformHandle testNode { m_transformHierarchy->create(scene::global_invalidTransformHandle) };
+    const ecs::Entity testEntity { m_world->create() };
+    float testAngle { 0.0f };
+
+    m_world->add(testEntity, ecs::Transform { glm::mat4x4(1.0f) });
+    m_world->add(testEntity, ecs::TransformNode { testNode });
+    m_world->add(
+        testEntity,
+        ecs::MeshRenderer {
+            m_geometrySystem->getDefaultGeometry(), // geometry
+            0u                                      // objectId
+        }
+    );
+
+    // Both start from the state before the first frame, so a replay sees exactly what was recorded.
+    if (!m_launchOptions.replayInputPath.empty()) {
+        if (!m_input->startReplay(m_launchOptions.replayInputPath)) {
+            return false;
+        }
+    }
+    else if (!m_launchOptions.recordInputPath.empty()) {
+        if (!m_input->startRecording(m_launchOptions.recordInputPath)) {
+            return false;
+        }
+    }
+
     m_isRunning = true;
     m_clock->start();
     m_clock->update();
     m_lastTime = m_clock->getElapsedTime();
 
     uint32_t frameCount { 0u };
+    double lastFrameStartTime { 0.0 };
     const double targetFrameInSeconds = 1.0 / 60.0;
 
     while (m_isRunning) {
@@ -144,65 +206,138 @@ auto App::run() -> bool {
             m_isRunning = false;
         }
 
+        if (m_input->isReplayFinished()) {
+            Logger::info("Input replay finished, shutting down.");
+            break;
+        }
+
+        // Applies the input queued by the platform, even when suspended so closing the window is not missed.
+        m_input->update(m_platform->getAbsoluteTime());
+
         if (!m_isSuspended) {
             // Update clock and get delta time.
             m_clock->update();
             const double currentTime { m_clock->getElapsedTime() };
-            const double deltaTime { currentTime - m_lastTime };
+            // A replay advances by the fixed timestep of its recording, whatever the frames actually take.
+            const double deltaTime { m_input->isReplaying() ? m_input->getReplayTimestep() : currentTime - m_lastTime };
             const double frameStartTime { m_platform->getAbsoluteTime() };
+            const uint64_t frameStartAllocationCount { Memory::getAllocationCount() };
 
-            if (!m_game->update(static_cast<float>(deltaTime))) {
-                Logger::fatal("Game update failed, shutting down!");
-                break;
-            }
+            {
+                // What the engine allocates on behalf of the game.
+                const MemoryScope memoryScope { MemoryTag::Game };
 
-            // HACK.
-            m_rendererFrontend->setView(m_game->getState().view);
+                if (!m_game->update(static_cast<float>(deltaTime))) {
+                    Logger::fatal("Game update failed, shutting down!");
+                    break;
+                }
 
-            if (!m_game->render(static_cast<float>(deltaTime))) {
-                Logger::fatal("Game render failed, shutting down!");
-                break;
+                if (!m_game->render(static_cast<float>(deltaTime))) {
+                    Logger::fatal("Game render failed, shutting down!");
+                    break;
+                }
             }
 
             // TODO: Refactor packet creation.
-            const renderer::Packet packet {
-                deltaTime
+            renderer::Packet packet {
+                deltaTime,
+                { },
+                { },
+                { },
+                { }
             };
 
             // TODO: Temporary.
             static uint32_t currentTextureIndex = 0u;
-            static std::string previousTextureName = "default";
             if (m_game->getState().textureIndex == 1u && currentTextureIndex != 1u) {
                 currentTextureIndex = 1u;
+                const resources::TextureHandle previousTexture { m_rendererFrontend->m_testDiffuse };
                 m_rendererFrontend->m_testDiffuse = m_textureSystem->acquire("wall", true);
-                //m_textureSystem->release(previousTextureName);
-                previousTextureName = "wall";
+                if (previousTexture != m_textureSystem->getDefaultTexture()) {
+                    m_textureSystem->release(previousTexture);
+                }
             }
             else if (m_game->getState().textureIndex == 2u && currentTextureIndex != 2u) {
                 currentTextureIndex = 2u;
+                const resources::TextureHandle previousTexture { m_rendererFrontend->m_testDiffuse };
                 m_rendererFrontend->m_testDiffuse = m_textureSystem->acquire("grass", true);
-                //m_textureSystem->release(previousTextureName);
-                previousTextureName = "grass";
+                if (previousTexture != m_textureSystem->getDefaultTexture()) {
+                    m_textureSystem->release(previousTexture);
+                }
             }
             else if (m_game->getState().textureIndex == 3u && currentTextureIndex != 3u) {
 
                 currentTextureIndex = 3u;
+                const resources::TextureHandle previousTexture { m_rendererFrontend->m_testDiffuse };
                 m_rendererFrontend->m_testDiffuse = m_textureSystem->acquire("dirt", true);
-                //m_textureSystem->release(previousTextureName);
-                previousTextureName = "dirt";
+                if (previousTexture != m_textureSystem->getDefaultTexture()) {
+                    m_textureSystem->release(previousTexture);
+                }
             }
 
-            if (m_rendererFrontend->m_testDiffuse == nullptr) {
+            if (m_rendererFrontend->m_testDiffuse == resources::global_invalidTextureHandle) {
                 m_rendererFrontend->m_testDiffuse = m_textureSystem->getDefaultTexture();
             }
 
+            m_rendererFrontend->setMaterialDiffuse(0u, m_rendererFrontend->m_testDiffuse);
+
+            testAngle += 0.001f;
+            m_transformHierarchy->setRotation(testNode, glm::angleAxis(testAngle, glm::vec3(0.0f, 0.0f, 1.0f)));
+
             // TODO: End temporary.
 
+            reloadChangedAssets();
+
+            // Upload textures which finished decoding, bounded by the per-frame budget.
+            m_textureSystem->update();
+
+            // Recomputes the world matrices of changed nodes only and copies them into their entities.
+            m_transformHierarchy->update();
+            m_transformHierarchy->writeTransforms(*m_world);
+
+            // Only rebuilds the matrices if the game or a resize changed the camera.
+            scene::Camera* camera { m_world->get<scene::Camera>(m_camera) };
+            camera->update();
+            m_rendererFrontend->setCamera(*camera);
+
+            m_rendererFrontend->collectGeometries(*m_world, packet);
             m_rendererFrontend->drawFrame(packet);
 
             // Figure out how long the frame took and, if below.
             const double frameEndTime { m_platform->getAbsoluteTime() };
             const double frameElapsedTime { frameEndTime - frameStartTime };
+            const renderer::FrameTimings frameTimings { m_rendererFrontend->getFrameTimings() };
+
+            // The first frame has no previous one to measure from.
+            const double frameTime { frameCount > 0u ? frameStartTime - lastFrameStartTime : frameElapsedTime };
+            const uint64_t allocationCount { Memory::getAllocationCount() - frameStartAllocationCount };
+
+            m_frameStats->add(
+                FrameSample {
+                    static_cast<float>(frameTime * 1000.0),                                       // frameTime
+                    static_cast<float>(frameElapsedTime * 1000.0) - frameTimings.presentWaitTime, // cpuTime
+                    frameTimings.gpuTime,                                                         // gpuTime
+                    frameTimings.presentWaitTime,                                                 // presentWaitTime
+                    packet.cullingStats.cullTime,                                                 // cullTime
+                    static_cast<uint32_t>(allocationCount),                                       // allocationCount
+                    packet.cullingStats.objectCount,                                              // objectCount
+                    packet.cullingStats.visibleCount,                                             // visibleCount
+                    packet.cullingStats.instanceCount                                             // instanceCount
+                }
+            );
+
+            if (m_launchOptions.isMemoryReport) {
+                reportMemory(frameCount);
+            }
+
+            lastFrameStartTime = frameStartTime;
+            frameCount++;
+
+            if (m_launchOptions.benchmarkFrameCount > 0u && frameCount >= m_launchOptions.benchmarkFrameCount) {
+                Logger::info("Benchmark ran " + std::to_string(frameCount) + " frames, shutting down.");
+                m_isRunning = false;
+            }
+
             const double remainingInS { targetFrameInSeconds - frameElapsedTime};
 
             if (remainingInS > 0.0) {
@@ -211,20 +346,125 @@ auto App::run() -> bool {
                 if (remainingInMs > 0u && isFrameLimit) {
                     m_platform->Sleep(remainingInMs - 1u);
                 }
-                frameCount++;
             }
 
-            m_input->update(deltaTime);
-
             m_lastTime = currentTime;
         }
     }
 
-    // BEIGE NOTE: Unset test texture pointer to allow texture system destroy all textures before Vulkan instance.
-    m_rendererFrontend->m_testDiffuse = nullptr;
+    const bool areReportsWritten { !m_launchOptions.isBenchmark || writeBenchmarkReports() };
+
+    return m_input->stopRecording() && areReportsWritten;
+}
+
+auto App::mountAssets() -> std::shared_ptr<Vfs> {
+    std::shared_ptr<Vfs> vfs { std::make_shared<Vfs>() };
+
+    vfs->mountDirectory(std::string(m_assetDirectory));
+    vfs->mountArchive("assets.bpak");
+
+    return vfs;
+}
+
+auto App::reloadChangedAssets() -> void {
+    const std::string texturePrefix { "textures/" };
+    const std::string shaderPrefix { "shaders/" };
+
+    // A build copies the source and cooks it at once, the cooked file wins over cooking again in memory.
+    std::unordered_map<std::string, bool> changedTextures;
+    bool areShadersChanged { false };
+
+    for (const std::string& path : m_assetWatcher->poll()) {
+        const std::size_t extensionStart { path.rfind('.') };
+
+        if (extensionStart == std::string::npos) {
+            continue;
+        }
+
+        const std::string extension { path.substr(extensionStart) };
+
+        if (path.compare(0u, texturePrefix.size(), texturePrefix) == 0) {
+            const std::string name { path.substr(texturePrefix.size(), extensionStart - texturePrefix.size()) };
+
+            if (extension == ".png") {
+                changedTextures.emplace(name, true);
+            }
+            else if (extension == ".btex") {
+                changedTextures[name] = false;
+            }
+        }
+        else if (path.compare(0u, shaderPrefix.size(), shaderPrefix) == 0 && extension == ".spv") {
+            areShadersChanged = true;
+        }
+    }
+
+    // Neither kind of reload idles the device, replaced images and pipelines go through the deletion queue.
+    for (const std::pair<const std::string, bool>& changedTexture : changedTextures) {
+        m_textureSystem->reload(changedTexture.first, changedTexture.second);
+    }
+
+    // Every stage of a pipeline is rebuilt together, so several changed shaders cost one reload.
+    if (areShadersChanged) {
+        m_rendererFrontend->reloadShaders();
+    }
+}
+
+auto App::writeBenchmarkReports() const -> bool {
+    const std::string outputPath {
+        m_launchOptions.benchmarkOutputPath.empty()
+        ? std::string(m_defaultBenchmarkOutputPath)
+        : m_launchOptions.benchmarkOutputPath
+    };
+
+    if (!m_frameStats->writeJson(outputPath + ".json") || !m_frameStats->writeCsv(outputPath + ".csv")) {
+        Logger::error("App::writeBenchmarkReports - failed to write " + outputPath + ".json or .csv!");
+        return false;
+    }
+
+    Logger::info(
+        "Wrote statistics of " + std::to_string(m_frameStats->getCount()) + " frames to " + outputPath +
+        ".json and .csv."
+    );
 
     return true;
 }
 
+auto App::reportMemory(const uint32_t frame) -> void {
+    std::string report { "Memory of frame " + std::to_string(frame) + ":" };
+
+    for (std::size_t i { 0u }; i < m_lastMemoryStats.size(); i++) {
+        const MemoryTag tag { static_cast<MemoryTag>(i) };
+        const MemoryStats stats { Memory::getStats(tag) };
+        MemoryStats& lastStats { m_lastMemoryStats.at(i) };
+
+        report +=
+            " " + std::string(Memory::getTagName(tag)) + " " +
+            std::to_string(stats.allocationCount - lastStats.allocationCount) + " allocations of " +
+            std::to_string(stats.allocatedBytes - lastStats.allocatedBytes) + " B";
+
+        // Only explicit allocations know their tag when freed, a live size that keeps growing is a leak.
+        if (stats.peakBytes > 0) {
+            report +=
+                " (" + std::to_string(stats.liveBytes) + " B live, " +
+                std::to_string(stats.liveBytes - lastStats.liveBytes) + " B since the last frame, " +
+                std::to_string(stats.peakBytes) + " B peak)";
+        }
+
+        report += ",";
+        lastStats = stats;
+    }
+
+    const MemoryStats heapStats { Memory::getHeapStats() };
+
+    report +=
+        " heap " + std::to_string(heapStats.liveBytes) + " B live, " +
+        std::to_string(heapStats.liveBytes - m_lastHeapStats.liveBytes) + " B since the last frame, " +
+        std::to_string(heapStats.peakBytes) + " B peak.";
+
+    m_lastHeapStats = heapStats;
+
+    Logger::info(report);
+}
+
 } // namespace core
 } // namespace beige
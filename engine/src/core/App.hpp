@@ -3,11 +3,21 @@
 #include "../Defines.hpp"
 #include "Input.hpp"
 #include "../platform/Platform.hpp"
+#include "../platform/FileWatcher.hpp"
 #include "../renderer/RendererFrontend.hpp"
+#include "../systems/GeometrySystem.hpp"
 #include "../systems/TextureSystem.hpp"
 #include "../IGame.hpp"
+#include "../ecs/World.hpp"
+#include "../scene/Camera.hpp"
+#include "../scene/TransformHierarchy.hpp"
 #include "Clock.hpp"
+#include "FrameStats.hpp"
+#include "JobSystem.hpp"
+#include "Memory.hpp"
+#include "Vfs.hpp"
 
+#include <array>
 #include <memory>
 
 namespace beige {
@@ -15,16 +25,29 @@ namespace core {
 
 class BEIGE_API App final {
 public:
-    App(std::unique_ptr<IGame> game);
+    App(std::unique_ptr<IGame> game, const LaunchOptions& launchOptions);
     ~App();
 
     auto run() -> bool;
 
 private:
+    static constexpr std::string_view m_assetDirectory { "assets" };
+    static constexpr std::string_view m_defaultBenchmarkOutputPath { "benchmark" };
+
+    // Frames kept for the reports of a benchmark without a frame count, the latest ones win.
+    static constexpr uint32_t m_frameStatsCapacity { 65536u };
+
     std::vector<Input::KeyEvent::Subscription> m_keyEventSubscriptions;
     std::vector<Input::MouseEvent::Subscription> m_mouseEventSubscriptions;
     std::vector<platform::Platform::Event::Subscription> m_platformSubscriptions;
 
+    LaunchOptions m_launchOptions;
+    std::unique_ptr<FrameStats> m_frameStats;
+
+    // As of the last memory report, which logs the differences.
+    std::array<MemoryStats, static_cast<std::size_t>(MemoryTag::Count)> m_lastMemoryStats;
+    MemoryStats m_lastHeapStats;
+
     bool m_isRunning;
     bool m_isSuspended;
     double m_lastTime;
@@ -35,9 +58,24 @@ private:
     std::shared_ptr<Input> m_input;
     std::shared_ptr<platform::Platform> m_platform;
     std::unique_ptr<Clock> m_clock;
+    std::shared_ptr<JobSystem> m_jobSystem;
+    std::shared_ptr<Vfs> m_vfs;
+    std::shared_ptr<ecs::World> m_world;
+    std::shared_ptr<scene::TransformHierarchy> m_transformHierarchy;
+    ecs::Entity m_camera;
     std::shared_ptr<renderer::Frontend> m_rendererFrontend;
     std::unique_ptr<systems::Texture> m_textureSystem;
+    std::unique_ptr<systems::Geometry> m_geometrySystem;
     std::unique_ptr<IGame> m_game;
+
+    // Changed loose assets are swapped in while running, packed ones shadow them.
+    std::unique_ptr<platform::FileWatcher> m_assetWatcher;
+
+    // Loose assets are mounted first so a packed archive, if built, takes precedence.
+    static auto mountAssets() -> std::shared_ptr<Vfs>;
+    auto reloadChangedAssets() -> void;
+    auto writeBenchmarkReports() const -> bool;
+    auto reportMemory(const uint32_t frame) -> void;
 };
 
 } // namespace core
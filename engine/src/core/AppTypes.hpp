@@ -14,5 +14,15 @@ struct AppConfig {
     std::string name;
 };
 
+// Given on the command line, settings of a single run rather than of the game.
+struct LaunchOptions {
+    std::string recordInputPath;     // Records the input of the run to this file, if set.
+    std::string replayInputPath;     // Replays the input of this recording with its fixed timestep and quits at its end.
+    bool isBenchmark;                // Collects frame statistics and writes them as reports at exit.
+    uint32_t benchmarkFrameCount;    // Quits after as many frames, 0 runs until the replay ends or the app is closed.
+    std::string benchmarkOutputPath; // The reports are written here with .json and .csv appended.
+    bool isMemoryReport;             // Logs the allocations of every memory tag each frame.
+};
+
 } // namespace core
 } // namespace beige
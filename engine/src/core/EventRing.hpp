@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace beige {
+namespace core {
+
+/**
+ * A fixed size queue between exactly one producer and one consumer thread which never blocks or allocates. Each side
+ * only writes its own index and reads the other's, so the two atomics are the only synchronization needed.
+ */
+template<typename T, uint32_t Capacity>
+class EventRing final {
+    static_assert(Capacity > 0u && (Capacity & (Capacity - 1u)) == 0u, "The capacity has to be a power of two!");
+
+public:
+    EventRing() : m_head { 0u }, m_tail { 0u }, m_values { } { }
+    ~EventRing() = default;
+
+    EventRing(const EventRing&) = delete;
+    auto operator=(const EventRing&) -> EventRing& = delete;
+
+    /**
+     * Only called from the producer thread.
+     * @returns False if the ring is full, the value is dropped then.
+     */
+    auto tryPush(const T& value) -> bool {
+        const uint32_t tail { m_tail.load(std::memory_order_relaxed) };
+
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+
+        m_values[tail & (Capacity - 1u)] = value;
+        m_tail.store(tail + 1u, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Only called from the consumer thread.
+     * @returns False if the ring is empty.
+     */
+    auto tryPop(T& value) -> bool {
+        const uint32_t head { m_head.load(std::memory_order_relaxed) };
+
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = m_values[head & (Capacity - 1u)];
+        m_head.store(head + 1u, std::memory_order_release);
+
+        return true;
+    }
+
+private:
+    // The indices only ever grow and wrap around, on separate cache lines so the threads do not contend for them.
+    alignas(64) std::atomic<uint32_t> m_head;
+    alignas(64) std::atomic<uint32_t> m_tail;
+    alignas(64) std::array<T, Capacity> m_values;
+};
+
+} // namespace core
+} // namespace beige
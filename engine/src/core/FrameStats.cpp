@@ -0,0 +1,188 @@
+#include "FrameStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <numeric>
+
+namespace beige {
+namespace core {
+
+namespace {
+
+struct Summary {
+    double mean;
+    double p50;
+    double p95;
+    double p99;
+    double max;
+};
+
+auto summarize(std::vector<double> values) -> Summary {
+    if (values.empty()) {
+        return Summary { 0.0, 0.0, 0.0, 0.0, 0.0 };
+    }
+
+    std::sort(values.begin(), values.end());
+
+    // Nearest rank, so every percentile is a value which actually occurred.
+    const auto percentile {
+        [&values](const double fraction) -> double {
+            const std::size_t rank { static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(values.size()))) };
+            return values.at(std::max<std::size_t>(rank, 1u) - 1u);
+        }
+    };
+
+    return Summary {
+        std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size()), // mean
+        percentile(0.50),                                                                        // p50
+        percentile(0.95),                                                                        // p95
+        percentile(0.99),                                                                        // p99
+        values.back()                                                                            // max
+    };
+}
+
+auto writeSummary(
+    std::ofstream& file,
+    const std::string& name,
+    const std::vector<FrameSample>& samples,
+    const std::function<double(const FrameSample&)>& field
+) -> void {
+    std::vector<double> values(samples.size());
+    std::transform(samples.begin(), samples.end(), values.begin(), field);
+
+    const Summary summary { summarize(std::move(values)) };
+
+    file << "    \"" << name << "\": { "
+        << "\"mean\": " << summary.mean << ", "
+        << "\"p50\": " << summary.p50 << ", "
+        << "\"p95\": " << summary.p95 << ", "
+        << "\"p99\": " << summary.p99 << ", "
+        << "\"max\": " << summary.max << " },\n";
+}
+
+} // namespace
+
+FrameStats::FrameStats(const uint32_t capacity) :
+m_samples { },
+m_capacity { std::max(capacity, 1u) },
+m_next { 0u } {
+    m_samples.reserve(m_capacity);
+}
+
+auto FrameStats::add(const FrameSample& sample) -> void {
+    if (m_samples.size() < m_capacity) {
+        m_samples.push_back(sample);
+    }
+    else {
+        m_samples.at(m_next) = sample;
+    }
+
+    m_next = (m_next + 1u) % m_capacity;
+}
+
+auto FrameStats::getCount() const -> uint32_t {
+    return static_cast<uint32_t>(m_samples.size());
+}
+
+auto FrameStats::writeJson(const std::string& path) const -> bool {
+    const std::vector<FrameSample> samples { getOrderedSamples() };
+
+    double totalFrameTime { 0.0 };
+    std::vector<uint32_t> histogram(m_histogramBucketCount, 0u);
+
+    for (const FrameSample& sample : samples) {
+        totalFrameTime += sample.frameTime;
+
+        const uint32_t bucket { static_cast<uint32_t>(std::max(sample.frameTime, 0.0f) / m_histogramBucketWidth) };
+        histogram.at(std::min(bucket, m_histogramBucketCount - 1u))++;
+    }
+
+    const double averageFps {
+        totalFrameTime > 0.0 ? static_cast<double>(samples.size()) * 1000.0 / totalFrameTime : 0.0
+    };
+
+    std::ofstream file { path, std::ios::trunc };
+
+    file << "{\n";
+    file << "    \"frameCount\": " << samples.size() << ",\n";
+    file << "    \"averageFps\": " << averageFps << ",\n";
+
+    writeSummary(file, "frameTime", samples, [](const FrameSample& sample) -> double { return sample.frameTime; });
+    writeSummary(file, "cpuTime", samples, [](const FrameSample& sample) -> double { return sample.cpuTime; });
+    writeSummary(file, "gpuTime", samples, [](const FrameSample& sample) -> double { return sample.gpuTime; });
+    writeSummary(
+        file,
+        "presentWaitTime",
+        samples,
+        [](const FrameSample& sample) -> double { return sample.presentWaitTime; }
+    );
+    writeSummary(file, "cullTime", samples, [](const FrameSample& sample) -> double { return sample.cullTime; });
+    writeSummary(
+        file,
+        "allocationCount",
+        samples,
+        [](const FrameSample& sample) -> double { return sample.allocationCount; }
+    );
+    writeSummary(file, "objectCount", samples, [](const FrameSample& sample) -> double { return sample.objectCount; });
+    writeSummary(file, "visibleCount", samples, [](const FrameSample& sample) -> double { return sample.visibleCount; });
+    writeSummary(
+        file,
+        "instanceCount",
+        samples,
+        [](const FrameSample& sample) -> double { return sample.instanceCount; }
+    );
+
+    file << "    \"frameTimeHistogram\": {\n";
+    file << "        \"bucketWidth\": " << m_histogramBucketWidth << ",\n";
+    file << "        \"counts\": [";
+
+    for (uint32_t i { 0u }; i < m_histogramBucketCount; i++) {
+        file << (i == 0u ? "" : ", ") << histogram.at(i);
+    }
+
+    file << "]\n";
+    file << "    }\n";
+    file << "}\n";
+
+    return static_cast<bool>(file);
+}
+
+auto FrameStats::writeCsv(const std::string& path) const -> bool {
+    std::ofstream file { path, std::ios::trunc };
+
+    file << "frame,frameTime,cpuTime,gpuTime,presentWaitTime,cullTime,allocationCount,objectCount,visibleCount,instanceCount\n";
+
+    uint32_t frame { 0u };
+
+    for (const FrameSample& sample : getOrderedSamples()) {
+        file << frame++ << ','
+            << sample.frameTime << ','
+            << sample.cpuTime << ','
+            << sample.gpuTime << ','
+            << sample.presentWaitTime << ','
+            << sample.cullTime << ','
+            << sample.allocationCount << ','
+            << sample.objectCount << ','
+            << sample.visibleCount << ','
+            << sample.instanceCount << '\n';
+    }
+
+    return static_cast<bool>(file);
+}
+
+auto FrameStats::getOrderedSamples() const -> std::vector<FrameSample> {
+    if (m_samples.size() < m_capacity) {
+        return m_samples;
+    }
+
+    // Once full, the next sample to be replaced is the oldest one.
+    std::vector<FrameSample> samples { m_samples };
+    std::rotate(samples.begin(), samples.begin() + m_next, samples.end());
+
+    return samples;
+}
+
+} // namespace core
+} // namespace beige
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../Defines.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace beige {
+namespace core {
+
+struct FrameSample {
+    float frameTime;          // In milliseconds, from the start of the previous frame.
+    float cpuTime;            // In milliseconds, the host worked on the frame without the present waits.
+    float gpuTime;            // In milliseconds, see renderer::FrameTimings.
+    float presentWaitTime;    // In milliseconds, the host blocked on the device and presentation.
+    float cullTime;           // In milliseconds, see renderer::CullingStats.
+    uint32_t allocationCount; // Heap allocations of the engine during the frame.
+    uint32_t objectCount;     // Geometries culled on the host.
+    uint32_t visibleCount;    // Geometries which survived culling.
+    uint32_t instanceCount;   // Instances culled on the device, not part of the counts above.
+};
+
+/**
+ * Keeps the samples of the last frames in a ring buffer and reports them, to catch regressions in automated runs.
+ */
+class BEIGE_API FrameStats final {
+public:
+    FrameStats(const uint32_t capacity);
+    ~FrameStats() = default;
+
+    FrameStats(const FrameStats&) = delete;
+    auto operator=(const FrameStats&) -> FrameStats& = delete;
+
+    /**
+     * Adds the sample of a frame, replacing the oldest one once the ring is full.
+     */
+    auto add(const FrameSample& sample) -> void;
+
+    /**
+     * @returns The number of kept samples, at most the capacity.
+     */
+    auto getCount() const -> uint32_t;
+
+    /**
+     * Writes the mean, p50, p95, p99 and max of every sample field, the average frame rate and a histogram of the
+     * frame times.
+     * @returns False if the file could not be written.
+     */
+    auto writeJson(const std::string& path) const -> bool;
+
+    /**
+     * Writes every kept sample as a row, oldest first.
+     * @returns False if the file could not be written.
+     */
+    auto writeCsv(const std::string& path) const -> bool;
+
+private:
+    // One millisecond each, the last one also counts every longer frame.
+    static constexpr uint32_t m_histogramBucketCount { 100u };
+    static constexpr float m_histogramBucketWidth { 1.0f };
+
+    std::vector<FrameSample> m_samples;
+    uint32_t m_capacity;
+    uint32_t m_next;
+
+    auto getOrderedSamples() const -> std::vector<FrameSample>;
+};
+
+} // namespace core
+} // namespace beige
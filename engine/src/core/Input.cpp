@@ -1,60 +1,340 @@
 #include "Input.hpp"
 
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
 namespace beige {
 namespace core {
 
 std::shared_ptr<Input> Input::m_instance { new Input };
-std::vector<bool> Input::m_currentKeyboardState(256, false);
-std::vector<bool> Input::m_previousKeyboardState(256, false);
+std::bitset<global_keyCount> Input::m_currentKeyboardState { };
+std::bitset<global_keyCount> Input::m_previousKeyboardState { };
+std::bitset<global_keyCount> Input::m_changedKeyboardState { };
 
 MouseState Input::m_currentMouseState {
-    0,
-    0,
-    {
-        { Button::Left, false },
-        { Button::Middle, false },
-        { Button::Right, false }
-    }
+    0,  // xPos
+    0,  // yPos
+    { } // buttons
 };
 
-MouseState Input::m_previousMouseState{
+MouseState Input::m_previousMouseState {
     m_currentMouseState
 };
 
+EventRing<InputEvent, Input::m_eventCapacity> Input::m_events { };
+std::atomic<uint32_t> Input::m_droppedEventCount { 0u };
+
+uint32_t Input::m_frame { 0u };
+double Input::m_startTime { 0.0 };
+double Input::m_lastTime { 0.0 };
+
+bool Input::m_isRecording { false };
+std::string Input::m_recordingPath { };
+std::vector<InputRecordingEvent> Input::m_recordedEvents { };
+
+bool Input::m_isReplaying { false };
+InputRecordingHeader Input::m_replayHeader { };
+std::vector<InputRecordingEvent> Input::m_replayEvents { };
+std::size_t Input::m_replayIndex { 0u };
+
 auto Input::getInstance() -> std::shared_ptr<Input> {
     return m_instance;
 }
 
-auto Input::update(const double deltaTime) -> void {
+auto Input::update(const double time) -> void {
     m_previousKeyboardState = m_currentKeyboardState;
     m_previousMouseState = m_currentMouseState;
+
+    if (m_frame == 0u) {
+        m_startTime = time;
+    }
+
+    m_lastTime = time;
+
+    InputEvent event { };
+
+    while (m_events.tryPop(event)) {
+        // Anything else from the platform would make the replay diverge, Escape still allows to abort it.
+        if (m_isReplaying && (event.type != InputEventType::Key || static_cast<Key>(event.code) != Key::Escape)) {
+            continue;
+        }
+
+        if (m_isRecording) {
+            record(event);
+        }
+
+        applyEvent(event);
+    }
+
+    if (m_isReplaying) {
+        replayFrame();
+    }
+
+    if (m_isRecording || m_isReplaying) {
+        m_frame++;
+    }
+
+    // Every key that went down or up since the last frame, whatever happened in between.
+    m_changedKeyboardState = m_currentKeyboardState ^ m_previousKeyboardState;
+
+    const uint32_t droppedEventCount { m_droppedEventCount.exchange(0u, std::memory_order_relaxed) };
+
+    if (droppedEventCount > 0u) {
+        Logger::warn("Input event ring full, dropped " + std::to_string(droppedEventCount) + " events!");
+    }
 }
 
 auto Input::isKeyDown(const Key key) -> bool {
-    return m_currentKeyboardState.at(static_cast<uint64_t>(key));
+    return m_currentKeyboardState.test(static_cast<std::size_t>(key));
 }
+
 auto Input::isKeyUp(const Key key) -> bool {
-    return !m_currentKeyboardState.at(static_cast<uint64_t>(key));
+    return !m_currentKeyboardState.test(static_cast<std::size_t>(key));
 }
 
 auto Input::wasKeyDown(const Key key) -> bool {
-    return m_previousKeyboardState.at(static_cast<uint64_t>(key));
+    return m_previousKeyboardState.test(static_cast<std::size_t>(key));
 }
 
 auto Input::wasKeyUp(const Key key) -> bool {
-    return !m_previousKeyboardState.at(static_cast<uint64_t>(key));
+    return !m_previousKeyboardState.test(static_cast<std::size_t>(key));
+}
+
+auto Input::wasKeyPressed(const Key key) -> bool {
+    const std::size_t index { static_cast<std::size_t>(key) };
+    return m_changedKeyboardState.test(index) && m_currentKeyboardState.test(index);
+}
+
+auto Input::wasKeyReleased(const Key key) -> bool {
+    const std::size_t index { static_cast<std::size_t>(key) };
+    return m_changedKeyboardState.test(index) && !m_currentKeyboardState.test(index);
+}
+
+auto Input::isButtonDown(const Button button) -> bool {
+    return m_currentMouseState.buttons.at(static_cast<std::size_t>(button));
+}
+
+auto Input::wasButtonDown(const Button button) -> bool {
+    return m_previousMouseState.buttons.at(static_cast<std::size_t>(button));
+}
+
+auto Input::pushEvent(const InputEvent& event) -> bool {
+    if (!m_events.tryPush(event)) {
+        m_droppedEventCount.fetch_add(1u, std::memory_order_relaxed);
+        return false;
+    }
+
+    return true;
+}
+
+auto Input::startRecording(const std::string& path) -> bool {
+    if (m_isRecording || m_isReplaying) {
+        Logger::error("Input::startRecording - already recording or replaying!");
+        return false;
+    }
+
+    m_frame = 0u;
+    m_isRecording = true;
+    m_recordingPath = path;
+    m_recordedEvents.clear();
+
+    Logger::info("Recording input to " + path + ".");
+
+    return true;
+}
+
+auto Input::stopRecording() -> bool {
+    if (!m_isRecording) {
+        return true;
+    }
+
+    m_isRecording = false;
+
+    // The first and last update span one frame less than were recorded.
+    const double timestep {
+        m_frame > 1u ? (m_lastTime - m_startTime) / static_cast<double>(m_frame - 1u) : m_defaultReplayTimestep
+    };
+
+    const InputRecordingHeader header {
+        global_inputRecordingMagic,                     // magic
+        global_inputRecordingVersion,                   // version
+        m_frame,                                        // frameCount
+        static_cast<uint32_t>(m_recordedEvents.size()), // eventCount
+        timestep                                        // timestep
+    };
+
+    std::ofstream file { m_recordingPath, std::ios::binary | std::ios::trunc };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(
+        reinterpret_cast<const char*>(m_recordedEvents.data()),
+        static_cast<std::streamsize>(m_recordedEvents.size() * sizeof(InputRecordingEvent))
+    );
+
+    if (!file) {
+        Logger::error("Input::stopRecording - failed to write " + m_recordingPath + "!");
+        return false;
+    }
+
+    Logger::info(
+        "Recorded " + std::to_string(header.eventCount) + " input events over " + std::to_string(header.frameCount) +
+        " frames to " + m_recordingPath + "."
+    );
+
+    return true;
+}
+
+auto Input::startReplay(const std::string& path) -> bool {
+    if (m_isRecording || m_isReplaying) {
+        Logger::error("Input::startReplay - already recording or replaying!");
+        return false;
+    }
+
+    std::ifstream file { path, std::ios::binary };
+
+    if (!file) {
+        Logger::error("Input::startReplay - failed to read " + path + "!");
+        return false;
+    }
+
+    InputRecordingHeader header { };
+
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        Logger::error("Input::startReplay - recording " + path + " is truncated!");
+        return false;
+    }
+
+    if (
+        header.magic != global_inputRecordingMagic ||
+        header.version != global_inputRecordingVersion ||
+        !(header.timestep > 0.0)
+    ) {
+        Logger::error("Input::startReplay - recording " + path + " is invalid or outdated!");
+        return false;
+    }
+
+    std::vector<InputRecordingEvent> events(header.eventCount);
+
+    if (!file.read(
+        reinterpret_cast<char*>(events.data()),
+        static_cast<std::streamsize>(events.size() * sizeof(InputRecordingEvent))
+    )) {
+        Logger::error("Input::startReplay - recording " + path + " is truncated!");
+        return false;
+    }
+
+    const bool isOrdered {
+        std::is_sorted(
+            events.begin(),
+            events.end(),
+            [](const InputRecordingEvent& lhs, const InputRecordingEvent& rhs) -> bool {
+                return lhs.frame < rhs.frame;
+            }
+        )
+    };
+
+    if (!isOrdered || (!events.empty() && events.back().frame >= header.frameCount)) {
+        Logger::error("Input::startReplay - recording " + path + " has events out of its frames!");
+        return false;
+    }
+
+    m_frame = 0u;
+    m_isReplaying = true;
+    m_replayHeader = header;
+    m_replayEvents = std::move(events);
+    m_replayIndex = 0u;
+
+    Logger::info(
+        "Replaying " + std::to_string(header.frameCount) + " frames of input from " + path + " with a timestep of " +
+        std::to_string(header.timestep) + " s."
+    );
+
+    return true;
+}
+
+auto Input::isReplaying() -> bool {
+    return m_isReplaying;
+}
+
+auto Input::isReplayFinished() -> bool {
+    return m_isReplaying && m_frame >= m_replayHeader.frameCount;
+}
+
+auto Input::getReplayTimestep() -> double {
+    return m_replayHeader.timestep;
+}
+
+auto Input::applyEvent(const InputEvent& event) -> void {
+    switch (event.type) {
+    case InputEventType::Key: {
+        m_instance->processKey(static_cast<Key>(event.code), event.isPressed);
+        break;
+    }
+    case InputEventType::Button: {
+        m_instance->processButton(static_cast<Button>(event.code), event.isPressed);
+        break;
+    }
+    case InputEventType::MouseMove: {
+        m_instance->processMouseMove(event.x, event.y);
+        break;
+    }
+    case InputEventType::MouseWheel: {
+        m_instance->processMouseWheel(event.x);
+        break;
+    }
+    }
+}
+
+auto Input::record(const InputEvent& event) -> void {
+    m_recordedEvents.push_back(
+        InputRecordingEvent {
+            m_frame,                                        // frame
+            static_cast<float>(event.time - m_startTime),   // time
+            event.x,                                        // x
+            event.y,                                        // y
+            static_cast<uint16_t>(event.code),              // code
+            static_cast<uint8_t>(event.type),               // type
+            static_cast<uint8_t>(event.isPressed ? 1u : 0u) // isPressed
+        }
+    );
+}
+
+auto Input::replayFrame() -> void {
+    while (m_replayIndex < m_replayEvents.size() && m_replayEvents[m_replayIndex].frame <= m_frame) {
+        const InputRecordingEvent& recordedEvent { m_replayEvents[m_replayIndex] };
+
+        applyEvent(
+            InputEvent {
+                m_startTime + static_cast<double>(recordedEvent.time), // time
+                static_cast<InputEventType>(recordedEvent.type),       // type
+                recordedEvent.code,                                    // code
+                recordedEvent.x,                                       // x
+                recordedEvent.y,                                       // y
+                recordedEvent.isPressed != 0u                          // isPressed
+            }
+        );
+
+        m_replayIndex++;
+    }
 }
 
 auto Input::processKey(const Key key, const bool isPressed) -> void {
-    if (m_currentKeyboardState.at(static_cast<uint64_t>(key)) != isPressed) {
-        m_currentKeyboardState.at(static_cast<uint64_t>(key)) = isPressed;
+    const std::size_t index { static_cast<std::size_t>(key) };
+
+    if (index < global_keyCount && m_currentKeyboardState.test(index) != isPressed) {
+        m_currentKeyboardState.set(index, isPressed);
         KeyEvent::notifyListeners(isPressed ? KeyEventCode::Pressed : KeyEventCode::Released, key);
     }
 }
 
 auto Input::processButton(const Button button, const bool isPressed) -> void {
-    if (m_currentMouseState.buttons.at(button) != isPressed) {
-        m_currentMouseState.buttons.at(button) = isPressed;
+    const std::size_t index { static_cast<std::size_t>(button) };
+
+    if (index < global_buttonCount && m_currentMouseState.buttons[index] != isPressed) {
+        m_currentMouseState.buttons[index] = isPressed;
         MouseEvent::notifyListeners(isPressed ? MouseEventCode::Pressed : MouseEventCode::Released, m_currentMouseState);
     }
 }
@@ -3,13 +3,24 @@
 #include "../Defines.hpp"
 #include "InputTypes.hpp"
 #include "Event.hpp"
+#include "EventRing.hpp"
+#include "InputRecording.hpp"
 
+#include <atomic>
+#include <bitset>
 #include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace beige {
 namespace core {
 
+/**
+ * The platform layer only pushes raw events into a lock-free ring, so it may run on a thread of its own and sample
+ * input faster than the frame rate. The frame applies them in update(), which is the only place state changes and
+ * listeners are notified. What update() applies can be recorded, and a recording replayed in place of the platform.
+ */
 class BEIGE_API Input final :
 public Event<KeyEventCode, Key>,
 public Event<MouseEventCode, MouseState> {
@@ -21,27 +32,109 @@ public:
 
     static auto getInstance() -> std::shared_ptr<Input>;
 
-    static auto update(const double deltaTime) -> void;
+    /**
+     * Keeps the state of the last frame and applies the events queued since, in the order they happened. While
+     * replaying, the events of the recording are applied instead and only Escape still comes from the platform.
+     * @param time The absolute platform time of the frame.
+     */
+    static auto update(const double time) -> void;
 
     auto isKeyDown(const Key key) -> bool;
     auto isKeyUp(const Key key) -> bool;
     auto wasKeyDown(const Key key) -> bool;
     auto wasKeyUp(const Key key) -> bool;
 
+    /**
+     * @returns True if the key went down since the last frame.
+     */
+    auto wasKeyPressed(const Key key) -> bool;
+
+    /**
+     * @returns True if the key went up since the last frame.
+     */
+    auto wasKeyReleased(const Key key) -> bool;
+
+    auto isButtonDown(const Button button) -> bool;
+    auto wasButtonDown(const Button button) -> bool;
+
+    /**
+     * Queues a raw event, only called from the one thread which samples the platform.
+     * @returns False if the ring is full and the event was dropped.
+     */
+    auto pushEvent(const InputEvent& event) -> bool;
+
+    /**
+     * Records every event applied from the next update() on, until stopRecording().
+     * @returns False if already recording or replaying.
+     */
+    auto startRecording(const std::string& path) -> bool;
+
+    /**
+     * Writes the recording to the path it was started with.
+     * @returns False if the file could not be written, true if written or nothing was recorded.
+     */
+    auto stopRecording() -> bool;
+
+    /**
+     * Replays a recording from the next update() on, starting from the current state.
+     * @returns False if the file is missing or not a valid recording.
+     */
+    auto startReplay(const std::string& path) -> bool;
+
+    auto isReplaying() -> bool;
+
+    /**
+     * @returns True once every frame of the recording has been replayed.
+     */
+    auto isReplayFinished() -> bool;
+
+    /**
+     * @returns The fixed timestep replayed frames advance by, in place of the measured frame time.
+     */
+    auto getReplayTimestep() -> double;
+
+private:
+    Input() = default;
+
     auto processKey(const Key key, const bool isPressed) -> void;
     auto processButton(const Button button, const bool isPressed) -> void;
     auto processMouseMove(const int32_t xPos, const int32_t yPos) -> void;
     auto processMouseWheel(const int32_t deltaZ) -> void;
 
-private:
-    Input() = default;
+    static auto applyEvent(const InputEvent& event) -> void;
+    static auto record(const InputEvent& event) -> void;
+    static auto replayFrame() -> void;
+
+    // Enough for a few frames of a high rate mouse.
+    static constexpr uint32_t m_eventCapacity { 1024u };
+
+    // For recordings too short to measure a frame time.
+    static constexpr double m_defaultReplayTimestep { 1.0 / 60.0 };
 
     static std::shared_ptr<Input> m_instance;
 
-    static std::vector<bool> m_currentKeyboardState;
-    static std::vector<bool> m_previousKeyboardState;
+    static std::bitset<global_keyCount> m_currentKeyboardState;
+    static std::bitset<global_keyCount> m_previousKeyboardState;
+    static std::bitset<global_keyCount> m_changedKeyboardState;
     static MouseState m_currentMouseState;
     static MouseState m_previousMouseState;
+
+    static EventRing<InputEvent, m_eventCapacity> m_events;
+    static std::atomic<uint32_t> m_droppedEventCount;
+
+    // Counts updates since recording or replaying started, the events are keyed by it.
+    static uint32_t m_frame;
+    static double m_startTime;
+    static double m_lastTime;
+
+    static bool m_isRecording;
+    static std::string m_recordingPath;
+    static std::vector<InputRecordingEvent> m_recordedEvents;
+
+    static bool m_isReplaying;
+    static InputRecordingHeader m_replayHeader;
+    static std::vector<InputRecordingEvent> m_replayEvents;
+    static std::size_t m_replayIndex;
 };
 
 } // namespace core
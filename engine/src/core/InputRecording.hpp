@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+namespace beige {
+namespace core {
+
+// Layout of an input recording (.binp) file:
+// InputRecordingHeader | InputRecordingEvent[eventCount].
+// Events are stored with the frame they were applied in, ordered by it, rather than by when they happened. A replay
+// applies them in the same frames with a fixed timestep, so every run reaches the same state whatever the frame rate.
+
+inline constexpr uint32_t global_inputRecordingMagic { 0x504E4942u }; // "BINP"
+inline constexpr uint32_t global_inputRecordingVersion { 1u };
+
+struct InputRecordingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t frameCount; // Frames recorded, the replay ends after as many.
+    uint32_t eventCount;
+    double timestep;     // Mean frame time of the recording in seconds, every replayed frame advances by it.
+};
+
+struct InputRecordingEvent {
+    uint32_t frame;
+    float time;        // Seconds since the recording started, for inspecting a recording only.
+    int32_t x;
+    int32_t y;
+    uint16_t code;
+    uint8_t type;      // An InputEventType.
+    uint8_t isPressed;
+};
+
+static_assert(sizeof(InputRecordingHeader) == 24u, "Input recording header layout changed, bump the version!");
+static_assert(sizeof(InputRecordingEvent) == 20u, "Input recording event layout changed, bump the version!");
+
+} // namespace core
+} // namespace beige
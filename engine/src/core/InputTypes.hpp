@@ -2,7 +2,8 @@
 
 #include "../Defines.hpp"
 
-#include <map>
+#include <array>
+#include <cstdint>
 
 namespace beige {
 namespace core {
@@ -144,10 +145,36 @@ enum class Button : uint32_t {
     Right
 };
 
+// Virtual key codes fit in a byte, so every Key is a bit of a 256 bit set.
+inline constexpr uint32_t global_keyCount { 256u };
+
+// Including Button::Invalid, so the buttons index their array directly.
+inline constexpr uint32_t global_buttonCount { 4u };
+
 struct MouseState {
     int32_t xPos;
     int32_t yPos;
-    std::map<Button, bool> buttons;
+    std::array<bool, global_buttonCount> buttons; // Indexed by Button.
+};
+
+enum class InputEventType : uint32_t {
+    Key,
+    Button,
+    MouseMove,
+    MouseWheel
+};
+
+/**
+ * A raw event as the platform layer received it, queued until the next Input::update() applies it. The timestamps
+ * let consumers order and replay events independent of the frame they were applied in.
+ */
+struct InputEvent {
+    double time;         // Absolute platform time in seconds.
+    InputEventType type;
+    uint32_t code;       // The Key or Button, unused for mouse moves and the wheel.
+    int32_t x;           // The position for moves, the delta for the wheel.
+    int32_t y;
+    bool isPressed;      // For keys and buttons.
 };
 
 enum class KeyEventCode : uint32_t {
@@ -0,0 +1,174 @@
+#include "JobSystem.hpp"
+
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace beige {
+namespace core {
+
+namespace {
+
+// Shared with the helper jobs, which may only start once the loop is done and then find no chunk left.
+struct ParallelLoop {
+    std::function<void(const uint32_t, const uint32_t)> function;
+    uint32_t count;
+    uint32_t chunkSize;
+    uint32_t chunkCount;
+    std::atomic<uint32_t> nextChunk { 0u };
+    std::mutex mutex;
+    std::condition_variable finished;
+    uint32_t finishedChunkCount { 0u }; // Guarded by the mutex.
+};
+
+auto runChunks(ParallelLoop& loop) -> void {
+    uint32_t finishedChunkCount { 0u };
+
+    while (true) {
+        const uint32_t chunk { loop.nextChunk.fetch_add(1u) };
+
+        if (chunk >= loop.chunkCount) {
+            break;
+        }
+
+        const uint32_t begin { chunk * loop.chunkSize };
+        const uint32_t end { loop.count - begin > loop.chunkSize ? begin + loop.chunkSize : loop.count };
+        loop.function(begin, end);
+        finishedChunkCount++;
+    }
+
+    if (finishedChunkCount > 0u) {
+        std::lock_guard<std::mutex> lock { loop.mutex };
+        loop.finishedChunkCount += finishedChunkCount;
+
+        if (loop.finishedChunkCount == loop.chunkCount) {
+            loop.finished.notify_all();
+        }
+    }
+}
+
+} // namespace
+
+JobSystem::JobSystem(const uint32_t workerCount) :
+m_workers { },
+m_jobs { },
+m_mutex { },
+m_jobAvailable { },
+m_idle { },
+m_activeJobCount { 0u },
+m_isRunning { true } {
+    const uint32_t hardwareThreadCount { std::max(std::thread::hardware_concurrency(), 2u) };
+    const uint32_t count { workerCount != 0u ? workerCount : hardwareThreadCount - 1u };
+
+    for (uint32_t i { 0u }; i < count; i++) {
+        m_workers.emplace_back(&JobSystem::work, this);
+    }
+
+    Logger::info("Job system started with " + std::to_string(count) + " workers.");
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        m_isRunning = false;
+    }
+
+    m_jobAvailable.notify_all();
+
+    // Workers drain the queue before they exit.
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+auto JobSystem::submit(Job job) -> void {
+    {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        m_jobs.push_back(std::move(job));
+    }
+
+    m_jobAvailable.notify_one();
+}
+
+auto JobSystem::waitIdle() -> void {
+    std::unique_lock<std::mutex> lock { m_mutex };
+    m_idle.wait(lock, [&]() -> bool { return m_jobs.empty() && m_activeJobCount == 0u; });
+}
+
+auto JobSystem::parallelFor(
+    const uint32_t count,
+    const uint32_t chunkSize,
+    const std::function<void(const uint32_t, const uint32_t)>& function
+) -> void {
+    if (count == 0u || chunkSize == 0u) {
+        return;
+    }
+
+    const uint32_t chunkCount { (count - 1u) / chunkSize + 1u };
+
+    if (chunkCount == 1u || m_workers.empty()) {
+        function(0u, count);
+        return;
+    }
+
+    std::shared_ptr<ParallelLoop> loop { std::make_shared<ParallelLoop>() };
+    loop->function = function;
+    loop->count = count;
+    loop->chunkSize = chunkSize;
+    loop->chunkCount = chunkCount;
+
+    // The calling thread takes chunks as well, so one helper fewer than chunks keeps every thread busy.
+    const uint32_t workerCount { static_cast<uint32_t>(m_workers.size()) };
+    const uint32_t helperCount { chunkCount - 1u < workerCount ? chunkCount - 1u : workerCount };
+
+    for (uint32_t i { 0u }; i < helperCount; i++) {
+        submit(
+            [loop]() -> void {
+                runChunks(*loop);
+            }
+        );
+    }
+
+    runChunks(*loop);
+
+    std::unique_lock<std::mutex> lock { loop->mutex };
+    loop->finished.wait(lock, [&]() -> bool { return loop->finishedChunkCount == loop->chunkCount; });
+}
+
+auto JobSystem::getWorkerCount() const -> uint32_t {
+    return static_cast<uint32_t>(m_workers.size());
+}
+
+auto JobSystem::work() -> void {
+    while (true) {
+        Job job;
+
+        {
+            std::unique_lock<std::mutex> lock { m_mutex };
+            m_jobAvailable.wait(lock, [&]() -> bool { return !m_jobs.empty() || !m_isRunning; });
+
+            if (m_jobs.empty()) {
+                return;
+            }
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+            m_activeJobCount++;
+        }
+
+        job();
+
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            m_activeJobCount--;
+
+            if (m_jobs.empty() && m_activeJobCount == 0u) {
+                m_idle.notify_all();
+            }
+        }
+    }
+}
+
+} // namespace core
+} // namespace beige
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../Defines.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace beige {
+namespace core {
+
+class BEIGE_API JobSystem final {
+public:
+    using Job = std::function<void()>;
+
+    // A worker count of 0 uses one worker per hardware thread, minus the main thread.
+    JobSystem(const uint32_t workerCount = 0u);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    auto operator=(const JobSystem&) -> JobSystem& = delete;
+
+    auto submit(Job job) -> void;
+
+    // Blocks until every submitted job has finished.
+    auto waitIdle() -> void;
+
+    /**
+     * Splits [0, count) into chunks and runs them on the workers and the calling thread. Returns once every chunk
+     * is done, without waiting for unrelated jobs like waitIdle() does.
+     * @param count The number of items.
+     * @param chunkSize The number of items per call.
+     * @param function Called with the first and one past the last item of a chunk, from several threads at once.
+     */
+    auto parallelFor(
+        const uint32_t count,
+        const uint32_t chunkSize,
+        const std::function<void(const uint32_t, const uint32_t)>& function
+    ) -> void;
+
+    auto getWorkerCount() const -> uint32_t;
+
+private:
+    std::vector<std::thread> m_workers;
+    std::deque<Job> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;
+    std::condition_variable m_idle;
+    uint32_t m_activeJobCount;
+    bool m_isRunning;
+
+    auto work() -> void;
+};
+
+} // namespace core
+} // namespace beige
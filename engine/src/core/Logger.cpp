@@ -1,5 +1,7 @@
 #include "Logger.hpp"
 
+#include "Memory.hpp"
+
 #include <iostream>
 #include <sstream>
 
@@ -12,6 +14,7 @@ namespace core {
 #define LOG_WARN_ENABLED 1
 
 std::fstream Logger::m_logFile { };
+std::mutex Logger::m_mutex { };
 Logger::Initializer Logger::m_initializer { };
 
 const std::map<Logger::Level, platform::ConsoleColor> Logger::m_levelConsoleColorMap {
@@ -88,8 +91,12 @@ auto operator<< (std::ostream& outputStream, const Logger::Level level) -> std::
 }
 
 auto Logger::writeLog(const Level level, const std::string& message) -> void {
+    const MemoryScope memoryScope { MemoryTag::Logger };
+
     std::stringstream consoleMessage;
     consoleMessage << level << " " << message;
+
+    std::lock_guard<std::mutex> lock { m_mutex };
     platform::Platform::consoleWrite(consoleMessage.str(), m_levelConsoleColorMap.at(level));
     appendToLogFile(consoleMessage.str() + "\n");
 }
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <map>
 #include <fstream>
+#include <mutex>
 
 namespace beige {
 namespace core {
@@ -41,6 +42,8 @@ private:
     };
 
     static std::fstream m_logFile;
+    // Logging happens from worker threads as well.
+    static std::mutex m_mutex;
     static class Initializer {
     public:
         Initializer() {
@@ -0,0 +1,394 @@
+#include "Memory.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+
+// _msize and _aligned_malloc, or malloc_usable_size.
+#include <malloc.h>
+
+namespace {
+
+using beige::core::MemoryTag;
+
+struct Counters {
+    std::atomic<uint64_t> allocationCount;
+    std::atomic<uint64_t> allocatedBytes;
+    std::atomic<int64_t> liveBytes;
+    std::atomic<int64_t> peakBytes;
+};
+
+// Precedes every block of Memory::allocate(), the tag is needed again to free it.
+struct AllocationHeader {
+    uint64_t size;
+    uint32_t tag;
+    uint32_t offset; // From the start of the block to the memory handed out.
+};
+
+static_assert(sizeof(AllocationHeader) == 16u, "The header has to keep the alignment of malloc");
+
+// Constant initialized, so they are usable by allocations during the dynamic initialization of other statics.
+std::array<Counters, static_cast<std::size_t>(MemoryTag::Count)> global_tagCounters { };
+Counters global_heapCounters { };
+thread_local MemoryTag global_currentTag { MemoryTag::General };
+
+auto getCounters(const MemoryTag tag) -> Counters& {
+    return global_tagCounters[static_cast<std::size_t>(tag)];
+}
+
+auto addLiveBytes(Counters& counters, const int64_t size) -> void {
+    const int64_t liveBytes { counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size };
+    int64_t peakBytes { counters.peakBytes.load(std::memory_order_relaxed) };
+
+    // Retries until the peak is at least as high, whichever thread raised it.
+    while (
+        liveBytes > peakBytes &&
+        !counters.peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed)
+    ) { }
+}
+
+auto addAllocation(Counters& counters, const std::size_t size) -> void {
+    counters.allocationCount.fetch_add(1u, std::memory_order_relaxed);
+    counters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    addLiveBytes(counters, static_cast<int64_t>(size));
+}
+
+auto load(const Counters& counters) -> beige::core::MemoryStats {
+    return beige::core::MemoryStats {
+        counters.allocationCount.load(std::memory_order_relaxed), // allocationCount
+        counters.allocatedBytes.load(std::memory_order_relaxed),  // allocatedBytes
+        counters.liveBytes.load(std::memory_order_relaxed),       // liveBytes
+        counters.peakBytes.load(std::memory_order_relaxed)        // peakBytes
+    };
+}
+
+// The usable size of a block, which works for blocks of other modules sharing the C runtime as well.
+auto getBlockSize(void* pointer) -> std::size_t {
+#ifdef _MSC_VER
+    return _msize(pointer);
+#else
+    return malloc_usable_size(pointer);
+#endif // _MSC_VER
+}
+
+auto getAlignedBlockSize(void* pointer, const std::size_t alignment) -> std::size_t {
+#ifdef _MSC_VER
+    return _aligned_msize(pointer, alignment, 0u);
+#else
+    static_cast<void>(alignment);
+    return malloc_usable_size(pointer);
+#endif // _MSC_VER
+}
+
+// Heap blocks are counted for the tag of the thread, and as live for the heap only.
+auto countHeapAllocation(const std::size_t size) -> void {
+    Counters& tagCounters { getCounters(global_currentTag) };
+    tagCounters.allocationCount.fetch_add(1u, std::memory_order_relaxed);
+    tagCounters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+    addAllocation(global_heapCounters, size);
+}
+
+auto countHeapFree(const std::size_t size) -> void {
+    global_heapCounters.liveBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+}
+
+auto allocate(const std::size_t size) -> void* {
+    void* pointer { std::malloc(size == 0u ? 1u : size) };
+
+    if (pointer != nullptr) {
+        countHeapAllocation(getBlockSize(pointer));
+    }
+
+    return pointer;
+}
+
+auto allocateAligned(const std::size_t size, const std::align_val_t alignment) -> void* {
+    const std::size_t alignmentValue { static_cast<std::size_t>(alignment) };
+
+#ifdef _MSC_VER
+    void* pointer { _aligned_malloc(size == 0u ? 1u : size, alignmentValue) };
+#else
+    // The size has to be a multiple of the alignment.
+    const std::size_t alignedSize { ((size == 0u ? 1u : size) + alignmentValue - 1u) / alignmentValue * alignmentValue };
+    void* pointer { std::aligned_alloc(alignmentValue, alignedSize) };
+#endif // _MSC_VER
+
+    if (pointer != nullptr) {
+        countHeapAllocation(getAlignedBlockSize(pointer, alignmentValue));
+    }
+
+    return pointer;
+}
+
+auto deallocate(void* pointer) -> void {
+    if (pointer == nullptr) {
+        return;
+    }
+
+    countHeapFree(getBlockSize(pointer));
+    std::free(pointer);
+}
+
+auto deallocateAligned(void* pointer, const std::align_val_t alignment) -> void {
+    if (pointer == nullptr) {
+        return;
+    }
+
+    countHeapFree(getAlignedBlockSize(pointer, static_cast<std::size_t>(alignment)));
+
+#ifdef _MSC_VER
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif // _MSC_VER
+}
+
+// Retries through the new handler like the default operator new does, throws once there is none.
+auto allocateOrThrow(const std::size_t size) -> void* {
+    for (;;) {
+        void* pointer { allocate(size) };
+
+        if (pointer != nullptr) {
+            return pointer;
+        }
+
+        const std::new_handler handler { std::get_new_handler() };
+
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        handler();
+    }
+}
+
+auto allocateAlignedOrThrow(const std::size_t size, const std::align_val_t alignment) -> void* {
+    for (;;) {
+        void* pointer { allocateAligned(size, alignment) };
+
+        if (pointer != nullptr) {
+            return pointer;
+        }
+
+        const std::new_handler handler { std::get_new_handler() };
+
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        handler();
+    }
+}
+
+} // namespace
+
+auto operator new(std::size_t size) -> void* {
+    return allocateOrThrow(size);
+}
+
+auto operator new[](std::size_t size) -> void* {
+    return allocateOrThrow(size);
+}
+
+auto operator new(std::size_t size, const std::nothrow_t&) noexcept -> void* {
+    return allocate(size);
+}
+
+auto operator new[](std::size_t size, const std::nothrow_t&) noexcept -> void* {
+    return allocate(size);
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void* {
+    return allocateAlignedOrThrow(size, alignment);
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment) -> void* {
+    return allocateAlignedOrThrow(size, alignment);
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept -> void* {
+    return allocateAligned(size, alignment);
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept -> void* {
+    return allocateAligned(size, alignment);
+}
+
+auto operator delete(void* pointer) noexcept -> void {
+    deallocate(pointer);
+}
+
+auto operator delete[](void* pointer) noexcept -> void {
+    deallocate(pointer);
+}
+
+auto operator delete(void* pointer, std::size_t) noexcept -> void {
+    deallocate(pointer);
+}
+
+auto operator delete[](void* pointer, std::size_t) noexcept -> void {
+    deallocate(pointer);
+}
+
+auto operator delete(void* pointer, const std::nothrow_t&) noexcept -> void {
+    deallocate(pointer);
+}
+
+auto operator delete[](void* pointer, const std::nothrow_t&) noexcept -> void {
+    deallocate(pointer);
+}
+
+auto operator delete(void* pointer, std::align_val_t alignment) noexcept -> void {
+    deallocateAligned(pointer, alignment);
+}
+
+auto operator delete[](void* pointer, std::align_val_t alignment) noexcept -> void {
+    deallocateAligned(pointer, alignment);
+}
+
+auto operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept -> void {
+    deallocateAligned(pointer, alignment);
+}
+
+auto operator delete[](void* pointer, std::size_t, std::align_val_t alignment) noexcept -> void {
+    deallocateAligned(pointer, alignment);
+}
+
+auto operator delete(void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept -> void {
+    deallocateAligned(pointer, alignment);
+}
+
+auto operator delete[](void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept -> void {
+    deallocateAligned(pointer, alignment);
+}
+
+namespace beige {
+namespace core {
+
+MemoryScope::MemoryScope(const MemoryTag tag) :
+m_previousTag { global_currentTag } {
+    global_currentTag = tag;
+}
+
+MemoryScope::~MemoryScope() {
+    global_currentTag = m_previousTag;
+}
+
+auto Memory::getAllocationCount() -> uint64_t {
+    return global_heapCounters.allocationCount.load(std::memory_order_relaxed);
+}
+
+auto Memory::getStats(const MemoryTag tag) -> MemoryStats {
+    return load(getCounters(tag));
+}
+
+auto Memory::getHeapStats() -> MemoryStats {
+    return load(global_heapCounters);
+}
+
+auto Memory::getTagName(const MemoryTag tag) -> const char* {
+    switch (tag) {
+    case MemoryTag::General: return "General";
+    case MemoryTag::Renderer: return "Renderer";
+    case MemoryTag::Texture: return "Texture";
+    case MemoryTag::Logger: return "Logger";
+    case MemoryTag::Game: return "Game";
+    case MemoryTag::VulkanDriver: return "VulkanDriver";
+    case MemoryTag::DeviceBuffer: return "DeviceBuffer";
+    case MemoryTag::DeviceImage: return "DeviceImage";
+    default: return "Unknown";
+    }
+}
+
+auto Memory::allocate(const std::size_t size, const std::size_t alignment, const MemoryTag tag) -> void* {
+    const std::size_t headerSize { sizeof(AllocationHeader) };
+    const std::size_t blockAlignment { std::max(alignment, headerSize) };
+
+    if (size > std::numeric_limits<std::size_t>::max() - headerSize - blockAlignment) {
+        return nullptr;
+    }
+
+    // Room for the header in front and for moving the memory up to the alignment.
+    std::byte* block { static_cast<std::byte*>(std::malloc(size + headerSize + blockAlignment)) };
+
+    if (block == nullptr) {
+        return nullptr;
+    }
+
+    const std::uintptr_t address { reinterpret_cast<std::uintptr_t>(block) + headerSize };
+    std::byte* pointer { reinterpret_cast<std::byte*>((address + blockAlignment - 1u) & ~(blockAlignment - 1u)) };
+
+    const AllocationHeader header {
+        size,                                  // size
+        static_cast<uint32_t>(tag),            // tag
+        static_cast<uint32_t>(pointer - block) // offset
+    };
+
+    std::memcpy(pointer - headerSize, &header, headerSize);
+    addAllocation(getCounters(tag), size);
+
+    return pointer;
+}
+
+auto Memory::reallocate(
+    void* pointer,
+    const std::size_t size,
+    const std::size_t alignment,
+    const MemoryTag tag
+) -> void* {
+    if (pointer == nullptr) {
+        return allocate(size, alignment, tag);
+    }
+
+    if (size == 0u) {
+        free(pointer);
+        return nullptr;
+    }
+
+    void* newPointer { allocate(size, alignment, tag) };
+
+    if (newPointer == nullptr) {
+        return nullptr;
+    }
+
+    AllocationHeader header { };
+    std::memcpy(&header, static_cast<std::byte*>(pointer) - sizeof(AllocationHeader), sizeof(AllocationHeader));
+    std::memcpy(newPointer, pointer, std::min(static_cast<std::size_t>(header.size), size));
+
+    free(pointer);
+
+    return newPointer;
+}
+
+auto Memory::free(void* pointer) -> void {
+    if (pointer == nullptr) {
+        return;
+    }
+
+    std::byte* bytes { static_cast<std::byte*>(pointer) };
+    AllocationHeader header { };
+    std::memcpy(&header, bytes - sizeof(AllocationHeader), sizeof(AllocationHeader));
+
+    getCounters(static_cast<MemoryTag>(header.tag)).liveBytes.fetch_sub(
+        static_cast<int64_t>(header.size),
+        std::memory_order_relaxed
+    );
+
+    std::free(bytes - header.offset);
+}
+
+auto Memory::addExternal(const std::size_t size, const MemoryTag tag) -> void {
+    addAllocation(getCounters(tag), size);
+}
+
+auto Memory::removeExternal(const std::size_t size, const MemoryTag tag) -> void {
+    getCounters(tag).liveBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+}
+
+} // namespace core
+} // namespace beige
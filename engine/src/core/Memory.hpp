@@ -0,0 +1,107 @@
+#pragma once
+
+#include "../Defines.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace beige {
+namespace core {
+
+// What the engine allocates for. Heap allocations take the tag of the innermost MemoryScope of their thread.
+enum class MemoryTag : uint32_t {
+    General,
+    Renderer,
+    Texture,
+    Logger,
+    Game,         // The engine on behalf of the game, the game module allocates through its own heap.
+    VulkanDriver, // Host memory of the driver, through the allocation callbacks of the Vulkan backend.
+    DeviceBuffer, // Device memory of the buffers: geometry, uniforms, instances and staging.
+    DeviceImage,  // Device memory of the images: textures and attachments.
+    Count
+};
+
+struct MemoryStats {
+    uint64_t allocationCount; // Since the start, which only ever grows. Differences give per frame counts.
+    uint64_t allocatedBytes;  // Since the start, which only ever grows.
+    int64_t liveBytes;        // Allocated and not freed yet.
+    int64_t peakBytes;        // The most live bytes at any time.
+};
+
+/**
+ * Tags the heap allocations of the current thread until it is destroyed, then restores the previous tag.
+ */
+class BEIGE_API MemoryScope final {
+public:
+    MemoryScope(const MemoryTag tag);
+    ~MemoryScope();
+
+    MemoryScope(const MemoryScope&) = delete;
+    auto operator=(const MemoryScope&) -> MemoryScope& = delete;
+
+private:
+    MemoryTag m_previousTag;
+};
+
+/**
+ * Counts the heap allocations of the engine. The global operator new is replaced for it, which only covers the code
+ * of the engine module, the game allocates through its own.
+ *
+ * A heap block does not know the scope it was allocated in, so the heap is freed as a whole: the stats of a tag count
+ * its heap allocations, but only its explicit allocations are live, while getHeapStats() has the live bytes of all
+ * of them.
+ */
+class BEIGE_API Memory final {
+public:
+    Memory() = delete;
+    ~Memory() = delete;
+
+    /**
+     * @returns The number of heap allocations since the start, which only ever grows. Differences give per frame
+     * counts.
+     */
+    static auto getAllocationCount() -> uint64_t;
+
+    static auto getStats(const MemoryTag tag) -> MemoryStats;
+
+    /**
+     * @returns The stats of every heap allocation of the engine, whatever the tag.
+     */
+    static auto getHeapStats() -> MemoryStats;
+
+    static auto getTagName(const MemoryTag tag) -> const char*;
+
+    /**
+     * Allocates memory which is counted as live for the tag until it is freed, bypassing the heap stats.
+     * @param alignment A power of two.
+     * @returns The memory or nullptr if there is none, or if the size with the header and alignment overflows.
+     */
+    static auto allocate(const std::size_t size, const std::size_t alignment, const MemoryTag tag) -> void*;
+
+    /**
+     * Moves an allocation of allocate() to one of the new size, keeping its contents up to the smaller size. A size
+     * of 0 frees the allocation.
+     * @returns The new memory, or nullptr if the size is 0 or there is no memory. Without memory the old allocation
+     * stays valid.
+     */
+    static auto reallocate(
+        void* pointer,
+        const std::size_t size,
+        const std::size_t alignment,
+        const MemoryTag tag
+    ) -> void*;
+
+    /**
+     * Frees an allocation of allocate(), nullptr is ignored.
+     */
+    static auto free(void* pointer) -> void;
+
+    /**
+     * Counts memory allocated elsewhere, like the internal allocations the driver reports or device memory.
+     */
+    static auto addExternal(const std::size_t size, const MemoryTag tag) -> void;
+    static auto removeExternal(const std::size_t size, const MemoryTag tag) -> void;
+};
+
+} // namespace core
+} // namespace beige
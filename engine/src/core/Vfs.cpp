@@ -0,0 +1,248 @@
+#include "Vfs.hpp"
+
+#include "Logger.hpp"
+#include "../resources/Lz4.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+
+namespace beige {
+namespace core {
+
+namespace {
+
+// An LZ4 block expands at most 255 to 1, larger sizes are corrupt and must not be allocated.
+constexpr uint64_t global_maximumLz4Ratio { 255u };
+
+auto isEntrySizeValid(const resources::PackedArchiveEntry& entry) -> bool {
+    switch (entry.compression) {
+    case resources::PackedCompression::None:
+        return entry.uncompressedSize == entry.size;
+    case resources::PackedCompression::Lz4:
+        return entry.uncompressedSize / global_maximumLz4Ratio <= entry.size;
+    }
+
+    return false;
+}
+
+} // namespace
+
+Vfs::Vfs() :
+m_mounts { } {
+
+}
+
+Vfs::~Vfs() {
+
+}
+
+auto Vfs::mountDirectory(const std::string& path) -> void {
+    m_mounts.push_back({ path, nullptr });
+
+    Logger::info("Mounted directory " + path + ".");
+}
+
+auto Vfs::mountArchive(const std::string& path) -> bool {
+    std::shared_ptr<platform::MappedFile> file { std::make_shared<platform::MappedFile>(path) };
+
+    if (!file->isOpen()) {
+        Logger::debug("No archive at " + path + ".");
+        return false;
+    }
+
+    const std::byte* data { file->getData() };
+    const uint64_t size { file->getSize() };
+
+    resources::PackedArchiveHeader header;
+    if (size < sizeof(header)) {
+        Logger::error("Archive " + path + " is truncated!");
+        return false;
+    }
+
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.magic != resources::global_packedArchiveMagic || header.version != resources::global_packedArchiveVersion) {
+        Logger::error("Archive " + path + " has an unknown format or version, repack it!");
+        return false;
+    }
+
+    const uint64_t entriesSize { static_cast<uint64_t>(header.entryCount) * sizeof(resources::PackedArchiveEntry) };
+
+    if (
+        entriesSize > size - sizeof(header) ||
+        header.pathsOffset > size ||
+        header.pathsSize > size - header.pathsOffset
+    ) {
+        Logger::error("Archive " + path + " is truncated!");
+        return false;
+    }
+
+    std::unique_ptr<Archive> archive { std::make_unique<Archive>() };
+    archive->path = path;
+    archive->file = file;
+    archive->entries.reserve(header.entryCount);
+
+    const char* paths { reinterpret_cast<const char*>(data + header.pathsOffset) };
+
+    for (uint32_t i { 0u }; i < header.entryCount; i++) {
+        resources::PackedArchiveEntry entry;
+        std::memcpy(&entry, data + sizeof(header) + i * sizeof(entry), sizeof(entry));
+
+        if (
+            entry.pathOffset > header.pathsSize ||
+            entry.pathLength > header.pathsSize - entry.pathOffset ||
+            entry.offset > size ||
+            entry.size > size - entry.offset ||
+            !isEntrySizeValid(entry)
+        ) {
+            Logger::error("Archive " + path + " has a malformed entry!");
+            return false;
+        }
+
+        archive->entries.emplace(std::string(paths + entry.pathOffset, entry.pathLength), entry);
+    }
+
+    m_mounts.push_back({ std::string(), std::move(archive) });
+
+    Logger::info("Mounted archive " + path + " with " + std::to_string(header.entryCount) + " files.");
+
+    return true;
+}
+
+auto Vfs::read(const std::string& path) const -> std::optional<File> {
+    for (auto mount { m_mounts.rbegin() }; mount != m_mounts.rend(); mount++) {
+        if (mount->archive) {
+            const auto entry { mount->archive->entries.find(path) };
+
+            if (entry != mount->archive->entries.end()) {
+                return readEntry(*mount->archive, entry->second);
+            }
+
+            continue;
+        }
+
+        std::shared_ptr<platform::MappedFile> file { std::make_shared<platform::MappedFile>(mount->directory + "/" + path) };
+
+        if (file->isOpen()) {
+            const File result {
+                file->getData(), // data
+                file->getSize(), // size
+                file             // storage
+            };
+
+            return result;
+        }
+    }
+
+    return std::nullopt;
+}
+
+auto Vfs::exists(const std::string& path) const -> bool {
+    for (const Mount& mount : m_mounts) {
+        if (mount.archive) {
+            if (mount.archive->entries.count(path) != 0u) {
+                return true;
+            }
+
+            continue;
+        }
+
+        std::error_code errorCode;
+        if (std::filesystem::is_regular_file(mount.directory + "/" + path, errorCode)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+auto Vfs::prefetch(const std::vector<std::string>& paths) const -> void {
+    // Loose files are left to the read ahead of the OS, only archives can merge files into larger reads.
+    for (const Mount& mount : m_mounts) {
+        if (!mount.archive) {
+            continue;
+        }
+
+        std::vector<std::pair<uint64_t, uint64_t>> ranges;
+
+        for (const std::string& path : paths) {
+            const auto entry { mount.archive->entries.find(path) };
+
+            if (entry != mount.archive->entries.end()) {
+                ranges.emplace_back(entry->second.offset, entry->second.offset + entry->second.size);
+            }
+        }
+
+        if (ranges.empty()) {
+            continue;
+        }
+
+        std::sort(ranges.begin(), ranges.end());
+
+        std::pair<uint64_t, uint64_t> merged { ranges.front() };
+        uint32_t requestCount { 0u };
+
+        for (const std::pair<uint64_t, uint64_t>& range : ranges) {
+            if (range.first <= merged.second + m_prefetchMergeDistance) {
+                merged.second = std::max(merged.second, range.second);
+                continue;
+            }
+
+            mount.archive->file->prefetch(merged.first, merged.second - merged.first);
+            requestCount++;
+            merged = range;
+        }
+
+        mount.archive->file->prefetch(merged.first, merged.second - merged.first);
+        requestCount++;
+
+        Logger::debug(
+            "Prefetching " + std::to_string(ranges.size()) + " files of " + mount.archive->path +
+            " in " + std::to_string(requestCount) + " reads."
+        );
+    }
+}
+
+auto Vfs::readEntry(
+    const Archive& archive,
+    const resources::PackedArchiveEntry& entry
+) -> std::optional<File> {
+    const std::byte* blob { archive.file->getData() + entry.offset };
+
+    switch (entry.compression) {
+    case resources::PackedCompression::None: {
+        const File result {
+            blob,        // data
+            entry.size,  // size
+            archive.file // storage
+        };
+
+        return result;
+    }
+    case resources::PackedCompression::Lz4: {
+        std::shared_ptr<std::vector<std::byte>> decompressed {
+            std::make_shared<std::vector<std::byte>>(static_cast<std::size_t>(entry.uncompressedSize))
+        };
+
+        if (!resources::Lz4::decompress(blob, entry.size, decompressed->data(), entry.uncompressedSize)) {
+            Logger::error("Failed to decompress an entry of archive " + archive.path + "!");
+            return std::nullopt;
+        }
+
+        const File result {
+            decompressed->data(),   // data
+            entry.uncompressedSize, // size
+            decompressed            // storage
+        };
+
+        return result;
+    }
+    }
+
+    return std::nullopt;
+}
+
+} // namespace core
+} // namespace beige
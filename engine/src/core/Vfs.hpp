@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../Defines.hpp"
+#include "../platform/MappedFile.hpp"
+#include "../resources/PackedArchive.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace beige {
+namespace core {
+
+/**
+ * Read-only file system over mounted directories and packed archives, addressed by paths relative to the mount
+ * such as "textures/wall.btex". Mounting happens up front on the main thread, reads are safe from any thread after.
+ */
+class BEIGE_API Vfs final {
+public:
+    // View of a file's contents, valid as long as storage is held.
+    struct File {
+        const std::byte* data;
+        uint64_t size;
+        std::shared_ptr<const void> storage; // Either a file mapping or the decompressed data.
+    };
+
+    Vfs();
+    ~Vfs();
+
+    Vfs(const Vfs&) = delete;
+    auto operator=(const Vfs&) -> Vfs& = delete;
+
+    /**
+     * Mounts a directory, later mounts are searched first.
+     * @param path The path of the directory.
+     */
+    auto mountDirectory(const std::string& path) -> void;
+
+    /**
+     * Mounts a packed archive, later mounts are searched first. The archive stays mapped until the VFS is destroyed.
+     * @param path The path of the archive.
+     * @returns True if the archive was mounted, false if it is missing or malformed.
+     */
+    auto mountArchive(const std::string& path) -> bool;
+
+    /**
+     * Reads a file. Loose files and uncompressed archive entries are mapped, not copied, compressed entries are
+     * decompressed into memory owned by the result.
+     * @param path The path of the file relative to the mounts.
+     * @returns The contents of the file, nothing if no mount has it.
+     */
+    auto read(const std::string& path) const -> std::optional<File>;
+    auto exists(const std::string& path) const -> bool;
+
+    /**
+     * Hints that the files are about to be read. Archive entries next to each other are merged into one range,
+     * so a level load turns into a few large sequential reads instead of a page fault per 4 KiB.
+     * @param paths The paths of the files relative to the mounts.
+     */
+    auto prefetch(const std::vector<std::string>& paths) const -> void;
+
+private:
+    // Ranges closer than this are prefetched as one, reading the gap costs less than another request.
+    static constexpr uint64_t m_prefetchMergeDistance { 256u * 1024u };
+
+    struct Archive {
+        std::string path;
+        std::shared_ptr<platform::MappedFile> file;
+        std::unordered_map<std::string, resources::PackedArchiveEntry> entries;
+    };
+
+    // Either a directory or an archive.
+    struct Mount {
+        std::string directory;
+        std::unique_ptr<Archive> archive;
+    };
+
+    std::vector<Mount> m_mounts;
+
+    static auto readEntry(
+        const Archive& archive,
+        const resources::PackedArchiveEntry& entry
+    ) -> std::optional<File>;
+};
+
+} // namespace core
+} // namespace beige
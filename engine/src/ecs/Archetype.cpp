@@ -0,0 +1,206 @@
+#include "Archetype.hpp"
+
+#include <cstring>
+#include <exception>
+#include <string>
+
+namespace beige {
+namespace ecs {
+
+namespace {
+
+auto alignUp(const uint32_t value, const uint32_t alignment) -> uint32_t {
+    return (value + alignment - 1u) / alignment * alignment;
+}
+
+} // namespace
+
+Archetype::Archetype(const ComponentMask mask, const std::vector<ComponentInfo>& componentInfos) :
+m_mask { mask },
+m_componentIds { },
+m_chunkCapacity { 0u },
+m_entityCount { 0u },
+m_componentSizes { },
+m_columnOffsets { },
+m_addEdges { },
+m_removeEdges { },
+m_chunks { } {
+    m_columnOffsets.fill(m_invalidOffset);
+    m_addEdges.fill(nullptr);
+    m_removeEdges.fill(nullptr);
+
+    uint32_t rowSize { static_cast<uint32_t>(sizeof(Entity)) };
+
+    for (ComponentId componentId { 0u }; componentId < static_cast<ComponentId>(componentInfos.size()); componentId++) {
+        if ((m_mask & getComponentBit(componentId)) != 0u) {
+            m_componentIds.push_back(componentId);
+            m_componentSizes.at(componentId) = componentInfos.at(componentId).size;
+            rowSize += componentInfos.at(componentId).size;
+        }
+    }
+
+    // Start from the capacity without padding and give up entities until the padded arrays fit.
+    m_chunkCapacity = m_chunkSize / rowSize;
+
+    while (m_chunkCapacity > 0u && layOut(m_chunkCapacity) > m_chunkSize) {
+        m_chunkCapacity--;
+    }
+
+    if (m_chunkCapacity == 0u) {
+        const std::string message { "The components of an entity take up " + std::to_string(rowSize) + " bytes, more than a chunk!" };
+        throw std::exception(message.c_str());
+    }
+}
+
+Archetype::~Archetype() {
+
+}
+
+auto Archetype::getMask() const -> ComponentMask {
+    return m_mask;
+}
+
+auto Archetype::getComponentIds() const -> const std::vector<ComponentId>& {
+    return m_componentIds;
+}
+
+auto Archetype::hasComponent(const ComponentId componentId) const -> bool {
+    return componentId < global_maxComponentCount && (m_mask & getComponentBit(componentId)) != 0u;
+}
+
+auto Archetype::getComponentSize(const ComponentId componentId) const -> uint32_t {
+    return m_componentSizes.at(componentId);
+}
+
+auto Archetype::getChunkCapacity() const -> uint32_t {
+    return m_chunkCapacity;
+}
+
+auto Archetype::getChunkCount() const -> uint32_t {
+    return static_cast<uint32_t>(m_chunks.size());
+}
+
+auto Archetype::getEntityCount() const -> uint32_t {
+    return m_entityCount;
+}
+
+auto Archetype::getCount(const uint32_t chunk) const -> uint32_t {
+    return m_chunks.at(chunk).count;
+}
+
+auto Archetype::getEntities(const uint32_t chunk) const -> const Entity* {
+    // The entities come first, at offset 0.
+    return reinterpret_cast<const Entity*>(m_chunks.at(chunk).data->bytes.data());
+}
+
+auto Archetype::getColumn(const uint32_t chunk, const ComponentId componentId) const -> std::byte* {
+    if (!hasComponent(componentId)) {
+        return nullptr;
+    }
+
+    return m_chunks.at(chunk).data->bytes.data() + m_columnOffsets.at(componentId);
+}
+
+auto Archetype::getComponent(const Location location, const ComponentId componentId) const -> std::byte* {
+    std::byte* column { getColumn(location.chunk, componentId) };
+
+    if (column == nullptr) {
+        return nullptr;
+    }
+
+    return column + static_cast<std::size_t>(m_componentSizes.at(componentId)) * location.row;
+}
+
+auto Archetype::allocate(const Entity entity) -> Location {
+    if (m_chunks.empty() || m_chunks.back().count == m_chunkCapacity) {
+        Chunk chunk {
+            std::make_unique<ChunkData>(), // data
+            0u                             // count
+        };
+
+        m_chunks.push_back(std::move(chunk));
+    }
+
+    Chunk& chunk { m_chunks.back() };
+
+    const Location location {
+        static_cast<uint32_t>(m_chunks.size()) - 1u, // chunk
+        chunk.count                                  // row
+    };
+
+    reinterpret_cast<Entity*>(chunk.data->bytes.data())[location.row] = entity;
+    chunk.count++;
+    m_entityCount++;
+
+    return location;
+}
+
+auto Archetype::free(const Location location) -> Entity {
+    const Location lastLocation {
+        static_cast<uint32_t>(m_chunks.size()) - 1u, // chunk
+        m_chunks.back().count - 1u                   // row
+    };
+
+    Entity movedEntity { global_invalidEntity };
+
+    if (location.chunk != lastLocation.chunk || location.row != lastLocation.row) {
+        movedEntity = getEntities(lastLocation.chunk)[lastLocation.row];
+        reinterpret_cast<Entity*>(m_chunks.at(location.chunk).data->bytes.data())[location.row] = movedEntity;
+        copyComponents(*this, lastLocation, *this, location);
+    }
+
+    m_chunks.back().count--;
+    m_entityCount--;
+
+    if (m_chunks.back().count == 0u) {
+        m_chunks.pop_back();
+    }
+
+    return movedEntity;
+}
+
+auto Archetype::copyComponents(
+    const Archetype& source,
+    const Location sourceLocation,
+    Archetype& target,
+    const Location targetLocation
+) -> void {
+    for (const ComponentId componentId : source.m_componentIds) {
+        std::byte* targetComponent { target.getComponent(targetLocation, componentId) };
+
+        if (targetComponent != nullptr) {
+            std::memcpy(targetComponent, source.getComponent(sourceLocation, componentId), source.m_componentSizes.at(componentId));
+        }
+    }
+}
+
+auto Archetype::getAddEdge(const ComponentId componentId) const -> Archetype* {
+    return m_addEdges.at(componentId);
+}
+
+auto Archetype::setAddEdge(const ComponentId componentId, Archetype* archetype) -> void {
+    m_addEdges.at(componentId) = archetype;
+}
+
+auto Archetype::getRemoveEdge(const ComponentId componentId) const -> Archetype* {
+    return m_removeEdges.at(componentId);
+}
+
+auto Archetype::setRemoveEdge(const ComponentId componentId, Archetype* archetype) -> void {
+    m_removeEdges.at(componentId) = archetype;
+}
+
+auto Archetype::layOut(const uint32_t capacity) -> uint32_t {
+    uint32_t offset { static_cast<uint32_t>(sizeof(Entity)) * capacity };
+
+    for (const ComponentId componentId : m_componentIds) {
+        offset = alignUp(offset, m_columnAlignment);
+        m_columnOffsets.at(componentId) = offset;
+        offset += m_componentSizes.at(componentId) * capacity;
+    }
+
+    return offset;
+}
+
+} // namespace ecs
+} // namespace beige
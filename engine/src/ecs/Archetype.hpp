@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Component.hpp"
+#include "Entity.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace beige {
+namespace ecs {
+
+/**
+ * Stores every entity with the same set of components. Entities live in fixed size chunks, each holding one
+ * contiguous array per component, so a system touching a few components streams through just those arrays. Entities
+ * are kept densely packed: only the last chunk is ever partly filled.
+ */
+class Archetype final {
+public:
+    static constexpr uint32_t m_chunkSize { 16384u };
+    static constexpr uint32_t m_columnAlignment { 64u }; // Every array starts on a cache line.
+
+    struct Location {
+        uint32_t chunk;
+        uint32_t row;
+    };
+
+    Archetype(const ComponentMask mask, const std::vector<ComponentInfo>& componentInfos);
+    ~Archetype();
+
+    Archetype(const Archetype&) = delete;
+    auto operator=(const Archetype&) -> Archetype& = delete;
+
+    auto getMask() const -> ComponentMask;
+    auto getComponentIds() const -> const std::vector<ComponentId>&;
+    auto hasComponent(const ComponentId componentId) const -> bool;
+    auto getComponentSize(const ComponentId componentId) const -> uint32_t;
+
+    auto getChunkCapacity() const -> uint32_t;
+    auto getChunkCount() const -> uint32_t;
+    auto getEntityCount() const -> uint32_t;
+    auto getCount(const uint32_t chunk) const -> uint32_t;
+    auto getEntities(const uint32_t chunk) const -> const Entity*;
+
+    /**
+     * @returns The array of the component in the chunk, or nullptr if the archetype does not have the component.
+     */
+    auto getColumn(const uint32_t chunk, const ComponentId componentId) const -> std::byte*;
+    auto getComponent(const Location location, const ComponentId componentId) const -> std::byte*;
+
+    /**
+     * Appends the entity, its components are left uninitialized.
+     */
+    auto allocate(const Entity entity) -> Location;
+
+    /**
+     * Removes the entity at the location by moving the last entity of the archetype into its place.
+     * @returns The entity which moved to the location, or the invalid entity if the removed one was the last.
+     */
+    auto free(const Location location) -> Entity;
+
+    /**
+     * Copies the components both archetypes have, the others are left as they are.
+     */
+    static auto copyComponents(
+        const Archetype& source,
+        const Location sourceLocation,
+        Archetype& target,
+        const Location targetLocation
+    ) -> void;
+
+    // Archetypes one component away, cached so structural changes skip the lookup by mask.
+    auto getAddEdge(const ComponentId componentId) const -> Archetype*;
+    auto setAddEdge(const ComponentId componentId, Archetype* archetype) -> void;
+    auto getRemoveEdge(const ComponentId componentId) const -> Archetype*;
+    auto setRemoveEdge(const ComponentId componentId, Archetype* archetype) -> void;
+
+private:
+    struct alignas(m_columnAlignment) ChunkData {
+        std::array<std::byte, m_chunkSize> bytes;
+    };
+
+    struct Chunk {
+        std::unique_ptr<ChunkData> data;
+        uint32_t count;
+    };
+
+    static constexpr uint32_t m_invalidOffset { static_cast<uint32_t>(-1) };
+
+    ComponentMask m_mask;
+    std::vector<ComponentId> m_componentIds; // Ascending.
+    uint32_t m_chunkCapacity;
+    uint32_t m_entityCount;
+
+    // Indexed by component id.
+    std::array<uint32_t, global_maxComponentCount> m_componentSizes;
+    std::array<uint32_t, global_maxComponentCount> m_columnOffsets;
+    std::array<Archetype*, global_maxComponentCount> m_addEdges;
+    std::array<Archetype*, global_maxComponentCount> m_removeEdges;
+
+    std::vector<Chunk> m_chunks;
+
+    /**
+     * Lays the arrays out for the given number of entities per chunk, filling m_columnOffsets.
+     * @returns The bytes used.
+     */
+    auto layOut(const uint32_t capacity) -> uint32_t;
+};
+
+} // namespace ecs
+} // namespace beige
@@ -0,0 +1,102 @@
+#include "CommandBuffer.hpp"
+
+namespace beige {
+namespace ecs {
+
+CommandBuffer::CommandBuffer() :
+m_commands { },
+m_data { },
+m_createdCount { 0u } {
+
+}
+
+CommandBuffer::~CommandBuffer() {
+
+}
+
+auto CommandBuffer::create() -> Entity {
+    const Entity placeholder {
+        m_createdCount,                // index
+        global_pendingEntityGeneration // generation
+    };
+
+    m_createdCount++;
+    push(CommandType::Create, placeholder, nullptr, 0u, 0u, 0u);
+
+    return placeholder;
+}
+
+auto CommandBuffer::destroy(const Entity entity) -> void {
+    push(CommandType::Destroy, entity, nullptr, 0u, 0u, 0u);
+}
+
+auto CommandBuffer::playback(World& world) -> void {
+    std::vector<Entity> createdEntities;
+    createdEntities.reserve(m_createdCount);
+
+    for (const Command& command : m_commands) {
+        Entity entity { command.entity };
+
+        if (entity.generation == global_pendingEntityGeneration && command.type != CommandType::Create) {
+            entity = entity.index < createdEntities.size() ? createdEntities.at(entity.index) : global_invalidEntity;
+        }
+
+        switch (command.type) {
+        case CommandType::Create: {
+            createdEntities.push_back(world.create());
+            break;
+        }
+        case CommandType::Destroy: {
+            world.destroy(entity);
+            break;
+        }
+        case CommandType::Add: {
+            const ComponentId componentId {
+                world.registerComponent(*command.componentType, command.componentSize, command.componentAlignment)
+            };
+
+            world.addComponent(entity, componentId, m_data.data() + command.dataOffset);
+            break;
+        }
+        case CommandType::Remove: {
+            const ComponentId componentId {
+                world.registerComponent(*command.componentType, command.componentSize, command.componentAlignment)
+            };
+
+            world.removeComponent(entity, componentId);
+            break;
+        }
+        }
+    }
+
+    m_commands.clear();
+    m_data.clear();
+    m_createdCount = 0u;
+}
+
+auto CommandBuffer::isEmpty() const -> bool {
+    return m_commands.empty();
+}
+
+auto CommandBuffer::push(
+    const CommandType type,
+    const Entity entity,
+    const std::type_info* componentType,
+    const uint32_t componentSize,
+    const uint32_t componentAlignment,
+    const std::size_t dataOffset
+) -> void {
+    const Command command {
+        type,               // type
+        entity,             // entity
+        componentType,      // componentType
+        componentSize,      // componentSize
+        componentAlignment, // componentAlignment
+        dataOffset          // dataOffset
+    };
+
+    m_commands.push_back(command);
+}
+
+} // namespace ecs
+} // namespace beige
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../Defines.hpp"
+#include "Entity.hpp"
+#include "World.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace beige {
+namespace ecs {
+
+/**
+ * Records structural changes while chunks are iterated and applies them to the world later, in recording order.
+ * Recording does not touch the world, so every job can fill its own buffer.
+ */
+class BEIGE_API CommandBuffer final {
+public:
+    CommandBuffer();
+    ~CommandBuffer();
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    auto operator=(const CommandBuffer&) -> CommandBuffer& = delete;
+
+    /**
+     * @returns A placeholder which the commands of this buffer accept, it becomes an entity on playback.
+     */
+    auto create() -> Entity;
+    auto destroy(const Entity entity) -> void;
+
+    template<typename T>
+    auto add(const Entity entity, const T& component) -> void {
+        static_assert(std::is_trivially_copyable_v<T>, "Components are copied between chunks byte by byte!");
+
+        const std::size_t dataOffset { m_data.size() };
+        m_data.resize(dataOffset + sizeof(T));
+        std::memcpy(m_data.data() + dataOffset, &component, sizeof(T));
+
+        push(CommandType::Add, entity, &typeid(T), static_cast<uint32_t>(sizeof(T)), static_cast<uint32_t>(alignof(T)), dataOffset);
+    }
+
+    template<typename T>
+    auto remove(const Entity entity) -> void {
+        push(CommandType::Remove, entity, &typeid(T), static_cast<uint32_t>(sizeof(T)), static_cast<uint32_t>(alignof(T)), 0u);
+    }
+
+    /**
+     * Applies the commands and clears the buffer. Commands on entities which are no longer alive are skipped.
+     */
+    auto playback(World& world) -> void;
+
+    auto isEmpty() const -> bool;
+
+private:
+    enum class CommandType : uint8_t {
+        Create,
+        Destroy,
+        Add,
+        Remove
+    };
+
+    struct Command {
+        CommandType type;
+        Entity entity;
+        const std::type_info* componentType; // Resolved on playback, recording has no world to ask.
+        uint32_t componentSize;
+        uint32_t componentAlignment;
+        std::size_t dataOffset;
+    };
+
+    std::vector<Command> m_commands;
+    std::vector<std::byte> m_data; // Components of the add commands.
+    uint32_t m_createdCount;
+
+    auto push(
+        const CommandType type,
+        const Entity entity,
+        const std::type_info* componentType,
+        const uint32_t componentSize,
+        const uint32_t componentAlignment,
+        const std::size_t dataOffset
+    ) -> void;
+};
+
+} // namespace ecs
+} // namespace beige
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+namespace beige {
+namespace ecs {
+
+using ComponentId = uint32_t;
+using ComponentMask = uint64_t; // One bit per component id.
+
+inline constexpr uint32_t global_maxComponentCount { 64u };
+inline constexpr ComponentId global_invalidComponentId { static_cast<ComponentId>(-1) };
+
+// Components are plain data, they are copied between chunks byte by byte.
+struct ComponentInfo {
+    uint32_t size;
+    uint32_t alignment;
+};
+
+// The invalid id has no bit.
+inline constexpr auto getComponentBit(const ComponentId componentId) -> ComponentMask {
+    return componentId < global_maxComponentCount ? static_cast<ComponentMask>(1u) << componentId : 0u;
+}
+
+} // namespace ecs
+} // namespace beige
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "../resources/GeometryHandle.hpp"
+#include "../resources/ITexture.hpp"
+#include "../scene/TransformHandle.hpp"
+
+#include <glm/glm.hpp>
+
+namespace beige {
+namespace ecs {
+
+struct Transform {
+    glm::mat4x4 model; // World space, read by the renderer.
+};
+
+// The textures belong to the material, see renderer::Frontend::setMaterialDiffuse(). Entities sharing the shader
+// resources of a material cannot draw with different textures.
+struct MeshRenderer {
+    resources::GeometryHandle geometry;
+    resources::ObjectId objectId; // Shader resources of the material.
+};
+
+// Links the transform to a node of the transform hierarchy, which writes the world matrix of the node into it.
+struct TransformNode {
+    scene::TransformHandle handle;
+};
+
+} // namespace ecs
+} // namespace beige
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+namespace beige {
+namespace ecs {
+
+// Refers to a slot of the world, the generation tells a recycled slot apart from the entity it used to hold.
+struct Entity {
+    uint32_t index;
+    uint32_t generation;
+};
+
+inline constexpr Entity global_invalidEntity { static_cast<uint32_t>(-1), 0u };
+
+// Marks entities created by a command buffer which do not exist in the world until it is played back.
+inline constexpr uint32_t global_pendingEntityGeneration { static_cast<uint32_t>(-1) };
+
+inline constexpr auto operator==(const Entity& lhs, const Entity& rhs) -> bool {
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+inline constexpr auto operator!=(const Entity& lhs, const Entity& rhs) -> bool {
+    return !(lhs == rhs);
+}
+
+} // namespace ecs
+} // namespace beige
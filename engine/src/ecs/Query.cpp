@@ -0,0 +1,53 @@
+#include "Query.hpp"
+
+namespace beige {
+namespace ecs {
+
+Query::Query(const ComponentMask includeMask, const ComponentMask excludeMask) :
+m_includeMask { includeMask },
+m_excludeMask { excludeMask },
+m_archetypes { },
+m_checkedArchetypeCount { 0u } {
+
+}
+
+Query::~Query() {
+
+}
+
+auto Query::getIncludeMask() const -> ComponentMask {
+    return m_includeMask;
+}
+
+auto Query::getExcludeMask() const -> ComponentMask {
+    return m_excludeMask;
+}
+
+auto Query::update(const std::vector<std::unique_ptr<Archetype>>& archetypes) -> void {
+    for (uint32_t i { m_checkedArchetypeCount }; i < static_cast<uint32_t>(archetypes.size()); i++) {
+        const ComponentMask mask { archetypes.at(i)->getMask() };
+
+        if ((mask & m_includeMask) == m_includeMask && (mask & m_excludeMask) == 0u) {
+            m_archetypes.push_back(archetypes.at(i).get());
+        }
+    }
+
+    m_checkedArchetypeCount = static_cast<uint32_t>(archetypes.size());
+}
+
+auto Query::getArchetypes() const -> const std::vector<Archetype*>& {
+    return m_archetypes;
+}
+
+auto Query::getEntityCount() const -> uint32_t {
+    uint32_t entityCount { 0u };
+
+    for (const Archetype* archetype : m_archetypes) {
+        entityCount += archetype->getEntityCount();
+    }
+
+    return entityCount;
+}
+
+} // namespace ecs
+} // namespace beige
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Archetype.hpp"
+#include "Component.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace beige {
+namespace ecs {
+
+/**
+ * Remembers the archetypes which have every included and none of the excluded components. Archetypes are never
+ * destroyed, so matches stay valid and only archetypes created since the last update have to be checked.
+ */
+class Query final {
+public:
+    Query(const ComponentMask includeMask, const ComponentMask excludeMask);
+    ~Query();
+
+    auto getIncludeMask() const -> ComponentMask;
+    auto getExcludeMask() const -> ComponentMask;
+
+    auto update(const std::vector<std::unique_ptr<Archetype>>& archetypes) -> void;
+
+    auto getArchetypes() const -> const std::vector<Archetype*>&;
+    auto getEntityCount() const -> uint32_t;
+
+private:
+    ComponentMask m_includeMask;
+    ComponentMask m_excludeMask;
+    std::vector<Archetype*> m_archetypes;
+    uint32_t m_checkedArchetypeCount;
+};
+
+} // namespace ecs
+} // namespace beige
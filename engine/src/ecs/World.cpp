@@ -0,0 +1,299 @@
+#include "World.hpp"
+
+#include "../core/Logger.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace beige {
+namespace ecs {
+
+World::World(std::shared_ptr<core::JobSystem> jobSystem) :
+m_jobSystem { jobSystem },
+m_componentInfos { },
+m_componentIds { },
+m_archetypes { },
+m_archetypesByMask { },
+m_emptyArchetype { nullptr },
+m_records { },
+m_freeIndices { },
+m_entityCount { 0u },
+m_queries { } {
+    m_emptyArchetype = getArchetype(0u);
+}
+
+World::~World() {
+
+}
+
+auto World::create() -> Entity {
+    uint32_t index { static_cast<uint32_t>(m_records.size()) };
+
+    if (!m_freeIndices.empty()) {
+        index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+    } else {
+        const Record record {
+            nullptr,    // archetype
+            { 0u, 0u }, // location
+            0u          // generation
+        };
+
+        m_records.push_back(record);
+    }
+
+    Record& record { m_records.at(index) };
+
+    const Entity entity {
+        index,            // index
+        record.generation // generation
+    };
+
+    record.archetype = m_emptyArchetype;
+    record.location = m_emptyArchetype->allocate(entity);
+    m_entityCount++;
+
+    return entity;
+}
+
+auto World::destroy(const Entity entity) -> bool {
+    if (!isAlive(entity)) {
+        return false;
+    }
+
+    Record& record { m_records.at(entity.index) };
+    const Entity movedEntity { record.archetype->free(record.location) };
+
+    if (movedEntity != global_invalidEntity) {
+        m_records.at(movedEntity.index).location = record.location;
+    }
+
+    record.archetype = nullptr;
+    record.generation++;
+
+    // Keep the generation of placeholders from ever being handed out.
+    if (record.generation == global_pendingEntityGeneration) {
+        record.generation = 0u;
+    }
+
+    m_freeIndices.push_back(entity.index);
+    m_entityCount--;
+
+    return true;
+}
+
+auto World::isAlive(const Entity entity) const -> bool {
+    return entity.index < m_records.size() &&
+        m_records.at(entity.index).archetype != nullptr &&
+        m_records.at(entity.index).generation == entity.generation;
+}
+
+auto World::getEntityCount() const -> uint32_t {
+    return m_entityCount;
+}
+
+auto World::getQuery(const ComponentMask includeMask, const ComponentMask excludeMask) -> Query& {
+    for (const std::unique_ptr<Query>& query : m_queries) {
+        if (query->getIncludeMask() == includeMask && query->getExcludeMask() == excludeMask) {
+            query->update(m_archetypes);
+            return *query;
+        }
+    }
+
+    m_queries.push_back(std::make_unique<Query>(includeMask, excludeMask));
+    m_queries.back()->update(m_archetypes);
+
+    return *m_queries.back();
+}
+
+auto World::forEachChunk(Query& query, const std::function<void(const ChunkView&)>& function) -> void {
+    query.update(m_archetypes);
+
+    for (const Archetype* archetype : query.getArchetypes()) {
+        for (uint32_t chunk { 0u }; chunk < archetype->getChunkCount(); chunk++) {
+            function(ChunkView(*this, *archetype, chunk));
+        }
+    }
+}
+
+auto World::parallelForEachChunk(Query& query, const std::function<void(const ChunkView&)>& function) -> void {
+    query.update(m_archetypes);
+
+    struct ChunkReference {
+        const Archetype* archetype;
+        uint32_t chunk;
+    };
+
+    std::vector<ChunkReference> chunkReferences;
+
+    for (const Archetype* archetype : query.getArchetypes()) {
+        for (uint32_t chunk { 0u }; chunk < archetype->getChunkCount(); chunk++) {
+            const ChunkReference chunkReference {
+                archetype, // archetype
+                chunk      // chunk
+            };
+
+            chunkReferences.push_back(chunkReference);
+        }
+    }
+
+    m_jobSystem->parallelFor(
+        static_cast<uint32_t>(chunkReferences.size()),
+        m_chunksPerJob,
+        [&](const uint32_t begin, const uint32_t end) -> void {
+            for (uint32_t i { begin }; i < end; i++) {
+                function(ChunkView(*this, *chunkReferences.at(i).archetype, chunkReferences.at(i).chunk));
+            }
+        }
+    );
+}
+
+auto World::registerComponent(const std::type_info& type, const uint32_t size, const uint32_t alignment) -> ComponentId {
+    const std::unordered_map<std::type_index, ComponentId>::const_iterator componentId { m_componentIds.find(type) };
+
+    if (componentId != m_componentIds.end()) {
+        return componentId->second;
+    }
+
+    if (m_componentInfos.size() >= global_maxComponentCount) {
+        core::Logger::error(
+            "Unable to register component " + std::string(type.name()) + ", there are already " +
+            std::to_string(global_maxComponentCount) + " component types!"
+        );
+        return global_invalidComponentId;
+    }
+
+    const ComponentInfo componentInfo {
+        size,     // size
+        alignment // alignment
+    };
+
+    m_componentInfos.push_back(componentInfo);
+
+    const ComponentId newComponentId { static_cast<ComponentId>(m_componentInfos.size()) - 1u };
+    m_componentIds.emplace(type, newComponentId);
+
+    return newComponentId;
+}
+
+auto World::findComponentId(const std::type_info& type) const -> std::optional<ComponentId> {
+    const std::unordered_map<std::type_index, ComponentId>::const_iterator componentId { m_componentIds.find(type) };
+
+    if (componentId == m_componentIds.end()) {
+        return std::nullopt;
+    }
+
+    return componentId->second;
+}
+
+auto World::addComponent(const Entity entity, const ComponentId componentId, const void* component) -> bool {
+    if (!isAlive(entity) || componentId >= global_maxComponentCount) {
+        return false;
+    }
+
+    Record& record { m_records.at(entity.index) };
+
+    if (!record.archetype->hasComponent(componentId)) {
+        Archetype* source { record.archetype };
+        Archetype* target { source->getAddEdge(componentId) };
+
+        if (target == nullptr) {
+            target = getArchetype(source->getMask() | getComponentBit(componentId));
+            source->setAddEdge(componentId, target);
+            target->setRemoveEdge(componentId, source);
+        }
+
+        moveEntity(entity, target);
+    }
+
+    std::memcpy(
+        record.archetype->getComponent(record.location, componentId),
+        component,
+        m_componentInfos.at(componentId).size
+    );
+
+    return true;
+}
+
+auto World::removeComponent(const Entity entity, const ComponentId componentId) -> bool {
+    if (!isAlive(entity) || !m_records.at(entity.index).archetype->hasComponent(componentId)) {
+        return false;
+    }
+
+    Archetype* source { m_records.at(entity.index).archetype };
+    Archetype* target { source->getRemoveEdge(componentId) };
+
+    if (target == nullptr) {
+        target = getArchetype(source->getMask() & ~getComponentBit(componentId));
+        source->setRemoveEdge(componentId, target);
+        target->setAddEdge(componentId, source);
+    }
+
+    moveEntity(entity, target);
+
+    return true;
+}
+
+auto World::getComponent(const Entity entity, const ComponentId componentId) const -> void* {
+    if (!isAlive(entity)) {
+        return nullptr;
+    }
+
+    const Record& record { m_records.at(entity.index) };
+
+    return record.archetype->getComponent(record.location, componentId);
+}
+
+auto World::getArchetype(const ComponentMask mask) -> Archetype* {
+    const std::unordered_map<ComponentMask, Archetype*>::const_iterator archetype { m_archetypesByMask.find(mask) };
+
+    if (archetype != m_archetypesByMask.end()) {
+        return archetype->second;
+    }
+
+    m_archetypes.push_back(std::make_unique<Archetype>(mask, m_componentInfos));
+    m_archetypesByMask.emplace(mask, m_archetypes.back().get());
+
+    return m_archetypes.back().get();
+}
+
+auto World::moveEntity(const Entity entity, Archetype* target) -> void {
+    Record& record { m_records.at(entity.index) };
+    Archetype* source { record.archetype };
+
+    const Archetype::Location sourceLocation { record.location };
+    const Archetype::Location targetLocation { target->allocate(entity) };
+
+    Archetype::copyComponents(*source, sourceLocation, *target, targetLocation);
+
+    const Entity movedEntity { source->free(sourceLocation) };
+
+    if (movedEntity != global_invalidEntity) {
+        m_records.at(movedEntity.index).location = sourceLocation;
+    }
+
+    record.archetype = target;
+    record.location = targetLocation;
+}
+
+ChunkView::ChunkView(const World& world, const Archetype& archetype, const uint32_t chunk) :
+m_world { world },
+m_archetype { archetype },
+m_chunk { chunk } {
+
+}
+
+ChunkView::~ChunkView() {
+
+}
+
+auto ChunkView::getCount() const -> uint32_t {
+    return m_archetype.getCount(m_chunk);
+}
+
+auto ChunkView::getEntities() const -> const Entity* {
+    return m_archetype.getEntities(m_chunk);
+}
+
+} // namespace ecs
+} // namespace beige
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "../Defines.hpp"
+#include "../core/JobSystem.hpp"
+#include "Archetype.hpp"
+#include "Component.hpp"
+#include "Entity.hpp"
+#include "Query.hpp"
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace beige {
+namespace ecs {
+
+class ChunkView;
+
+/**
+ * Owns the entities and their components, grouped into archetypes by the set of components they have. Adding or
+ * removing a component moves the entity to another archetype, so structural changes must not happen while chunks
+ * are iterated; record them into a CommandBuffer and play it back afterwards instead.
+ */
+class BEIGE_API World final {
+public:
+    World(std::shared_ptr<core::JobSystem> jobSystem);
+    ~World();
+
+    World(const World&) = delete;
+    auto operator=(const World&) -> World& = delete;
+
+    auto create() -> Entity;
+    auto destroy(const Entity entity) -> bool;
+    auto isAlive(const Entity entity) const -> bool;
+    auto getEntityCount() const -> uint32_t;
+
+    /**
+     * Registers the component type on first use. Not safe to call while chunks are iterated on several threads.
+     * @returns The id of the component, or the invalid id if there are too many component types.
+     */
+    template<typename T>
+    auto getComponentId() -> ComponentId {
+        static_assert(std::is_trivially_copyable_v<T>, "Components are copied between chunks byte by byte!");
+        static_assert(alignof(T) <= Archetype::m_columnAlignment, "Components cannot be aligned beyond a cache line!");
+
+        return registerComponent(typeid(T), static_cast<uint32_t>(sizeof(T)), static_cast<uint32_t>(alignof(T)));
+    }
+
+    /**
+     * Adds the component, or overwrites it if the entity already has one.
+     * @returns False if the entity is not alive.
+     */
+    template<typename T>
+    auto add(const Entity entity, const T& component) -> bool {
+        return addComponent(entity, getComponentId<T>(), &component);
+    }
+
+    template<typename T>
+    auto remove(const Entity entity) -> bool {
+        return removeComponent(entity, getComponentId<T>());
+    }
+
+    /**
+     * @returns The component, valid until the next structural change, or nullptr if the entity does not have one.
+     */
+    template<typename T>
+    auto get(const Entity entity) const -> T* {
+        const std::optional<ComponentId> componentId { findComponentId(typeid(T)) };
+
+        if (!componentId.has_value()) {
+            return nullptr;
+        }
+
+        return reinterpret_cast<T*>(getComponent(entity, componentId.value()));
+    }
+
+    template<typename T>
+    auto has(const Entity entity) const -> bool {
+        return get<T>(entity) != nullptr;
+    }
+
+    /**
+     * @returns The query over the entities with every one of the components, kept by the world across calls.
+     */
+    template<typename... Ts>
+    auto getQuery() -> Query& {
+        return getQuery((getComponentBit(getComponentId<Ts>()) | ...), 0u);
+    }
+
+    auto getQuery(const ComponentMask includeMask, const ComponentMask excludeMask) -> Query&;
+
+    /**
+     * Calls the function for every non-empty chunk of the archetypes matching the query.
+     */
+    auto forEachChunk(Query& query, const std::function<void(const ChunkView&)>& function) -> void;
+
+    /**
+     * Like forEachChunk(), but spreads the chunks over the job system. The function is called from several threads
+     * at once and may only write the components of the chunk it is given.
+     */
+    auto parallelForEachChunk(Query& query, const std::function<void(const ChunkView&)>& function) -> void;
+
+    auto registerComponent(const std::type_info& type, const uint32_t size, const uint32_t alignment) -> ComponentId;
+    auto findComponentId(const std::type_info& type) const -> std::optional<ComponentId>;
+    auto addComponent(const Entity entity, const ComponentId componentId, const void* component) -> bool;
+    auto removeComponent(const Entity entity, const ComponentId componentId) -> bool;
+    auto getComponent(const Entity entity, const ComponentId componentId) const -> void*;
+
+private:
+    // Chunks per job, a few chunks amortize the cost of handing out work.
+    static constexpr uint32_t m_chunksPerJob { 4u };
+
+    struct Record {
+        Archetype* archetype; // nullptr while the slot is free.
+        Archetype::Location location;
+        uint32_t generation;
+    };
+
+    std::shared_ptr<core::JobSystem> m_jobSystem;
+
+    std::vector<ComponentInfo> m_componentInfos; // Indexed by component id.
+    std::unordered_map<std::type_index, ComponentId> m_componentIds;
+
+    std::vector<std::unique_ptr<Archetype>> m_archetypes; // Never shrinks, queries rely on it.
+    std::unordered_map<ComponentMask, Archetype*> m_archetypesByMask;
+    Archetype* m_emptyArchetype;
+
+    std::vector<Record> m_records; // Indexed by entity index.
+    std::vector<uint32_t> m_freeIndices;
+    uint32_t m_entityCount;
+
+    std::vector<std::unique_ptr<Query>> m_queries;
+
+    auto getArchetype(const ComponentMask mask) -> Archetype*;
+    auto moveEntity(const Entity entity, Archetype* target) -> void;
+};
+
+/**
+ * The entities of one chunk and their component arrays, which are indexed like the entities.
+ */
+class BEIGE_API ChunkView final {
+public:
+    ChunkView(const World& world, const Archetype& archetype, const uint32_t chunk);
+    ~ChunkView();
+
+    auto getCount() const -> uint32_t;
+    auto getEntities() const -> const Entity*;
+
+    /**
+     * @returns The array of the component, or nullptr if the chunk does not have the component.
+     */
+    template<typename T>
+    auto get() const -> T* {
+        const std::optional<ComponentId> componentId { m_world.findComponentId(typeid(T)) };
+
+        if (!componentId.has_value()) {
+            return nullptr;
+        }
+
+        return reinterpret_cast<T*>(m_archetype.getColumn(m_chunk, componentId.value()));
+    }
+
+private:
+    const World& m_world;
+    const Archetype& m_archetype;
+    uint32_t m_chunk;
+};
+
+} // namespace ecs
+} // namespace beige
@@ -0,0 +1,898 @@
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BEIGE_SIMD_SSE2
+#endif // SSE2
+
+// AVX2 kernels are compiled for x64 only and called only after checking the CPU supports them.
+#if defined(BEIGE_SIMD_SSE2) && (defined(_M_X64) || defined(__x86_64__))
+#include <immintrin.h>
+#define BEIGE_SIMD_AVX2
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BEIGE_SIMD_TARGET_AVX2
+#else
+#define BEIGE_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif // _MSC_VER
+#endif // AVX2
+
+namespace beige {
+namespace math {
+
+namespace {
+
+struct Kernels {
+    auto (*hasTransparency)(const uint8_t* pixels, const uint64_t pixelCount) -> bool;
+    auto (*expandRgbToRgba)(const uint8_t* source, uint8_t* destination, const uint64_t pixelCount) -> void;
+    auto (*swapRows)(uint8_t* row0, uint8_t* row1, const uint64_t rowSize) -> void;
+    auto (*premultiplyAlpha)(uint8_t* pixels, const uint64_t pixelCount) -> void;
+    auto (*downsampleRow)(const uint8_t* sourceRow0, const uint8_t* sourceRow1, uint8_t* destinationRow, const uint32_t destinationWidth) -> void;
+    auto (*cullSpheres)(const float* planes, const float* centersX, const float* centersY, const float* centersZ, const float* radii, const uint32_t count, uint32_t* visibleIndices) -> uint32_t;
+    auto (*multiplyMatrices)(const float* lhs, const float* rhs, float* result, const uint32_t count) -> void;
+    auto (*transformPoints)(const float* matrix, const float* points, float* results, const uint32_t count) -> void;
+    auto (*cullPackedSpheres)(const float* planes, const uint32_t planeCount, const float* spheres, const uint32_t count, uint32_t* visibleIndices) -> uint32_t;
+};
+
+constexpr uint32_t global_frustumPlaneCount { 6u };
+constexpr uint32_t global_matrixSize { 16u };
+
+// Exact round(value * alpha / 255) for 8 bit inputs.
+auto multiplyAlpha(const uint32_t value, const uint32_t alpha) -> uint8_t {
+    const uint32_t product { value * alpha + 128u };
+    return static_cast<uint8_t>((product + (product >> 8u)) >> 8u);
+}
+
+auto hasTransparencyScalar(const uint8_t* pixels, const uint64_t pixelCount) -> bool {
+    for (uint64_t i { 0u }; i < pixelCount; i++) {
+        if (pixels[i * 4u + 3u] != 0xFFu) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+auto expandRgbToRgbaScalar(const uint8_t* source, uint8_t* destination, const uint64_t pixelCount) -> void {
+    for (uint64_t i { 0u }; i < pixelCount; i++) {
+        destination[i * 4u + 0u] = source[i * 3u + 0u];
+        destination[i * 4u + 1u] = source[i * 3u + 1u];
+        destination[i * 4u + 2u] = source[i * 3u + 2u];
+        destination[i * 4u + 3u] = 0xFFu;
+    }
+}
+
+auto swapRowsScalar(uint8_t* row0, uint8_t* row1, const uint64_t rowSize) -> void {
+    std::swap_ranges(row0, row0 + rowSize, row1);
+}
+
+auto premultiplyAlphaScalar(uint8_t* pixels, const uint64_t pixelCount) -> void {
+    for (uint64_t i { 0u }; i < pixelCount; i++) {
+        uint8_t* pixel { pixels + i * 4u };
+        pixel[0] = multiplyAlpha(pixel[0], pixel[3]);
+        pixel[1] = multiplyAlpha(pixel[1], pixel[3]);
+        pixel[2] = multiplyAlpha(pixel[2], pixel[3]);
+    }
+}
+
+// Averages destination pixels [first, destinationWidth) of a row whose source pixels are all in bounds.
+auto downsampleRowRangeScalar(
+    const uint8_t* sourceRow0,
+    const uint8_t* sourceRow1,
+    uint8_t* destinationRow,
+    const uint32_t first,
+    const uint32_t destinationWidth
+) -> void {
+    for (uint32_t x { first }; x < destinationWidth; x++) {
+        for (uint32_t c { 0u }; c < 4u; c++) {
+            const uint32_t sum {
+                static_cast<uint32_t>(sourceRow0[x * 8u + c]) + sourceRow0[x * 8u + 4u + c] +
+                sourceRow1[x * 8u + c] + sourceRow1[x * 8u + 4u + c]
+            };
+            destinationRow[x * 4u + c] = static_cast<uint8_t>((sum + 2u) >> 2u);
+        }
+    }
+}
+
+auto downsampleRowScalar(const uint8_t* sourceRow0, const uint8_t* sourceRow1, uint8_t* destinationRow, const uint32_t destinationWidth) -> void {
+    downsampleRowRangeScalar(sourceRow0, sourceRow1, destinationRow, 0u, destinationWidth);
+}
+
+// Tests spheres [first, count), the written indices count from the start of the arrays.
+auto cullSpheresRangeScalar(
+    const float* planes,
+    const float* centersX,
+    const float* centersY,
+    const float* centersZ,
+    const float* radii,
+    const uint32_t first,
+    const uint32_t count,
+    uint32_t* visibleIndices
+) -> uint32_t {
+    uint32_t visibleCount { 0u };
+
+    for (uint32_t i { first }; i < count; i++) {
+        bool isVisible { true };
+
+        for (uint32_t plane { 0u }; plane < global_frustumPlaneCount && isVisible; plane++) {
+            const float* p { planes + plane * 4u };
+            isVisible = p[0] * centersX[i] + p[1] * centersY[i] + p[2] * centersZ[i] + p[3] > -radii[i];
+        }
+
+        // Every sphere is written, only visible ones advance the output.
+        visibleIndices[visibleCount] = i;
+        visibleCount += isVisible ? 1u : 0u;
+    }
+
+    return visibleCount;
+}
+
+auto cullSpheresScalar(
+    const float* planes,
+    const float* centersX,
+    const float* centersY,
+    const float* centersZ,
+    const float* radii,
+    const uint32_t count,
+    uint32_t* visibleIndices
+) -> uint32_t {
+    return cullSpheresRangeScalar(planes, centersX, centersY, centersZ, radii, 0u, count, visibleIndices);
+}
+
+auto multiplyMatricesScalar(const float* lhs, const float* rhs, float* result, const uint32_t count) -> void {
+    for (uint32_t i { 0u }; i < count; i++) {
+        const float* a { lhs + i * global_matrixSize };
+        const float* b { rhs + i * global_matrixSize };
+        float* r { result + i * global_matrixSize };
+
+        for (uint32_t column { 0u }; column < 4u; column++) {
+            for (uint32_t row { 0u }; row < 4u; row++) {
+                r[column * 4u + row] =
+                    a[0u * 4u + row] * b[column * 4u + 0u] +
+                    a[1u * 4u + row] * b[column * 4u + 1u] +
+                    a[2u * 4u + row] * b[column * 4u + 2u] +
+                    a[3u * 4u + row] * b[column * 4u + 3u];
+            }
+        }
+    }
+}
+
+// Transforms points [first, count), into a temporary so the results may alias the points.
+auto transformPointsRangeScalar(
+    const float* matrix,
+    const float* points,
+    float* results,
+    const uint32_t first,
+    const uint32_t count
+) -> void {
+    for (uint32_t i { first }; i < count; i++) {
+        const float* p { points + i * 4u };
+        std::array<float, 4u> result;
+
+        for (uint32_t row { 0u }; row < 4u; row++) {
+            result[row] =
+                matrix[0u * 4u + row] * p[0] +
+                matrix[1u * 4u + row] * p[1] +
+                matrix[2u * 4u + row] * p[2] +
+                matrix[3u * 4u + row] * p[3];
+        }
+
+        std::memcpy(results + i * 4u, result.data(), sizeof(result));
+    }
+}
+
+auto transformPointsScalar(const float* matrix, const float* points, float* results, const uint32_t count) -> void {
+    transformPointsRangeScalar(matrix, points, results, 0u, count);
+}
+
+// Tests spheres [first, count), the written indices count from the start of the array.
+auto cullPackedSpheresRangeScalar(
+    const float* planes,
+    const uint32_t planeCount,
+    const float* spheres,
+    const uint32_t first,
+    const uint32_t count,
+    uint32_t* visibleIndices
+) -> uint32_t {
+    uint32_t visibleCount { 0u };
+
+    for (uint32_t i { first }; i < count; i++) {
+        const float* sphere { spheres + i * 4u };
+        bool isVisible { true };
+
+        for (uint32_t plane { 0u }; plane < planeCount && isVisible; plane++) {
+            const float* p { planes + plane * 4u };
+            isVisible = p[0] * sphere[0] + p[1] * sphere[1] + p[2] * sphere[2] + p[3] > -sphere[3];
+        }
+
+        visibleIndices[visibleCount] = i;
+        visibleCount += isVisible ? 1u : 0u;
+    }
+
+    return visibleCount;
+}
+
+auto cullPackedSpheresScalar(
+    const float* planes,
+    const uint32_t planeCount,
+    const float* spheres,
+    const uint32_t count,
+    uint32_t* visibleIndices
+) -> uint32_t {
+    return cullPackedSpheresRangeScalar(planes, planeCount, spheres, 0u, count, visibleIndices);
+}
+
+#ifdef BEIGE_SIMD_SSE2
+auto hasTransparencySse2(const uint8_t* pixels, const uint64_t pixelCount) -> bool {
+    // Setting the color bytes leaves all ones only where alpha is 255.
+    const __m128i colorMask { _mm_set1_epi32(0x00FFFFFF) };
+    const __m128i opaque { _mm_set1_epi32(-1) };
+
+    uint64_t i { 0u };
+    for (; i + 16u <= pixelCount; i += 16u) {
+        const __m128i* source { reinterpret_cast<const __m128i*>(pixels + i * 4u) };
+        const __m128i combined {
+            _mm_and_si128(
+                _mm_and_si128(_mm_loadu_si128(source + 0), _mm_loadu_si128(source + 1)),
+                _mm_and_si128(_mm_loadu_si128(source + 2), _mm_loadu_si128(source + 3))
+            )
+        };
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(combined, colorMask), opaque)) != 0xFFFF) {
+            return true;
+        }
+    }
+
+    return hasTransparencyScalar(pixels + i * 4u, pixelCount - i);
+}
+
+auto swapRowsSse2(uint8_t* row0, uint8_t* row1, const uint64_t rowSize) -> void {
+    uint64_t i { 0u };
+    for (; i + 16u <= rowSize; i += 16u) {
+        const __m128i value0 { _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + i)) };
+        const __m128i value1 { _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + i)) };
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row0 + i), value1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row1 + i), value0);
+    }
+
+    swapRowsScalar(row0 + i, row1 + i, rowSize - i);
+}
+
+// Multiplies two pixels widened to 16 bits per channel, alpha is multiplied with 255 which keeps it as it is.
+auto premultiplyPixelPairSse2(const __m128i pixels) -> __m128i {
+    const __m128i alphaLanes { _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0) };
+    const __m128i alpha { _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)) };
+    const __m128i factor { _mm_or_si128(_mm_andnot_si128(alphaLanes, alpha), _mm_and_si128(alphaLanes, _mm_set1_epi16(255))) };
+
+    const __m128i product { _mm_add_epi16(_mm_mullo_epi16(pixels, factor), _mm_set1_epi16(128)) };
+    return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+}
+
+auto premultiplyAlphaSse2(uint8_t* pixels, const uint64_t pixelCount) -> void {
+    const __m128i zero { _mm_setzero_si128() };
+
+    uint64_t i { 0u };
+    for (; i + 4u <= pixelCount; i += 4u) {
+        __m128i* destination { reinterpret_cast<__m128i*>(pixels + i * 4u) };
+        const __m128i value { _mm_loadu_si128(destination) };
+
+        const __m128i low { premultiplyPixelPairSse2(_mm_unpacklo_epi8(value, zero)) };
+        const __m128i high { premultiplyPixelPairSse2(_mm_unpackhi_epi8(value, zero)) };
+        _mm_storeu_si128(destination, _mm_packus_epi16(low, high));
+    }
+
+    premultiplyAlphaScalar(pixels + i * 4u, pixelCount - i);
+}
+
+auto downsampleRowSse2(const uint8_t* sourceRow0, const uint8_t* sourceRow1, uint8_t* destinationRow, const uint32_t destinationWidth) -> void {
+    const __m128i zero { _mm_setzero_si128() };
+    const __m128i rounding { _mm_set1_epi16(2) };
+
+    // Four destination pixels per iteration: split even and odd source pixels, then add all four in 16 bits.
+    uint32_t x { 0u };
+    for (; x + 4u <= destinationWidth; x += 4u) {
+        const __m128 top0 { _mm_loadu_ps(reinterpret_cast<const float*>(sourceRow0 + x * 8u)) };
+        const __m128 top1 { _mm_loadu_ps(reinterpret_cast<const float*>(sourceRow0 + x * 8u + 16u)) };
+        const __m128 bottom0 { _mm_loadu_ps(reinterpret_cast<const float*>(sourceRow1 + x * 8u)) };
+        const __m128 bottom1 { _mm_loadu_ps(reinterpret_cast<const float*>(sourceRow1 + x * 8u + 16u)) };
+
+        const __m128i topEven { _mm_castps_si128(_mm_shuffle_ps(top0, top1, _MM_SHUFFLE(2, 0, 2, 0))) };
+        const __m128i topOdd { _mm_castps_si128(_mm_shuffle_ps(top0, top1, _MM_SHUFFLE(3, 1, 3, 1))) };
+        const __m128i bottomEven { _mm_castps_si128(_mm_shuffle_ps(bottom0, bottom1, _MM_SHUFFLE(2, 0, 2, 0))) };
+        const __m128i bottomOdd { _mm_castps_si128(_mm_shuffle_ps(bottom0, bottom1, _MM_SHUFFLE(3, 1, 3, 1))) };
+
+        const __m128i sumLow {
+            _mm_add_epi16(
+                _mm_add_epi16(_mm_unpacklo_epi8(topEven, zero), _mm_unpacklo_epi8(topOdd, zero)),
+                _mm_add_epi16(_mm_unpacklo_epi8(bottomEven, zero), _mm_unpacklo_epi8(bottomOdd, zero))
+            )
+        };
+        const __m128i sumHigh {
+            _mm_add_epi16(
+                _mm_add_epi16(_mm_unpackhi_epi8(topEven, zero), _mm_unpackhi_epi8(topOdd, zero)),
+                _mm_add_epi16(_mm_unpackhi_epi8(bottomEven, zero), _mm_unpackhi_epi8(bottomOdd, zero))
+            )
+        };
+
+        const __m128i averageLow { _mm_srli_epi16(_mm_add_epi16(sumLow, rounding), 2) };
+        const __m128i averageHigh { _mm_srli_epi16(_mm_add_epi16(sumHigh, rounding), 2) };
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destinationRow + x * 4u), _mm_packus_epi16(averageLow, averageHigh));
+    }
+
+    downsampleRowRangeScalar(sourceRow0, sourceRow1, destinationRow, x, destinationWidth);
+}
+
+auto cullSpheresSse2(
+    const float* planes,
+    const float* centersX,
+    const float* centersY,
+    const float* centersZ,
+    const float* radii,
+    const uint32_t count,
+    uint32_t* visibleIndices
+) -> uint32_t {
+    // A plain array, std::array would drop the alignment of the vector type.
+    __m128 planeValues[global_frustumPlaneCount * 4u];
+    for (uint32_t i { 0u }; i < global_frustumPlaneCount * 4u; i++) {
+        planeValues[i] = _mm_set1_ps(planes[i]);
+    }
+
+    uint32_t visibleCount { 0u };
+    uint32_t i { 0u };
+
+    for (; i + 4u <= count; i += 4u) {
+        const __m128 x { _mm_loadu_ps(centersX + i) };
+        const __m128 y { _mm_loadu_ps(centersY + i) };
+        const __m128 z { _mm_loadu_ps(centersZ + i) };
+        const __m128 negativeRadius { _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radii + i)) };
+
+        __m128 isInside { _mm_castsi128_ps(_mm_set1_epi32(-1)) };
+
+        for (uint32_t plane { 0u }; plane < global_frustumPlaneCount; plane++) {
+            const __m128* p { planeValues + plane * 4u };
+            const __m128 distance {
+                _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(p[0], x), _mm_mul_ps(p[1], y)),
+                    _mm_add_ps(_mm_mul_ps(p[2], z), p[3])
+                )
+            };
+            isInside = _mm_and_ps(isInside, _mm_cmpgt_ps(distance, negativeRadius));
+        }
+
+        const uint32_t mask { static_cast<uint32_t>(_mm_movemask_ps(isInside)) };
+
+        for (uint32_t lane { 0u }; lane < 4u; lane++) {
+            visibleIndices[visibleCount] = i + lane;
+            visibleCount += (mask >> lane) & 1u;
+        }
+    }
+
+    return visibleCount + cullSpheresRangeScalar(planes, centersX, centersY, centersZ, radii, i, count, visibleIndices + visibleCount);
+}
+
+// Every column of the result is the columns of lhs weighted by the elements of the same column of rhs.
+auto multiplyMatricesSse2(const float* lhs, const float* rhs, float* result, const uint32_t count) -> void {
+    for (uint32_t i { 0u }; i < count; i++) {
+        const float* a { lhs + i * global_matrixSize };
+        const float* b { rhs + i * global_matrixSize };
+        float* r { result + i * global_matrixSize };
+
+        const __m128 a0 { _mm_loadu_ps(a + 0u) };
+        const __m128 a1 { _mm_loadu_ps(a + 4u) };
+        const __m128 a2 { _mm_loadu_ps(a + 8u) };
+        const __m128 a3 { _mm_loadu_ps(a + 12u) };
+
+        for (uint32_t column { 0u }; column < 4u; column++) {
+            const __m128 b0 { _mm_set1_ps(b[column * 4u + 0u]) };
+            const __m128 b1 { _mm_set1_ps(b[column * 4u + 1u]) };
+            const __m128 b2 { _mm_set1_ps(b[column * 4u + 2u]) };
+            const __m128 b3 { _mm_set1_ps(b[column * 4u + 3u]) };
+
+            _mm_storeu_ps(
+                r + column * 4u,
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, b0), _mm_mul_ps(a1, b1)), _mm_add_ps(_mm_mul_ps(a2, b2), _mm_mul_ps(a3, b3)))
+            );
+        }
+    }
+}
+
+auto transformPointsSse2(const float* matrix, const float* points, float* results, const uint32_t count) -> void {
+    const __m128 m0 { _mm_loadu_ps(matrix + 0u) };
+    const __m128 m1 { _mm_loadu_ps(matrix + 4u) };
+    const __m128 m2 { _mm_loadu_ps(matrix + 8u) };
+    const __m128 m3 { _mm_loadu_ps(matrix + 12u) };
+
+    for (uint32_t i { 0u }; i < count; i++) {
+        const __m128 point { _mm_loadu_ps(points + i * 4u) };
+        const __m128 x { _mm_shuffle_ps(point, point, _MM_SHUFFLE(0, 0, 0, 0)) };
+        const __m128 y { _mm_shuffle_ps(point, point, _MM_SHUFFLE(1, 1, 1, 1)) };
+        const __m128 z { _mm_shuffle_ps(point, point, _MM_SHUFFLE(2, 2, 2, 2)) };
+        const __m128 w { _mm_shuffle_ps(point, point, _MM_SHUFFLE(3, 3, 3, 3)) };
+
+        _mm_storeu_ps(
+            results + i * 4u,
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m1, y)), _mm_add_ps(_mm_mul_ps(m2, z), _mm_mul_ps(m3, w)))
+        );
+    }
+}
+
+// Four spheres per iteration, transposed into one register per component.
+auto cullPackedSpheresSse2(
+    const float* planes,
+    const uint32_t planeCount,
+    const float* spheres,
+    const uint32_t count,
+    uint32_t* visibleIndices
+) -> uint32_t {
+    uint32_t visibleCount { 0u };
+    uint32_t i { 0u };
+
+    for (; i + 4u <= count; i += 4u) {
+        __m128 x { _mm_loadu_ps(spheres + i * 4u + 0u) };
+        __m128 y { _mm_loadu_ps(spheres + i * 4u + 4u) };
+        __m128 z { _mm_loadu_ps(spheres + i * 4u + 8u) };
+        __m128 radius { _mm_loadu_ps(spheres + i * 4u + 12u) };
+        _MM_TRANSPOSE4_PS(x, y, z, radius);
+
+        const __m128 negativeRadius { _mm_sub_ps(_mm_setzero_ps(), radius) };
+        __m128 isInside { _mm_castsi128_ps(_mm_set1_epi32(-1)) };
+
+        for (uint32_t plane { 0u }; plane < planeCount; plane++) {
+            const float* p { planes + plane * 4u };
+            const __m128 distance {
+                _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p[0]), x), _mm_mul_ps(_mm_set1_ps(p[1]), y)),
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p[2]), z), _mm_set1_ps(p[3]))
+                )
+            };
+            isInside = _mm_and_ps(isInside, _mm_cmpgt_ps(distance, negativeRadius));
+        }
+
+        const uint32_t mask { static_cast<uint32_t>(_mm_movemask_ps(isInside)) };
+
+        for (uint32_t lane { 0u }; lane < 4u; lane++) {
+            visibleIndices[visibleCount] = i + lane;
+            visibleCount += (mask >> lane) & 1u;
+        }
+    }
+
+    return visibleCount + cullPackedSpheresRangeScalar(planes, planeCount, spheres, i, count, visibleIndices + visibleCount);
+}
+#endif // BEIGE_SIMD_SSE2
+
+#ifdef BEIGE_SIMD_AVX2
+BEIGE_SIMD_TARGET_AVX2 auto hasTransparencyAvx2(const uint8_t* pixels, const uint64_t pixelCount) -> bool {
+    const __m256i colorMask { _mm256_set1_epi32(0x00FFFFFF) };
+    const __m256i opaque { _mm256_set1_epi32(-1) };
+
+    uint64_t i { 0u };
+    for (; i + 32u <= pixelCount; i += 32u) {
+        const __m256i* source { reinterpret_cast<const __m256i*>(pixels + i * 4u) };
+        const __m256i combined {
+            _mm256_and_si256(
+                _mm256_and_si256(_mm256_loadu_si256(source + 0), _mm256_loadu_si256(source + 1)),
+                _mm256_and_si256(_mm256_loadu_si256(source + 2), _mm256_loadu_si256(source + 3))
+            )
+        };
+
+        if (!_mm256_testc_si256(_mm256_or_si256(combined, colorMask), opaque)) {
+            return true;
+        }
+    }
+
+    return hasTransparencySse2(pixels + i * 4u, pixelCount - i);
+}
+
+// Byte shuffles are SSSE3, which every AVX2 CPU has. Sixteen pixels per iteration, read as three whole vectors.
+BEIGE_SIMD_TARGET_AVX2 auto expandRgbToRgbaAvx2(const uint8_t* source, uint8_t* destination, const uint64_t pixelCount) -> void {
+    const __m128i shuffle { _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1) };
+    const __m128i alpha { _mm_set1_epi32(static_cast<int32_t>(0xFF000000u)) };
+
+    uint64_t i { 0u };
+    for (; i + 16u <= pixelCount; i += 16u) {
+        const __m128i* input { reinterpret_cast<const __m128i*>(source + i * 3u) };
+        __m128i* output { reinterpret_cast<__m128i*>(destination + i * 4u) };
+
+        const __m128i input0 { _mm_loadu_si128(input + 0) };
+        const __m128i input1 { _mm_loadu_si128(input + 1) };
+        const __m128i input2 { _mm_loadu_si128(input + 2) };
+
+        _mm_storeu_si128(output + 0, _mm_or_si128(_mm_shuffle_epi8(input0, shuffle), alpha));
+        _mm_storeu_si128(output + 1, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(input1, input0, 12), shuffle), alpha));
+        _mm_storeu_si128(output + 2, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(input2, input1, 8), shuffle), alpha));
+        _mm_storeu_si128(output + 3, _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(input2, 4), shuffle), alpha));
+    }
+
+    expandRgbToRgbaScalar(source + i * 3u, destination + i * 4u, pixelCount - i);
+}
+
+// Same as the SSE2 version, four pixels widened to 16 bits per channel.
+BEIGE_SIMD_TARGET_AVX2 auto premultiplyPixelQuadAvx2(const __m256i pixels) -> __m256i {
+    const __m256i alphaLanes { _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0) };
+    const __m256i alpha { _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)) };
+    const __m256i factor { _mm256_or_si256(_mm256_andnot_si256(alphaLanes, alpha), _mm256_and_si256(alphaLanes, _mm256_set1_epi16(255))) };
+
+    const __m256i product { _mm256_add_epi16(_mm256_mullo_epi16(pixels, factor), _mm256_set1_epi16(128)) };
+    return _mm256_srli_epi16(_mm256_add_epi16(product, _mm256_srli_epi16(product, 8)), 8);
+}
+
+BEIGE_SIMD_TARGET_AVX2 auto premultiplyAlphaAvx2(uint8_t* pixels, const uint64_t pixelCount) -> void {
+    const __m256i zero { _mm256_setzero_si256() };
+
+    // Unpacking and packing both work per 128 bit lane, so the pixel order survives the round trip.
+    uint64_t i { 0u };
+    for (; i + 8u <= pixelCount; i += 8u) {
+        __m256i* destination { reinterpret_cast<__m256i*>(pixels + i * 4u) };
+        const __m256i value { _mm256_loadu_si256(destination) };
+
+        const __m256i low { premultiplyPixelQuadAvx2(_mm256_unpacklo_epi8(value, zero)) };
+        const __m256i high { premultiplyPixelQuadAvx2(_mm256_unpackhi_epi8(value, zero)) };
+        _mm256_storeu_si256(destination, _mm256_packus_epi16(low, high));
+    }
+
+    premultiplyAlphaSse2(pixels + i * 4u, pixelCount - i);
+}
+
+// Only needs AVX, which every AVX2 CPU has. Eight spheres per iteration.
+BEIGE_SIMD_TARGET_AVX2 auto cullSpheresAvx2(
+    const float* planes,
+    const float* centersX,
+    const float* centersY,
+    const float* centersZ,
+    const float* radii,
+    const uint32_t count,
+    uint32_t* visibleIndices
+) -> uint32_t {
+    // A plain array, std::array would drop the alignment of the vector type.
+    __m256 planeValues[global_frustumPlaneCount * 4u];
+    for (uint32_t i { 0u }; i < global_frustumPlaneCount * 4u; i++) {
+        planeValues[i] = _mm256_set1_ps(planes[i]);
+    }
+
+    uint32_t visibleCount { 0u };
+    uint32_t i { 0u };
+
+    for (; i + 8u <= count; i += 8u) {
+        const __m256 x { _mm256_loadu_ps(centersX + i) };
+        const __m256 y { _mm256_loadu_ps(centersY + i) };
+        const __m256 z { _mm256_loadu_ps(centersZ + i) };
+        const __m256 negativeRadius { _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(radii + i)) };
+
+        __m256 isInside { _mm256_castsi256_ps(_mm256_set1_epi32(-1)) };
+
+        for (uint32_t plane { 0u }; plane < global_frustumPlaneCount; plane++) {
+            const __m256* p { planeValues + plane * 4u };
+            const __m256 distance {
+                _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(p[0], x), _mm256_mul_ps(p[1], y)),
+                    _mm256_add_ps(_mm256_mul_ps(p[2], z), p[3])
+                )
+            };
+            isInside = _mm256_and_ps(isInside, _mm256_cmp_ps(distance, negativeRadius, _CMP_GT_OQ));
+        }
+
+        const uint32_t mask { static_cast<uint32_t>(_mm256_movemask_ps(isInside)) };
+
+        for (uint32_t lane { 0u }; lane < 8u; lane++) {
+            visibleIndices[visibleCount] = i + lane;
+            visibleCount += (mask >> lane) & 1u;
+        }
+    }
+
+    return visibleCount + cullSpheresRangeScalar(planes, centersX, centersY, centersZ, radii, i, count, visibleIndices + visibleCount);
+}
+
+// Only needs AVX. Two columns of the result per iteration, the columns of lhs are repeated in both halves.
+BEIGE_SIMD_TARGET_AVX2 auto multiplyMatricesAvx2(const float* lhs, const float* rhs, float* result, const uint32_t count) -> void {
+    for (uint32_t i { 0u }; i < count; i++) {
+        const float* a { lhs + i * global_matrixSize };
+        const float* b { rhs + i * global_matrixSize };
+        float* r { result + i * global_matrixSize };
+
+        const __m256 a0 { _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 0u)) };
+        const __m256 a1 { _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4u)) };
+        const __m256 a2 { _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8u)) };
+        const __m256 a3 { _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12u)) };
+
+        for (uint32_t column { 0u }; column < 4u; column += 2u) {
+            // Shuffles work per 128 bit half, each half broadcasts an element of its own column.
+            const __m256 columns { _mm256_loadu_ps(b + column * 4u) };
+            const __m256 b0 { _mm256_shuffle_ps(columns, columns, _MM_SHUFFLE(0, 0, 0, 0)) };
+            const __m256 b1 { _mm256_shuffle_ps(columns, columns, _MM_SHUFFLE(1, 1, 1, 1)) };
+            const __m256 b2 { _mm256_shuffle_ps(columns, columns, _MM_SHUFFLE(2, 2, 2, 2)) };
+            const __m256 b3 { _mm256_shuffle_ps(columns, columns, _MM_SHUFFLE(3, 3, 3, 3)) };
+
+            _mm256_storeu_ps(
+                r + column * 4u,
+                _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(a0, b0), _mm256_mul_ps(a1, b1)),
+                    _mm256_add_ps(_mm256_mul_ps(a2, b2), _mm256_mul_ps(a3, b3))
+                )
+            );
+        }
+    }
+}
+
+// Only needs AVX. Two points per iteration, the columns of the matrix are repeated in both halves.
+BEIGE_SIMD_TARGET_AVX2 auto transformPointsAvx2(const float* matrix, const float* points, float* results, const uint32_t count) -> void {
+    const __m256 m0 { _mm256_broadcast_ps(reinterpret_cast<const __m128*>(matrix + 0u)) };
+    const __m256 m1 { _mm256_broadcast_ps(reinterpret_cast<const __m128*>(matrix + 4u)) };
+    const __m256 m2 { _mm256_broadcast_ps(reinterpret_cast<const __m128*>(matrix + 8u)) };
+    const __m256 m3 { _mm256_broadcast_ps(reinterpret_cast<const __m128*>(matrix + 12u)) };
+
+    uint32_t i { 0u };
+
+    for (; i + 2u <= count; i += 2u) {
+        const __m256 pointPair { _mm256_loadu_ps(points + i * 4u) };
+        const __m256 x { _mm256_shuffle_ps(pointPair, pointPair, _MM_SHUFFLE(0, 0, 0, 0)) };
+        const __m256 y { _mm256_shuffle_ps(pointPair, pointPair, _MM_SHUFFLE(1, 1, 1, 1)) };
+        const __m256 z { _mm256_shuffle_ps(pointPair, pointPair, _MM_SHUFFLE(2, 2, 2, 2)) };
+        const __m256 w { _mm256_shuffle_ps(pointPair, pointPair, _MM_SHUFFLE(3, 3, 3, 3)) };
+
+        _mm256_storeu_ps(
+            results + i * 4u,
+            _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(m0, x), _mm256_mul_ps(m1, y)),
+                _mm256_add_ps(_mm256_mul_ps(m2, z), _mm256_mul_ps(m3, w))
+            )
+        );
+    }
+
+    transformPointsRangeScalar(matrix, points, results, i, count);
+}
+
+// Only needs AVX. Eight spheres per iteration, spheres i and i + 4 share a register so that transposing each half
+// keeps the lanes in order.
+BEIGE_SIMD_TARGET_AVX2 auto cullPackedSpheresAvx2(
+    const float* planes,
+    const uint32_t planeCount,
+    const float* spheres,
+    const uint32_t count,
+    uint32_t* visibleIndices
+) -> uint32_t {
+    uint32_t visibleCount { 0u };
+    uint32_t i { 0u };
+
+    for (; i + 8u <= count; i += 8u) {
+        const float* s { spheres + i * 4u };
+        const __m256 s04 { _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(s + 0u)), _mm_loadu_ps(s + 16u), 1) };
+        const __m256 s15 { _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(s + 4u)), _mm_loadu_ps(s + 20u), 1) };
+        const __m256 s26 { _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(s + 8u)), _mm_loadu_ps(s + 24u), 1) };
+        const __m256 s37 { _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(s + 12u)), _mm_loadu_ps(s + 28u), 1) };
+
+        const __m256 xy01 { _mm256_unpacklo_ps(s04, s15) };
+        const __m256 zr01 { _mm256_unpackhi_ps(s04, s15) };
+        const __m256 xy23 { _mm256_unpacklo_ps(s26, s37) };
+        const __m256 zr23 { _mm256_unpackhi_ps(s26, s37) };
+
+        const __m256 x { _mm256_shuffle_ps(xy01, xy23, _MM_SHUFFLE(1, 0, 1, 0)) };
+        const __m256 y { _mm256_shuffle_ps(xy01, xy23, _MM_SHUFFLE(3, 2, 3, 2)) };
+        const __m256 z { _mm256_shuffle_ps(zr01, zr23, _MM_SHUFFLE(1, 0, 1, 0)) };
+        const __m256 negativeRadius { _mm256_sub_ps(_mm256_setzero_ps(), _mm256_shuffle_ps(zr01, zr23, _MM_SHUFFLE(3, 2, 3, 2))) };
+
+        __m256 isInside { _mm256_castsi256_ps(_mm256_set1_epi32(-1)) };
+
+        for (uint32_t plane { 0u }; plane < planeCount; plane++) {
+            const float* p { planes + plane * 4u };
+            const __m256 distance {
+                _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p[0]), x), _mm256_mul_ps(_mm256_set1_ps(p[1]), y)),
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p[2]), z), _mm256_set1_ps(p[3]))
+                )
+            };
+            isInside = _mm256_and_ps(isInside, _mm256_cmp_ps(distance, negativeRadius, _CMP_GT_OQ));
+        }
+
+        const uint32_t mask { static_cast<uint32_t>(_mm256_movemask_ps(isInside)) };
+
+        for (uint32_t lane { 0u }; lane < 8u; lane++) {
+            visibleIndices[visibleCount] = i + lane;
+            visibleCount += (mask >> lane) & 1u;
+        }
+    }
+
+    return visibleCount + cullPackedSpheresRangeScalar(planes, planeCount, spheres, i, count, visibleIndices + visibleCount);
+}
+#endif // BEIGE_SIMD_AVX2
+
+auto makeKernels(const Simd::Level level) -> Kernels {
+    Kernels kernels {
+        hasTransparencyScalar,  // hasTransparency
+        expandRgbToRgbaScalar,  // expandRgbToRgba
+        swapRowsScalar,         // swapRows
+        premultiplyAlphaScalar, // premultiplyAlpha
+        downsampleRowScalar,    // downsampleRow
+        cullSpheresScalar,      // cullSpheres
+        multiplyMatricesScalar, // multiplyMatrices
+        transformPointsScalar,  // transformPoints
+        cullPackedSpheresScalar // cullPackedSpheres
+    };
+
+#ifdef BEIGE_SIMD_SSE2
+    // SSE2 has no byte shuffle, RGB expansion stays scalar at this level.
+    if (level >= Simd::Level::Sse2) {
+        kernels.hasTransparency = hasTransparencySse2;
+        kernels.swapRows = swapRowsSse2;
+        kernels.premultiplyAlpha = premultiplyAlphaSse2;
+        kernels.downsampleRow = downsampleRowSse2;
+        kernels.cullSpheres = cullSpheresSse2;
+        kernels.multiplyMatrices = multiplyMatricesSse2;
+        kernels.transformPoints = transformPointsSse2;
+        kernels.cullPackedSpheres = cullPackedSpheresSse2;
+    }
+#endif // BEIGE_SIMD_SSE2
+
+#ifdef BEIGE_SIMD_AVX2
+    // Row swaps and downsampling are bound by memory bandwidth, the SSE2 versions already saturate it.
+    if (level >= Simd::Level::Avx2) {
+        kernels.hasTransparency = hasTransparencyAvx2;
+        kernels.expandRgbToRgba = expandRgbToRgbaAvx2;
+        kernels.premultiplyAlpha = premultiplyAlphaAvx2;
+        kernels.cullSpheres = cullSpheresAvx2;
+        kernels.multiplyMatrices = multiplyMatricesAvx2;
+        kernels.transformPoints = transformPointsAvx2;
+        kernels.cullPackedSpheres = cullPackedSpheresAvx2;
+    }
+#endif // BEIGE_SIMD_AVX2
+
+    return kernels;
+}
+
+auto detectLevel() -> Simd::Level {
+#ifdef BEIGE_SIMD_AVX2
+#if defined(_MSC_VER)
+    std::array<int32_t, 4u> info { };
+    __cpuid(info.data(), 0);
+
+    if (info.at(0) >= 7) {
+        __cpuid(info.data(), 1);
+        const bool hasOsxsave { (info.at(2) & (1 << 27)) != 0 };
+        const bool hasAvx { (info.at(2) & (1 << 28)) != 0 };
+
+        __cpuidex(info.data(), 7, 0);
+        const bool hasAvx2 { (info.at(1) & (1 << 5)) != 0 };
+
+        // The OS has to save the upper halves of the YMM registers too.
+        if (hasOsxsave && hasAvx && hasAvx2 && (_xgetbv(0) & 0x6u) == 0x6u) {
+            return Simd::Level::Avx2;
+        }
+    }
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return Simd::Level::Avx2;
+    }
+#endif // _MSC_VER
+#endif // BEIGE_SIMD_AVX2
+
+#ifdef BEIGE_SIMD_SSE2
+    return Simd::Level::Sse2;
+#else
+    return Simd::Level::Scalar;
+#endif // BEIGE_SIMD_SSE2
+}
+
+const Simd::Level global_supportedLevel { detectLevel() };
+Simd::Level global_level { global_supportedLevel };
+Kernels global_kernels { makeKernels(global_level) };
+
+} // namespace
+
+auto Simd::getLevel() -> Level {
+    return global_level;
+}
+
+auto Simd::setLevel(const Level level) -> void {
+    global_level = std::min(level, global_supportedLevel);
+    global_kernels = makeKernels(global_level);
+}
+
+auto Simd::getSupportedLevel() -> Level {
+    return global_supportedLevel;
+}
+
+auto Simd::getLevelName(const Level level) -> const char* {
+    switch (level) {
+    case Level::Scalar:
+        return "scalar";
+    case Level::Sse2:
+        return "SSE2";
+    case Level::Avx2:
+        return "AVX2";
+    }
+
+    return "unknown";
+}
+
+auto Simd::hasTransparency(const void* pixels, const uint64_t pixelCount) -> bool {
+    return global_kernels.hasTransparency(static_cast<const uint8_t*>(pixels), pixelCount);
+}
+
+auto Simd::expandRgbToRgba(const void* source, void* destination, const uint64_t pixelCount) -> void {
+    global_kernels.expandRgbToRgba(static_cast<const uint8_t*>(source), static_cast<uint8_t*>(destination), pixelCount);
+}
+
+auto Simd::flipVertically(void* pixels, const uint64_t rowSize, const uint32_t rowCount) -> void {
+    uint8_t* rows { static_cast<uint8_t*>(pixels) };
+
+    for (uint32_t row { 0u }; row < rowCount / 2u; row++) {
+        global_kernels.swapRows(rows + row * rowSize, rows + (rowCount - 1u - row) * rowSize, rowSize);
+    }
+}
+
+auto Simd::premultiplyAlpha(void* pixels, const uint64_t pixelCount) -> void {
+    global_kernels.premultiplyAlpha(static_cast<uint8_t*>(pixels), pixelCount);
+}
+
+auto Simd::downsampleBox(
+    const void* source,
+    const uint32_t sourceWidth,
+    const uint32_t sourceHeight,
+    void* destination
+) -> void {
+    const uint32_t destinationWidth { std::max(sourceWidth / 2u, 1u) };
+    const uint32_t destinationHeight { std::max(sourceHeight / 2u, 1u) };
+    const uint8_t* sourcePixels { static_cast<const uint8_t*>(source) };
+    uint8_t* destinationPixels { static_cast<uint8_t*>(destination) };
+
+    for (uint32_t y { 0u }; y < destinationHeight; y++) {
+        // Odd dimensions clamp to the last row/column.
+        const uint8_t* sourceRow0 { sourcePixels + static_cast<uint64_t>(std::min(y * 2u, sourceHeight - 1u)) * sourceWidth * 4u };
+        const uint8_t* sourceRow1 { sourcePixels + static_cast<uint64_t>(std::min(y * 2u + 1u, sourceHeight - 1u)) * sourceWidth * 4u };
+        uint8_t* destinationRow { destinationPixels + static_cast<uint64_t>(y) * destinationWidth * 4u };
+
+        // Pixels with both source columns in bounds go through the kernel, only a width of one is left over.
+        const uint32_t pairedWidth { sourceWidth / 2u };
+        global_kernels.downsampleRow(sourceRow0, sourceRow1, destinationRow, pairedWidth);
+
+        for (uint32_t x { pairedWidth }; x < destinationWidth; x++) {
+            const uint32_t x0 { std::min(x * 2u, sourceWidth - 1u) * 4u };
+            const uint32_t x1 { std::min(x * 2u + 1u, sourceWidth - 1u) * 4u };
+
+            for (uint32_t c { 0u }; c < 4u; c++) {
+                const uint32_t sum {
+                    static_cast<uint32_t>(sourceRow0[x0 + c]) + sourceRow0[x1 + c] +
+                    sourceRow1[x0 + c] + sourceRow1[x1 + c]
+                };
+                destinationRow[x * 4u + c] = static_cast<uint8_t>((sum + 2u) >> 2u);
+            }
+        }
+    }
+}
+
+auto Simd::cullSpheres(
+    const float* planes,
+    const float* centersX,
+    const float* centersY,
+    const float* centersZ,
+    const float* radii,
+    const uint32_t count,
+    uint32_t* visibleIndices
+) -> uint32_t {
+    return global_kernels.cullSpheres(planes, centersX, centersY, centersZ, radii, count, visibleIndices);
+}
+
+auto Simd::multiplyMatrices(const float* lhs, const float* rhs, float* result, const uint32_t count) -> void {
+    global_kernels.multiplyMatrices(lhs, rhs, result, count);
+}
+
+auto Simd::transformPoints(const float* matrix, const float* points, float* results, const uint32_t count) -> void {
+    global_kernels.transformPoints(matrix, points, results, count);
+}
+
+auto Simd::cullPackedSpheres(
+    const float* planes,
+    const uint32_t planeCount,
+    const float* spheres,
+    const uint32_t count,
+    uint32_t* visibleIndices
+) -> uint32_t {
+    return global_kernels.cullPackedSpheres(planes, planeCount, spheres, count, visibleIndices);
+}
+
+} // namespace math
+} // namespace beige
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdint>
+
+namespace beige {
+namespace math {
+
+/**
+ * Kernels for the texture load path, the renderer and the batch operations of the simd math types. Every kernel has
+ * a scalar, an SSE2 and, where it pays off, an AVX2 version; the widest one the CPU supports is picked once at runtime.
+ */
+class Simd final {
+public:
+    enum class Level : uint32_t {
+        Scalar = 0u,
+        Sse2 = 1u,
+        Avx2 = 2u
+    };
+
+    Simd() = delete;
+    ~Simd() = delete;
+
+    /**
+     * @returns The instruction set the kernels currently run with.
+     */
+    static auto getLevel() -> Level;
+
+    /**
+     * Forces the kernels down to a narrower instruction set, used to compare the versions against each other.
+     * @param level The level to use, clamped to the widest one the CPU supports.
+     */
+    static auto setLevel(const Level level) -> void;
+    static auto getSupportedLevel() -> Level;
+    static auto getLevelName(const Level level) -> const char*;
+
+    /**
+     * Indicates if any pixel of an RGBA8 image has an alpha below 255.
+     * @param pixels The tightly packed RGBA8 pixels.
+     * @param pixelCount The number of pixels.
+     * @returns True if the image is not fully opaque.
+     */
+    static auto hasTransparency(const void* pixels, const uint64_t pixelCount) -> bool;
+
+    /**
+     * Expands RGB8 pixels to RGBA8 with an opaque alpha.
+     * @param source The tightly packed RGB8 pixels.
+     * @param destination The RGBA8 pixels to write, must not overlap the source.
+     * @param pixelCount The number of pixels.
+     */
+    static auto expandRgbToRgba(const void* source, void* destination, const uint64_t pixelCount) -> void;
+
+    /**
+     * Flips an image upside down in place.
+     * @param pixels The tightly packed rows.
+     * @param rowSize The size of a row in bytes.
+     * @param rowCount The number of rows.
+     */
+    static auto flipVertically(void* pixels, const uint64_t rowSize, const uint32_t rowCount) -> void;
+
+    /**
+     * Multiplies the color channels of RGBA8 pixels with their alpha in place, rounded to nearest.
+     * @param pixels The tightly packed RGBA8 pixels.
+     * @param pixelCount The number of pixels.
+     */
+    static auto premultiplyAlpha(void* pixels, const uint64_t pixelCount) -> void;
+
+    /**
+     * Halves an RGBA8 image with a 2x2 box filter, rounded to nearest. Odd dimensions clamp to the last row/column.
+     * @param source The tightly packed RGBA8 source pixels.
+     * @param sourceWidth The width of the source.
+     * @param sourceHeight The height of the source.
+     * @param destination The destination pixels, max(width / 2, 1) by max(height / 2, 1).
+     */
+    static auto downsampleBox(
+        const void* source,
+        const uint32_t sourceWidth,
+        const uint32_t sourceHeight,
+        void* destination
+    ) -> void;
+
+    /**
+     * Tests bounding spheres, stored as separate arrays, against the planes of a view frustum.
+     * @param planes Six planes as a, b, c and d each, with normals pointing into the frustum.
+     * @param centersX The x coordinates of the sphere centers, likewise for centersY and centersZ.
+     * @param radii The radii of the spheres.
+     * @param count The number of spheres.
+     * @param visibleIndices Receives the indices of the spheres at least partly inside, room for count of them.
+     * @returns The number of spheres at least partly inside.
+     */
+    static auto cullSpheres(
+        const float* planes,
+        const float* centersX,
+        const float* centersY,
+        const float* centersZ,
+        const float* radii,
+        const uint32_t count,
+        uint32_t* visibleIndices
+    ) -> uint32_t;
+
+    /**
+     * Multiplies pairs of column-major 4x4 matrices, result = lhs * rhs for each pair.
+     * @param lhs The left matrices, 16 floats each.
+     * @param rhs The right matrices.
+     * @param result Receives the products, must not overlap the inputs.
+     * @param count The number of pairs.
+     */
+    static auto multiplyMatrices(const float* lhs, const float* rhs, float* result, const uint32_t count) -> void;
+
+    /**
+     * Transforms points by a column-major 4x4 matrix, directions with a w of 0 are only rotated and scaled.
+     * @param matrix The matrix, 16 floats.
+     * @param points The points as x, y, z and w each.
+     * @param results Receives the transformed points, may be the points themselves.
+     * @param count The number of points.
+     */
+    static auto transformPoints(const float* matrix, const float* points, float* results, const uint32_t count) -> void;
+
+    /**
+     * Tests bounding spheres, stored as center and radius each, against any number of planes.
+     * @param planes The planes as a, b, c and d each, with normals pointing to the side the spheres are kept on.
+     * @param planeCount The number of planes.
+     * @param spheres The spheres as x, y, z and radius each.
+     * @param count The number of spheres.
+     * @param visibleIndices Receives the indices of the spheres at least partly inside every plane, room for count of them.
+     * @returns The number of spheres at least partly inside every plane.
+     */
+    static auto cullPackedSpheres(
+        const float* planes,
+        const uint32_t planeCount,
+        const float* spheres,
+        const uint32_t count,
+        uint32_t* visibleIndices
+    ) -> uint32_t;
+};
+
+} // namespace math
+} // namespace beige
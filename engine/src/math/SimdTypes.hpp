@@ -0,0 +1,253 @@
+#pragma once
+
+#include "Simd.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BEIGE_SIMD_SSE2
+#endif // SSE2
+
+// MSVC has no macro for SSE4.1 alone, building with /arch:AVX implies it.
+#if defined(BEIGE_SIMD_SSE2) && (defined(__SSE4_1__) || defined(__AVX__))
+#include <smmintrin.h>
+#define BEIGE_SIMD_SSE41
+#endif // SSE4.1
+
+namespace beige {
+namespace math {
+namespace simd {
+
+/**
+ * Laid out like glm::vec4 but aligned for whole register loads. Single values are operated on inline, arrays of
+ * them through the batch functions below, which run the widest kernels the CPU supports.
+ */
+struct alignas(16) Vec4 {
+    float x;
+    float y;
+    float z;
+    float w;
+};
+
+// Column-major, like glm.
+struct alignas(16) Mat4 {
+    std::array<Vec4, 4u> columns;
+};
+
+struct alignas(16) Quat {
+    float x;
+    float y;
+    float z;
+    float w;
+};
+
+static_assert(sizeof(Vec4) == 4u * sizeof(float), "The batch kernels read vectors as tightly packed floats!");
+static_assert(sizeof(Mat4) == 16u * sizeof(float), "The batch kernels read matrices as tightly packed floats!");
+
+// Conversions are explicit so glm values only cross into the hot paths where it is intended.
+inline auto fromGlm(const glm::vec4& value) -> Vec4 {
+    return Vec4 { value.x, value.y, value.z, value.w };
+}
+
+inline auto fromGlm(const glm::vec3& value, const float w) -> Vec4 {
+    return Vec4 { value.x, value.y, value.z, w };
+}
+
+inline auto fromGlm(const glm::mat4x4& value) -> Mat4 {
+    return Mat4 { { fromGlm(value[0]), fromGlm(value[1]), fromGlm(value[2]), fromGlm(value[3]) } };
+}
+
+inline auto fromGlm(const glm::quat& value) -> Quat {
+    return Quat { value.x, value.y, value.z, value.w };
+}
+
+inline auto toGlm(const Vec4& value) -> glm::vec4 {
+    return glm::vec4(value.x, value.y, value.z, value.w);
+}
+
+inline auto toGlm(const Mat4& value) -> glm::mat4x4 {
+    return glm::mat4x4(
+        toGlm(value.columns[0]),
+        toGlm(value.columns[1]),
+        toGlm(value.columns[2]),
+        toGlm(value.columns[3])
+    );
+}
+
+inline auto toGlm(const Quat& value) -> glm::quat {
+    return glm::quat(value.w, value.x, value.y, value.z);
+}
+
+#ifdef BEIGE_SIMD_SSE2
+inline auto load(const Vec4& value) -> __m128 {
+    return _mm_load_ps(&value.x);
+}
+
+inline auto store(const __m128 value) -> Vec4 {
+    Vec4 result;
+    _mm_store_ps(&result.x, value);
+    return result;
+}
+#endif // BEIGE_SIMD_SSE2
+
+inline auto operator+(const Vec4& lhs, const Vec4& rhs) -> Vec4 {
+#ifdef BEIGE_SIMD_SSE2
+    return store(_mm_add_ps(load(lhs), load(rhs)));
+#else
+    return Vec4 { lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w };
+#endif // BEIGE_SIMD_SSE2
+}
+
+inline auto operator-(const Vec4& lhs, const Vec4& rhs) -> Vec4 {
+#ifdef BEIGE_SIMD_SSE2
+    return store(_mm_sub_ps(load(lhs), load(rhs)));
+#else
+    return Vec4 { lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w };
+#endif // BEIGE_SIMD_SSE2
+}
+
+inline auto operator*(const Vec4& lhs, const float rhs) -> Vec4 {
+#ifdef BEIGE_SIMD_SSE2
+    return store(_mm_mul_ps(load(lhs), _mm_set1_ps(rhs)));
+#else
+    return Vec4 { lhs.x * rhs, lhs.y * rhs, lhs.z * rhs, lhs.w * rhs };
+#endif // BEIGE_SIMD_SSE2
+}
+
+inline auto dot(const Vec4& lhs, const Vec4& rhs) -> float {
+#if defined(BEIGE_SIMD_SSE41)
+    return _mm_cvtss_f32(_mm_dp_ps(load(lhs), load(rhs), 0xF1));
+#elif defined(BEIGE_SIMD_SSE2)
+    const __m128 product { _mm_mul_ps(load(lhs), load(rhs)) };
+    const __m128 pairs { _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1))) };
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_movehl_ps(pairs, pairs)));
+#else
+    return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z + lhs.w * rhs.w;
+#endif // BEIGE_SIMD_SSE41
+}
+
+// Of the xyz parts, w of the result is 0.
+inline auto cross(const Vec4& lhs, const Vec4& rhs) -> Vec4 {
+#ifdef BEIGE_SIMD_SSE2
+    const __m128 a { load(lhs) };
+    const __m128 b { load(rhs) };
+    const __m128 aYzx { _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)) };
+    const __m128 bYzx { _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1)) };
+    const __m128 result { _mm_sub_ps(_mm_mul_ps(a, bYzx), _mm_mul_ps(aYzx, b)) };
+    return store(_mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 0, 2, 1)));
+#else
+    return Vec4 { lhs.y * rhs.z - lhs.z * rhs.y, lhs.z * rhs.x - lhs.x * rhs.z, lhs.x * rhs.y - lhs.y * rhs.x, 0.0f };
+#endif // BEIGE_SIMD_SSE2
+}
+
+inline auto operator*(const Mat4& lhs, const Vec4& rhs) -> Vec4 {
+#ifdef BEIGE_SIMD_SSE2
+    const __m128 value { load(rhs) };
+    const __m128 x { _mm_mul_ps(load(lhs.columns[0]), _mm_shuffle_ps(value, value, _MM_SHUFFLE(0, 0, 0, 0))) };
+    const __m128 y { _mm_mul_ps(load(lhs.columns[1]), _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 1, 1, 1))) };
+    const __m128 z { _mm_mul_ps(load(lhs.columns[2]), _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 2, 2, 2))) };
+    const __m128 w { _mm_mul_ps(load(lhs.columns[3]), _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 3))) };
+    return store(_mm_add_ps(_mm_add_ps(x, y), _mm_add_ps(z, w)));
+#else
+    return lhs.columns[0] * rhs.x + lhs.columns[1] * rhs.y + lhs.columns[2] * rhs.z + lhs.columns[3] * rhs.w;
+#endif // BEIGE_SIMD_SSE2
+}
+
+inline auto operator*(const Mat4& lhs, const Mat4& rhs) -> Mat4 {
+    return Mat4 { { lhs * rhs.columns[0], lhs * rhs.columns[1], lhs * rhs.columns[2], lhs * rhs.columns[3] } };
+}
+
+// Applies rhs first, like glm.
+inline auto operator*(const Quat& lhs, const Quat& rhs) -> Quat {
+    return Quat {
+        lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y, // x
+        lhs.w * rhs.y + lhs.y * rhs.w + lhs.z * rhs.x - lhs.x * rhs.z, // y
+        lhs.w * rhs.z + lhs.z * rhs.w + lhs.x * rhs.y - lhs.y * rhs.x, // z
+        lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z  // w
+    };
+}
+
+inline auto normalize(const Quat& value) -> Quat {
+    const float inverseLength {
+        1.0f / std::sqrt(value.x * value.x + value.y * value.y + value.z * value.z + value.w * value.w)
+    };
+
+    return Quat { value.x * inverseLength, value.y * inverseLength, value.z * inverseLength, value.w * inverseLength };
+}
+
+/**
+ * Rotates the xyz part by a unit quaternion, w is kept.
+ */
+inline auto rotate(const Quat& rotation, const Vec4& value) -> Vec4 {
+    // v + 2w(q x v) + 2q x (q x v), with the cross products on the vector part of q.
+    const Vec4 axis { rotation.x, rotation.y, rotation.z, 0.0f };
+    const Vec4 t { cross(axis, value) * 2.0f };
+    const Vec4 result { value + t * rotation.w + cross(axis, t) };
+
+    return Vec4 { result.x, result.y, result.z, value.w };
+}
+
+/**
+ * @returns The rotation matrix of a unit quaternion.
+ */
+inline auto toMatrix(const Quat& rotation) -> Mat4 {
+    const float xx { rotation.x * rotation.x };
+    const float yy { rotation.y * rotation.y };
+    const float zz { rotation.z * rotation.z };
+    const float xy { rotation.x * rotation.y };
+    const float xz { rotation.x * rotation.z };
+    const float yz { rotation.y * rotation.z };
+    const float wx { rotation.w * rotation.x };
+    const float wy { rotation.w * rotation.y };
+    const float wz { rotation.w * rotation.z };
+
+    return Mat4 {
+        {
+            Vec4 { 1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f },
+            Vec4 { 2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f },
+            Vec4 { 2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f },
+            Vec4 { 0.0f, 0.0f, 0.0f, 1.0f }
+        }
+    };
+}
+
+/**
+ * Transforms points, two per AVX register.
+ * @param results Receives the transformed points, may be the points themselves.
+ */
+inline auto transformPoints(const Mat4& matrix, const Vec4* points, Vec4* results, const uint32_t count) -> void {
+    Simd::transformPoints(&matrix.columns[0].x, &points->x, &results->x, count);
+}
+
+/**
+ * Multiplies pairs of matrices, results[i] = lhs[i] * rhs[i].
+ * @param results Receives the products, must not overlap the inputs.
+ */
+inline auto multiplyMatrices(const Mat4* lhs, const Mat4* rhs, Mat4* results, const uint32_t count) -> void {
+    Simd::multiplyMatrices(&lhs->columns[0].x, &rhs->columns[0].x, &results->columns[0].x, count);
+}
+
+/**
+ * Tests spheres, stored as center and radius, against planes, eight per AVX register.
+ * @param visibleIndices Receives the indices of the spheres at least partly inside every plane, room for count of them.
+ * @returns The number of spheres at least partly inside every plane.
+ */
+inline auto cullSpheres(
+    const Vec4* planes,
+    const uint32_t planeCount,
+    const Vec4* spheres,
+    const uint32_t count,
+    uint32_t* visibleIndices
+) -> uint32_t {
+    return Simd::cullPackedSpheres(&planes->x, planeCount, &spheres->x, count, visibleIndices);
+}
+
+} // namespace simd
+} // namespace math
+} // namespace beige
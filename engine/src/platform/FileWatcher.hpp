@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../Defines.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef BEIGE_PLATFORM_WIN32
+#include <windows.h>
+#endif // BEIGE_PLATFORM_WIN32
+
+namespace beige {
+namespace platform {
+
+/**
+ * Watches a directory tree for written files without blocking or a thread of its own.
+ * A file is reported once it has been quiet for a moment, editors and build tools tend to write it several times.
+ */
+class FileWatcher final {
+public:
+    FileWatcher(const std::string& path);
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    auto operator=(const FileWatcher&) -> FileWatcher& = delete;
+
+    auto isWatching() const -> bool;
+
+    /**
+     * Collects the changes the OS reported since the last call, meant to be called once per frame.
+     * @returns The paths of the files written since, relative to the watched directory with '/' separators.
+     */
+    auto poll() -> std::vector<std::string>;
+
+private:
+    static constexpr std::chrono::milliseconds m_settleTime { 100 };
+
+    std::string m_path;
+
+    // Paths reported by the OS and when they were last written.
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> m_pendingChanges;
+
+#ifdef BEIGE_PLATFORM_WIN32
+    HANDLE m_directory;
+    OVERLAPPED m_overlapped;
+    std::vector<DWORD> m_buffer; // ReadDirectoryChangesW needs a DWORD aligned buffer.
+
+    auto issueRead() -> bool;
+#endif // BEIGE_PLATFORM_WIN32
+};
+
+} // namespace platform
+} // namespace beige
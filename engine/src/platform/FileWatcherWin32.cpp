@@ -0,0 +1,157 @@
+#include "FileWatcher.hpp"
+
+#include "../core/Logger.hpp"
+
+#include <algorithm>
+
+#ifdef BEIGE_PLATFORM_WIN32
+
+namespace beige {
+namespace platform {
+
+namespace {
+
+// 64 KiB is the most ReadDirectoryChangesW accepts for network shares.
+constexpr std::size_t global_bufferSize { 64u * 1024u };
+
+} // namespace
+
+FileWatcher::FileWatcher(const std::string& path) :
+m_path { path },
+m_pendingChanges { },
+m_directory { INVALID_HANDLE_VALUE },
+m_overlapped { },
+m_buffer(global_bufferSize / sizeof(DWORD), 0u) {
+    m_directory = CreateFileA(
+        path.c_str(),
+        FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+        nullptr
+    );
+
+    if (m_directory == INVALID_HANDLE_VALUE) {
+        core::Logger::warn("Unable to watch directory " + path + "!");
+        return;
+    }
+
+    m_overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+
+    if (m_overlapped.hEvent == nullptr || !issueRead()) {
+        core::Logger::warn("Unable to watch directory " + path + "!");
+        return;
+    }
+
+    core::Logger::info("Watching directory " + path + " for changes.");
+}
+
+FileWatcher::~FileWatcher() {
+    if (m_directory != INVALID_HANDLE_VALUE) {
+        // The pending read writes into the buffer, it has to be finished before the buffer goes away.
+        if (CancelIoEx(m_directory, &m_overlapped)) {
+            DWORD transferredSize { 0u };
+            GetOverlappedResult(m_directory, &m_overlapped, &transferredSize, TRUE);
+        }
+
+        CloseHandle(m_directory);
+    }
+
+    if (m_overlapped.hEvent != nullptr) {
+        CloseHandle(m_overlapped.hEvent);
+    }
+}
+
+auto FileWatcher::isWatching() const -> bool {
+    return m_directory != INVALID_HANDLE_VALUE && m_overlapped.hEvent != nullptr;
+}
+
+auto FileWatcher::poll() -> std::vector<std::string> {
+    std::vector<std::string> changedPaths;
+
+    if (!isWatching()) {
+        return changedPaths;
+    }
+
+    const std::chrono::steady_clock::time_point now { std::chrono::steady_clock::now() };
+    DWORD transferredSize { 0u };
+
+    if (GetOverlappedResult(m_directory, &m_overlapped, &transferredSize, FALSE)) {
+        if (transferredSize == 0u) {
+            core::Logger::warn("Too many changes in " + m_path + " at once, some were missed!");
+        }
+
+        const std::byte* notification { reinterpret_cast<const std::byte*>(m_buffer.data()) };
+
+        while (transferredSize != 0u) {
+            const FILE_NOTIFY_INFORMATION* information { reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(notification) };
+
+            if (
+                information->Action == FILE_ACTION_ADDED ||
+                information->Action == FILE_ACTION_MODIFIED ||
+                information->Action == FILE_ACTION_RENAMED_NEW_NAME
+            ) {
+                const int32_t nameLength { static_cast<int32_t>(information->FileNameLength / sizeof(WCHAR)) };
+                const int32_t pathSize {
+                    WideCharToMultiByte(CP_UTF8, 0u, information->FileName, nameLength, nullptr, 0, nullptr, nullptr)
+                };
+
+                std::string path(static_cast<std::size_t>(pathSize), '\0');
+                WideCharToMultiByte(CP_UTF8, 0u, information->FileName, nameLength, path.data(), pathSize, nullptr, nullptr);
+                std::replace(path.begin(), path.end(), '\\', '/');
+
+                m_pendingChanges[path] = now;
+            }
+
+            if (information->NextEntryOffset == 0u) {
+                break;
+            }
+
+            notification += information->NextEntryOffset;
+        }
+
+        if (!issueRead()) {
+            core::Logger::warn("Stopped watching directory " + m_path + "!");
+            CloseHandle(m_directory);
+            m_directory = INVALID_HANDLE_VALUE;
+        }
+    }
+    else if (GetLastError() != ERROR_IO_INCOMPLETE) {
+        core::Logger::warn("Stopped watching directory " + m_path + "!");
+        CloseHandle(m_directory);
+        m_directory = INVALID_HANDLE_VALUE;
+    }
+
+    for (auto pendingChange { m_pendingChanges.begin() }; pendingChange != m_pendingChanges.end();) {
+        if (now - pendingChange->second < m_settleTime) {
+            pendingChange++;
+            continue;
+        }
+
+        changedPaths.push_back(pendingChange->first);
+        pendingChange = m_pendingChanges.erase(pendingChange);
+    }
+
+    std::sort(changedPaths.begin(), changedPaths.end());
+
+    return changedPaths;
+}
+
+auto FileWatcher::issueRead() -> bool {
+    return ReadDirectoryChangesW(
+        m_directory,
+        m_buffer.data(),
+        static_cast<DWORD>(m_buffer.size() * sizeof(DWORD)),
+        TRUE,
+        FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE,
+        nullptr,
+        &m_overlapped,
+        nullptr
+    ) != FALSE;
+}
+
+} // namespace platform
+} // namespace beige
+
+#endif // BEIGE_PLATFORM_WIN32
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../Defines.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+#ifdef BEIGE_PLATFORM_WIN32
+#include <windows.h>
+#endif // BEIGE_PLATFORM_WIN32
+
+namespace beige {
+namespace platform {
+
+/**
+ * Read-only view of a whole file mapped into the address space.
+ * Pages are faulted in by the OS on first access, nothing is copied up front.
+ */
+class MappedFile final {
+public:
+    MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+    auto isOpen() const -> bool;
+    auto getData() const -> const std::byte*;
+    auto getSize() const -> uint64_t;
+
+    /**
+     * Hints the OS to read a range of the file in ahead of use, in one large read instead of a fault per page.
+     * Only a hint, the call returns right away and failures are ignored.
+     * @param offset The start of the range.
+     * @param size The size of the range, clamped to the end of the file.
+     */
+    auto prefetch(const uint64_t offset, const uint64_t size) const -> void;
+
+private:
+    const std::byte* m_data;
+    uint64_t m_size;
+
+#ifdef BEIGE_PLATFORM_WIN32
+    HANDLE m_file;
+    HANDLE m_mapping;
+#endif // BEIGE_PLATFORM_WIN32
+};
+
+} // namespace platform
+} // namespace beige
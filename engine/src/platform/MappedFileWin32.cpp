@@ -0,0 +1,89 @@
+#include "MappedFile.hpp"
+
+#ifdef BEIGE_PLATFORM_WIN32
+
+namespace beige {
+namespace platform {
+
+MappedFile::MappedFile(const std::string& path) :
+m_data { nullptr },
+m_size { 0u },
+m_file { INVALID_HANDLE_VALUE },
+m_mapping { nullptr } {
+    m_file = CreateFileA(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr
+    );
+
+    if (m_file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(m_file, &fileSize) || fileSize.QuadPart == 0) {
+        return;
+    }
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+
+    if (m_mapping == nullptr) {
+        return;
+    }
+
+    m_data = static_cast<const std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0u, 0u, 0u));
+
+    if (m_data != nullptr) {
+        m_size = static_cast<uint64_t>(fileSize.QuadPart);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+
+    if (m_mapping != nullptr) {
+        CloseHandle(m_mapping);
+    }
+
+    if (m_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_file);
+    }
+}
+
+auto MappedFile::isOpen() const -> bool {
+    return m_data != nullptr;
+}
+
+auto MappedFile::getData() const -> const std::byte* {
+    return m_data;
+}
+
+auto MappedFile::getSize() const -> uint64_t {
+    return m_size;
+}
+
+auto MappedFile::prefetch(const uint64_t offset, const uint64_t size) const -> void {
+    if (m_data == nullptr || offset >= m_size) {
+        return;
+    }
+
+    const uint64_t remainingSize { m_size - offset };
+
+    WIN32_MEMORY_RANGE_ENTRY range {
+        const_cast<std::byte*>(m_data + offset),                         // VirtualAddress
+        static_cast<SIZE_T>(size < remainingSize ? size : remainingSize) // NumberOfBytes
+    };
+
+    PrefetchVirtualMemory(GetCurrentProcess(), 1u, &range, 0u);
+}
+
+} // namespace platform
+} // namespace beige
+
+#endif // BEIGE_PLATFORM_WIN32
@@ -169,7 +169,16 @@ auto Platform::processMessage(HWND hwnd, uint32_t message, WPARAM wParam, LPARAM
     }
     case WM_CLOSE: {
         // TODO: Fire an event for the application to quit
-        m_input->processKey(core::Key::Escape, true);
+        m_input->pushEvent(
+            core::InputEvent {
+                getAbsoluteTime(),                        // time
+                core::InputEventType::Key,                // type
+                static_cast<uint32_t>(core::Key::Escape), // code
+                0,                                        // x
+                0,                                        // y
+                true                                      // isPressed
+            }
+        );
         return 0;
     }
     case WM_DESTROY: {
@@ -190,13 +199,31 @@ auto Platform::processMessage(HWND hwnd, uint32_t message, WPARAM wParam, LPARAM
     case WM_SYSKEYUP: {
         const core::Key key { static_cast<core::Key>(wParam) };
         const bool isPressed { message == WM_KEYDOWN || message == WM_SYSKEYDOWN };
-        m_input->processKey(key, isPressed);
+        m_input->pushEvent(
+            core::InputEvent {
+                getAbsoluteTime(),          // time
+                core::InputEventType::Key,  // type
+                static_cast<uint32_t>(key), // code
+                0,                          // x
+                0,                          // y
+                isPressed                   // isPressed
+            }
+        );
         break;
     }
     case WM_MOUSEMOVE: {
         const int32_t xPosition { static_cast<int32_t>(GET_X_LPARAM(lParam)) };
         const int32_t yPosition { static_cast<int32_t>(GET_Y_LPARAM(lParam)) };
-        m_input->processMouseMove(xPosition, yPosition);
+        m_input->pushEvent(
+            core::InputEvent {
+                getAbsoluteTime(),               // time
+                core::InputEventType::MouseMove, // type
+                0u,                              // code
+                xPosition,                       // x
+                yPosition,                       // y
+                false                            // isPressed
+            }
+        );
         break;
     }
     case WM_MOUSEWHEEL: {
@@ -204,7 +231,16 @@ auto Platform::processMessage(HWND hwnd, uint32_t message, WPARAM wParam, LPARAM
         if (zDelta != 0) {
             zDelta = (zDelta < 0) ? -1 : 1;
         }
-        m_input->processMouseWheel(zDelta);
+        m_input->pushEvent(
+            core::InputEvent {
+                getAbsoluteTime(),                // time
+                core::InputEventType::MouseWheel, // type
+                0u,                               // code
+                zDelta,                           // x
+                0,                                // y
+                false                             // isPressed
+            }
+        );
         break;
     }
     case WM_LBUTTONDOWN: [[fallthrough]];
@@ -235,7 +271,16 @@ auto Platform::processMessage(HWND hwnd, uint32_t message, WPARAM wParam, LPARAM
         }
 
         if (button != core::Button::Invalid) {
-            m_input->processButton(button, isPressed);
+            m_input->pushEvent(
+                core::InputEvent {
+                    getAbsoluteTime(),             // time
+                    core::InputEventType::Button,  // type
+                    static_cast<uint32_t>(button), // code
+                    0,                             // x
+                    0,                             // y
+                    isPressed                      // isPressed
+                }
+            );
         }
         break;
     }
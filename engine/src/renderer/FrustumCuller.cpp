@@ -0,0 +1,136 @@
+#include "FrustumCuller.hpp"
+
+#include "../math/Simd.hpp"
+
+#include <chrono>
+#include <cmath>
+
+namespace beige {
+namespace renderer {
+
+FrustumCuller::FrustumCuller(std::shared_ptr<core::JobSystem> jobSystem) :
+m_jobSystem { jobSystem },
+m_centersX { },
+m_centersY { },
+m_centersZ { },
+m_radii { },
+m_visibleIndices { },
+m_chunkVisibleCounts { } {
+
+}
+
+FrustumCuller::~FrustumCuller() {
+
+}
+
+auto FrustumCuller::cull(
+    const std::array<float, 24u>& planes,
+    const std::vector<GeometryRenderData>& geometries,
+    const LodSelector& lodSelector,
+    std::vector<uint32_t>& visibleGeometries
+) -> CullingStats {
+    const std::chrono::steady_clock::time_point start { std::chrono::steady_clock::now() };
+
+    const uint32_t count { static_cast<uint32_t>(geometries.size()) };
+    const uint32_t chunkCount { (count + m_chunkSize - 1u) / m_chunkSize };
+
+    // Only ever grows, so steady scenes cull without allocating.
+    if (m_radii.size() < count) {
+        m_centersX.resize(count);
+        m_centersY.resize(count);
+        m_centersZ.resize(count);
+        m_radii.resize(count);
+        m_visibleIndices.resize(count);
+    }
+
+    if (m_chunkVisibleCounts.size() < chunkCount) {
+        m_chunkVisibleCounts.resize(chunkCount);
+    }
+
+    m_jobSystem->parallelFor(count, m_chunkSize, [&](const uint32_t begin, const uint32_t end) {
+        for (uint32_t i { begin }; i < end; i++) {
+            const GeometryRenderData& geometry { geometries.at(i) };
+            const glm::vec4 boundingSphere { lodSelector.getBoundingSphere(geometry.geometry, geometry.model) };
+
+            m_centersX[i] = boundingSphere.x;
+            m_centersY[i] = boundingSphere.y;
+            m_centersZ[i] = boundingSphere.z;
+            m_radii[i] = boundingSphere.w;
+        }
+
+        uint32_t* visibleIndices { m_visibleIndices.data() + begin };
+
+        const uint32_t visibleCount {
+            math::Simd::cullSpheres(
+                planes.data(),
+                m_centersX.data() + begin,
+                m_centersY.data() + begin,
+                m_centersZ.data() + begin,
+                m_radii.data() + begin,
+                end - begin,
+                visibleIndices
+            )
+        };
+
+        // The kernel counts from the start of the arrays it was given.
+        for (uint32_t i { 0u }; i < visibleCount; i++) {
+            visibleIndices[i] += begin;
+        }
+
+        m_chunkVisibleCounts[begin / m_chunkSize] = visibleCount;
+    });
+
+    visibleGeometries.clear();
+
+    for (uint32_t chunk { 0u }; chunk < chunkCount; chunk++) {
+        const uint32_t* visibleIndices { m_visibleIndices.data() + chunk * m_chunkSize };
+        visibleGeometries.insert(visibleGeometries.end(), visibleIndices, visibleIndices + m_chunkVisibleCounts[chunk]);
+    }
+
+    const std::chrono::duration<float, std::milli> elapsed { std::chrono::steady_clock::now() - start };
+
+    const CullingStats stats {
+        count,                                           // objectCount
+        static_cast<uint32_t>(visibleGeometries.size()), // visibleCount
+        elapsed.count(),                                 // cullTime
+        0u                                               // instanceCount
+    };
+
+    return stats;
+}
+
+auto FrustumCuller::extractPlanes(const glm::mat4x4& viewProjection) -> std::array<float, 24u> {
+    // glm stores columns, so row i of the matrix is element i of every column.
+    const auto row = [&viewProjection](const uint32_t i) -> glm::vec4 {
+        return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+    };
+
+    // The projection maps depth to [0, 1] with reverse-Z, so the near plane is z <= w and the far plane z >= 0.
+    const std::array<glm::vec4, 6u> frustumPlanes {
+        row(3u) + row(0u), // Left
+        row(3u) - row(0u), // Right
+        row(3u) + row(1u), // Bottom
+        row(3u) - row(1u), // Top
+        row(3u) - row(2u), // Near
+        row(2u)            // Far
+    };
+
+    std::array<float, 24u> planes { };
+
+    for (uint32_t i { 0u }; i < frustumPlanes.size(); i++) {
+        // Normalized so the plane distance compares against the sphere radius. A far plane at infinity has no
+        // normal, it is replaced by one which keeps everything.
+        const float length { glm::length(glm::vec3(frustumPlanes.at(i))) };
+        const glm::vec4 plane { length > 0.0f ? frustumPlanes.at(i) / length : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f) };
+
+        planes.at(i * 4u + 0u) = plane.x;
+        planes.at(i * 4u + 1u) = plane.y;
+        planes.at(i * 4u + 2u) = plane.z;
+        planes.at(i * 4u + 3u) = plane.w;
+    }
+
+    return planes;
+}
+
+} // namespace renderer
+} // namespace beige
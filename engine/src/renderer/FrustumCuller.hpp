@@ -0,0 +1,63 @@
+#pragma once
+
+#include "RendererTypes.hpp"
+#include "LodSelector.hpp"
+#include "../core/JobSystem.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace beige {
+namespace renderer {
+
+/**
+ * Tests the bounding spheres of the submitted geometries against the view frustum. Spheres are gathered into
+ * structure-of-arrays form so the SIMD kernels test several at once, and chunks of them are spread over the job system.
+ */
+class FrustumCuller final {
+public:
+    // Geometries per job, small packets are culled on the calling thread.
+    static constexpr uint32_t m_chunkSize { 1024u };
+
+    FrustumCuller(std::shared_ptr<core::JobSystem> jobSystem);
+    ~FrustumCuller();
+
+    FrustumCuller(const FrustumCuller&) = delete;
+    auto operator=(const FrustumCuller&) -> FrustumCuller& = delete;
+
+    /**
+     * @param planes The frustum planes, as extracted by extractPlanes().
+     * @param geometries The geometries to test, unknown ones are always visible.
+     * @param lodSelector Knows the bounds of every geometry.
+     * @param visibleGeometries Receives the indices of the geometries at least partly inside, in submission order.
+     * @returns The object and visible counts, and how long culling took.
+     */
+    auto cull(
+        const std::array<float, 24u>& planes,
+        const std::vector<GeometryRenderData>& geometries,
+        const LodSelector& lodSelector,
+        std::vector<uint32_t>& visibleGeometries
+    ) -> CullingStats;
+
+    /**
+     * Extracts the planes as (a, b, c, d) with normals pointing inward, after Gribb and Hartmann's "Fast Extraction of
+     * Viewing Frustum Planes from the World-View-Projection Matrix". Expects a reverse-Z projection like the camera's.
+     */
+    static auto extractPlanes(const glm::mat4x4& viewProjection) -> std::array<float, 24u>;
+
+private:
+    std::shared_ptr<core::JobSystem> m_jobSystem;
+    std::vector<float> m_centersX;
+    std::vector<float> m_centersY;
+    std::vector<float> m_centersZ;
+    std::vector<float> m_radii;
+    std::vector<uint32_t> m_visibleIndices;     // Every chunk compacts to the front of its own range.
+    std::vector<uint32_t> m_chunkVisibleCounts;
+};
+
+} // namespace renderer
+} // namespace beige
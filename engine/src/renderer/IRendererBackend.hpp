@@ -2,12 +2,19 @@
 
 #include "../Defines.hpp"
 #include "../platform/Platform.hpp"
+#include "../math/MathTypes.hpp"
+#include "../resources/GeometryHandle.hpp"
+#include "../resources/GeometryLod.hpp"
 #include "../resources/ITexture.hpp"
+#include "../resources/TexturePool.hpp"
 #include "RendererTypes.hpp"
 
 #include <glm/glm.hpp>
+#include <array>
 #include <string>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace beige {
 namespace renderer {
@@ -29,18 +36,94 @@ public:
     ) -> void = 0;
     virtual auto endFrame(const float deltaTime) -> bool = 0;
 
+    /**
+     * Begins the main render pass. Compute work of the frame, like cullInstances(), has to be recorded before.
+     */
+    virtual auto beginRenderPass() -> void = 0;
+    virtual auto endRenderPass() -> void = 0;
+
     virtual auto updateObject(
-        const GeometryRenderData& geometryRenderData
+        const GeometryRenderData& geometryRenderData,
+        const resources::TexturePool& texturePool
+    ) -> void = 0;
+
+    /**
+     * Records culling of the instances on the device, which compacts the visible ones into indirect draw commands.
+     * Has to be called before the render pass begins, at most once per frame.
+     * @param boundingSpheres The model space bounding sphere of every instance.
+     * @param frustumPlanes The planes as (a, b, c, d) with normals pointing inward.
+     * @returns False if the device cannot cull the instances, nothing was recorded then.
+     */
+    virtual auto cullInstances(
+        const std::vector<GeometryRenderData>& instances,
+        const std::vector<glm::vec4>& boundingSpheres,
+        const std::array<float, 24u>& frustumPlanes
+    ) -> bool = 0;
+
+    /**
+     * Draws the instances which survived cullInstances() with the textures of the given geometry.
+     */
+    virtual auto drawInstances(
+        const GeometryRenderData& geometryRenderData,
+        const resources::TexturePool& texturePool
     ) -> void = 0;
 
+    /**
+     * @returns The timings of the last frame, the device time stays 0 if it cannot write timestamps.
+     */
+    virtual auto getFrameTimings() const -> FrameTimings = 0;
+
+    /**
+     * @returns The number of frames the host may record ahead of the device.
+     */
+    virtual auto getMaxFramesInFlight() const -> uint32_t = 0;
+
+    /**
+     * Allocates the shader resources of a material, objects drawn with the same id share them.
+     * @returns The id to draw objects with, or nothing if every id is taken.
+     */
+    virtual auto acquireObjectResources() -> std::optional<resources::ObjectId> = 0;
+
     virtual auto createTexture(
         const std::string& name,
         const int32_t width,
         const int32_t height,
         const int32_t channelCount,
+        const resources::TextureFormat format,
         const void* pixels,
+        const uint32_t mipLevelCount,
         const bool hasTransparency
     ) -> std::shared_ptr<resources::ITexture> = 0;
+    virtual auto createPendingTexture(const std::string& name) -> std::shared_ptr<resources::ITexture> = 0;
+
+    /**
+     * Submits the uploads as one batch without waiting for the device. The textures keep their previous image until
+     * completeUploads() reports the batch as finished.
+     * @returns The number of the batch, batches are numbered from 1 in submission order.
+     */
+    virtual auto uploadTextures(const std::vector<TextureUpload>& textureUploads) -> uint64_t = 0;
+
+    /**
+     * Swaps in the images of every batch the device has finished.
+     * @param wait Blocks until every submitted batch is finished.
+     * @returns The last finished batch, 0 if none finished yet.
+     */
+    virtual auto completeUploads(const bool wait) -> uint64_t = 0;
+
+    /**
+     * Releases the device resources of the texture once the frames in flight no longer draw it.
+     */
+    virtual auto destroyTexture(std::shared_ptr<resources::ITexture> texture) -> void = 0;
+    virtual auto setDefaultTexture(std::shared_ptr<resources::ITexture> texture) -> void = 0;
+    virtual auto supportsTextureFormat(const resources::TextureFormat format) const -> bool = 0;
+    virtual auto reloadShaders() -> bool = 0;
+
+    virtual auto createGeometry(
+        const std::vector<math::Vertex3D>& vertices,
+        const std::vector<uint32_t>& indices,
+        const std::vector<resources::GeometryLod>& lods
+    ) -> resources::GeometryHandle = 0;
+    virtual auto destroyGeometry(const resources::GeometryHandle geometry) -> void = 0;
 };
 
 } // namespace renderer
@@ -0,0 +1,170 @@
+#include "LodSelector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace beige {
+namespace renderer {
+
+namespace {
+
+// The largest axis scale keeps bounding spheres conservative under non-uniform scaling.
+auto getMaximumScale(const glm::mat4x4& model) -> float {
+    return std::max({ glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2])) });
+}
+
+} // namespace
+
+LodSelector::LodSelector() :
+m_projectionScale { 1.0f },
+m_geometries { },
+m_objectLods { } {
+
+}
+
+LodSelector::~LodSelector() {
+
+}
+
+auto LodSelector::setProjectionScale(const float projectionScale) -> void {
+    m_projectionScale = projectionScale;
+}
+
+auto LodSelector::addGeometry(
+    const resources::GeometryHandle handle,
+    const std::vector<math::Vertex3D>& vertices,
+    const std::vector<resources::GeometryLod>& lods
+) -> void {
+    if (handle == resources::global_invalidGeometryHandle || vertices.empty()) {
+        return;
+    }
+
+    glm::vec3 min { vertices.front().position };
+    glm::vec3 max { vertices.front().position };
+
+    for (const math::Vertex3D& vertex : vertices) {
+        min = glm::min(min, vertex.position);
+        max = glm::max(max, vertex.position);
+    }
+
+    const glm::vec3 center { (min + max) * 0.5f };
+    float radius { 0.0f };
+
+    for (const math::Vertex3D& vertex : vertices) {
+        radius = std::max(radius, glm::length(vertex.position - center));
+    }
+
+    std::vector<float> errors { 0.0f };
+
+    if (!lods.empty()) {
+        errors.resize(lods.size());
+        std::transform(
+            lods.begin(),
+            lods.end(),
+            errors.begin(),
+            [](const resources::GeometryLod& lod) -> float {
+                return lod.error;
+            }
+        );
+    }
+
+    if (handle.index >= m_geometries.size()) {
+        m_geometries.resize(handle.index + 1u);
+    }
+
+    const Geometry geometry {
+        handle.generation, // generation
+        center,            // center
+        radius,            // radius
+        std::move(errors)  // errors
+    };
+
+    m_geometries.at(handle.index) = geometry;
+}
+
+auto LodSelector::removeGeometry(const resources::GeometryHandle handle) -> void {
+    if (handle.index < m_geometries.size() && m_geometries.at(handle.index).generation == handle.generation) {
+        m_geometries.at(handle.index).errors.clear();
+    }
+}
+
+auto LodSelector::getBoundingSphere(const resources::GeometryHandle handle) const -> glm::vec4 {
+    if (handle.index >= m_geometries.size() || m_geometries.at(handle.index).generation != handle.generation) {
+        return glm::vec4(glm::vec3(0.0f), std::numeric_limits<float>::infinity());
+    }
+
+    const Geometry& geometry { m_geometries.at(handle.index) };
+
+    return glm::vec4(geometry.center, geometry.radius);
+}
+
+auto LodSelector::getBoundingSphere(
+    const resources::GeometryHandle handle,
+    const glm::mat4x4& model
+) const -> glm::vec4 {
+    const glm::vec4 boundingSphere { getBoundingSphere(handle) };
+
+    return glm::vec4(glm::vec3(model * glm::vec4(glm::vec3(boundingSphere), 1.0f)), boundingSphere.w * getMaximumScale(model));
+}
+
+auto LodSelector::select(
+    const ecs::Entity entity,
+    const resources::GeometryHandle handle,
+    const glm::mat4x4& model,
+    const glm::vec3& cameraPosition
+) -> uint32_t {
+    if (handle.index >= m_geometries.size() || m_geometries.at(handle.index).generation != handle.generation) {
+        return 0u;
+    }
+
+    const Geometry& geometry { m_geometries.at(handle.index) };
+
+    if (geometry.errors.size() < 2u) {
+        return 0u;
+    }
+
+    const glm::vec4 boundingSphere { getBoundingSphere(handle, model) };
+    const float distance { glm::length(glm::vec3(boundingSphere) - cameraPosition) - boundingSphere.w };
+
+    // Objects without an entity have nothing to remember their level by.
+    ObjectLod untrackedLod { entity.generation, handle, 0u };
+
+    if (entity != ecs::global_invalidEntity && entity.index >= m_objectLods.size()) {
+        m_objectLods.resize(static_cast<std::size_t>(entity.index) + 1u, untrackedLod);
+    }
+
+    ObjectLod& objectLod { entity != ecs::global_invalidEntity ? m_objectLods.at(entity.index) : untrackedLod };
+
+    // A recycled entity slot or a new geometry starts over instead of inheriting the level of something else.
+    if (objectLod.generation != entity.generation || objectLod.geometry != handle) {
+        objectLod = ObjectLod { entity.generation, handle, 0u };
+    }
+
+    uint32_t& currentLod { objectLod.lod };
+
+    // Up close every error is visible.
+    if (distance <= 0.0f) {
+        currentLod = 0u;
+        return currentLod;
+    }
+
+    const float pixelsPerUnit { m_projectionScale * getMaximumScale(model) / distance };
+    uint32_t lod { 0u };
+
+    // Errors grow with every level, so the first acceptable one from the coarse end is the coarsest.
+    for (uint32_t i { static_cast<uint32_t>(geometry.errors.size()) - 1u }; i > 0u; i--) {
+        const float threshold { i > currentLod ? m_pixelErrorThreshold * m_hysteresis : m_pixelErrorThreshold };
+
+        if (geometry.errors.at(i) * pixelsPerUnit <= threshold) {
+            lod = i;
+            break;
+        }
+    }
+
+    currentLod = lod;
+    return currentLod;
+}
+
+} // namespace renderer
+} // namespace beige
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../ecs/Entity.hpp"
+#include "../math/MathTypes.hpp"
+#include "../resources/GeometryHandle.hpp"
+#include "../resources/GeometryLod.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace beige {
+namespace renderer {
+
+/**
+ * Picks the coarsest level of detail whose simplification error projects to less than a pixel. Objects keep their
+ * level until the error of a coarser one drops well below the threshold, so they do not flicker at the boundary.
+ */
+class LodSelector final {
+public:
+    // Projected error in pixels a level of detail may show.
+    static constexpr float m_pixelErrorThreshold { 1.0f };
+
+    // Fraction of the threshold a coarser level has to get below before an object switches to it.
+    static constexpr float m_hysteresis { 0.75f };
+
+    LodSelector();
+    ~LodSelector();
+
+    /**
+     * @param projectionScale Pixels covered by one unit at a distance of one unit, half the viewport height
+     * times the vertical scale of the projection.
+     */
+    auto setProjectionScale(const float projectionScale) -> void;
+
+    /**
+     * Remembers the bounds and the errors of a created geometry.
+     */
+    auto addGeometry(
+        const resources::GeometryHandle handle,
+        const std::vector<math::Vertex3D>& vertices,
+        const std::vector<resources::GeometryLod>& lods
+    ) -> void;
+    auto removeGeometry(const resources::GeometryHandle handle) -> void;
+
+    /**
+     * @returns The bounding sphere of the geometry in model space, as center and radius. Unknown geometries get an
+     * infinite radius.
+     */
+    auto getBoundingSphere(const resources::GeometryHandle handle) const -> glm::vec4;
+
+    /**
+     * @returns The bounding sphere of the geometry placed by the model matrix, as center and radius. Unknown
+     * geometries get an infinite radius.
+     */
+    auto getBoundingSphere(const resources::GeometryHandle handle, const glm::mat4x4& model) const -> glm::vec4;
+
+    /**
+     * @param entity Keys the level the object kept from earlier frames. State of a destroyed entity or of a removed
+     * geometry is dropped once the slot of the entity is reused or the entity draws another geometry.
+     * @returns The level of detail to draw the object with, 0 for unknown geometries.
+     */
+    auto select(
+        const ecs::Entity entity,
+        const resources::GeometryHandle handle,
+        const glm::mat4x4& model,
+        const glm::vec3& cameraPosition
+    ) -> uint32_t;
+
+private:
+    struct Geometry {
+        uint32_t generation;
+        glm::vec3 center;
+        float radius;
+        std::vector<float> errors; // One per level of detail, finest first.
+    };
+
+    struct ObjectLod {
+        uint32_t generation; // Of the entity the level was selected for.
+        resources::GeometryHandle geometry;
+        uint32_t lod;
+    };
+
+    float m_projectionScale;
+    std::vector<Geometry> m_geometries; // Indexed like the slots of the geometry pool.
+    std::vector<ObjectLod> m_objectLods; // Indexed like the entity slots of the world, so it grows no further.
+};
+
+} // namespace renderer
+} // namespace beige
@@ -2,12 +2,14 @@
 
 #include "vulkan/VulkanBackend.hpp"
 #include "../core/Logger.hpp"
+#include "../core/Memory.hpp"
+#include "../ecs/Components.hpp"
 
 #include <glm/glm.hpp>
-#include <glm/ext/matrix_clip_space.hpp>
-#include <glm/ext/matrix_transform.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <utility>
 
 namespace beige {
 namespace renderer {
@@ -16,68 +18,139 @@ Frontend::Frontend(
     const std::string& appName,
     const uint32_t width,
     const uint32_t height,
-    std::shared_ptr<platform::Platform> platform
+    std::shared_ptr<platform::Platform> platform,
+    std::shared_ptr<core::JobSystem> jobSystem,
+    std::shared_ptr<const core::Vfs> vfs
 ) :
-m_backend {
+Frontend {
     std::make_unique<vulkan::Backend>(
         appName,
         width,
         height,
-        platform
-    )
-},
-m_frameCount { 0u },
-m_nearClip { 0.01f },
-m_farClip { 1000.0f },
-m_projection {
-    glm::perspective(
-        glm::radians(45.0f),
-        static_cast<float>(width) / static_cast<float>(height),
-        m_nearClip,
-        m_farClip
-    )
-},
-m_view { glm::mat4x4(1.0f) },
-m_testDiffuse { } {
+        platform,
+        vfs
+    ),
+    height,
+    jobSystem
+} {
 
 }
 
-Frontend::~Frontend() {
+Frontend::Frontend(
+    std::unique_ptr<IBackend> backend,
+    const uint32_t height,
+    std::shared_ptr<core::JobSystem> jobSystem
+) :
+m_backend { std::move(backend) },
+m_texturePool { },
+m_lodSelector { },
+m_frustumCuller { jobSystem },
+m_instanceBoundingSpheres { },
+m_instanceKeys { },
+m_materialDiffuses { },
+m_frameCount { 0u },
+m_framebufferHeight { height },
+m_camera { },
+m_testDiffuse { resources::global_invalidTextureHandle } {
+    m_lodSelector.setProjectionScale(m_camera.getProjection()[1][1] * static_cast<float>(height) * 0.5f);
+}
 
+Frontend::~Frontend() {
+    // Frames in flight may still draw the textures left in the pool.
+    for (const std::shared_ptr<resources::ITexture>& texture : m_texturePool.clear()) {
+        m_backend->destroyTexture(texture);
+    }
 }
 
 auto Frontend::onResized(const uint16_t width, const uint16_t height) -> void {
-    m_projection = glm::perspective(
-        glm::radians(45.0f),
-        static_cast<float>(width) / static_cast<float>(height),
-        m_nearClip,
-        m_farClip
-    );
+    m_framebufferHeight = height;
+    m_lodSelector.setProjectionScale(m_camera.getProjection()[1][1] * static_cast<float>(height) * 0.5f);
 
     m_backend->onResized(width, height);
 }
 
-auto Frontend::drawFrame(const Packet& packet) -> bool {
+auto Frontend::drawFrame(Packet& packet) -> bool {
+    const core::MemoryScope memoryScope { core::MemoryTag::Renderer };
+
     // If the begin frame returned successfully, mid-frame operations may continue.
     if (beginFrame(packet.deltaTime)) {
+        bool areInstancesCulled { false };
+
+        // Compute work has to be recorded before the render pass begins.
+        if (!packet.instances.empty()) {
+            m_instanceBoundingSpheres.resize(packet.instances.size());
+
+            // The device culls with the level picked here, distant instances are drawn coarser like the geometries.
+            for (std::size_t i { 0u }; i < packet.instances.size(); i++) {
+                GeometryRenderData& instance { packet.instances.at(i) };
+
+                instance.lod = m_lodSelector.select(
+                    instance.entity,
+                    instance.geometry,
+                    instance.model,
+                    m_camera.getPosition()
+                );
+                m_instanceBoundingSpheres.at(i) = m_lodSelector.getBoundingSphere(instance.geometry);
+            }
+
+            areInstancesCulled = m_backend->cullInstances(
+                packet.instances,
+                m_instanceBoundingSpheres,
+                m_camera.getFrustumPlanes()
+            );
+
+            if (!areInstancesCulled) {
+                packet.geometries.insert(packet.geometries.end(), packet.instances.begin(), packet.instances.end());
+            }
+        }
+
+        m_backend->beginRenderPass();
+
         m_backend->updateGlobalState(
-            m_projection,
-            m_view,
+            m_camera.getProjection(),
+            m_camera.getView(),
             glm::vec3(0.0f),
             glm::vec4(1.0f),
             0
         );
 
-        static float angle { 0.01f };
-        angle += 0.001f;
+        packet.cullingStats = m_frustumCuller.cull(
+            m_camera.getFrustumPlanes(),
+            packet.geometries,
+            m_lodSelector,
+            packet.visibleGeometries
+        );
+        packet.cullingStats.instanceCount = areInstancesCulled ? static_cast<uint32_t>(packet.instances.size()) : 0u;
 
-        const GeometryRenderData geometryRenderData {
-            0u, // TODO: Actual objectId;
-            glm::rotate(glm::mat4x4(1.0f), angle, glm::vec3(0.0f, 0.0f, 1.0f)),
-            { m_testDiffuse }
-        };
+        for (const uint32_t index : packet.visibleGeometries) {
+            GeometryRenderData& geometryRenderData { packet.geometries.at(index) };
 
-        m_backend->updateObject(geometryRenderData);
+            geometryRenderData.lod = m_lodSelector.select(
+                geometryRenderData.entity,
+                geometryRenderData.geometry,
+                geometryRenderData.model,
+                m_camera.getPosition()
+            );
+
+            // Let the texture system know which textures are in use.
+            for (const resources::TextureHandle texture : geometryRenderData.textures) {
+                m_texturePool.markUsed(texture, m_frameCount);
+            }
+
+            m_backend->updateObject(geometryRenderData, m_texturePool);
+        }
+
+        if (areInstancesCulled) {
+            const GeometryRenderData& instance { packet.instances.front() };
+
+            for (const resources::TextureHandle texture : instance.textures) {
+                m_texturePool.markUsed(texture, m_frameCount);
+            }
+
+            m_backend->drawInstances(instance, m_texturePool);
+        }
+
+        m_backend->endRenderPass();
 
         // End the frame. if this fails, it is likely unrecoverable.
         const bool result { endFrame(packet.deltaTime) };
@@ -91,8 +164,128 @@ auto Frontend::drawFrame(const Packet& packet) -> bool {
     return true;
 }
 
-auto Frontend::setView(const glm::mat4x4& view) -> void {
-    m_view = view;
+auto Frontend::collectGeometries(ecs::World& world, Packet& packet) -> void {
+    ecs::Query& query { world.getQuery<ecs::Transform, ecs::MeshRenderer>() };
+    const std::size_t firstGeometry { packet.geometries.size() };
+
+    packet.geometries.reserve(packet.geometries.size() + query.getEntityCount());
+
+    world.forEachChunk(
+        query,
+        [&](const ecs::ChunkView& chunk) -> void {
+            const ecs::Entity* entities { chunk.getEntities() };
+            const ecs::Transform* transforms { chunk.get<ecs::Transform>() };
+            const ecs::MeshRenderer* meshRenderers { chunk.get<ecs::MeshRenderer>() };
+
+            for (uint32_t i { 0u }; i < chunk.getCount(); i++) {
+                const resources::ObjectId objectId { meshRenderers[i].objectId };
+                const resources::TextureHandle diffuse {
+                    objectId < m_materialDiffuses.size() ? m_materialDiffuses[objectId] : resources::global_invalidTextureHandle
+                };
+
+                const GeometryRenderData geometryRenderData {
+                    entities[i],               // entity
+                    objectId,                  // objectId
+                    meshRenderers[i].geometry, // geometry
+                    0u,                        // lod, selected by drawFrame()
+                    transforms[i].model,       // model
+                    { diffuse }                // textures
+                };
+
+                packet.geometries.push_back(geometryRenderData);
+            }
+        }
+    );
+
+    if (!packet.instances.empty()) {
+        return;
+    }
+
+    // Only one group can be drawn as instances. The textures come with the material, so they match as well.
+    const auto getInstanceKey = [](const GeometryRenderData& geometryRenderData) -> InstanceKey {
+        return {
+            geometryRenderData.objectId,
+            geometryRenderData.geometry.index,
+            geometryRenderData.geometry.generation
+        };
+    };
+
+    m_instanceKeys.clear();
+
+    for (std::size_t i { firstGeometry }; i < packet.geometries.size(); i++) {
+        m_instanceKeys.push_back(getInstanceKey(packet.geometries.at(i)));
+    }
+
+    // Equal keys end up next to each other, the longest run is the largest group.
+    std::sort(m_instanceKeys.begin(), m_instanceKeys.end());
+
+    InstanceKey largestKey { };
+    std::size_t largestCount { 0u };
+    std::size_t runStart { 0u };
+
+    for (std::size_t i { 1u }; i <= m_instanceKeys.size(); i++) {
+        if (i < m_instanceKeys.size() && m_instanceKeys.at(i) == m_instanceKeys.at(runStart)) {
+            continue;
+        }
+
+        if (i - runStart > largestCount) {
+            largestKey = m_instanceKeys.at(runStart);
+            largestCount = i - runStart;
+        }
+
+        runStart = i;
+    }
+
+    if (largestCount < m_minInstanceCount) {
+        return;
+    }
+
+    packet.instances.reserve(largestCount);
+
+    std::size_t geometryCount { firstGeometry };
+
+    for (std::size_t i { firstGeometry }; i < packet.geometries.size(); i++) {
+        if (getInstanceKey(packet.geometries.at(i)) == largestKey) {
+            packet.instances.push_back(packet.geometries.at(i));
+        } else {
+            packet.geometries.at(geometryCount++) = packet.geometries.at(i);
+        }
+    }
+
+    packet.geometries.resize(geometryCount);
+}
+
+auto Frontend::setCamera(const scene::Camera& camera) -> void {
+    m_camera = camera;
+    m_lodSelector.setProjectionScale(m_camera.getProjection()[1][1] * static_cast<float>(m_framebufferHeight) * 0.5f);
+}
+
+auto Frontend::getFrameCount() const -> uint64_t {
+    return m_frameCount;
+}
+
+auto Frontend::getFrameTimings() const -> FrameTimings {
+    return m_backend->getFrameTimings();
+}
+
+auto Frontend::getMaxFramesInFlight() const -> uint32_t {
+    return m_backend->getMaxFramesInFlight();
+}
+
+auto Frontend::getTexturePool() -> resources::TexturePool& {
+    return m_texturePool;
+}
+
+auto Frontend::acquireObjectResources() -> std::optional<resources::ObjectId> {
+    return m_backend->acquireObjectResources();
+}
+
+auto Frontend::setMaterialDiffuse(const resources::ObjectId objectId, const resources::TextureHandle diffuse) -> void {
+    if (objectId >= m_materialDiffuses.size()) {
+        m_materialDiffuses.resize(static_cast<std::size_t>(objectId) + 1u, resources::global_invalidTextureHandle);
+    }
+
+    m_materialDiffuses.at(objectId) = diffuse;
 }
 
 auto Frontend::beginFrame(const float deltaTime) -> bool {
@@ -110,7 +303,9 @@ auto Frontend::createTexture(
     const int32_t width,
     const int32_t height,
     const int32_t channelCount,
+    const resources::TextureFormat format,
     const void* pixels,
+    const uint32_t mipLevelCount,
     const bool hasTransparency
 ) -> std::shared_ptr<resources::ITexture> {
     return m_backend->createTexture(
@@ -118,10 +313,56 @@ auto Frontend::createTexture(
         width,
         height,
         channelCount,
+        format,
         pixels,
+        mipLevelCount,
         hasTransparency
     );
 }
 
+auto Frontend::createPendingTexture(const std::string& name) -> std::shared_ptr<resources::ITexture> {
+    return m_backend->createPendingTexture(name);
+}
+
+auto Frontend::uploadTextures(const std::vector<TextureUpload>& textureUploads) -> uint64_t {
+    return m_backend->uploadTextures(textureUploads);
+}
+
+auto Frontend::completeUploads(const bool wait) -> uint64_t {
+    return m_backend->completeUploads(wait);
+}
+
+auto Frontend::destroyTexture(const resources::TextureHandle texture) -> void {
+    m_backend->destroyTexture(m_texturePool.getTexture(texture));
+    m_texturePool.free(texture);
+}
+
+auto Frontend::setDefaultTexture(std::shared_ptr<resources::ITexture> texture) -> void {
+    m_backend->setDefaultTexture(texture);
+}
+
+auto Frontend::supportsTextureFormat(const resources::TextureFormat format) const -> bool {
+    return m_backend->supportsTextureFormat(format);
+}
+
+auto Frontend::reloadShaders() -> bool {
+    return m_backend->reloadShaders();
+}
+
+auto Frontend::createGeometry(
+    const std::vector<math::Vertex3D>& vertices,
+    const std::vector<uint32_t>& indices,
+    const std::vector<resources::GeometryLod>& lods
+) -> resources::GeometryHandle {
+    const resources::GeometryHandle geometry { m_backend->createGeometry(vertices, indices, lods) };
+    m_lodSelector.addGeometry(geometry, vertices, lods);
+    return geometry;
+}
+
+auto Frontend::destroyGeometry(const resources::GeometryHandle geometry) -> void {
+    m_lodSelector.removeGeometry(geometry);
+    m_backend->destroyGeometry(geometry);
+}
+
 } // namespace renderer
 } // namespace beige
@@ -1,33 +1,103 @@
 #pragma once
 
+#include "../Defines.hpp"
 #include "RendererTypes.hpp"
 #include "IRendererBackend.hpp"
+#include "FrustumCuller.hpp"
+#include "LodSelector.hpp"
 #include "../resources/ITexture.hpp"
+#include "../resources/TexturePool.hpp"
+#include "../core/JobSystem.hpp"
+#include "../core/Vfs.hpp"
+#include "../ecs/World.hpp"
+#include "../scene/Camera.hpp"
 
 #include <cstdint>
 #include <memory>
 #include <array>
+#include <tuple>
+#include <vector>
 
 namespace beige {
 namespace renderer {
 
-class Frontend final {
+class BEIGE_API Frontend final {
 public:
+    // Entities sharing a material and geometry it takes for collectGeometries() to draw them as instances.
+    static constexpr uint32_t m_minInstanceCount { 256u };
+
     Frontend(
         const std::string& appName,
         const uint32_t width,
         const uint32_t height,
-        std::shared_ptr<platform::Platform> platform
+        std::shared_ptr<platform::Platform> platform,
+        std::shared_ptr<core::JobSystem> jobSystem,
+        std::shared_ptr<const core::Vfs> vfs
+    );
+
+    /**
+     * Draws through the given backend instead of creating the Vulkan one, benchmarks pass one without a device.
+     * @param height The height of the framebuffer, used to select levels of detail.
+     */
+    Frontend(
+        std::unique_ptr<IBackend> backend,
+        const uint32_t height,
+        std::shared_ptr<core::JobSystem> jobSystem
     );
     ~Frontend();
 
     auto onResized(const uint16_t width, const uint16_t height) -> void;
-    auto drawFrame(const Packet& packet) -> bool;
 
-    auto setView(const glm::mat4x4& view) -> void;
+    /**
+     * Culls the geometries of the packet and draws the visible ones.
+     * @param packet Receives the visible geometries and the culling stats of the frame.
+     * @returns False if the frame could not be ended, which is likely unrecoverable.
+     */
+    auto drawFrame(Packet& packet) -> bool;
+
+    /**
+     * Appends a geometry for every entity with a transform and a mesh renderer, reading their component arrays
+     * chunk by chunk. If the packet has no instances yet, the largest group of at least m_minInstanceCount entities
+     * sharing a material and geometry is moved into the instances, which are culled on the device.
+     */
+    auto collectGeometries(ecs::World& world, Packet& packet) -> void;
+
+    /**
+     * Sets the camera the next frames are drawn and culled with, its matrices have to be up to date.
+     */
+    auto setCamera(const scene::Camera& camera) -> void;
+    auto getFrameCount() const -> uint64_t;
+
+    /**
+     * @returns The host waits and device time of the last drawn frame.
+     */
+    auto getFrameTimings() const -> FrameTimings;
+
+    /**
+     * @returns The number of frames the host may record ahead of the device, a resource drawn in one of them
+     * stays in use for that long.
+     */
+    auto getMaxFramesInFlight() const -> uint32_t;
+
+    /**
+     * The pool owning every texture, geometry refers to its textures by handles into it.
+     */
+    auto getTexturePool() -> resources::TexturePool&;
+
+    /**
+     * Allocates the shader resources of a material, objects drawn with the same id share them.
+     * @returns The id to draw objects with, or nothing if every id is taken.
+     */
+    auto acquireObjectResources() -> std::optional<resources::ObjectId>;
+
+    /**
+     * Sets the texture every mesh renderer of the material is drawn with. Their draws share one descriptor set, which
+     * cannot be rewritten between them within a frame.
+     */
+    auto setMaterialDiffuse(const resources::ObjectId objectId, const resources::TextureHandle diffuse) -> void;
 
     // TODO: Temporary.
-    std::shared_ptr<resources::ITexture> m_testDiffuse;
+    resources::TextureHandle m_testDiffuse;
     // TODO: End temporary.
 
     auto createTexture(
@@ -35,18 +105,81 @@ public:
         const int32_t width,
         const int32_t height,
         const int32_t channelCount,
+        const resources::TextureFormat format,
         const void* pixels,
+        const uint32_t mipLevelCount,
         const bool hasTransparency
     ) -> std::shared_ptr<resources::ITexture>;
 
+    /**
+     * Creates a texture without data, it is left at the invalid generation and drawn with the default texture.
+     */
+    auto createPendingTexture(const std::string& name) -> std::shared_ptr<resources::ITexture>;
+
+    /**
+     * Uploads data to pending (or already loaded) textures through one staging buffer and one submission, without
+     * waiting for the device.
+     * @returns The number of the batch, finished once completeUploads() returns it or a later one.
+     */
+    auto uploadTextures(const std::vector<TextureUpload>& textureUploads) -> uint64_t;
+
+    /**
+     * Swaps in the images of the finished upload batches.
+     * @param wait Blocks until every submitted batch is finished.
+     * @returns The last finished batch.
+     */
+    auto completeUploads(const bool wait) -> uint64_t;
+
+    /**
+     * Frees the slot of the texture, its device resources are released once the frames in flight no longer draw it.
+     */
+    auto destroyTexture(const resources::TextureHandle texture) -> void;
+
+    /**
+     * Sets the texture bound in place of textures that are not loaded yet.
+     */
+    auto setDefaultTexture(std::shared_ptr<resources::ITexture> texture) -> void;
+
+    auto supportsTextureFormat(const resources::TextureFormat format) const -> bool;
+
+    /**
+     * Reads the shaders again and swaps in the rebuilt pipelines, the old ones are kept while frames use them.
+     * @returns True if every shader was rebuilt, the old ones stay in use otherwise.
+     */
+    auto reloadShaders() -> bool;
+
+    /**
+     * Copies a geometry into the vertex and index buffers shared by every geometry.
+     * @param lods Ranges of the indices, finest first. If empty, all indices form the only level of detail.
+     * @returns The handle to draw the geometry with, or an invalid handle if the buffers are full.
+     */
+    auto createGeometry(
+        const std::vector<math::Vertex3D>& vertices,
+        const std::vector<uint32_t>& indices,
+        const std::vector<resources::GeometryLod>& lods
+    ) -> resources::GeometryHandle;
+
+    /**
+     * Invalidates the handle, the ranges are reused once the frames in flight no longer draw the geometry.
+     */
+    auto destroyGeometry(const resources::GeometryHandle geometry) -> void;
+
 private:
+    // Material, geometry index and generation of an entity.
+    using InstanceKey = std::tuple<resources::ObjectId, uint32_t, uint32_t>;
+
     std::unique_ptr<IBackend> m_backend;
-    uint64_t m_frameCount;
+    resources::TexturePool m_texturePool;
+    LodSelector m_lodSelector;
+    FrustumCuller m_frustumCuller;
+    std::vector<glm::vec4> m_instanceBoundingSpheres; // Reused every frame.
+    std::vector<InstanceKey> m_instanceKeys;          // Reused every frame.
 
-    float m_nearClip;
-    float m_farClip;
-    glm::mat4x4 m_projection;
-    glm::mat4x4 m_view;
+    // Indexed by object id, materials without a texture are drawn with the default one.
+    std::vector<resources::TextureHandle> m_materialDiffuses;
+    uint64_t m_frameCount;
+    uint32_t m_framebufferHeight;
+    scene::Camera m_camera;
 
     auto beginFrame(const float deltaTime) -> bool;
     auto endFrame(const float deltaTime) -> bool;
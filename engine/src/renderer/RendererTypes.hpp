@@ -1,20 +1,20 @@
 #pragma once
 
+#include "../ecs/Entity.hpp"
+#include "../resources/GeometryHandle.hpp"
 #include "../resources/ITexture.hpp"
+#include "../resources/TextureHandle.hpp"
 
 #include <glm/glm.hpp>
 
 #include <array>
 #include <memory>
+#include <vector>
 
 
 namespace beige {
 namespace renderer {
 
-struct Packet {
-    float deltaTime;
-};
-
 struct GlobalUniformObject {
     glm::mat4x4 projection; // 64 bytes
     glm::mat4x4 view;       // 64 bytes
@@ -29,10 +29,59 @@ struct ObjectUniformObject {
     glm::vec4 reserved_2;   // 16 bytes, reserved for future use
 };
 
+// One per drawn object in the instance storage buffer, read by the vertex shader and by culling on the device.
+struct InstanceObject {
+    glm::mat4x4 model;        // 64 bytes
+    glm::vec4 boundingSphere; // 16 bytes, model space center and radius
+    uint32_t indexCount;      // 4 bytes, range of the level of detail to draw
+    uint32_t firstIndex;      // 4 bytes
+    int32_t vertexOffset;     // 4 bytes
+    uint32_t reserved_0;      // 4 bytes, reserved for future use
+};
+
 struct GeometryRenderData {
-    resources::ObjectId objectId;
+    ecs::Entity entity;                 // Stable per object, keys state kept across frames like the level of detail.
+    resources::ObjectId objectId;       // Material of the object, shared by every object drawn with it.
+    resources::GeometryHandle geometry; // Ranges of the shared vertex and index buffers, stale handles are not drawn.
+    uint32_t lod;                       // Level of detail to draw, clamped to the levels of the geometry.
     glm::mat4x4 model;
-    std::array<std::shared_ptr<resources::ITexture>, 16u> textures;
+    std::array<resources::TextureHandle, 16u> textures; // Resolved through the texture pool, unused slots are left zeroed.
+};
+
+struct CullingStats {
+    uint32_t objectCount;
+    uint32_t visibleCount;
+    float cullTime;         // In milliseconds.
+    uint32_t instanceCount; // Culled on the device instead, which keeps their visible count to itself.
+};
+
+struct FrameTimings {
+    float gpuTime;         // In milliseconds, of the last frame the device finished, which lags the frames in flight.
+    float presentWaitTime; // In milliseconds, the host blocked on the device, acquiring an image and presenting.
+};
+
+struct Packet {
+    float deltaTime;
+    std::vector<GeometryRenderData> geometries;
+    std::vector<uint32_t> visibleGeometries; // Indices into geometries which survived culling, filled by drawFrame().
+    CullingStats cullingStats;               // Filled by drawFrame().
+
+    // Culled on the device and drawn with one indirect draw, for large numbers of objects which share the textures
+    // of the first one. Filled by collectGeometries() from entities sharing a material, geometry and texture. Falls
+    // back to the geometries if the device cannot draw with a count it wrote itself.
+    std::vector<GeometryRenderData> instances;
+};
+
+// Data for a texture created with createPendingTexture(), pixels have to stay valid until uploadTextures() returns.
+struct TextureUpload {
+    std::shared_ptr<resources::ITexture> texture;
+    int32_t width;
+    int32_t height;
+    int32_t channelCount;
+    resources::TextureFormat format;
+    const void* pixels;
+    uint32_t mipLevelCount; // Tightly packed levels in pixels, 1 generates the rest of the chain.
+    bool hasTransparency;
 };
 
 } // namespace renderer
@@ -0,0 +1,71 @@
+#include "VulkanAllocator.hpp"
+
+#include "../../core/Memory.hpp"
+
+namespace beige {
+namespace renderer {
+namespace vulkan {
+
+namespace {
+
+// Declared the way the Vulkan headers declare their function pointers, for the calling convention.
+VKAPI_ATTR void* VKAPI_CALL allocateMemory(
+    void* userData,
+    size_t size,
+    size_t alignment,
+    VkSystemAllocationScope allocationScope
+) {
+    return core::Memory::allocate(size, alignment, core::MemoryTag::VulkanDriver);
+}
+
+VKAPI_ATTR void* VKAPI_CALL reallocateMemory(
+    void* userData,
+    void* original,
+    size_t size,
+    size_t alignment,
+    VkSystemAllocationScope allocationScope
+) {
+    return core::Memory::reallocate(original, size, alignment, core::MemoryTag::VulkanDriver);
+}
+
+VKAPI_ATTR void VKAPI_CALL freeMemory(void* userData, void* memory) {
+    core::Memory::free(memory);
+}
+
+// The driver allocated these itself, they are only reported.
+VKAPI_ATTR void VKAPI_CALL notifyInternalAllocation(
+    void* userData,
+    size_t size,
+    VkInternalAllocationType allocationType,
+    VkSystemAllocationScope allocationScope
+) {
+    core::Memory::addExternal(size, core::MemoryTag::VulkanDriver);
+}
+
+VKAPI_ATTR void VKAPI_CALL notifyInternalFree(
+    void* userData,
+    size_t size,
+    VkInternalAllocationType allocationType,
+    VkSystemAllocationScope allocationScope
+) {
+    core::Memory::removeExternal(size, core::MemoryTag::VulkanDriver);
+}
+
+VkAllocationCallbacks global_allocationCallbacks {
+    nullptr,                  // pUserData
+    allocateMemory,           // pfnAllocation
+    reallocateMemory,         // pfnReallocation
+    freeMemory,               // pfnFree
+    notifyInternalAllocation, // pfnInternalAllocation
+    notifyInternalFree        // pfnInternalFree
+};
+
+} // namespace
+
+auto Allocator::getAllocationCallbacks() -> VkAllocationCallbacks* {
+    return &global_allocationCallbacks;
+}
+
+} // namespace vulkan
+} // namespace renderer
+} // namespace beige
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+namespace beige {
+namespace renderer {
+namespace vulkan {
+
+/**
+ * Routes the host allocations of the driver through core::Memory, where they are counted under the VulkanDriver tag.
+ */
+class Allocator final {
+public:
+    Allocator() = delete;
+    ~Allocator() = delete;
+
+    /**
+     * @returns The callbacks to pass to every create and destroy call, they stay valid for the whole run.
+     */
+    static auto getAllocationCallbacks() -> VkAllocationCallbacks*;
+};
+
+} // namespace vulkan
+} // namespace renderer
+} // namespace beige
@@ -1,32 +1,47 @@
 #include "VulkanBackend.hpp"
 
 #include "../../core/Logger.hpp"
+#include "VulkanAllocator.hpp"
 #include "VulkanDefines.hpp"
 #include "VulkanUtils.hpp"
 #include "../../math/MathTypes.hpp"
 
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstring>
 #include <limits>
+#include <utility>
 
 namespace beige {
 namespace renderer {
 namespace vulkan {
 
+namespace {
+
+// Only differences are taken, so the host waits can be timed without a platform when rendering offscreen.
+auto getAbsoluteTime() -> double {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
 Backend::Backend(
     const std::string& appName,
     const uint32_t width,
     const uint32_t height,
-    std::shared_ptr<platform::Platform> platform
+    std::shared_ptr<platform::Platform> platform,
+    std::shared_ptr<const core::Vfs> vfs
 ) :
 IBackend { },
 m_platform { platform },
+m_vfs { vfs },
 m_frameDeltaTime { 0.0f },
 m_framebufferWidth { width },
 m_framebufferHeight { height },
 m_framebufferSizeGeneration { 0u },
 m_framebufferSizeLastGeneration { 0u },
-m_allocationCallbacks { nullptr }, // TODO: Custom allocator
+m_allocationCallbacks { Allocator::getAllocationCallbacks() },
 m_instance { 0 },
 
 #if defined(BEIGE_DEBUG)
@@ -38,17 +53,28 @@ m_device { nullptr },
 m_swapchain { nullptr },
 m_recreatingSwapchain { false },
 m_mainRenderPass { nullptr },
-m_objectVertexBuffer { nullptr },
-m_objectIndexBuffer { nullptr },
+m_geometryPool { nullptr },
 m_imageIndex { 0u },
 m_graphicsCommandBuffers { },
 m_materialShader { nullptr },
+m_cullingShader { nullptr },
+m_instanceBuffers { },
+m_instanceObjects { },
+m_instanceCount { 0u },
+m_culledFirstInstance { 0u },
+m_culledInstanceCount { 0u },
+m_deletionQueue { nullptr },
+m_pendingUploads { },
+m_uploadBatch { 0u },
+m_completedUploadBatch { 0u },
 m_imageAvailableSemaphores { },
 m_queueCompleteSemaphores { },
 m_inFlightFences { },
 m_imagesInFlight { },
-m_geometryVertexOffset { 0u },
-m_geometryIndexOffset { 0u } {
+m_timestampQueryPool { VK_NULL_HANDLE },
+m_areTimestampsWritten { },
+m_frameTimings { },
+m_presentWaitTime { 0.0 } {
     const VkApplicationInfo applicationInfo {
         VK_STRUCTURE_TYPE_APPLICATION_INFO, // sType
         nullptr,                            // pNext
@@ -106,8 +132,13 @@ m_geometryIndexOffset { 0u } {
     instanceCreateInfo.enabledLayerCount = static_cast<uint32_t>(requiredValidationLayerNames.size());
     instanceCreateInfo.ppEnabledLayerNames = requiredValidationLayerNames.data();
 
-    std::vector<const char*> requiredExtensions { m_platform->getVulkanRequiredExtensionNames() };
-    requiredExtensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+    std::vector<const char*> requiredExtensions;
+
+    // Offscreen rendering needs no surface, so it runs without a display.
+    if (m_platform != nullptr) {
+        requiredExtensions = m_platform->getVulkanRequiredExtensionNames();
+        requiredExtensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+    }
 
 #ifdef BEIGE_DEBUG
     requiredExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -140,10 +171,10 @@ m_geometryIndexOffset { 0u } {
 
     const VkDebugUtilsMessengerCreateInfoEXT debugUtilsMessengerCreateInfo {
         VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT, // sType
-        nullptr, // pNext
-        0u, // flags
-        debugUtilsMessageSeverityFlags, // messageSeverity
-        debugUtilsMessageTypeFlags, // messageType
+        nullptr,                                                 // pNext
+        0u,                                                      // flags
+        debugUtilsMessageSeverityFlags,                          // messageSeverity
+        debugUtilsMessageTypeFlags,                              // messageType
         [](
             VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
             VkDebugUtilsMessageTypeFlagsEXT messageTypes,
@@ -192,11 +223,13 @@ m_geometryIndexOffset { 0u } {
     core::Logger::debug("Vulkan debugger created!");
 #endif // BEIGE_DEBUG
 
-    m_surface = std::make_shared<Surface>(
-        m_allocationCallbacks,
-        m_instance,
-        m_platform
-    );
+    if (m_platform != nullptr) {
+        m_surface = std::make_shared<Surface>(
+            m_allocationCallbacks,
+            m_instance,
+            m_platform
+        );
+    }
 
     m_device = std::make_shared<Device>(
         m_allocationCallbacks,
@@ -205,8 +238,8 @@ m_geometryIndexOffset { 0u } {
     );
 
     m_swapchain = std::make_shared<Swapchain>(
-        100u,
-        100u,
+        m_framebufferWidth,
+        m_framebufferHeight,
         m_allocationCallbacks,
         m_surface,
         m_device
@@ -224,7 +257,7 @@ m_geometryIndexOffset { 0u } {
         0.0f,                                    // g
         0.2f,                                    // b
         1.0f,                                    // a
-        1.0f,                                    // depth
+        0.0f,                                    // depth, the far plane with reverse-Z
         0u                                       // stencil
     );
 
@@ -284,58 +317,90 @@ m_geometryIndexOffset { 0u } {
     // Actual fences are not owned by this list
     m_imagesInFlight.resize(static_cast<uint32_t>(m_swapchain->getImages().size()), nullptr);
 
+    if (m_device->supportsTimestamps()) {
+        const VkQueryPoolCreateInfo queryPoolCreateInfo {
+            VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO, // sType
+            nullptr,                                  // pNext
+            0u,                                       // flags
+            VK_QUERY_TYPE_TIMESTAMP,                  // queryType
+            maxFramesInFlight * 2u,                   // queryCount
+            0u                                        // pipelineStatistics
+        };
+
+        VULKAN_CHECK(vkCreateQueryPool(logicalDevice, &queryPoolCreateInfo, m_allocationCallbacks, &m_timestampQueryPool));
+    }
+
+    m_areTimestampsWritten.resize(maxFramesInFlight, false);
+
+    m_deletionQueue = std::make_unique<DeletionQueue>(m_swapchain->getMaxFramesInFlight());
+
     m_materialShader = std::make_shared<MaterialShader>(
         m_allocationCallbacks,
         m_device,
         m_mainRenderPass,
         m_swapchain,
         m_framebufferWidth,
-        m_framebufferHeight
+        m_framebufferHeight,
+        m_vfs
     );
 
-    createBuffers();
-
-    const float f { 10.0f };
-
-    // TODO: Temporary test code
-    std::array<math::Vertex3D, 4u> verts { };
-
-    verts.at(0u).position = glm::vec3(-0.5f * f, -0.5f * f, 0.0f);
-    verts.at(0u).texCoord = glm::vec2(0.0f, 0.0f);
-
-    verts.at(1u).position = glm::vec3(0.5f * f, 0.5f * f, 0.0f);
-    verts.at(1u).texCoord = glm::vec2(1.0f, 1.0f);
+    const uint32_t deviceLocalBits {
+        m_device->supportsDeviceLocalHostVisible()
+        ? VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+        : 0u
+    };
 
-    verts.at(2u).position = glm::vec3(-0.5f * f, 0.5f * f, 0.0f);
-    verts.at(2u).texCoord = glm::vec2(0.0f, 1.0f);
+    const uint32_t instanceBufferMemoryPropertyFlags {
+        deviceLocalBits |
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+    };
 
-    verts.at(3u).position = glm::vec3(0.5f * f, -0.5f * f, 0.0f);
-    verts.at(3u).texCoord = glm::vec2(1.0f, 0.0f);
+    for (uint32_t i { 0u }; i < m_swapchain->getMaxFramesInFlight(); i++) {
+        m_instanceBuffers.push_back(
+            std::make_unique<Buffer>(
+                m_allocationCallbacks,
+                m_device,
+                static_cast<uint64_t>(sizeof(InstanceObject)) * m_maxInstanceCount,
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                instanceBufferMemoryPropertyFlags,
+                true
+            )
+        );
 
-    std::array<uint32_t, 6u> indices {
-        0u, 1u, 2u, 0u, 3u, 1u
-    };
+        m_instanceObjects.push_back(
+            static_cast<InstanceObject*>(
+                m_instanceBuffers.back()->lockMemory(
+                    0u,
+                    static_cast<uint64_t>(sizeof(InstanceObject)) * m_maxInstanceCount,
+                    0u
+                )
+            )
+        );
+    }
 
-    uploadDataRange(
-        m_device->getGraphicsCommandPool(),
-        VK_NULL_HANDLE,
-        m_device->getGraphicsQueue(),
-        m_objectVertexBuffer->getHandle(),
-        0u,
-        static_cast<uint64_t>(sizeof(math::Vertex3D) * verts.size()),
-        verts.data()
-    );
+    // Without an indirect count the instances are culled and drawn by the host like any other geometry. The culling
+    // shader writes the index of each instance as its first instance, which the device has to support too.
+    if (m_device->supportsIndirectCount() && m_device->supportsDrawIndirectFirstInstance()) {
+        m_cullingShader = std::make_unique<CullingShader>(
+            m_allocationCallbacks,
+            m_device,
+            m_swapchain->getMaxFramesInFlight(),
+            m_maxInstanceCount,
+            m_vfs
+        );
+    }
 
-    uploadDataRange(
-        m_device->getGraphicsCommandPool(),
-        VK_NULL_HANDLE,
-        m_device->getGraphicsQueue(),
-        m_objectIndexBuffer->getHandle(),
-        0u,
-        sizeof(uint32_t) * indices.size(),
-        indices.data()
+    const uint64_t vertexBufferSize { sizeof(glm::vec3) * 1024u * 1024u };
+    const uint64_t indexBufferSize { sizeof(uint32_t) * 1024u * 1024u };
+    m_geometryPool = std::make_unique<GeometryPool>(
+        m_allocationCallbacks,
+        m_device,
+        vertexBufferSize,
+        indexBufferSize
     );
 
+    // TODO: Temporary test code
     const std::optional<resources::ObjectId> objectId {
         m_materialShader->acquireResources()
     };
@@ -356,12 +421,31 @@ Backend::~Backend() {
 
     vkDeviceWaitIdle(logicalDevice);
 
-    m_objectIndexBuffer.reset();
-    m_objectVertexBuffer.reset();
+    // Finished uploads still retire images into the deletion queue.
+    completeUploads(true);
+
+    // Pending deletions still return ranges to the geometry pool.
+    m_deletionQueue.reset();
+    m_geometryPool.reset();
+
+    core::Logger::info("Destroying culling shader...");
+    m_cullingShader.reset();
+
+    for (const std::unique_ptr<Buffer>& instanceBuffer : m_instanceBuffers) {
+        instanceBuffer->unlockMemory();
+    }
+
+    m_instanceObjects.clear();
+    m_instanceBuffers.clear();
 
     core::Logger::info("Destroying material shader...");
     m_materialShader.reset();
 
+    if (m_timestampQueryPool != VK_NULL_HANDLE) {
+        vkDestroyQueryPool(logicalDevice, m_timestampQueryPool, m_allocationCallbacks);
+        m_timestampQueryPool = VK_NULL_HANDLE;
+    }
+
     core::Logger::info("Destroying images in-flight...");
     m_imagesInFlight.clear();
 
@@ -488,16 +572,50 @@ auto Backend::beginFrame(const float deltaTime) -> bool {
     }
 
     const uint32_t currentFrame { m_swapchain->getCurrentFrame() };
+    m_presentWaitTime = 0.0;
 
     // Wait for the execution of the current frame to complete.
     // The fence being free will allow this on to move on.
+    const double fenceWaitStartTime { getAbsoluteTime() };
+
     if (!m_inFlightFences.at(currentFrame)->wait(UINT64_MAX)) {
         core::Logger::warn("In-flight fence wait failure!");
         return false;
     }
 
+    m_presentWaitTime += getAbsoluteTime() - fenceWaitStartTime;
+
+    // The frame which last used these queries is done, their results are available without waiting.
+    if (m_timestampQueryPool != VK_NULL_HANDLE && m_areTimestampsWritten.at(currentFrame)) {
+        std::array<uint64_t, 2u> timestamps { 0u, 0u };
+
+        const VkResult result {
+            vkGetQueryPoolResults(
+                logicalDevice,
+                m_timestampQueryPool,
+                currentFrame * 2u,
+                static_cast<uint32_t>(timestamps.size()),
+                sizeof(timestamps),
+                timestamps.data(),
+                sizeof(uint64_t),
+                VK_QUERY_RESULT_64_BIT
+            )
+        };
+
+        if (result == VK_SUCCESS && timestamps.at(1) >= timestamps.at(0)) {
+            const double ticks { static_cast<double>(timestamps.at(1) - timestamps.at(0)) };
+            m_frameTimings.gpuTime = static_cast<float>(ticks * m_device->getTimestampPeriod() * 0.000001);
+        }
+
+        m_areTimestampsWritten.at(currentFrame) = false;
+    }
+
+    // The frame which last used this fence is done, so is everything it could have referenced.
+    m_deletionQueue->advanceFrame();
+
     // Acquire the next image from the swapchain. Pass along the semaphore that should signaled when this completes.
     // This same semaphore will later be waited on by the queue submission to ensure this image is available.
+    const double acquireStartTime { getAbsoluteTime() };
     const std::optional<uint32_t> imageIndex {
         m_swapchain->acquireNextImageIndex(
             m_framebufferWidth,
@@ -508,17 +626,32 @@ auto Backend::beginFrame(const float deltaTime) -> bool {
         )
     };
 
+    m_presentWaitTime += getAbsoluteTime() - acquireStartTime;
+
     if (!imageIndex.has_value()) {
         return false;
     }
 
     m_imageIndex = imageIndex.value();
+    m_instanceCount = 0u;
+    m_culledFirstInstance = 0u;
+    m_culledInstanceCount = 0u;
 
     // Begin recording commands.
     std::shared_ptr<CommandBuffer> graphicsCommandBuffer { m_graphicsCommandBuffers.at(m_imageIndex) };
     graphicsCommandBuffer->reset();
     graphicsCommandBuffer->begin(false, false, false);
 
+    if (m_timestampQueryPool != VK_NULL_HANDLE) {
+        vkCmdResetQueryPool(graphicsCommandBuffer->getHandle(), m_timestampQueryPool, currentFrame * 2u, 2u);
+        vkCmdWriteTimestamp(
+            graphicsCommandBuffer->getHandle(),
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            m_timestampQueryPool,
+            currentFrame * 2u
+        );
+    }
+
     // Dynamic state.
     const VkViewport viewport {
         0.0f,                                     // x
@@ -550,6 +683,12 @@ auto Backend::beginFrame(const float deltaTime) -> bool {
     vkCmdSetViewport(graphicsCommandBufferHandle, 0u, 1u, &viewport);
     vkCmdSetScissor(graphicsCommandBufferHandle, 0u, 1u, &scissor);
 
+    return true;
+}
+
+auto Backend::beginRenderPass() -> void {
+    const std::shared_ptr<CommandBuffer> graphicsCommandBuffer { m_graphicsCommandBuffers.at(m_imageIndex) };
+
     m_mainRenderPass->setW(static_cast<float>(m_framebufferWidth));
     m_mainRenderPass->setH(static_cast<float>(m_framebufferHeight));
 
@@ -558,7 +697,12 @@ auto Backend::beginFrame(const float deltaTime) -> bool {
         m_framebuffers.at(m_imageIndex)->getFramebuffer()
     );
 
-    return true;
+    // Every geometry lives in the same buffers, draws only pick their ranges.
+    m_geometryPool->bind(graphicsCommandBuffer->getHandle());
+}
+
+auto Backend::endRenderPass() -> void {
+    m_mainRenderPass->end(m_graphicsCommandBuffers.at(m_imageIndex));
 }
 
 auto Backend::updateGlobalState(
@@ -576,26 +720,40 @@ auto Backend::updateGlobalState(
 
     // TODO: Other uniform object properties.
 
-    m_materialShader->updateGlobalState(m_imageIndex, graphicsCommandBufferHandle, m_frameDeltaTime);
+    m_materialShader->updateGlobalState(
+        m_imageIndex,
+        graphicsCommandBufferHandle,
+        *m_instanceBuffers.at(m_swapchain->getCurrentFrame()),
+        m_frameDeltaTime
+    );
 }
 
 auto Backend::endFrame(const float deltaTime) -> bool {
     const std::shared_ptr<CommandBuffer> graphicsCommandBuffer { m_graphicsCommandBuffers.at(m_imageIndex) };
+    const uint32_t currentFrame { m_swapchain->getCurrentFrame() };
 
-    // End render pass.
-    m_mainRenderPass->end(graphicsCommandBuffer);
+    if (m_timestampQueryPool != VK_NULL_HANDLE) {
+        vkCmdWriteTimestamp(
+            graphicsCommandBuffer->getHandle(),
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            m_timestampQueryPool,
+            currentFrame * 2u + 1u
+        );
+    }
 
     graphicsCommandBuffer->end();
 
     // Make sure the previous frame is not using this image.
     const std::shared_ptr<Fence> fence { m_imagesInFlight.at(m_imageIndex) };
+    const double fenceWaitStartTime { getAbsoluteTime() };
 
     if (fence != nullptr) {
         fence->wait(UINT64_MAX);
     }
 
+    m_presentWaitTime += getAbsoluteTime() - fenceWaitStartTime;
+
     // Mark the image fence as in-use by this frame.
-    const uint32_t currentFrame { m_swapchain->getCurrentFrame() };
     const std::shared_ptr<Fence> currentInFlightFence { m_inFlightFences.at(currentFrame) };
     m_imagesInFlight.at(m_imageIndex) = currentInFlightFence;
 
@@ -609,15 +767,18 @@ auto Backend::endFrame(const float deltaTime) -> bool {
 
     const VkSemaphore currentQueueCompleteSemaphore { m_queueCompleteSemaphores.at(currentFrame) };
 
+    // Offscreen images are not acquired or presented, so there is nothing to wait for or signal.
+    const uint32_t semaphoreCount { m_swapchain->isOffscreen() ? 0u : 1u };
+
     const VkSubmitInfo submitInfo {
         VK_STRUCTURE_TYPE_SUBMIT_INFO,                // sType
         nullptr,                                      // pNext
-        1u,                                           // waitSemaphoreCount
+        semaphoreCount,                               // waitSemaphoreCount
         &m_imageAvailableSemaphores.at(currentFrame), // pWaitSemaphores
         &pipelineStageFlags,                          // pWaitDstStageMask
         1u,                                           // commandBufferCount
         &graphicsCommandBuffer->getHandle(),          // pCommandBuffers
-        1u,                                           // signalSemaphoreCount
+        semaphoreCount,                               // signalSemaphoreCount
         &currentQueueCompleteSemaphore                // pSignalSemaphores
     };
 
@@ -639,9 +800,12 @@ auto Backend::endFrame(const float deltaTime) -> bool {
     }
 
     graphicsCommandBuffer->updateSubmitted();
+    m_areTimestampsWritten.at(currentFrame) = m_timestampQueryPool != VK_NULL_HANDLE;
     // End queue submission.
 
     // Give the image back to the swapchain.
+    const double presentStartTime { getAbsoluteTime() };
+
     m_swapchain->present(
         m_framebufferWidth,
         m_framebufferHeight,
@@ -651,34 +815,158 @@ auto Backend::endFrame(const float deltaTime) -> bool {
         m_imageIndex
     );
 
+    m_presentWaitTime += getAbsoluteTime() - presentStartTime;
+    m_frameTimings.presentWaitTime = static_cast<float>(m_presentWaitTime * 1000.0);
+
     return true;
 }
 
 auto Backend::updateObject(
-    const GeometryRenderData& geometryRenderData
+    const GeometryRenderData& geometryRenderData,
+    const resources::TexturePool& texturePool
 ) -> void {
+    const GeometryPool::Geometry* geometry { m_geometryPool->resolve(geometryRenderData.geometry) };
+
+    if (geometry == nullptr) {
+        return;
+    }
+
+    if (m_instanceCount >= m_maxInstanceCount) {
+        core::Logger::warn("The instance buffer is full, the object is not drawn!");
+        return;
+    }
+
+    const uint32_t lodIndex { geometryRenderData.lod < geometry->lodCount ? geometryRenderData.lod : geometry->lodCount - 1u };
+    const resources::GeometryLod& lod { geometry->lods.at(lodIndex) };
+
+    m_instanceObjects.at(m_swapchain->getCurrentFrame())[m_instanceCount] = InstanceObject {
+        geometryRenderData.model,                    // model
+        glm::vec4(0.0f),                             // boundingSphere
+        lod.indexCount,                              // indexCount
+        geometry->firstIndex + lod.firstIndex,       // firstIndex
+        static_cast<int32_t>(geometry->firstVertex), // vertexOffset
+        0u                                           // reserved_0
+    };
+
     m_materialShader->updateObject(
         m_graphicsCommandBuffers.at(m_imageIndex)->getHandle(),
         m_imageIndex,
         geometryRenderData,
+        texturePool,
         m_frameDeltaTime
     );
 
-    // TODO: Temporary test code
     const VkCommandBuffer graphicsCommandBufferHandle { m_graphicsCommandBuffers.at(m_imageIndex)->getHandle() };
 
     m_materialShader->use(graphicsCommandBufferHandle);
 
-    // Bind vertex buffer and offset.
-    const std::array<VkDeviceSize, 1u> offsets{ 0u };
-    vkCmdBindVertexBuffers(graphicsCommandBufferHandle, 0u, 1u, &m_objectVertexBuffer->getHandle(), offsets.data());
+    // Issue the draw, the buffers were bound in beginRenderPass(). The first instance picks the instance object.
+    vkCmdDrawIndexed(
+        graphicsCommandBufferHandle,
+        lod.indexCount,
+        1u,
+        geometry->firstIndex + lod.firstIndex,
+        static_cast<int32_t>(geometry->firstVertex),
+        m_instanceCount
+    );
 
-    // Bind index buffer and offset.
-    vkCmdBindIndexBuffer(graphicsCommandBufferHandle, m_objectIndexBuffer->getHandle(), 0u, VK_INDEX_TYPE_UINT32);
+    m_instanceCount++;
+}
 
-    // Issue the draw.
-    vkCmdDrawIndexed(graphicsCommandBufferHandle, 6u, 1u, 0u, 0u, 0u);
-    // TODO: End temporary test code
+auto Backend::cullInstances(
+    const std::vector<GeometryRenderData>& instances,
+    const std::vector<glm::vec4>& boundingSpheres,
+    const std::array<float, 24u>& frustumPlanes
+) -> bool {
+    if (m_cullingShader == nullptr || instances.empty()) {
+        return false;
+    }
+
+    if (instances.size() > static_cast<std::size_t>(m_maxInstanceCount - m_instanceCount)) {
+        core::Logger::warn("Too many instances to cull on the device, culling them on the host!");
+        return false;
+    }
+
+    const uint32_t currentFrame { m_swapchain->getCurrentFrame() };
+    const uint32_t instanceCount { static_cast<uint32_t>(instances.size()) };
+    Buffer& instanceBuffer { *m_instanceBuffers.at(currentFrame) };
+
+    InstanceObject* instanceObjects { m_instanceObjects.at(currentFrame) + m_instanceCount };
+
+    for (uint32_t i { 0u }; i < instanceCount; i++) {
+        const GeometryRenderData& instance { instances.at(i) };
+        const GeometryPool::Geometry* geometry { m_geometryPool->resolve(instance.geometry) };
+        InstanceObject& instanceObject { instanceObjects[i] };
+
+        instanceObject.model = instance.model;
+        instanceObject.boundingSphere = boundingSpheres.at(i);
+        instanceObject.reserved_0 = 0u;
+
+        // Stale geometry is kept as an empty draw, so the indices still match the submitted instances.
+        if (geometry == nullptr) {
+            instanceObject.indexCount = 0u;
+            instanceObject.firstIndex = 0u;
+            instanceObject.vertexOffset = 0;
+            continue;
+        }
+
+        const uint32_t lodIndex { instance.lod < geometry->lodCount ? instance.lod : geometry->lodCount - 1u };
+        const resources::GeometryLod& lod { geometry->lods.at(lodIndex) };
+
+        instanceObject.indexCount = lod.indexCount;
+        instanceObject.firstIndex = geometry->firstIndex + lod.firstIndex;
+        instanceObject.vertexOffset = static_cast<int32_t>(geometry->firstVertex);
+    }
+
+    m_cullingShader->dispatch(
+        m_graphicsCommandBuffers.at(m_imageIndex)->getHandle(),
+        currentFrame,
+        instanceBuffer,
+        m_instanceCount,
+        instanceCount,
+        frustumPlanes
+    );
+
+    m_culledFirstInstance = m_instanceCount;
+    m_culledInstanceCount = instanceCount;
+    m_instanceCount += instanceCount;
+
+    return true;
+}
+
+auto Backend::drawInstances(
+    const GeometryRenderData& geometryRenderData,
+    const resources::TexturePool& texturePool
+) -> void {
+    if (m_culledInstanceCount == 0u) {
+        return;
+    }
+
+    const VkCommandBuffer graphicsCommandBufferHandle { m_graphicsCommandBuffers.at(m_imageIndex)->getHandle() };
+
+    m_materialShader->updateObject(
+        graphicsCommandBufferHandle,
+        m_imageIndex,
+        geometryRenderData,
+        texturePool,
+        m_frameDeltaTime
+    );
+
+    m_materialShader->use(graphicsCommandBufferHandle);
+
+    m_cullingShader->draw(graphicsCommandBufferHandle, m_swapchain->getCurrentFrame(), m_culledInstanceCount);
+}
+
+auto Backend::getFrameTimings() const -> FrameTimings {
+    return m_frameTimings;
+}
+
+auto Backend::getMaxFramesInFlight() const -> uint32_t {
+    return m_swapchain->getMaxFramesInFlight();
+}
+
+auto Backend::acquireObjectResources() -> std::optional<resources::ObjectId> {
+    return m_materialShader->acquireResources();
 }
 
 auto Backend::createTexture(
@@ -686,7 +974,9 @@ auto Backend::createTexture(
     const int32_t width,
     const int32_t height,
     const int32_t channelCount,
+    const resources::TextureFormat format,
     const void* pixels,
+    const uint32_t mipLevelCount,
     const bool hasTransparency
 ) -> std::shared_ptr<resources::ITexture> {
     return std::make_shared<Texture>(
@@ -694,13 +984,364 @@ auto Backend::createTexture(
         width,
         height,
         channelCount,
+        format,
         pixels,
+        mipLevelCount,
         hasTransparency,
         m_allocationCallbacks,
         m_device
     );
 }
 
+auto Backend::createPendingTexture(const std::string& name) -> std::shared_ptr<resources::ITexture> {
+    return std::make_shared<Texture>(
+        name,
+        m_allocationCallbacks,
+        m_device
+    );
+}
+
+auto Backend::uploadTextures(const std::vector<TextureUpload>& textureUploads) -> uint64_t {
+    if (textureUploads.empty()) {
+        return m_uploadBatch;
+    }
+
+    // Every texture gets a 16 byte aligned range of one staging buffer, which satisfies the block size of all formats.
+    const uint64_t stagingAlignment { 16u };
+
+    std::vector<std::shared_ptr<Texture>> textures;
+    std::vector<Texture::Upload> uploads;
+    std::vector<uint64_t> stagingOffsets;
+    uint64_t stagingSize { 0u };
+
+    for (const TextureUpload& textureUpload : textureUploads) {
+        std::shared_ptr<Texture> texture { std::dynamic_pointer_cast<Texture>(textureUpload.texture) };
+
+        if (texture == nullptr) {
+            core::Logger::warn("Tried to upload data to a texture not created by the Vulkan backend!");
+            continue;
+        }
+
+        // A texture uploaded twice in one batch only keeps the later data.
+        const std::vector<std::shared_ptr<Texture>>::const_iterator batchedTexture {
+            std::find(textures.begin(), textures.end(), texture)
+        };
+
+        // The pending image of an earlier batch may still be written, which is rare enough to wait for.
+        if (batchedTexture == textures.end() && texture->hasPendingUpload()) {
+            completeUploads(true);
+        }
+
+        // Textures may be re-uploaded while frames still sample the current image, the data goes to a pending one.
+        // Moved rather than copied, pixels may point into the generated chain it owns.
+        Texture::Upload upload {
+            texture->prepareUpload(
+                textureUpload.width,
+                textureUpload.height,
+                textureUpload.channelCount,
+                textureUpload.format,
+                textureUpload.pixels,
+                textureUpload.mipLevelCount,
+                textureUpload.hasTransparency
+            )
+        };
+
+        if (batchedTexture != textures.end()) {
+            uploads.at(static_cast<std::size_t>(batchedTexture - textures.begin())) = std::move(upload);
+        } else {
+            uploads.push_back(std::move(upload));
+            textures.push_back(texture);
+        }
+    }
+
+    for (const Texture::Upload& upload : uploads) {
+        stagingOffsets.push_back(stagingSize);
+        stagingSize += (upload.size + stagingAlignment - 1u) / stagingAlignment * stagingAlignment;
+    }
+
+    if (uploads.empty()) {
+        return m_uploadBatch;
+    }
+
+    const VkBufferUsageFlags bufferUsageFlags {
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+    };
+
+    const VkMemoryPropertyFlags memoryPropertyFlags {
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+    };
+
+    std::unique_ptr<Buffer> staging {
+        std::make_unique<Buffer>(
+            m_allocationCallbacks,
+            m_device,
+            stagingSize,
+            bufferUsageFlags,
+            memoryPropertyFlags,
+            true
+        )
+    };
+
+    // The staging buffer and command buffer live until the fence of the batch signals.
+    PendingUpload pendingUpload {
+        ++m_uploadBatch,                                                 // batch
+        std::make_unique<Fence>(m_allocationCallbacks, m_device, false), // fence
+        std::move(staging),                                              // staging
+        std::make_unique<CommandBuffer>(m_device),                       // commandBuffer
+        std::move(textures)                                              // textures
+    };
+
+    // One mapping for the whole batch.
+    std::byte* stagingData { static_cast<std::byte*>(pendingUpload.staging->lockMemory(0u, stagingSize, 0u)) };
+
+    for (size_t i { 0u }; i < uploads.size(); i++) {
+        std::memcpy(stagingData + stagingOffsets.at(i), uploads.at(i).pixels, static_cast<std::size_t>(uploads.at(i).size));
+    }
+
+    pendingUpload.staging->unlockMemory();
+
+    const VkCommandPool commandPool { m_device->getGraphicsCommandPool() };
+    const VkQueue queue { m_device->getGraphicsQueue() };
+
+    pendingUpload.commandBuffer->allocateAndBeginSingleUse(commandPool);
+
+    for (size_t i { 0u }; i < uploads.size(); i++) {
+        pendingUpload.textures.at(i)->recordUpload(
+            uploads.at(i),
+            pendingUpload.staging->getHandle(),
+            stagingOffsets.at(i),
+            pendingUpload.commandBuffer->getHandle()
+        );
+    }
+
+    // Frames keep drawing the current images meanwhile, only the fence of this batch is ever waited on.
+    pendingUpload.commandBuffer->submitSingleUse(queue, pendingUpload.fence->getFence());
+
+    m_pendingUploads.push_back(std::move(pendingUpload));
+
+    return m_uploadBatch;
+}
+
+auto Backend::completeUploads(const bool wait) -> uint64_t {
+    const VkCommandPool commandPool { m_device->getGraphicsCommandPool() };
+
+    while (!m_pendingUploads.empty()) {
+        PendingUpload& pendingUpload { m_pendingUploads.front() };
+
+        const bool isFinished {
+            wait
+            ? pendingUpload.fence->wait(UINT64_MAX)
+            : pendingUpload.fence->isSignaled()
+        };
+
+        if (!isFinished) {
+            break;
+        }
+
+        // Frames recorded from now on draw the new images, frames in flight keep the retired ones alive.
+        for (const std::shared_ptr<Texture>& texture : pendingUpload.textures) {
+            texture->completeUpload(*m_deletionQueue);
+        }
+
+        pendingUpload.commandBuffer->free(commandPool);
+        m_completedUploadBatch = pendingUpload.batch;
+        m_pendingUploads.pop_front();
+    }
+
+    return m_completedUploadBatch;
+}
+
+auto Backend::destroyTexture(std::shared_ptr<resources::ITexture> texture) -> void {
+    std::shared_ptr<Texture> vulkanTexture { std::dynamic_pointer_cast<Texture>(texture) };
+
+    // A pending image is left to its upload batch, which holds the texture until the device is done writing it.
+    if (vulkanTexture != nullptr) {
+        vulkanTexture->retire(*m_deletionQueue);
+    }
+}
+
+auto Backend::setDefaultTexture(std::shared_ptr<resources::ITexture> texture) -> void {
+    m_materialShader->setDefaultTexture(std::dynamic_pointer_cast<Texture>(texture));
+}
+
+auto Backend::supportsTextureFormat(const resources::TextureFormat format) const -> bool {
+    return m_device->supportsSampledFormat(Texture::getVulkanFormat(format));
+}
+
+auto Backend::reloadShaders() -> bool {
+    const bool isMaterialShaderReloaded {
+        m_materialShader->reload(m_framebufferWidth, m_framebufferHeight, *m_deletionQueue)
+    };
+
+    if (m_cullingShader == nullptr) {
+        return isMaterialShaderReloaded;
+    }
+
+    // Both are reloaded even if one fails, each keeps its previous pipeline on failure.
+    const bool isCullingShaderReloaded { m_cullingShader->reload(*m_deletionQueue) };
+
+    return isMaterialShaderReloaded && isCullingShaderReloaded;
+}
+
+auto Backend::createGeometry(
+    const std::vector<math::Vertex3D>& vertices,
+    const std::vector<uint32_t>& indices,
+    const std::vector<resources::GeometryLod>& lods
+) -> resources::GeometryHandle {
+    return m_geometryPool->upload(vertices, indices, lods, *m_deletionQueue);
+}
+
+auto Backend::destroyGeometry(const resources::GeometryHandle geometry) -> void {
+    m_geometryPool->free(geometry, *m_deletionQueue);
+}
+
+auto Backend::readFramebuffer(std::vector<std::byte>& pixels) -> bool {
+    if (!m_swapchain->isOffscreen()) {
+        core::Logger::warn("Backend::readFramebuffer - only offscreen images can be read back!");
+        return false;
+    }
+
+    if (m_imagesInFlight.at(m_imageIndex) == nullptr) {
+        core::Logger::warn("Backend::readFramebuffer - no frame was rendered yet!");
+        return false;
+    }
+
+    vkDeviceWaitIdle(m_device->getLogicalDevice());
+
+    // Offscreen images use a format with 4 bytes per pixel.
+    const uint64_t size { static_cast<uint64_t>(m_framebufferWidth) * m_framebufferHeight * 4u };
+
+    const VkMemoryPropertyFlags memoryPropertyFlags {
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+    };
+
+    Buffer readback {
+        m_allocationCallbacks,
+        m_device,
+        size,
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        memoryPropertyFlags,
+        true
+    };
+
+    const VkImage image { m_swapchain->getImages().at(m_imageIndex) };
+
+    const VkImageSubresourceRange imageSubresourceRange {
+        VK_IMAGE_ASPECT_COLOR_BIT, // aspectMask
+        0u,                        // baseMipLevel
+        1u,                        // levelCount
+        0u,                        // baseArrayLayer
+        1u                         // layerCount
+    };
+
+    // The render pass already left the image in the transfer source layout, only its writes have to be visible.
+    const VkImageMemoryBarrier imageMemoryBarrier {
+        VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER, // sType
+        nullptr,                                // pNext
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,   // srcAccessMask
+        VK_ACCESS_TRANSFER_READ_BIT,            // dstAccessMask
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,   // oldLayout
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,   // newLayout
+        VK_QUEUE_FAMILY_IGNORED,                // srcQueueFamilyIndex
+        VK_QUEUE_FAMILY_IGNORED,                // dstQueueFamilyIndex
+        image,                                  // image
+        imageSubresourceRange                   // subresourceRange
+    };
+
+    const VkImageSubresourceLayers imageSubresourceLayers {
+        VK_IMAGE_ASPECT_COLOR_BIT, // aspectMask
+        0u,                        // mipLevel
+        0u,                        // baseArrayLayer
+        1u                         // layerCount
+    };
+
+    const VkOffset3D offset {
+        0, // x
+        0, // y
+        0  // z
+    };
+
+    const VkExtent3D extent {
+        m_framebufferWidth,  // width
+        m_framebufferHeight, // height
+        1u                   // depth
+    };
+
+    const VkBufferImageCopy bufferImageCopy {
+        0u,                     // bufferOffset
+        0u,                     // bufferRowLength
+        0u,                     // bufferImageHeight
+        imageSubresourceLayers, // imageSubresource
+        offset,                 // imageOffset
+        extent                  // imageExtent
+    };
+
+    const VkBufferMemoryBarrier bufferMemoryBarrier {
+        VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER, // sType
+        nullptr,                                 // pNext
+        VK_ACCESS_TRANSFER_WRITE_BIT,            // srcAccessMask
+        VK_ACCESS_HOST_READ_BIT,                 // dstAccessMask
+        VK_QUEUE_FAMILY_IGNORED,                 // srcQueueFamilyIndex
+        VK_QUEUE_FAMILY_IGNORED,                 // dstQueueFamilyIndex
+        readback.getHandle(),                    // buffer
+        0u,                                      // offset
+        VK_WHOLE_SIZE                            // size
+    };
+
+    const VkCommandPool commandPool { m_device->getGraphicsCommandPool() };
+    const VkQueue queue { m_device->getGraphicsQueue() };
+
+    CommandBuffer temporaryCommandBuffer { m_device };
+    temporaryCommandBuffer.allocateAndBeginSingleUse(commandPool);
+
+    vkCmdPipelineBarrier(
+        temporaryCommandBuffer.getHandle(),
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0u,
+        0u,
+        nullptr,
+        0u,
+        nullptr,
+        1u,
+        &imageMemoryBarrier
+    );
+
+    vkCmdCopyImageToBuffer(
+        temporaryCommandBuffer.getHandle(),
+        image,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        readback.getHandle(),
+        1u,
+        &bufferImageCopy
+    );
+
+    vkCmdPipelineBarrier(
+        temporaryCommandBuffer.getHandle(),
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT,
+        0u,
+        0u,
+        nullptr,
+        1u,
+        &bufferMemoryBarrier,
+        0u,
+        nullptr
+    );
+
+    temporaryCommandBuffer.endSingleUse(commandPool, queue);
+
+    pixels.resize(static_cast<std::size_t>(size));
+
+    const void* data { readback.lockMemory(0u, size, 0u) };
+    std::memcpy(pixels.data(), data, static_cast<std::size_t>(size));
+    readback.unlockMemory();
+
+    return true;
+}
+
 auto Backend::regenerateFramebuffers() -> void {
     const std::vector<VkImageView> swapchainImageViews { m_swapchain->getImageViews() };
     const std::shared_ptr<Image> swapchainDepthAttachment { m_swapchain->getDepthAttachment() };
@@ -816,75 +1457,6 @@ auto Backend::recreateSwapchain() -> bool {
     return true;
 }
 
-auto Backend::createBuffers() -> void {
-    const VkMemoryPropertyFlags memoryPropertyFlags {
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-    };
-
-    const VkBufferUsageFlags vertexBufferUsageFlags {
-        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
-        VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT
-    };
-    const uint64_t vertexBufferSize { sizeof(glm::vec3) * 1024u * 1024u };
-    m_objectVertexBuffer = std::make_unique<Buffer>(
-        m_allocationCallbacks,
-        m_device,
-        vertexBufferSize,
-        vertexBufferUsageFlags,
-        memoryPropertyFlags,
-        true
-    );
-    m_geometryVertexOffset = 0u;
-
-    const VkBufferUsageFlags indexBufferUsageFlags {
-        VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
-        VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT
-    };
-    const uint64_t indexBufferSize { sizeof(uint32_t) * 1024u * 1024u };
-    m_objectIndexBuffer = std::make_unique<Buffer>(
-        m_allocationCallbacks,
-        m_device,
-        indexBufferSize,
-        indexBufferUsageFlags,
-        memoryPropertyFlags,
-        true
-    );
-    m_geometryIndexOffset = 0u;
-}
-
-auto Backend::uploadDataRange(
-    const VkCommandPool& commandPool,
-    const VkFence& fence,
-    const VkQueue& queue,
-    const VkBuffer& buffer,
-    const uint64_t offset,
-    const uint64_t size,
-    void* data
-) -> void {
-    const VkMemoryPropertyFlags memoryPropertyFlags {
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-    };
-
-    const VkBufferUsageFlags bufferUsageFlags {
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT
-    };
-
-    Buffer staging {
-        m_allocationCallbacks,
-        m_device,
-        size,
-        bufferUsageFlags,
-        memoryPropertyFlags,
-        true
-    };
-
-    staging.loadData(0u, size, 0u, data);
-    staging.copyTo(commandPool, fence, queue, staging.getHandle(), 0u, buffer, offset, size);
-}
-
 } // namespace vulkan
 } // namespace renderer
 } // namespace beige
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../Defines.hpp"
 #include "../IRendererBackend.hpp"
 
 #include "VulkanSurface.hpp"
@@ -10,20 +11,34 @@
 #include "VulkanFence.hpp"
 #include "VulkanBuffer.hpp"
 #include "VulkanTexture.hpp"
+#include "VulkanDeletionQueue.hpp"
+#include "VulkanGeometryPool.hpp"
 #include "shaders/VulkanMaterialShader.hpp"
+#include "shaders/VulkanCullingShader.hpp"
 #include "../../resources/ITexture.hpp"
 
+#include <cstddef>
+#include <deque>
+
 namespace beige {
 namespace renderer {
 namespace vulkan {
 
-class Backend final : public IBackend {
+class BEIGE_API Backend final : public IBackend {
+private:
+    static constexpr uint32_t m_maxInstanceCount { 65536u };
+
 public:
+    /**
+     * @param platform If nullptr, no surface is created and frames are rendered into offscreen images of the
+     * given size, which needs no display.
+     */
     Backend(
         const std::string& appName,
         const uint32_t width,
         const uint32_t height,
-        std::shared_ptr<platform::Platform> platform
+        std::shared_ptr<platform::Platform> platform,
+        std::shared_ptr<const core::Vfs> vfs
     );
     ~Backend();
 
@@ -39,21 +54,72 @@ public:
     ) -> void override;
     auto endFrame(const float deltaTime) -> bool override;
 
+    auto beginRenderPass() -> void override;
+    auto endRenderPass() -> void override;
+
     auto updateObject(
-        const GeometryRenderData& geometryRenderData
+        const GeometryRenderData& geometryRenderData,
+        const resources::TexturePool& texturePool
+    ) -> void override;
+
+    auto cullInstances(
+        const std::vector<GeometryRenderData>& instances,
+        const std::vector<glm::vec4>& boundingSpheres,
+        const std::array<float, 24u>& frustumPlanes
+    ) -> bool override;
+    auto drawInstances(
+        const GeometryRenderData& geometryRenderData,
+        const resources::TexturePool& texturePool
     ) -> void override;
 
+    auto getFrameTimings() const -> FrameTimings override;
+    auto getMaxFramesInFlight() const -> uint32_t override;
+    auto acquireObjectResources() -> std::optional<resources::ObjectId> override;
+
     auto createTexture(
         const std::string& name,
         const int32_t width,
         const int32_t height,
         const int32_t channelCount,
+        const resources::TextureFormat format,
         const void* pixels,
+        const uint32_t mipLevelCount,
         const bool hasTransparency
     ) -> std::shared_ptr<resources::ITexture> override;
+    auto createPendingTexture(const std::string& name) -> std::shared_ptr<resources::ITexture> override;
+    auto uploadTextures(const std::vector<TextureUpload>& textureUploads) -> uint64_t override;
+    auto completeUploads(const bool wait) -> uint64_t override;
+    auto destroyTexture(std::shared_ptr<resources::ITexture> texture) -> void override;
+    auto setDefaultTexture(std::shared_ptr<resources::ITexture> texture) -> void override;
+    auto supportsTextureFormat(const resources::TextureFormat format) const -> bool override;
+    auto reloadShaders() -> bool override;
+
+    auto createGeometry(
+        const std::vector<math::Vertex3D>& vertices,
+        const std::vector<uint32_t>& indices,
+        const std::vector<resources::GeometryLod>& lods
+    ) -> resources::GeometryHandle override;
+    auto destroyGeometry(const resources::GeometryHandle geometry) -> void override;
+
+    /**
+     * Waits for the device and copies the last rendered offscreen image to the host.
+     * @param pixels Receives the image as tightly packed Rgba8 rows, top row first.
+     * @returns False if the frames are presented to a surface or nothing was rendered yet.
+     */
+    auto readFramebuffer(std::vector<std::byte>& pixels) -> bool;
 
 private:
+    // A batch of texture uploads the device may still be working on.
+    struct PendingUpload {
+        uint64_t batch;
+        std::unique_ptr<Fence> fence;
+        std::unique_ptr<Buffer> staging;
+        std::unique_ptr<CommandBuffer> commandBuffer;
+        std::vector<std::shared_ptr<Texture>> textures;
+    };
+
     std::shared_ptr<platform::Platform> m_platform;
+    std::shared_ptr<const core::Vfs> m_vfs;
 
     float m_frameDeltaTime;
 
@@ -75,35 +141,44 @@ private:
     bool m_recreatingSwapchain;
     std::shared_ptr<RenderPass> m_mainRenderPass;
 
-    std::unique_ptr<Buffer> m_objectVertexBuffer;
-    std::unique_ptr<Buffer> m_objectIndexBuffer;
+    // Vertices and indices of every geometry, bound once per frame.
+    std::unique_ptr<GeometryPool> m_geometryPool;
 
     uint32_t m_imageIndex;
     std::vector<std::shared_ptr<Framebuffer>> m_framebuffers; // Framebuffers used for on-screen rendering
     std::vector<std::shared_ptr<CommandBuffer>> m_graphicsCommandBuffers;
     std::shared_ptr<MaterialShader> m_materialShader;
+    std::unique_ptr<CullingShader> m_cullingShader;
+
+    // Instance objects of every draw, one buffer per frame in flight. Draws pick theirs by the first instance.
+    std::vector<std::unique_ptr<Buffer>> m_instanceBuffers;
+    std::vector<InstanceObject*> m_instanceObjects; // Mapped for the lifetime of the buffers, they are host coherent.
+    uint32_t m_instanceCount;
+    uint32_t m_culledFirstInstance;
+    uint32_t m_culledInstanceCount;
+
+    // Replaced textures and pipelines wait here until the frames in flight are done with them.
+    std::unique_ptr<DeletionQueue> m_deletionQueue;
+
+    // Submitted texture uploads, oldest first. Fences signal in any order, batches are completed in order.
+    std::deque<PendingUpload> m_pendingUploads;
+    uint64_t m_uploadBatch;
+    uint64_t m_completedUploadBatch;
 
     std::vector<VkSemaphore> m_imageAvailableSemaphores;
     std::vector<VkSemaphore> m_queueCompleteSemaphores;
     std::vector<std::shared_ptr<Fence>> m_inFlightFences;
     std::vector<std::shared_ptr<Fence>> m_imagesInFlight; // Holds pointers to fences which exist and are owned elsewhere
 
-    uint64_t m_geometryVertexOffset;
-    uint64_t m_geometryIndexOffset;
+    // A timestamp at the start and the end of every frame in flight, read once its fence signals.
+    VkQueryPool m_timestampQueryPool;
+    std::vector<bool> m_areTimestampsWritten;
+    FrameTimings m_frameTimings;
+    double m_presentWaitTime; // In seconds, summed over the frame.
 
     auto regenerateFramebuffers() -> void;
     auto createCommandBuffers() -> void;
     auto recreateSwapchain() -> bool;
-    auto createBuffers() -> void;
-    auto uploadDataRange(
-        const VkCommandPool& commandPool,
-        const VkFence& fence,
-        const VkQueue& queue,
-        const VkBuffer& buffer,
-        const uint64_t offset,
-        const uint64_t size,
-        void* data
-    ) -> void;
 };
 
 } // namespace vulkan
@@ -3,6 +3,7 @@
 #include "VulkanDefines.hpp"
 #include "VulkanUtils.hpp"
 #include "VulkanCommandBuffer.hpp"
+#include "../../core/Memory.hpp"
 
 namespace beige {
 namespace renderer {
@@ -23,6 +24,7 @@ m_handle { VK_NULL_HANDLE },
 m_bufferUsageFlags { bufferUsageFlags },
 m_isLocked { false },
 m_deviceMemory { VK_NULL_HANDLE },
+m_deviceMemorySize { 0u },
 m_memoryIndex { 0u },
 m_memoryPropertyFlags { memoryPropertyFlags } {
     const VkBufferCreateInfo bufferCreateInfo {
@@ -82,6 +84,9 @@ m_memoryPropertyFlags { memoryPropertyFlags } {
         throw std::exception(message.c_str());
     }
 
+    m_deviceMemorySize = memoryRequirements.size;
+    core::Memory::addExternal(static_cast<std::size_t>(m_deviceMemorySize), core::MemoryTag::DeviceBuffer);
+
     if (bindOnCreate) {
         bind(0u);
     }
@@ -92,6 +97,7 @@ Buffer::~Buffer() {
 
     if (m_deviceMemory != VK_NULL_HANDLE) {
         vkFreeMemory(logicalDevice, m_deviceMemory, m_allocationCallbacks);
+        core::Memory::removeExternal(static_cast<std::size_t>(m_deviceMemorySize), core::MemoryTag::DeviceBuffer);
     }
 
     if (m_handle != VK_NULL_HANDLE) {
@@ -159,6 +165,8 @@ auto Buffer::resize(
         return false;
     }
 
+    core::Memory::addExternal(static_cast<std::size_t>(memoryRequirements.size), core::MemoryTag::DeviceBuffer);
+
     VULKAN_CHECK(vkBindBufferMemory(logicalDevice, newBuffer, newDeviceMemory, 0u));
 
     copyTo(
@@ -176,6 +184,7 @@ auto Buffer::resize(
 
     if (m_deviceMemory != VK_NULL_HANDLE) {
         vkFreeMemory(logicalDevice, m_deviceMemory, m_allocationCallbacks);
+        core::Memory::removeExternal(static_cast<std::size_t>(m_deviceMemorySize), core::MemoryTag::DeviceBuffer);
         m_deviceMemory = VK_NULL_HANDLE;
     }
 
@@ -186,6 +195,7 @@ auto Buffer::resize(
 
     m_totalSize = newSize;
     m_deviceMemory = newDeviceMemory;
+    m_deviceMemorySize = memoryRequirements.size;
     m_handle = newBuffer;
 
     return true;
@@ -67,6 +67,7 @@ private:
     VkBufferUsageFlags m_bufferUsageFlags;
     bool m_isLocked;
     VkDeviceMemory m_deviceMemory;
+    uint64_t m_deviceMemorySize; // Counted under the DeviceBuffer memory tag while allocated.
     uint32_t m_memoryIndex;
     uint32_t m_memoryPropertyFlags;
 };
@@ -163,6 +163,36 @@ auto CommandBuffer::endSingleUse(
     free(commandPool);
 }
 
+auto CommandBuffer::submitSingleUse(
+    const VkQueue& queue,
+    const VkFence& fence
+) -> void {
+    end();
+
+    const VkSubmitInfo submitInfo {
+        VK_STRUCTURE_TYPE_SUBMIT_INFO, // sType
+        nullptr,                       // pNext
+        0u,                            // waitSemaphoreCount
+        nullptr,                       // pWaitSemaphores
+        nullptr,                       // pWaitDstStageMask
+        1u,                            // commandBufferCount
+        &m_handle,                     // pCommandBuffers
+        0u,                            // signalSemaphoreCount
+        nullptr                        // pSignalSemaphores
+    };
+
+    VULKAN_CHECK(
+        vkQueueSubmit(
+            queue,
+            1u,
+            &submitInfo,
+            fence
+        )
+    );
+
+    updateSubmitted();
+}
+
 } // namespace vulkan
 } // namespace renderer
 } // namespace beige
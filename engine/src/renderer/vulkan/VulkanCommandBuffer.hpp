@@ -56,6 +56,14 @@ public:
         const VkQueue& queue
     ) -> void;
 
+    /**
+     * Ends and submits without waiting, the command buffer has to be freed once the fence signals.
+     */
+    auto submitSingleUse(
+        const VkQueue& queue,
+        const VkFence& fence
+    ) -> void;
+
 private:
     std::shared_ptr<Device> m_device;
 
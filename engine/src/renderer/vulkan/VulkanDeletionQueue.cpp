@@ -0,0 +1,45 @@
+#include "VulkanDeletionQueue.hpp"
+
+#include <utility>
+
+namespace beige {
+namespace renderer {
+namespace vulkan {
+
+DeletionQueue::DeletionQueue(const uint32_t frameLatency) :
+m_frameLatency { frameLatency },
+m_frame { 0u },
+m_pendingDeletions { } {
+
+}
+
+DeletionQueue::~DeletionQueue() {
+    flush();
+}
+
+auto DeletionQueue::push(Deletion deletion) -> void {
+    m_pendingDeletions.push_back({ m_frame, std::move(deletion) });
+}
+
+auto DeletionQueue::advanceFrame() -> void {
+    m_frame++;
+
+    // Deletions are pushed in frame order, so the due ones are at the front.
+    while (!m_pendingDeletions.empty() && m_pendingDeletions.front().frame + m_frameLatency <= m_frame) {
+        const Deletion deletion { std::move(m_pendingDeletions.front().deletion) };
+        m_pendingDeletions.pop_front();
+        deletion();
+    }
+}
+
+auto DeletionQueue::flush() -> void {
+    while (!m_pendingDeletions.empty()) {
+        const Deletion deletion { std::move(m_pendingDeletions.front().deletion) };
+        m_pendingDeletions.pop_front();
+        deletion();
+    }
+}
+
+} // namespace vulkan
+} // namespace renderer
+} // namespace beige
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+namespace beige {
+namespace renderer {
+namespace vulkan {
+
+/**
+ * Holds on to resources replaced while the device may still be using them, destroying them once every frame which
+ * could have recorded them has finished. Lets textures and pipelines be swapped without waiting for the device.
+ */
+class DeletionQueue final {
+public:
+    using Deletion = std::function<void()>;
+
+    /**
+     * @param frameLatency The number of frames in flight, deletions run this many frames after they were pushed.
+     */
+    DeletionQueue(const uint32_t frameLatency);
+    ~DeletionQueue();
+
+    DeletionQueue(const DeletionQueue&) = delete;
+    auto operator=(const DeletionQueue&) -> DeletionQueue& = delete;
+
+    auto push(Deletion deletion) -> void;
+
+    /**
+     * Called once per frame after waiting for the in-flight fence of the frame, runs the deletions which are due.
+     */
+    auto advanceFrame() -> void;
+
+    /**
+     * Runs every deletion right away, the device must be idle.
+     */
+    auto flush() -> void;
+
+private:
+    struct PendingDeletion {
+        uint64_t frame; // Frame the resource was replaced in.
+        Deletion deletion;
+    };
+
+    uint32_t m_frameLatency;
+    uint64_t m_frame;
+    std::deque<PendingDeletion> m_pendingDeletions;
+};
+
+} // namespace vulkan
+} // namespace renderer
+} // namespace beige
@@ -33,7 +33,10 @@ m_physicalDeviceProperties { 0 },
 m_physicalDeviceFeatures { 0 },
 m_physicalDeviceMemoryProperties { 0 },
 m_depthFormat { VK_FORMAT_UNDEFINED },
-m_supportsDeviceLocalHostVisible { false } {
+m_supportsDeviceLocalHostVisible { false },
+m_supportsIndirectCount { false },
+m_supportsDrawIndirectFirstInstance { false },
+m_supportsTimestamps { false } {
     if (!selectPhysicalDevice(instance)) {
         throw std::exception("Failed to create device!");
     }
@@ -82,14 +85,63 @@ m_supportsDeviceLocalHostVisible { false } {
     // TODO: Should be config driven
     VkPhysicalDeviceFeatures deviceFeatures { VK_FALSE };
     deviceFeatures.samplerAnisotropy = VK_TRUE;
+    deviceFeatures.textureCompressionBC = m_physicalDeviceFeatures.textureCompressionBC;
 
-    const std::vector<const char*> extensionNames {
-        VK_KHR_SWAPCHAIN_EXTENSION_NAME
-    };
+    if (
+        m_physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_2 &&
+        m_physicalDeviceFeatures.multiDrawIndirect == VK_TRUE
+    ) {
+        VkPhysicalDeviceVulkan12Features supportedVulkan12Features { };
+        supportedVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+        VkPhysicalDeviceFeatures2 supportedFeatures { };
+        supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        supportedFeatures.pNext = &supportedVulkan12Features;
+
+        vkGetPhysicalDeviceFeatures2(m_physicalDevice, &supportedFeatures);
+        m_supportsIndirectCount = supportedVulkan12Features.drawIndirectCount == VK_TRUE;
+    }
+
+    deviceFeatures.multiDrawIndirect = m_supportsIndirectCount ? VK_TRUE : VK_FALSE;
+
+    m_supportsDrawIndirectFirstInstance = m_physicalDeviceFeatures.drawIndirectFirstInstance == VK_TRUE;
+    deviceFeatures.drawIndirectFirstInstance = m_physicalDeviceFeatures.drawIndirectFirstInstance;
+
+    VkPhysicalDeviceVulkan12Features vulkan12Features { };
+    vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    vulkan12Features.drawIndirectCount = VK_TRUE;
+
+    // The structure may only be chained on devices which support Vulkan 1.2.
+    const void* deviceCreateInfoNext { m_supportsIndirectCount ? &vulkan12Features : nullptr };
+
+    const bool canCullOnDevice { m_supportsIndirectCount && m_supportsDrawIndirectFirstInstance };
+
+    core::Logger::info(
+        std::string("Indirect draw count and first instance ") + (canCullOnDevice ? "supported, culling on the device." : "not supported, culling on the host.")
+    );
+
+    uint32_t queueFamilyPropertyCount { 0u };
+    vkGetPhysicalDeviceQueueFamilyProperties(m_physicalDevice, &queueFamilyPropertyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilyProperties(queueFamilyPropertyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(m_physicalDevice, &queueFamilyPropertyCount, queueFamilyProperties.data());
+
+    m_supportsTimestamps =
+        queueFamilyProperties.at(m_graphicsQueueIndex.value()).timestampValidBits > 0u &&
+        m_physicalDeviceProperties.limits.timestampPeriod > 0.0f;
+
+    if (!m_supportsTimestamps) {
+        core::Logger::warn("Graphics queue cannot write timestamps, frames are not timed on the device.");
+    }
+
+    std::vector<const char*> extensionNames;
+
+    if (m_surface != nullptr) {
+        extensionNames.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    }
 
     const VkDeviceCreateInfo deviceCreateInfo {
         VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,                 // sType
-        nullptr,                                              // pNext
+        deviceCreateInfoNext,                                 // pNext
         0u,                                                   // flags
         static_cast<uint32_t>(deviceQueueCreateInfos.size()), // queueCreateInfoCount
         deviceQueueCreateInfos.data(),                        // pQueueCreateInfos
@@ -209,9 +261,68 @@ auto Device::supportsDeviceLocalHostVisible() const -> bool {
     return m_supportsDeviceLocalHostVisible;
 }
 
+auto Device::supportsIndirectCount() const -> bool {
+    return m_supportsIndirectCount;
+}
+
+auto Device::supportsDrawIndirectFirstInstance() const -> bool {
+    return m_supportsDrawIndirectFirstInstance;
+}
+
+auto Device::supportsTimestamps() const -> bool {
+    return m_supportsTimestamps;
+}
+
+auto Device::getTimestampPeriod() const -> float {
+    return m_physicalDeviceProperties.limits.timestampPeriod;
+}
+
+auto Device::supportsLinearBlit(const VkFormat format) const -> bool {
+    VkFormatProperties formatProperties;
+    vkGetPhysicalDeviceFormatProperties(
+        m_physicalDevice,
+        format,
+        &formatProperties
+    );
+
+    const VkFormatFeatureFlags requiredFlags {
+        VK_FORMAT_FEATURE_BLIT_SRC_BIT |
+        VK_FORMAT_FEATURE_BLIT_DST_BIT |
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT
+    };
+
+    return (formatProperties.optimalTilingFeatures & requiredFlags) == requiredFlags;
+}
+
+auto Device::supportsSampledFormat(const VkFormat format) const -> bool {
+    const bool isBlockCompressed { format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_BC7_SRGB_BLOCK };
+
+    if (isBlockCompressed && m_physicalDeviceFeatures.textureCompressionBC != VK_TRUE) {
+        return false;
+    }
+
+    VkFormatProperties formatProperties;
+    vkGetPhysicalDeviceFormatProperties(
+        m_physicalDevice,
+        format,
+        &formatProperties
+    );
+
+    const VkFormatFeatureFlags requiredFlags {
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT
+    };
+
+    return (formatProperties.optimalTilingFeatures & requiredFlags) == requiredFlags;
+}
+
 auto Device::querySwapchainSupport(
     const VkPhysicalDevice& physicalDevice
 ) -> void {
+    if (m_surface == nullptr) {
+        return;
+    }
+
     const VkSurfaceKHR surface { m_surface->getHandle() };
 
     VULKAN_CHECK(
@@ -268,6 +379,7 @@ auto Device::querySwapchainSupport(
 }
 
 auto Device::detectDepthFormat() -> void {
+    // Reverse-Z depends on the float formats for its precision, a normalized format is only the last resort.
     const std::array<VkFormat, 3u> candidates {
         VK_FORMAT_D32_SFLOAT,
         VK_FORMAT_D32_SFLOAT_S8_UINT,
@@ -284,10 +396,12 @@ auto Device::detectDepthFormat() -> void {
             &formatProperties
         );
 
-        if ((formatProperties.linearTilingFeatures & flags) != 0u) {
-            m_depthFormat = candidate;
-            return;
-        } else if ((formatProperties.optimalTilingFeatures & flags) != 0u) {
+        // The depth attachment is created with optimal tiling, linear support says nothing about it.
+        if ((formatProperties.optimalTilingFeatures & flags) != 0u) {
+            if (candidate == VK_FORMAT_D24_UNORM_S8_UINT) {
+                core::Logger::warn("No float depth format is supported, distant geometry may z-fight!");
+            }
+
             m_depthFormat = candidate;
             return;
         }
@@ -357,16 +471,21 @@ auto Device::selectPhysicalDevice(
         }
 
         // TODO: These requirements should probably be driven by engine
+        const bool isPresenting { m_surface != nullptr };
         PhysicalDeviceRequirements physicalDeviceRequirements {
             true, // graphics
-            true, // present
+            isPresenting, // present
             false, // compute
             true, // transfer
-            { VK_KHR_SWAPCHAIN_EXTENSION_NAME }, // deviceExtensionNames
+            { }, // deviceExtensionNames
             true, // samplerAnisotrophy
-            true // discrete
+            isPresenting // discrete
         };
 
+        if (isPresenting) {
+            physicalDeviceRequirements.deviceExtensionNames.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
+
         PhysicalDeviceQueueFamilies physicalDeviceQueueFamilies {
             0u, // graphicsFamilyIndex
             0u, // presentFamilyIndex
@@ -482,8 +601,6 @@ auto Device::physicalDeviceMeetsRequirements(
 
     uint32_t minTransferScore { 255u };
 
-    const VkSurfaceKHR surface { m_surface->getHandle() };
-
     for (uint32_t i { 0u }; i < queueFamilyProperties.size(); i++) {
         uint32_t currentTransferScore { 0u };
 
@@ -504,12 +621,16 @@ auto Device::physicalDeviceMeetsRequirements(
             }
         }
 
+        if (m_surface == nullptr) {
+            continue;
+        }
+
         VkBool32 supportsPreset { VK_FALSE };
         VULKAN_CHECK(
             vkGetPhysicalDeviceSurfaceSupportKHR(
                 physicalDevice,
                 i,
-                surface,
+                m_surface->getHandle(),
                 &supportsPreset
             )
         );
@@ -519,6 +640,11 @@ auto Device::physicalDeviceMeetsRequirements(
         }
     }
 
+    // Offscreen frames are "presented" by the graphics queue, which keeps the queue setup the same.
+    if (m_surface == nullptr) {
+        physicalDeviceQueueFamilies.presentFamilyIndex = physicalDeviceQueueFamilies.graphicsFamilyIndex;
+    }
+
     std::stringstream physicalDeviceQueueFamiliesLog;
     physicalDeviceQueueFamiliesLog <<
         "Graphics: " << (physicalDeviceQueueFamilies.graphicsFamilyIndex.has_value() ? "true" : "false") << " | " <<
@@ -542,7 +668,10 @@ auto Device::physicalDeviceMeetsRequirements(
         core::Logger::trace("Transfer family index: " + std::to_string(physicalDeviceQueueFamilies.transferFamilyIndex.value()));
         querySwapchainSupport(physicalDevice);
 
-        if (m_swapchainSupport.surfaceFormats.empty() || m_swapchainSupport.presentModes.empty()) {
+        if (
+            m_surface != nullptr &&
+            (m_swapchainSupport.surfaceFormats.empty() || m_swapchainSupport.presentModes.empty())
+        ) {
             core::Logger::info("Required swapchain support not present, skipping device...");
             return false;
         }
@@ -20,6 +20,10 @@ public:
         std::vector<VkPresentModeKHR> presentModes;
     };
 
+    /**
+     * @param surface The surface to present to, or nullptr to render offscreen only. Without a surface no present
+     * queue or swapchain support is required, and devices which are not discrete GPUs, like lavapipe, are accepted.
+     */
     Device(
         VkAllocationCallbacks* allocationCallbacks,
         const VkInstance& instance,
@@ -40,6 +44,43 @@ public:
 
     auto supportsDeviceLocalHostVisible() const -> bool;
 
+    /**
+     * Indicates if indirect draws can read their count from a buffer, which culling on the device needs to draw
+     * only what survived. Requires Vulkan 1.2 and multi draw indirect, both are enabled when present.
+     */
+    auto supportsIndirectCount() const -> bool;
+
+    /**
+     * Indicates if indirect draws may start at an instance other than 0, which lets every draw written by culling
+     * on the device find its instance data. Enabled when present.
+     */
+    auto supportsDrawIndirectFirstInstance() const -> bool;
+
+    /**
+     * Indicates if the graphics queue can write timestamps, which time the frames on the device.
+     */
+    auto supportsTimestamps() const -> bool;
+
+    /**
+     * @returns The nanoseconds a timestamp tick takes.
+     */
+    auto getTimestampPeriod() const -> float;
+
+    /**
+     * Indicates if images of the given format can be used as source and destination of a linearly filtered blit.
+     * @param format The format to check, assumes optimal tiling.
+     * @returns True if vkCmdBlitImage with VK_FILTER_LINEAR may be used to generate mip levels, otherwise false.
+     */
+    auto supportsLinearBlit(const VkFormat format) const -> bool;
+
+    /**
+     * Indicates if optimally tiled images of the given format can be sampled with a linear filter.
+     * Block compressed formats additionally require the matching device feature to be enabled.
+     * @param format The format to check.
+     * @returns True if textures of the format can be created, otherwise false.
+     */
+    auto supportsSampledFormat(const VkFormat format) const -> bool;
+
     auto querySwapchainSupport(
         const VkPhysicalDevice& physicalDevice
     ) -> void;
@@ -93,6 +134,9 @@ private:
     VkFormat m_depthFormat;
 
     bool m_supportsDeviceLocalHostVisible;
+    bool m_supportsIndirectCount;
+    bool m_supportsDrawIndirectFirstInstance;
+    bool m_supportsTimestamps;
 
     auto selectPhysicalDevice(
         const VkInstance& instance
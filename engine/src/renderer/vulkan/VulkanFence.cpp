@@ -88,6 +88,15 @@ auto Fence::wait(const uint64_t timeoutInNs) -> bool {
     return false;
 }
 
+auto Fence::isSignaled() -> bool {
+    if (!m_isSignaled) {
+        const VkDevice logicalDevice { m_device->getLogicalDevice() };
+        m_isSignaled = vkGetFenceStatus(logicalDevice, m_fence) == VK_SUCCESS;
+    }
+
+    return m_isSignaled;
+}
+
 auto Fence::reset() -> void {
     if (m_isSignaled) {
         const VkDevice logicalDevice { m_device->getLogicalDevice() };
@@ -23,6 +23,11 @@ public:
     auto getFence() const -> const VkFence&;
 
     auto wait(const uint64_t timeoutInNs) -> bool;
+
+    /**
+     * Checks the fence without waiting.
+     */
+    auto isSignaled() -> bool;
     auto reset() -> void;
 
 private:
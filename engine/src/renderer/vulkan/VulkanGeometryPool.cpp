@@ -0,0 +1,360 @@
+#include "VulkanGeometryPool.hpp"
+
+#include "VulkanCommandBuffer.hpp"
+#include "../../core/Logger.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace beige {
+namespace renderer {
+namespace vulkan {
+
+GeometryPool::GeometryPool(
+    VkAllocationCallbacks* allocationCallbacks,
+    std::shared_ptr<Device> device,
+    const uint64_t vertexBufferSize,
+    const uint64_t indexBufferSize
+) :
+m_allocationCallbacks { allocationCallbacks },
+m_device { device },
+m_vertexBuffer { nullptr },
+m_indexBuffer { nullptr },
+m_vertexRanges { vertexBufferSize / sizeof(math::Vertex3D) },
+m_indexRanges { indexBufferSize / sizeof(uint32_t) },
+m_geometries { },
+m_generations { },
+m_freeIndices { },
+m_defragmentationCount { 0u } {
+    m_vertexBuffer = createBuffer(vertexBufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+    m_indexBuffer = createBuffer(indexBufferSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+}
+
+GeometryPool::~GeometryPool() {
+
+}
+
+auto GeometryPool::upload(
+    const std::vector<math::Vertex3D>& vertices,
+    const std::vector<uint32_t>& indices,
+    const std::vector<resources::GeometryLod>& lods,
+    DeletionQueue& deletionQueue
+) -> resources::GeometryHandle {
+    if (vertices.empty() || indices.empty()) {
+        core::Logger::error("GeometryPool::upload - geometry without vertices or indices!");
+        return resources::global_invalidGeometryHandle;
+    }
+
+    const uint32_t vertexCount { static_cast<uint32_t>(vertices.size()) };
+    const uint32_t indexCount { static_cast<uint32_t>(indices.size()) };
+
+    if (lods.size() > resources::global_maxGeometryLodCount) {
+        core::Logger::error("GeometryPool::upload - geometry with " + std::to_string(lods.size()) + " levels of detail!");
+        return resources::global_invalidGeometryHandle;
+    }
+
+    for (const resources::GeometryLod& lod : lods) {
+        if (lod.indexCount == 0u || lod.firstIndex > indexCount || lod.indexCount > indexCount - lod.firstIndex) {
+            core::Logger::error("GeometryPool::upload - level of detail outside of the indices!");
+            return resources::global_invalidGeometryHandle;
+        }
+    }
+
+    std::optional<Geometry> geometry { allocateRanges(vertexCount, indexCount) };
+
+    if (!geometry.has_value() &&
+        m_vertexRanges.getFreeSize() >= vertexCount &&
+        m_indexRanges.getFreeSize() >= indexCount &&
+        defragment(deletionQueue)) {
+        geometry = allocateRanges(vertexCount, indexCount);
+    }
+
+    if (!geometry.has_value()) {
+        core::Logger::error(
+            "GeometryPool::upload - no room for " + std::to_string(vertexCount) + " vertices and " +
+            std::to_string(indexCount) + " indices!"
+        );
+        return resources::global_invalidGeometryHandle;
+    }
+
+    if (lods.empty()) {
+        geometry->lods.at(0u) = { 0u, indexCount, 0.0f };
+        geometry->lodCount = 1u;
+    } else {
+        std::copy(lods.begin(), lods.end(), geometry->lods.begin());
+        geometry->lodCount = static_cast<uint32_t>(lods.size());
+    }
+
+    const uint64_t vertexSize { sizeof(math::Vertex3D) * vertexCount };
+    const uint64_t indexSize { sizeof(uint32_t) * indexCount };
+
+    const VkBufferUsageFlags bufferUsageFlags {
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+    };
+
+    const VkMemoryPropertyFlags memoryPropertyFlags {
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+    };
+
+    // Vertices and indices share one staging buffer and one submission.
+    Buffer staging {
+        m_allocationCallbacks,
+        m_device,
+        vertexSize + indexSize,
+        bufferUsageFlags,
+        memoryPropertyFlags,
+        true
+    };
+
+    staging.loadData(0u, vertexSize, 0u, vertices.data());
+    staging.loadData(vertexSize, indexSize, 0u, indices.data());
+
+    const VkBufferCopy vertexCopyRegion {
+        0u,                                             // srcOffset
+        sizeof(math::Vertex3D) * geometry->firstVertex, // dstOffset
+        vertexSize                                      // size
+    };
+
+    const VkBufferCopy indexCopyRegion {
+        vertexSize,                              // srcOffset
+        sizeof(uint32_t) * geometry->firstIndex, // dstOffset
+        indexSize                                // size
+    };
+
+    const VkCommandPool commandPool { m_device->getGraphicsCommandPool() };
+    const VkQueue queue { m_device->getGraphicsQueue() };
+
+    // No frame in flight draws from the new ranges, so the copy needs no barrier against them.
+    CommandBuffer temporaryCommandBuffer { m_device };
+    temporaryCommandBuffer.allocateAndBeginSingleUse(commandPool);
+    vkCmdCopyBuffer(temporaryCommandBuffer.getHandle(), staging.getHandle(), m_vertexBuffer->getHandle(), 1u, &vertexCopyRegion);
+    vkCmdCopyBuffer(temporaryCommandBuffer.getHandle(), staging.getHandle(), m_indexBuffer->getHandle(), 1u, &indexCopyRegion);
+    temporaryCommandBuffer.endSingleUse(commandPool, queue);
+
+    uint32_t index { 0u };
+
+    if (!m_freeIndices.empty()) {
+        index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_geometries.size());
+        m_geometries.push_back(geometry.value());
+        m_generations.push_back(0u);
+    }
+
+    // Generations of live slots are odd, so a handle can never match a free slot.
+    m_generations.at(index)++;
+    m_geometries.at(index) = geometry.value();
+
+    const resources::GeometryHandle handle {
+        index,                  // index
+        m_generations.at(index) // generation
+    };
+
+    return handle;
+}
+
+auto GeometryPool::free(const resources::GeometryHandle handle, DeletionQueue& deletionQueue) -> void {
+    if (!isValid(handle)) {
+        return;
+    }
+
+    const Geometry geometry { m_geometries.at(handle.index) };
+
+    m_generations.at(handle.index)++;
+    m_freeIndices.push_back(handle.index);
+
+    deletionQueue.push(
+        [this, geometry, defragmentationCount = m_defragmentationCount]() -> void {
+            if (defragmentationCount != m_defragmentationCount) {
+                return;
+            }
+
+            m_vertexRanges.free(geometry.firstVertex, geometry.vertexCount);
+            m_indexRanges.free(geometry.firstIndex, geometry.indexCount);
+        }
+    );
+}
+
+auto GeometryPool::defragment(DeletionQueue& deletionQueue) -> bool {
+    std::shared_ptr<Buffer> vertexBuffer { nullptr };
+    std::shared_ptr<Buffer> indexBuffer { nullptr };
+
+    // Copying into new buffers avoids overlapping copies within a buffer, which Vulkan does not allow.
+    try {
+        vertexBuffer = createBuffer(m_vertexRanges.getTotalSize() * sizeof(math::Vertex3D), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+        indexBuffer = createBuffer(m_indexRanges.getTotalSize() * sizeof(uint32_t), VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+    } catch (const std::exception& exception) {
+        core::Logger::error(std::string("GeometryPool::defragment - failed to create buffers: ") + exception.what());
+        return false;
+    }
+
+    std::vector<uint32_t> liveIndices { };
+
+    for (uint32_t i { 0u }; i < static_cast<uint32_t>(m_generations.size()); i++) {
+        if (m_generations.at(i) % 2u == 1u) {
+            liveIndices.push_back(i);
+        }
+    }
+
+    // Geometries keep their order within each buffer.
+    std::vector<VkBufferCopy> vertexCopyRegions { };
+    std::vector<VkBufferCopy> indexCopyRegions { };
+    uint32_t vertexCount { 0u };
+    uint32_t indexCount { 0u };
+
+    std::sort(
+        liveIndices.begin(),
+        liveIndices.end(),
+        [&](const uint32_t lhs, const uint32_t rhs) -> bool {
+            return m_geometries.at(lhs).firstVertex < m_geometries.at(rhs).firstVertex;
+        }
+    );
+
+    for (const uint32_t index : liveIndices) {
+        Geometry& geometry { m_geometries.at(index) };
+
+        const VkBufferCopy copyRegion {
+            sizeof(math::Vertex3D) * geometry.firstVertex, // srcOffset
+            sizeof(math::Vertex3D) * vertexCount,          // dstOffset
+            sizeof(math::Vertex3D) * geometry.vertexCount  // size
+        };
+        vertexCopyRegions.push_back(copyRegion);
+
+        geometry.firstVertex = vertexCount;
+        vertexCount += geometry.vertexCount;
+    }
+
+    std::sort(
+        liveIndices.begin(),
+        liveIndices.end(),
+        [&](const uint32_t lhs, const uint32_t rhs) -> bool {
+            return m_geometries.at(lhs).firstIndex < m_geometries.at(rhs).firstIndex;
+        }
+    );
+
+    for (const uint32_t index : liveIndices) {
+        Geometry& geometry { m_geometries.at(index) };
+
+        const VkBufferCopy copyRegion {
+            sizeof(uint32_t) * geometry.firstIndex, // srcOffset
+            sizeof(uint32_t) * indexCount,          // dstOffset
+            sizeof(uint32_t) * geometry.indexCount  // size
+        };
+        indexCopyRegions.push_back(copyRegion);
+
+        geometry.firstIndex = indexCount;
+        indexCount += geometry.indexCount;
+    }
+
+    if (!liveIndices.empty()) {
+        const VkCommandPool commandPool { m_device->getGraphicsCommandPool() };
+        const VkQueue queue { m_device->getGraphicsQueue() };
+
+        CommandBuffer temporaryCommandBuffer { m_device };
+        temporaryCommandBuffer.allocateAndBeginSingleUse(commandPool);
+        vkCmdCopyBuffer(
+            temporaryCommandBuffer.getHandle(),
+            m_vertexBuffer->getHandle(),
+            vertexBuffer->getHandle(),
+            static_cast<uint32_t>(vertexCopyRegions.size()),
+            vertexCopyRegions.data()
+        );
+        vkCmdCopyBuffer(
+            temporaryCommandBuffer.getHandle(),
+            m_indexBuffer->getHandle(),
+            indexBuffer->getHandle(),
+            static_cast<uint32_t>(indexCopyRegions.size()),
+            indexCopyRegions.data()
+        );
+        temporaryCommandBuffer.endSingleUse(commandPool, queue);
+    }
+
+    // Frames in flight still draw from the old buffers with the old ranges.
+    deletionQueue.push(
+        [vertexBuffer = std::move(m_vertexBuffer), indexBuffer = std::move(m_indexBuffer)]() mutable -> void {
+            vertexBuffer.reset();
+            indexBuffer.reset();
+        }
+    );
+
+    m_vertexBuffer = vertexBuffer;
+    m_indexBuffer = indexBuffer;
+
+    m_vertexRanges.reset();
+    m_indexRanges.reset();
+    m_vertexRanges.allocate(vertexCount);
+    m_indexRanges.allocate(indexCount);
+    m_defragmentationCount++;
+
+    core::Logger::debug(
+        "Defragmented geometry buffers, " + std::to_string(liveIndices.size()) + " geometries with " +
+        std::to_string(vertexCount) + " vertices and " + std::to_string(indexCount) + " indices."
+    );
+
+    return true;
+}
+
+auto GeometryPool::bind(const VkCommandBuffer commandBuffer) const -> void {
+    const std::array<VkDeviceSize, 1u> offsets { 0u };
+    vkCmdBindVertexBuffers(commandBuffer, 0u, 1u, &m_vertexBuffer->getHandle(), offsets.data());
+    vkCmdBindIndexBuffer(commandBuffer, m_indexBuffer->getHandle(), 0u, VK_INDEX_TYPE_UINT32);
+}
+
+auto GeometryPool::getCount() const -> uint32_t {
+    return static_cast<uint32_t>(m_geometries.size() - m_freeIndices.size());
+}
+
+auto GeometryPool::createBuffer(const uint64_t size, const VkBufferUsageFlags usage) const -> std::shared_ptr<Buffer> {
+    const VkMemoryPropertyFlags memoryPropertyFlags {
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+    };
+
+    const VkBufferUsageFlags bufferUsageFlags {
+        usage |
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT
+    };
+
+    return std::make_shared<Buffer>(
+        m_allocationCallbacks,
+        m_device,
+        size,
+        bufferUsageFlags,
+        memoryPropertyFlags,
+        true
+    );
+}
+
+auto GeometryPool::allocateRanges(const uint32_t vertexCount, const uint32_t indexCount) -> std::optional<Geometry> {
+    const std::optional<uint64_t> firstVertex { m_vertexRanges.allocate(vertexCount) };
+    const std::optional<uint64_t> firstIndex { m_indexRanges.allocate(indexCount) };
+
+    if (!firstVertex.has_value() || !firstIndex.has_value()) {
+        if (firstVertex.has_value()) {
+            m_vertexRanges.free(firstVertex.value(), vertexCount);
+        }
+
+        if (firstIndex.has_value()) {
+            m_indexRanges.free(firstIndex.value(), indexCount);
+        }
+
+        return std::nullopt;
+    }
+
+    const Geometry geometry {
+        static_cast<uint32_t>(firstVertex.value()), // firstVertex
+        vertexCount,                                // vertexCount
+        static_cast<uint32_t>(firstIndex.value()),  // firstIndex
+        indexCount,                                 // indexCount
+        { },                                        // lods
+        0u                                          // lodCount
+    };
+
+    return geometry;
+}
+
+} // namespace vulkan
+} // namespace renderer
+} // namespace beige
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "VulkanBuffer.hpp"
+#include "VulkanDeletionQueue.hpp"
+#include "VulkanDevice.hpp"
+#include "../../math/MathTypes.hpp"
+#include "../../resources/FreeList.hpp"
+#include "../../resources/GeometryHandle.hpp"
+#include "../../resources/GeometryLod.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace beige {
+namespace renderer {
+namespace vulkan {
+
+/**
+ * Keeps the vertices and indices of every geometry in one device local vertex buffer and one index buffer, so the
+ * whole scene is drawn with a single binding. Geometries get their ranges from free lists and are drawn with a
+ * base vertex and first index.
+ */
+class GeometryPool final {
+public:
+    // Ranges in elements, ready to be passed to vkCmdDrawIndexed().
+    struct Geometry {
+        uint32_t firstVertex;
+        uint32_t vertexCount;
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        std::array<resources::GeometryLod, resources::global_maxGeometryLodCount> lods; // Within the index range.
+        uint32_t lodCount;
+    };
+
+    GeometryPool(
+        VkAllocationCallbacks* allocationCallbacks,
+        std::shared_ptr<Device> device,
+        const uint64_t vertexBufferSize,
+        const uint64_t indexBufferSize
+    );
+    ~GeometryPool();
+
+    GeometryPool(const GeometryPool&) = delete;
+    auto operator=(const GeometryPool&) -> GeometryPool& = delete;
+
+    /**
+     * Copies a geometry into free ranges of the buffers. If no free block is large enough but there is enough
+     * free space in total, the buffers are defragmented first.
+     * @param lods Ranges of the indices, finest first. If empty, all indices form the only level of detail.
+     * @returns The handle to the geometry, or an invalid handle if the buffers are full.
+     */
+    auto upload(
+        const std::vector<math::Vertex3D>& vertices,
+        const std::vector<uint32_t>& indices,
+        const std::vector<resources::GeometryLod>& lods,
+        DeletionQueue& deletionQueue
+    ) -> resources::GeometryHandle;
+
+    /**
+     * Invalidates the handle right away, the ranges are reused once the frames in flight are done with them.
+     * The deletion queue has to be flushed before the pool is destroyed.
+     */
+    auto free(const resources::GeometryHandle handle, DeletionQueue& deletionQueue) -> void;
+
+    /**
+     * Packs the geometries to the start of new buffers, leaving one free block at the end of each. The old
+     * buffers are kept until the frames in flight are done with them.
+     * @returns False if the new buffers could not be created, the old ones are left in use then.
+     */
+    auto defragment(DeletionQueue& deletionQueue) -> bool;
+
+    auto isValid(const resources::GeometryHandle handle) const -> bool {
+        return handle.index < m_generations.size() && m_generations[handle.index] == handle.generation;
+    }
+
+    /**
+     * @returns The ranges of the geometry, or nullptr if the handle is stale or invalid.
+     */
+    auto resolve(const resources::GeometryHandle handle) const -> const Geometry* {
+        return isValid(handle) ? &m_geometries[handle.index] : nullptr;
+    }
+
+    /**
+     * Binds both buffers, once per frame covers every geometry.
+     */
+    auto bind(const VkCommandBuffer commandBuffer) const -> void;
+    auto getCount() const -> uint32_t;
+
+private:
+    VkAllocationCallbacks* m_allocationCallbacks;
+    std::shared_ptr<Device> m_device;
+
+    std::shared_ptr<Buffer> m_vertexBuffer;
+    std::shared_ptr<Buffer> m_indexBuffer;
+    resources::FreeList m_vertexRanges; // In vertices.
+    resources::FreeList m_indexRanges;  // In indices.
+
+    std::vector<Geometry> m_geometries;
+    std::vector<uint32_t> m_generations;
+    std::vector<uint32_t> m_freeIndices;
+
+    // Counts defragmentations. Ranges still waiting to be freed from before one are already free after it.
+    uint64_t m_defragmentationCount;
+
+    auto createBuffer(const uint64_t size, const VkBufferUsageFlags usage) const -> std::shared_ptr<Buffer>;
+    auto allocateRanges(const uint32_t vertexCount, const uint32_t indexCount) -> std::optional<Geometry>;
+};
+
+} // namespace vulkan
+} // namespace renderer
+} // namespace beige
@@ -1,6 +1,9 @@
 #include "VulkanImage.hpp"
 
 #include "VulkanDefines.hpp"
+#include "../../core/Memory.hpp"
+
+#include <algorithm>
 
 namespace beige {
 namespace renderer {
@@ -12,6 +15,7 @@ Image::Image(
     const VkImageType& imageType,
     const uint32_t width,
     const uint32_t height,
+    const uint32_t mipLevels,
     const VkFormat& format,
     const VkImageTiling& imageTiling,
     const VkImageUsageFlags& imageUsageFlags,
@@ -23,9 +27,11 @@ m_allocationCallbacks { allocationCallbacks },
 m_device { device },
 m_handle { VK_NULL_HANDLE },
 m_deviceMemory { VK_NULL_HANDLE },
+m_deviceMemorySize { 0u },
 m_imageView { VK_NULL_HANDLE },
 m_width { width },
-m_height { height } {
+m_height { height },
+m_mipLevels { mipLevels } {
     const VkExtent3D extent {
         width,  // width
         height, // height
@@ -39,7 +45,7 @@ m_height { height } {
         VK_IMAGE_TYPE_2D,                    // imageType
         format,                              // format
         extent,                              // extent
-        4u,                                  // mipLevels // TODO: Support mip mapping
+        m_mipLevels,                         // mipLevels
         1u,                                  // arrayLayers // TODO: Support number of layers in the image
         VK_SAMPLE_COUNT_1_BIT,               // samples // TODO: Configurable sample count
         imageTiling,                         // tiling
@@ -92,6 +98,9 @@ m_height { height } {
         )
     );
 
+    m_deviceMemorySize = memoryRequirements.size;
+    core::Memory::addExternal(static_cast<std::size_t>(m_deviceMemorySize), core::MemoryTag::DeviceImage);
+
     VULKAN_CHECK(
         vkBindImageMemory(
             logicalDevice,
@@ -123,6 +132,7 @@ Image::~Image() {
             m_deviceMemory,
             m_allocationCallbacks
         );
+        core::Memory::removeExternal(static_cast<std::size_t>(m_deviceMemorySize), core::MemoryTag::DeviceImage);
     }
 
     if (m_handle != VK_NULL_HANDLE) {
@@ -134,10 +144,18 @@ Image::~Image() {
     }
 }
 
+auto Image::getHandle() const -> const VkImage& {
+    return m_handle;
+}
+
 auto Image::getImageView() const -> const VkImageView& {
     return m_imageView;
 }
 
+auto Image::getMipLevels() const -> uint32_t {
+    return m_mipLevels;
+}
+
 auto Image::transitionLayout(
     const VkCommandBuffer& commandBuffer,
     const VkFormat& format,
@@ -147,7 +165,7 @@ auto Image::transitionLayout(
     const VkImageSubresourceRange imageSubresourceRange {
         VK_IMAGE_ASPECT_COLOR_BIT, // aspectMask
         0u,                        // baseMipLevel
-        1u,                        // levelCount
+        m_mipLevels,               // levelCount
         0u,                        // baseArrayLayer
         1u                         // layerCount
     };
@@ -209,12 +227,14 @@ auto Image::transitionLayout(
 
 auto Image::copyFromBuffer(
     const VkBuffer& buffer,
-    const VkCommandBuffer& commandBuffer
+    const VkCommandBuffer& commandBuffer,
+    const uint32_t mipLevel,
+    const uint64_t bufferOffset
 ) -> void {
     // Region to copy.
     const VkImageSubresourceLayers imageSubresourceLayers {
         VK_IMAGE_ASPECT_COLOR_BIT, // aspectMask
-        0u,                        // mipLevel
+        mipLevel,                  // mipLevel
         0u,                        // baseArrayLayer
         1u                         // layerCount
     };
@@ -225,14 +245,16 @@ auto Image::copyFromBuffer(
         0  // z
     };
 
+    // For block compressed formats the extent may end in a partial block, which is valid as it reaches the
+    // edge of the level. Zero row length and image height mean tightly packed texels/blocks.
     const VkExtent3D extent {
-        m_width,  // width
-        m_height, // height
-        1u        // depth
+        std::max(m_width >> mipLevel, 1u),  // width
+        std::max(m_height >> mipLevel, 1u), // height
+        1u                                  // depth
     };
 
     const VkBufferImageCopy bufferImageCopy {
-        0u,                     // bufferOffset
+        bufferOffset,           // bufferOffset
         0u,                     // bufferRowLength
         0u,                     // bufferImageHeight
         imageSubresourceLayers, // imageSubresource
@@ -250,14 +272,139 @@ auto Image::copyFromBuffer(
     );
 }
 
+auto Image::generateMipmaps(const VkCommandBuffer& commandBuffer) -> void {
+    const VkImageSubresourceRange imageSubresourceRange {
+        VK_IMAGE_ASPECT_COLOR_BIT, // aspectMask
+        0u,                        // baseMipLevel
+        1u,                        // levelCount
+        0u,                        // baseArrayLayer
+        1u                         // layerCount
+    };
+
+    VkImageMemoryBarrier imageMemoryBarrier {
+        VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,    // sType
+        nullptr,                                   // pNext
+        VK_ACCESS_NONE,                            // srcAccessMask
+        VK_ACCESS_NONE,                            // dstAccessMask
+        VK_IMAGE_LAYOUT_UNDEFINED,                 // oldLayout
+        VK_IMAGE_LAYOUT_UNDEFINED,                 // newLayout
+        m_device->getGraphicsQueueIndex().value(), // srcQueueFamilyIndex
+        m_device->getGraphicsQueueIndex().value(), // dstQueueFamilyIndex
+        m_handle,                                  // image
+        imageSubresourceRange                      // subresourceRange
+    };
+
+    int32_t mipWidth { static_cast<int32_t>(m_width) };
+    int32_t mipHeight { static_cast<int32_t>(m_height) };
+
+    for (uint32_t i { 1u }; i < m_mipLevels; i++) {
+        // The previous level has been written, make it the blit source.
+        imageMemoryBarrier.subresourceRange.baseMipLevel = i - 1u;
+        imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0u,
+            0u,
+            nullptr,
+            0u,
+            nullptr,
+            1u,
+            &imageMemoryBarrier
+        );
+
+        const int32_t nextMipWidth { std::max(mipWidth / 2, 1) };
+        const int32_t nextMipHeight { std::max(mipHeight / 2, 1) };
+
+        const VkImageSubresourceLayers srcImageSubresourceLayers {
+            VK_IMAGE_ASPECT_COLOR_BIT, // aspectMask
+            i - 1u,                    // mipLevel
+            0u,                        // baseArrayLayer
+            1u                         // layerCount
+        };
+
+        const VkImageSubresourceLayers dstImageSubresourceLayers {
+            VK_IMAGE_ASPECT_COLOR_BIT, // aspectMask
+            i,                         // mipLevel
+            0u,                        // baseArrayLayer
+            1u                         // layerCount
+        };
+
+        const VkImageBlit imageBlit {
+            srcImageSubresourceLayers,                                                // srcSubresource
+            { VkOffset3D { 0, 0, 0 }, VkOffset3D { mipWidth, mipHeight, 1 } },         // srcOffsets
+            dstImageSubresourceLayers,                                                // dstSubresource
+            { VkOffset3D { 0, 0, 0 }, VkOffset3D { nextMipWidth, nextMipHeight, 1 } } // dstOffsets
+        };
+
+        vkCmdBlitImage(
+            commandBuffer,
+            m_handle,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+            m_handle,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            1u,
+            &imageBlit,
+            VK_FILTER_LINEAR
+        );
+
+        // The previous level is final now, hand it over to the fragment stage.
+        imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        imageMemoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            0u,
+            0u,
+            nullptr,
+            0u,
+            nullptr,
+            1u,
+            &imageMemoryBarrier
+        );
+
+        mipWidth = nextMipWidth;
+        mipHeight = nextMipHeight;
+    }
+
+    // The last level was only ever written to.
+    imageMemoryBarrier.subresourceRange.baseMipLevel = m_mipLevels - 1u;
+    imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    imageMemoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+        0u,
+        0u,
+        nullptr,
+        0u,
+        nullptr,
+        1u,
+        &imageMemoryBarrier
+    );
+}
+
 auto Image::createImageView(
     const VkFormat& format,
     const VkImageAspectFlags& imageAspectFlags
 ) -> void {
     const VkImageSubresourceRange imageSubresourceRange {
         imageAspectFlags, // aspectMask
-        0u,               // baseMipLevel // TODO: Make configurable
-        1u,               // levelCount // TODO: Make configurable
+        0u,               // baseMipLevel
+        m_mipLevels,      // levelCount
         0u,               // baseArrayLayer // TODO: Make configurable
         1u                // layerCount // TODO: Make configurable
     };
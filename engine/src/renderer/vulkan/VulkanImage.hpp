@@ -19,6 +19,7 @@ public:
         const VkImageType& imageType,
         const uint32_t width,
         const uint32_t height,
+        const uint32_t mipLevels,
         const VkFormat& format,
         const VkImageTiling& imageTiling,
         const VkImageUsageFlags& imageUsageFlags,
@@ -28,7 +29,9 @@ public:
     );
     ~Image();
 
+    auto getHandle() const -> const VkImage&;
     auto getImageView() const -> const VkImageView&;
+    auto getMipLevels() const -> uint32_t;
 
     auto transitionLayout(
         const VkCommandBuffer& commandBuffer,
@@ -37,20 +40,39 @@ public:
         const VkImageLayout& newLayout
     ) -> void;
 
+    /**
+     * Records a copy of one tightly packed mip level from the buffer into the image.
+     * @param buffer The buffer to copy from.
+     * @param commandBuffer The command buffer to record the copy into.
+     * @param mipLevel The level to copy into, the whole level is written.
+     * @param bufferOffset The offset of the level in the buffer, a multiple of the format's texel block size.
+     */
     auto copyFromBuffer(
         const VkBuffer& buffer,
-        const VkCommandBuffer& commandBuffer
+        const VkCommandBuffer& commandBuffer,
+        const uint32_t mipLevel,
+        const uint64_t bufferOffset
     ) -> void;
 
+    /**
+     * Fills mip levels 1..n by successively blitting each level into the next one.
+     * Expects every level to be in the transfer destination layout with level 0 already populated,
+     * leaves every level in the shader read-only layout.
+     * @param commandBuffer The command buffer to record the blits into.
+     */
+    auto generateMipmaps(const VkCommandBuffer& commandBuffer) -> void;
+
 private:
     VkAllocationCallbacks* m_allocationCallbacks;
     std::shared_ptr<Device> m_device;
 
     VkImage m_handle;
     VkDeviceMemory m_deviceMemory;
+    uint64_t m_deviceMemorySize; // Counted under the DeviceImage memory tag while allocated.
     VkImageView m_imageView;
     uint32_t m_width;
     uint32_t m_height;
+    uint32_t m_mipLevels;
 
     auto createImageView(
         const VkFormat& format,
@@ -75,7 +75,7 @@ m_handle { VK_NULL_HANDLE } {
         0u,                                                         // flags
         VK_TRUE,                                                    // depthTestEnable
         VK_TRUE,                                                    // depthWriteEnable
-        VK_COMPARE_OP_LESS,                                         // depthCompareOp
+        VK_COMPARE_OP_GREATER_OR_EQUAL,                             // depthCompareOp, reverse-Z puts nearer fragments higher
         VK_FALSE,                                                   // depthBoundsTestEnable
         VK_FALSE,                                                   // stencilTestEnable
         { },                                                        // front
@@ -159,25 +159,7 @@ m_handle { VK_NULL_HANDLE } {
         static_cast<uint32_t>(sizeof(glm::mat4x4)) * 2u  // size
     };
 
-    const VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo {
-        VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,      // sType
-        nullptr,                                            // pNext
-        0u,                                                 // flags
-        static_cast<uint32_t>(descriptorSetLayouts.size()), // setLayoutCount
-        descriptorSetLayouts.data(),                        // pSetLayouts
-        1u,                                                 // pushConstantRangeCount
-        &pushConstantRange                                  // pPushConstantRanges
-    };
-
-    // Create the pipeline layout.
-    VULKAN_CHECK(
-        vkCreatePipelineLayout(
-            m_device->getLogicalDevice(),
-            &pipelineLayoutCreateInfo,
-            m_allocationCallbacks,
-            &m_pipelineLayout
-        )
-    );
+    createPipelineLayout(descriptorSetLayouts, { pushConstantRange });
 
     const VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo {
         VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,              // sType
@@ -220,6 +202,63 @@ m_handle { VK_NULL_HANDLE } {
     }
 }
 
+Pipeline::Pipeline(
+    VkAllocationCallbacks* allocationCallbacks,
+    std::shared_ptr<Device> device,
+    const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+    const VkPipelineShaderStageCreateInfo& pipelineShaderStageCreateInfo,
+    const uint32_t pushConstantSize
+) :
+m_allocationCallbacks { allocationCallbacks },
+m_device { device },
+m_renderPass { nullptr },
+m_pipelineLayout { VK_NULL_HANDLE },
+m_handle { VK_NULL_HANDLE } {
+    std::vector<VkPushConstantRange> pushConstantRanges;
+
+    if (pushConstantSize > 0u) {
+        const VkPushConstantRange pushConstantRange {
+            VK_SHADER_STAGE_COMPUTE_BIT, // stageFlags
+            0u,                          // offset
+            pushConstantSize             // size
+        };
+
+        pushConstantRanges.push_back(pushConstantRange);
+    }
+
+    createPipelineLayout(descriptorSetLayouts, pushConstantRanges);
+
+    const VkComputePipelineCreateInfo computePipelineCreateInfo {
+        VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO, // sType
+        nullptr,                                        // pNext
+        0u,                                             // flags
+        pipelineShaderStageCreateInfo,                  // stage
+        m_pipelineLayout,                               // layout
+        VK_NULL_HANDLE,                                 // basePipelineHandle
+        -1                                              // basePipelineIndex
+    };
+
+    const VkResult result {
+        vkCreateComputePipelines(
+            m_device->getLogicalDevice(),
+            VK_NULL_HANDLE,
+            1u,
+            &computePipelineCreateInfo,
+            m_allocationCallbacks,
+            &m_handle
+        )
+    };
+
+    if (Utils::isResultSuccess(result)) {
+        core::Logger::info("Compute pipeline created!");
+    } else {
+        vkDestroyPipelineLayout(m_device->getLogicalDevice(), m_pipelineLayout, m_allocationCallbacks);
+
+        const std::string message { "vkCreateComputePipelines failed with " + Utils::resultToString(result, true) + "!" };
+        throw std::exception(message.c_str());
+    }
+}
+
 Pipeline::~Pipeline() {
     const VkDevice logicalDevice { m_device->getLogicalDevice() };
 
@@ -240,6 +279,31 @@ auto Pipeline::getPipelineLayout() const -> const VkPipelineLayout& {
     return m_pipelineLayout;
 }
 
+auto Pipeline::createPipelineLayout(
+    const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+    const std::vector<VkPushConstantRange>& pushConstantRanges
+) -> void {
+    const VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo {
+        VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,      // sType
+        nullptr,                                            // pNext
+        0u,                                                 // flags
+        static_cast<uint32_t>(descriptorSetLayouts.size()), // setLayoutCount
+        descriptorSetLayouts.data(),                        // pSetLayouts
+        static_cast<uint32_t>(pushConstantRanges.size()),   // pushConstantRangeCount
+        pushConstantRanges.data()                           // pPushConstantRanges
+    };
+
+    // Create the pipeline layout.
+    VULKAN_CHECK(
+        vkCreatePipelineLayout(
+            m_device->getLogicalDevice(),
+            &pipelineLayoutCreateInfo,
+            m_allocationCallbacks,
+            &m_pipelineLayout
+        )
+    );
+}
+
 auto Pipeline::bind(
     const VkCommandBuffer& commandBuffer,
     const VkPipelineBindPoint& pipelineBindPoint
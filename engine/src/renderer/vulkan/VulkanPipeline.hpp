@@ -21,6 +21,18 @@ public:
         const bool isWireframe
     );
 
+    /**
+     * Creates a compute pipeline, which is bound to VK_PIPELINE_BIND_POINT_COMPUTE.
+     * @param pushConstantSize The size of the push constants of the compute stage in bytes, 0 for none.
+     */
+    Pipeline(
+        VkAllocationCallbacks* allocationCallbacks,
+        std::shared_ptr<Device> device,
+        const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+        const VkPipelineShaderStageCreateInfo& pipelineShaderStageCreateInfo,
+        const uint32_t pushConstantSize
+    );
+
     ~Pipeline();
 
     auto getPipelineLayout() const -> const VkPipelineLayout&;
@@ -37,6 +49,11 @@ private:
 
     VkPipelineLayout m_pipelineLayout;
     VkPipeline m_handle;
+
+    auto createPipelineLayout(
+        const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+        const std::vector<VkPushConstantRange>& pushConstantRanges
+    ) -> void;
 };
 
 } // namespace vulkan
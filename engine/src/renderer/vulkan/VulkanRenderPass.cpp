@@ -42,6 +42,13 @@ m_state { State::Ready } {
     const VkFormat depthFormat { m_device->getDepthFormat() };
     const VkDevice logicalDevice { m_device->getLogicalDevice() };
 
+    // Offscreen frames are copied out instead of presented.
+    const VkImageLayout colorFinalLayout {
+        m_swapchain->isOffscreen()
+        ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+        : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+    };
+
     const VkAttachmentDescription colorAttachmentDescription {
         0u,                               // flags
         surfaceFormat.format,             // format // TODO: Configurable
@@ -51,7 +58,7 @@ m_state { State::Ready } {
         VK_ATTACHMENT_LOAD_OP_DONT_CARE,  // stencilLoadOp
         VK_ATTACHMENT_STORE_OP_DONT_CARE, // stencilStoreOp
         VK_IMAGE_LAYOUT_UNDEFINED,        // initialLayout - do not expect any particular layout before render pass
-        VK_IMAGE_LAYOUT_PRESENT_SRC_KHR   // finalLayout - transitioned to after the render pass
+        colorFinalLayout                  // finalLayout - transitioned to after the render pass
     };
 
     const VkAttachmentDescription depthAttachmentDescription {
@@ -27,7 +27,8 @@ m_images { },
 m_imageViews { },
 m_imageIndex { 0u },
 m_currentFrame { 0u },
-m_depthAttachment { nullptr } {
+m_depthAttachment { nullptr },
+m_offscreenImages { } {
     // Simply create a new one
     create(width, height);
 }
@@ -60,6 +61,10 @@ auto Swapchain::getCurrentFrame() const -> const uint32_t {
     return m_currentFrame;
 }
 
+auto Swapchain::isOffscreen() const -> bool {
+    return m_surface == nullptr;
+}
+
 auto Swapchain::recreate(const uint32_t width, const uint32_t height) -> void {
     destroy();
     create(width, height);
@@ -72,6 +77,12 @@ auto Swapchain::acquireNextImageIndex(
     const VkSemaphore& imageAvailableSemaphore,
     const VkFence& fence
 ) -> std::optional<uint32_t> {
+    // Nothing signals the semaphore, offscreen frames are only ordered by the fences of the frames in flight.
+    if (isOffscreen()) {
+        m_imageIndex = (m_imageIndex + 1u) % static_cast<uint32_t>(m_images.size());
+        return std::optional<uint32_t>(m_imageIndex);
+    }
+
     uint32_t imageIndex { 0u };
 
     const VkResult result {
@@ -105,6 +116,11 @@ auto Swapchain::present(
     const VkSemaphore& renderCompleteSemaphore,
     const uint32_t presentImageIndex
 ) -> void {
+    if (isOffscreen()) {
+        m_currentFrame = (m_currentFrame + 1u) % m_maxFramesInFlight;
+        return;
+    }
+
     // Return the image to the swapchain for presentation
     VkPresentInfoKHR presentInfo {
         VK_STRUCTURE_TYPE_PRESENT_INFO_KHR, // sType
@@ -134,6 +150,11 @@ auto Swapchain::create(const uint32_t width, const uint32_t height) -> void {
     VkExtent2D imageExtent { width, height };
     m_maxFramesInFlight = 2u;
 
+    if (isOffscreen()) {
+        createOffscreen(width, height);
+        return;
+    }
+
     const Device::SwapchainSupport swapchainSupport {
         m_device->getSwapchainSupport()
     };
@@ -286,6 +307,51 @@ auto Swapchain::create(const uint32_t width, const uint32_t height) -> void {
         );
     }
 
+    createDepthAttachment(imageExtent);
+
+    core::Logger::info("Swapchain created successfully!");
+}
+
+auto Swapchain::createOffscreen(const uint32_t width, const uint32_t height) -> void {
+    // Rgba8 keeps read back frames in the byte order image files use.
+    m_surfaceFormat = {
+        VK_FORMAT_R8G8B8A8_UNORM,         // format
+        VK_COLOR_SPACE_SRGB_NONLINEAR_KHR // colorSpace
+    };
+
+    // The first acquire wraps around to the first image.
+    m_currentFrame = 0u;
+    m_imageIndex = m_offscreenImageCount - 1u;
+
+    for (uint32_t i { 0u }; i < m_offscreenImageCount; i++) {
+        const std::shared_ptr<Image> image {
+            std::make_shared<Image>(
+                m_allocationCallbacks,
+                m_device,
+                VK_IMAGE_TYPE_2D,
+                width,
+                height,
+                1u,
+                m_surfaceFormat.format,
+                VK_IMAGE_TILING_OPTIMAL,
+                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                true,
+                VK_IMAGE_ASPECT_COLOR_BIT
+            )
+        };
+
+        m_offscreenImages.push_back(image);
+        m_images.push_back(image->getHandle());
+        m_imageViews.push_back(image->getImageView());
+    }
+
+    createDepthAttachment({ width, height });
+
+    core::Logger::info("Offscreen swapchain created successfully!");
+}
+
+auto Swapchain::createDepthAttachment(const VkExtent2D& imageExtent) -> void {
     // Depth resources
     m_device->detectDepthFormat();
 
@@ -296,6 +362,7 @@ auto Swapchain::create(const uint32_t width, const uint32_t height) -> void {
         VK_IMAGE_TYPE_2D,
         imageExtent.width,
         imageExtent.height,
+        1u,
         m_device->getDepthFormat(),
         VK_IMAGE_TILING_OPTIMAL,
         VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
@@ -303,8 +370,6 @@ auto Swapchain::create(const uint32_t width, const uint32_t height) -> void {
         true,
         VK_IMAGE_ASPECT_DEPTH_BIT
     );
-
-    core::Logger::info("Swapchain created successfully!");
 }
 
 auto Swapchain::destroy() -> void {
@@ -314,6 +379,14 @@ auto Swapchain::destroy() -> void {
 
     m_depthAttachment.reset();
 
+    // The images own their views.
+    if (isOffscreen()) {
+        m_offscreenImages.clear();
+        m_images.clear();
+        m_imageViews.clear();
+        return;
+    }
+
     std::for_each(
         m_imageViews.begin(),
         m_imageViews.end(),
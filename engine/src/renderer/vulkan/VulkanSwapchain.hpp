@@ -16,6 +16,13 @@ namespace vulkan {
 
 class Swapchain final {
 public:
+    // Matches the descriptor sets the material shader allocates per object and image.
+    static constexpr uint32_t m_offscreenImageCount { 3u };
+
+    /**
+     * @param surface The surface to present to. Without one the swapchain owns offscreen color images instead, which
+     * are handed out in turn and stay in the transfer source layout after a frame so they can be read back.
+     */
     Swapchain(
         const uint32_t width,
         const uint32_t height,
@@ -31,6 +38,7 @@ public:
     auto getDepthAttachment() const -> const std::shared_ptr<Image>&;
     auto getMaxFramesInFlight() const -> const uint32_t;
     auto getCurrentFrame() const -> const uint32_t;
+    auto isOffscreen() const -> bool;
 
     auto recreate(const uint32_t width, const uint32_t height) -> void;
 
@@ -62,11 +70,14 @@ private:
     std::vector<VkImage> m_images;
     std::vector<VkImageView> m_imageViews;
     std::shared_ptr<Image> m_depthAttachment;
+    std::vector<std::shared_ptr<Image>> m_offscreenImages;
 
     uint32_t m_imageIndex;
     uint32_t m_currentFrame;
 
     auto create(const uint32_t width, const uint32_t height) -> void;
+    auto createOffscreen(const uint32_t width, const uint32_t height) -> void;
+    auto createDepthAttachment(const VkExtent2D& imageExtent) -> void;
     auto destroy() -> void;
 };
 
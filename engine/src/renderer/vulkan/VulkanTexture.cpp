@@ -4,6 +4,10 @@
 #include "VulkanCommandBuffer.hpp"
 #include "VulkanUtils.hpp"
 #include "../../core/Logger.hpp"
+#include "../../resources/TextureUtils.hpp"
+
+#include <algorithm>
+#include <utility>
 
 namespace beige {
 namespace renderer {
@@ -11,30 +15,54 @@ namespace vulkan {
 
 Texture::Texture(
     const std::string& name,
-    const int32_t width,
-    const int32_t height,
-    const int32_t channelCount,
-    const void* pixels,
-    const bool hasTransparency,
     VkAllocationCallbacks* allocationCallbacks,
     std::shared_ptr<Device> device
 ) :
 ITexture {
     name,
-    width,
-    height,
-    channelCount,
-    pixels,
-    hasTransparency
+    0,
+    0,
+    0,
+    nullptr,
+    false
 },
 m_image { nullptr },
 m_sampler { VK_NULL_HANDLE },
+m_pendingImage { nullptr },
+m_pendingSampler { VK_NULL_HANDLE },
 m_allocationCallbacks { allocationCallbacks },
 m_device { device } {
-    const VkDeviceSize imageSize { static_cast<VkDeviceSize>(m_width * m_height * m_channelCount) };
 
-    // NOTE: Assumes 8 bits per channel.
-    const VkFormat imageFormat { VK_FORMAT_R8G8B8A8_UNORM };
+}
+
+Texture::Texture(
+    const std::string& name,
+    const int32_t width,
+    const int32_t height,
+    const int32_t channelCount,
+    const resources::TextureFormat format,
+    const void* pixels,
+    const uint32_t mipLevelCount,
+    const bool hasTransparency,
+    VkAllocationCallbacks* allocationCallbacks,
+    std::shared_ptr<Device> device
+) :
+Texture {
+    name,
+    allocationCallbacks,
+    device
+} {
+    const Upload upload {
+        prepareUpload(
+            width,
+            height,
+            channelCount,
+            format,
+            pixels,
+            mipLevelCount,
+            hasTransparency
+        )
+    };
 
     // Create a staging buffer and load data into it.
     const VkBufferUsageFlags bufferUsageFlags {
@@ -49,28 +77,145 @@ m_device { device } {
     Buffer staging {
         m_allocationCallbacks,
         m_device,
-        imageSize,
+        upload.size,
         bufferUsageFlags,
         memoryPropertyFlags,
         true
     };
 
-    staging.loadData(0u, imageSize, 0u, pixels);
+    staging.loadData(0u, upload.size, 0u, upload.pixels);
+
+    const VkCommandPool commandPool { m_device->getGraphicsCommandPool() };
+    const VkQueue queue { m_device->getGraphicsQueue() };
+
+    CommandBuffer temporaryCommandBuffer { m_device };
+    temporaryCommandBuffer.allocateAndBeginSingleUse(commandPool);
+
+    recordUpload(upload, staging.getHandle(), 0u, temporaryCommandBuffer.getHandle());
+
+    temporaryCommandBuffer.endSingleUse(commandPool, queue);
+
+    activatePendingImage();
+    m_generation++;
+}
+
+Texture::~Texture() {
+    destroy();
+}
+
+auto Texture::getImageView() const -> const VkImageView& {
+    return m_image->getImageView();
+}
+
+auto Texture::getSampler() const -> const VkSampler& {
+    return m_sampler;
+}
+
+auto Texture::retire(DeletionQueue& deletionQueue) -> void {
+    if (m_image == nullptr) {
+        return;
+    }
+
+    std::shared_ptr<Image> image { std::move(m_image) };
+    const VkSampler sampler { m_sampler };
+    m_sampler = VK_NULL_HANDLE;
+
+    deletionQueue.push(
+        [image, sampler, device = m_device, allocationCallbacks = m_allocationCallbacks]() mutable -> void {
+            image.reset();
+            vkDestroySampler(device->getLogicalDevice(), sampler, allocationCallbacks);
+        }
+    );
+}
+
+auto Texture::prepareUpload(
+    const int32_t width,
+    const int32_t height,
+    const int32_t channelCount,
+    const resources::TextureFormat format,
+    const void* pixels,
+    const uint32_t mipLevelCount,
+    const bool hasTransparency
+) -> Upload {
+    m_width = width;
+    m_height = height;
+    m_channelCount = channelCount;
+    m_format = format;
+    m_hasTransparency = hasTransparency;
+
+    // NOTE: Uncompressed textures assume 8 bits per channel.
+    const VkFormat imageFormat { getVulkanFormat(m_format) };
+    const bool isBlockCompressed { resources::TextureUtils::isBlockCompressed(m_format) };
+
+    const uint32_t fullMipLevelCount {
+        resources::TextureUtils::getMipLevelCount(static_cast<uint32_t>(m_width), static_cast<uint32_t>(m_height))
+    };
+
+    // Precomputed levels coming with the asset are uploaded as they are. Otherwise the full chain is generated,
+    // on the device if the format can be blitted with a linear filter, on the CPU if it cannot.
+    // Block compressed data can't be filtered, such textures only get the levels they come with.
+    const bool usePrecomputedMips { mipLevelCount > 1u || isBlockCompressed };
+
+    Upload upload {
+        pixels,                                                          // pixels
+        0u,                                                              // size
+        { },                                                             // mipOffsets
+        { },                                                             // generatedMipChain
+        !usePrecomputedMips && m_device->supportsLinearBlit(imageFormat) // useDeviceMips
+    };
+
+    m_mipLevels = usePrecomputedMips ? std::max(mipLevelCount, 1u) : fullMipLevelCount;
+    uint32_t uploadMipLevelCount { usePrecomputedMips ? m_mipLevels : 1u };
+
+    if (!usePrecomputedMips && !upload.useDeviceMips) {
+        core::Logger::debug("Linear blit not supported, generating mip chain of texture " + m_name + " on the CPU...");
+        upload.generatedMipChain = resources::TextureUtils::generateMipChain(
+            pixels,
+            static_cast<uint32_t>(m_width),
+            static_cast<uint32_t>(m_height),
+            static_cast<uint32_t>(m_channelCount),
+            m_mipLevels
+        );
+        upload.pixels = upload.generatedMipChain.data();
+        uploadMipLevelCount = m_mipLevels;
+    }
+
+    // Levels are tightly packed one after another, base level first. Every level is a whole number of blocks,
+    // which keeps each offset aligned to the texel block size as copies require.
+    upload.mipOffsets.resize(uploadMipLevelCount);
+    for (uint32_t i { 0u }; i < uploadMipLevelCount; i++) {
+        upload.mipOffsets.at(i) = upload.size;
+        upload.size += resources::TextureUtils::getMipLevelSize(
+            m_format,
+            static_cast<uint32_t>(m_width),
+            static_cast<uint32_t>(m_height),
+            i
+        );
+    }
 
     // NOTE: Lots of assumptions here, different texture types will require different options here.
+    // Block compressed images can't be rendered to.
     const VkImageUsageFlags imageUsageFlags {
-        VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
-        VK_IMAGE_USAGE_TRANSFER_DST_BIT |
-        VK_IMAGE_USAGE_SAMPLED_BIT |
-        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+        isBlockCompressed ?
+            static_cast<VkImageUsageFlags>(
+                VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                VK_IMAGE_USAGE_SAMPLED_BIT
+            ) :
+            static_cast<VkImageUsageFlags>(
+                VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                VK_IMAGE_USAGE_SAMPLED_BIT |
+                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+            )
     };
 
-    m_image = std::make_unique<Image>(
+    m_pendingImage = std::make_unique<Image>(
         m_allocationCallbacks,
         m_device,
         VK_IMAGE_TYPE_2D,
         m_width,
         m_height,
+        m_mipLevels,
         imageFormat,
         VK_IMAGE_TILING_OPTIMAL,
         imageUsageFlags,
@@ -79,33 +224,75 @@ m_device { device } {
         VK_IMAGE_ASPECT_COLOR_BIT
     );
 
-    const VkCommandPool commandPool { m_device->getGraphicsCommandPool() };
-    const VkQueue queue { m_device->getGraphicsQueue() };
+    m_pendingSampler = createSampler();
 
-    CommandBuffer temporaryCommandBuffer { m_device };
-    temporaryCommandBuffer.allocateAndBeginSingleUse(commandPool);
+    return upload;
+}
+
+auto Texture::recordUpload(
+    const Upload& upload,
+    const VkBuffer& stagingBuffer,
+    const uint64_t stagingOffset,
+    const VkCommandBuffer& commandBuffer
+) -> void {
+    const VkFormat imageFormat { getVulkanFormat(m_format) };
 
     // Transition the layout from whatever it is currently to optimal for receiving data.
-    m_image->transitionLayout(
-        temporaryCommandBuffer.getHandle(),
+    m_pendingImage->transitionLayout(
+        commandBuffer,
         imageFormat,
         VK_IMAGE_LAYOUT_UNDEFINED,
         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
     );
 
     // Copy the data from the buffer.
-    m_image->copyFromBuffer(staging.getHandle(), temporaryCommandBuffer.getHandle());
+    for (uint32_t i { 0u }; i < static_cast<uint32_t>(upload.mipOffsets.size()); i++) {
+        m_pendingImage->copyFromBuffer(stagingBuffer, commandBuffer, i, stagingOffset + upload.mipOffsets.at(i));
+    }
 
-    // Transition from optimal for data reciept to shader-read-only optimal layout.
-    m_image->transitionLayout(
-        temporaryCommandBuffer.getHandle(),
-        imageFormat,
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-    );
+    if (upload.useDeviceMips) {
+        // Blit the rest of the chain from the base level, this also leaves every level shader-read-only optimal.
+        m_pendingImage->generateMipmaps(commandBuffer);
+    } else {
+        // Transition from optimal for data reciept to shader-read-only optimal layout.
+        m_pendingImage->transitionLayout(
+            commandBuffer,
+            imageFormat,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+        );
+    }
+}
 
-    temporaryCommandBuffer.endSingleUse(commandPool, queue);
+auto Texture::completeUpload(DeletionQueue& deletionQueue) -> void {
+    if (m_pendingImage == nullptr) {
+        return;
+    }
+
+    retire(deletionQueue);
+    activatePendingImage();
+}
+
+auto Texture::hasPendingUpload() const -> bool {
+    return m_pendingImage != nullptr;
+}
+
+auto Texture::getVulkanFormat(const resources::TextureFormat format) -> VkFormat {
+    switch (format) {
+    case resources::TextureFormat::Rgba8:
+        return VK_FORMAT_R8G8B8A8_UNORM;
+    case resources::TextureFormat::Bc1:
+        return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+    case resources::TextureFormat::Bc3:
+        return VK_FORMAT_BC3_UNORM_BLOCK;
+    case resources::TextureFormat::Bc7:
+        return VK_FORMAT_BC7_UNORM_BLOCK;
+    }
 
+    return VK_FORMAT_UNDEFINED;
+}
+
+auto Texture::createSampler() -> VkSampler {
     // Create a sampler for the texture.
     // TODO: Filters should be configurable.
     const VkSamplerCreateInfo samplerCreateInfo {
@@ -124,17 +311,19 @@ m_device { device } {
         VK_FALSE,                              // compareEnable
         VK_COMPARE_OP_ALWAYS,                  // compareOp
         0.0f,                                  // minLod
-        0.0f,                                  // maxLod
+        static_cast<float>(m_mipLevels),       // maxLod
         VK_BORDER_COLOR_INT_OPAQUE_BLACK,      // borderColor
         VK_FALSE                               // unnormalizedCoordinates
     };
 
+    VkSampler sampler { VK_NULL_HANDLE };
+
     VkResult result {
         vkCreateSampler(
             m_device->getLogicalDevice(),
             &samplerCreateInfo,
             m_allocationCallbacks,
-            &m_sampler
+            &sampler
         )
     };
 
@@ -143,27 +332,36 @@ m_device { device } {
         throw std::exception(message.c_str());
     }
 
-    m_generation++;
+    return sampler;
 }
 
-Texture::~Texture() {
-    vkDeviceWaitIdle(m_device->getLogicalDevice());
+auto Texture::activatePendingImage() -> void {
+    m_image = std::move(m_pendingImage);
+    m_sampler = m_pendingSampler;
+    m_pendingSampler = VK_NULL_HANDLE;
+}
 
+auto Texture::destroy() -> void {
     m_image.reset();
+    m_pendingImage.reset();
 
-    vkDestroySampler(
-        m_device->getLogicalDevice(),
-        m_sampler,
-        m_allocationCallbacks
-    );
-}
-
-auto Texture::getImageView() const -> const VkImageView& {
-    return m_image->getImageView();
-}
+    if (m_sampler != VK_NULL_HANDLE) {
+        vkDestroySampler(
+            m_device->getLogicalDevice(),
+            m_sampler,
+            m_allocationCallbacks
+        );
+        m_sampler = VK_NULL_HANDLE;
+    }
 
-auto Texture::getSampler() const -> const VkSampler& {
-    return m_sampler;
+    if (m_pendingSampler != VK_NULL_HANDLE) {
+        vkDestroySampler(
+            m_device->getLogicalDevice(),
+            m_pendingSampler,
+            m_allocationCallbacks
+        );
+        m_pendingSampler = VK_NULL_HANDLE;
+    }
 }
 
 } // namespace vulkan
@@ -3,6 +3,10 @@
 #include "../../resources/ITexture.hpp"
 #include "VulkanImage.hpp"
 #include "VulkanDevice.hpp"
+#include "VulkanDeletionQueue.hpp"
+
+#include <cstddef>
+#include <vector>
 
 namespace beige {
 namespace renderer {
@@ -10,27 +14,107 @@ namespace vulkan {
 
 class Texture final : public resources::ITexture {
 public:
+    // Everything needed to record the upload of one texture, produced by prepareUpload().
+    struct Upload {
+        const void* pixels;                       // Tightly packed levels, base level first.
+        uint64_t size;                            // Size of all levels in bytes.
+        std::vector<VkDeviceSize> mipOffsets;     // Offset of each level relative to pixels.
+        std::vector<std::byte> generatedMipChain; // Owns pixels if the chain was built on the CPU.
+        bool useDeviceMips;                       // Indicates if levels 1..n are blitted on the device.
+    };
+
+    /**
+     * Creates a texture without an image, it stays at the invalid generation until data is uploaded.
+     */
+    Texture(
+        const std::string& name,
+        VkAllocationCallbacks* allocationCallbacks,
+        std::shared_ptr<Device> device
+    );
+
+    /**
+     * Creates a texture and uploads its data right away, waiting for the transfer to finish.
+     */
     Texture(
         const std::string& name,
         const int32_t width,
         const int32_t height,
         const int32_t channelCount,
+        const resources::TextureFormat format,
         const void* pixels,
+        const uint32_t mipLevelCount,
         const bool hasTransparency,
         VkAllocationCallbacks* allocationCallbacks,
         std::shared_ptr<Device> device
     );
+
+    /**
+     * Destroys the image right away, retire() it first if the device may still be drawing with it.
+     */
     ~Texture();
 
     auto getImageView() const -> const VkImageView&;
     auto getSampler() const -> const VkSampler&;
 
+    /**
+     * Hands the image and sampler over to the deletion queue, for textures the device may still be drawing with.
+     * The texture keeps its generation, it has no image until the next upload completes.
+     */
+    auto retire(DeletionQueue& deletionQueue) -> void;
+
+    /**
+     * Creates a pending image and sampler for the given data and works out which levels have to be uploaded.
+     * The current image stays in use until completeUpload() swaps in the pending one. The device must be done
+     * with the pending image of an earlier upload.
+     * @returns The levels to copy into staging memory, pixels stays referenced by the result.
+     */
+    auto prepareUpload(
+        const int32_t width,
+        const int32_t height,
+        const int32_t channelCount,
+        const resources::TextureFormat format,
+        const void* pixels,
+        const uint32_t mipLevelCount,
+        const bool hasTransparency
+    ) -> Upload;
+
+    /**
+     * Records the copies from staging memory and the layout transitions, leaving the pending image
+     * shader-read-only.
+     * @param upload The result of prepareUpload().
+     * @param stagingBuffer The buffer the levels were written to.
+     * @param stagingOffset The offset of the base level in the buffer, a multiple of 16.
+     * @param commandBuffer The command buffer to record into.
+     */
+    auto recordUpload(
+        const Upload& upload,
+        const VkBuffer& stagingBuffer,
+        const uint64_t stagingOffset,
+        const VkCommandBuffer& commandBuffer
+    ) -> void;
+
+    /**
+     * Retires the current image and makes the pending one current, once the device finished the upload.
+     */
+    auto completeUpload(DeletionQueue& deletionQueue) -> void;
+    auto hasPendingUpload() const -> bool;
+
+    static auto getVulkanFormat(const resources::TextureFormat format) -> VkFormat;
+
 private:
     VkAllocationCallbacks* m_allocationCallbacks;
     std::shared_ptr<Device> m_device;
 
     std::unique_ptr<Image> m_image;
     VkSampler m_sampler;
+
+    // Written by an upload the device may still be working on.
+    std::unique_ptr<Image> m_pendingImage;
+    VkSampler m_pendingSampler;
+
+    auto createSampler() -> VkSampler;
+    auto activatePendingImage() -> void;
+    auto destroy() -> void;
 };
 
 } // namespace vulkan
@@ -1,5 +1,11 @@
 #include "VulkanUtils.hpp"
 
+#include "VulkanDefines.hpp"
+
+#include <cstring>
+#include <optional>
+#include <vector>
+
 namespace beige {
 namespace renderer {
 namespace vulkan {
@@ -43,6 +49,50 @@ auto Utils::isResultSuccess(const VkResult& result) -> bool {
     // TODO: return true by default, add other error codes
 }
 
+auto Utils::createShaderModule(
+    const VkDevice& logicalDevice,
+    VkAllocationCallbacks* allocationCallbacks,
+    const core::Vfs& vfs,
+    const std::string& path
+) -> VkShaderModule {
+    const std::optional<core::Vfs::File> file { vfs.read(path) };
+
+    if (!file.has_value()) {
+        core::Logger::error("Shader module file error: " + path + "!");
+        return VK_NULL_HANDLE;
+    }
+
+    if (file->size == 0u) {
+        core::Logger::error("Shader file is empty: " + path + "!");
+        return VK_NULL_HANDLE;
+    }
+
+    // SPIR-V is read as 32-bit words, archived and mapped files are aligned for it but copy in case.
+    std::vector<uint32_t> buffer((static_cast<std::size_t>(file->size) + sizeof(uint32_t) - 1u) / sizeof(uint32_t), 0u);
+    std::memcpy(buffer.data(), file->data, static_cast<std::size_t>(file->size));
+
+    const VkShaderModuleCreateInfo shaderModuleCreateInfo {
+        VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO, // sType
+        nullptr,                                     // pNext
+        0u,                                          // flags
+        static_cast<std::size_t>(file->size),        // codeSize
+        buffer.data()                                // pCode
+    };
+
+    VkShaderModule shaderModule { VK_NULL_HANDLE };
+
+    VULKAN_CHECK(
+        vkCreateShaderModule(
+            logicalDevice,
+            &shaderModuleCreateInfo,
+            allocationCallbacks,
+            &shaderModule
+        )
+    );
+
+    return shaderModule;
+}
+
 } // namespace vulkan
 } // namespace renderer
 } // namespace beige
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../../core/Vfs.hpp"
+
 #include <vulkan/vulkan.h>
 
 #include <string>
@@ -27,6 +29,18 @@ public:
      * @returns True if success, otherwise false. Defaults to true for unknown result types.
      */
     static auto isResultSuccess(const VkResult& result) -> bool;
+
+    /**
+     * Reads SPIR-V through the VFS and creates a shader module from it.
+     * @param path The path of the SPIR-V in the VFS.
+     * @returns The module, or VK_NULL_HANDLE if the file is missing or empty.
+     */
+    static auto createShaderModule(
+        const VkDevice& logicalDevice,
+        VkAllocationCallbacks* allocationCallbacks,
+        const core::Vfs& vfs,
+        const std::string& path
+    ) -> VkShaderModule;
 };
 
 } // namespace vulkan
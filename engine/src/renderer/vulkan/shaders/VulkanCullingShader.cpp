@@ -0,0 +1,365 @@
+#include "VulkanCullingShader.hpp"
+
+#include "../../../core/Logger.hpp"
+#include "../VulkanDefines.hpp"
+#include "../VulkanUtils.hpp"
+
+#include <string>
+
+namespace beige {
+namespace renderer {
+namespace vulkan {
+
+CullingShader::CullingShader(
+    VkAllocationCallbacks* allocationCallbacks,
+    std::shared_ptr<Device> device,
+    const uint32_t frameCount,
+    const uint32_t maxInstanceCount,
+    std::shared_ptr<const core::Vfs> vfs
+) :
+m_allocationCallbacks { allocationCallbacks },
+m_device { device },
+m_vfs { vfs },
+m_descriptorPool { VK_NULL_HANDLE },
+m_descriptorSetLayout { VK_NULL_HANDLE },
+m_descriptorSets { },
+m_drawCommandBuffers { },
+m_drawCountBuffers { },
+m_pipeline { nullptr } {
+    // Binding 0 - instance objects, binding 1 - draw commands, binding 2 - draw count.
+    std::array<VkDescriptorSetLayoutBinding, m_descriptorCount> descriptorSetLayoutBindings { };
+
+    for (uint32_t i { 0u }; i < m_descriptorCount; i++) {
+        descriptorSetLayoutBindings.at(i).binding = i;
+        descriptorSetLayoutBindings.at(i).descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptorSetLayoutBindings.at(i).descriptorCount = 1u;
+        descriptorSetLayoutBindings.at(i).stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        descriptorSetLayoutBindings.at(i).pImmutableSamplers = nullptr;
+    }
+
+    const VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO, // sType
+        nullptr,                                             // pNext
+        0u,                                                  // flags
+        m_descriptorCount,                                   // bindingCount
+        descriptorSetLayoutBindings.data()                   // pBindings
+    };
+
+    VULKAN_CHECK(
+        vkCreateDescriptorSetLayout(
+            m_device->getLogicalDevice(),
+            &descriptorSetLayoutCreateInfo,
+            m_allocationCallbacks,
+            &m_descriptorSetLayout
+        )
+    );
+
+    const VkDescriptorPoolSize descriptorPoolSize {
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, // type
+        m_descriptorCount * frameCount     // descriptorCount
+    };
+
+    const VkDescriptorPoolCreateInfo descriptorPoolCreateInfo {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO, // sType
+        nullptr,                                       // pNext
+        0u,                                            // flags
+        frameCount,                                    // maxSets
+        1u,                                            // poolSizeCount
+        &descriptorPoolSize                            // pPoolSizes
+    };
+
+    VULKAN_CHECK(
+        vkCreateDescriptorPool(
+            m_device->getLogicalDevice(),
+            &descriptorPoolCreateInfo,
+            m_allocationCallbacks,
+            &m_descriptorPool
+        )
+    );
+
+    const std::vector<VkDescriptorSetLayout> descriptorSetLayouts(frameCount, m_descriptorSetLayout);
+    m_descriptorSets.resize(frameCount, VK_NULL_HANDLE);
+
+    const VkDescriptorSetAllocateInfo descriptorSetAllocateInfo {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO, // sType
+        nullptr,                                        // pNext
+        m_descriptorPool,                               // descriptorPool
+        frameCount,                                     // descriptorSetCount
+        descriptorSetLayouts.data()                     // pSetLayouts
+    };
+
+    VULKAN_CHECK(
+        vkAllocateDescriptorSets(
+            m_device->getLogicalDevice(),
+            &descriptorSetAllocateInfo,
+            m_descriptorSets.data()
+        )
+    );
+
+    const VkBufferUsageFlags drawCommandBufferUsageFlags {
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+        VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT
+    };
+
+    // The count is reset with a fill, so it also has to be a transfer destination.
+    const VkBufferUsageFlags drawCountBufferUsageFlags {
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+        VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT
+    };
+
+    for (uint32_t i { 0u }; i < frameCount; i++) {
+        m_drawCommandBuffers.push_back(
+            std::make_unique<Buffer>(
+                m_allocationCallbacks,
+                m_device,
+                static_cast<uint64_t>(sizeof(VkDrawIndexedIndirectCommand)) * maxInstanceCount,
+                drawCommandBufferUsageFlags,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                true
+            )
+        );
+
+        m_drawCountBuffers.push_back(
+            std::make_unique<Buffer>(
+                m_allocationCallbacks,
+                m_device,
+                static_cast<uint64_t>(sizeof(uint32_t)),
+                drawCountBufferUsageFlags,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                true
+            )
+        );
+    }
+
+    m_pipeline = createPipeline();
+
+    if (m_pipeline == nullptr) {
+        const std::string message { "Unable to create the pipeline for " + std::string(m_builtinCullingShaderName) + "!" };
+        throw std::exception(message.c_str());
+    }
+}
+
+CullingShader::~CullingShader() {
+    const VkDevice logicalDevice { m_device->getLogicalDevice() };
+
+    m_pipeline.reset();
+    m_drawCountBuffers.clear();
+    m_drawCommandBuffers.clear();
+
+    vkDestroyDescriptorPool(
+        logicalDevice,
+        m_descriptorPool,
+        m_allocationCallbacks
+    );
+
+    vkDestroyDescriptorSetLayout(
+        logicalDevice,
+        m_descriptorSetLayout,
+        m_allocationCallbacks
+    );
+}
+
+auto CullingShader::reload(DeletionQueue& deletionQueue) -> bool {
+    std::unique_ptr<Pipeline> pipeline { nullptr };
+
+    try {
+        pipeline = createPipeline();
+    } catch (const std::exception& exception) {
+        core::Logger::error(
+            "Reloading " + std::string(m_builtinCullingShaderName) + " failed, keeping the previous shader: " + exception.what()
+        );
+        return false;
+    }
+
+    if (pipeline == nullptr) {
+        core::Logger::error("Reloading " + std::string(m_builtinCullingShaderName) + " failed, keeping the previous shader!");
+        return false;
+    }
+
+    std::shared_ptr<Pipeline> previousPipeline { std::move(m_pipeline) };
+    deletionQueue.push([previousPipeline]() mutable -> void { previousPipeline.reset(); });
+    m_pipeline = std::move(pipeline);
+
+    core::Logger::info("Reloaded " + std::string(m_builtinCullingShaderName) + ".");
+
+    return true;
+}
+
+auto CullingShader::dispatch(
+    const VkCommandBuffer& commandBuffer,
+    const uint32_t frame,
+    const Buffer& instanceBuffer,
+    const uint32_t firstInstance,
+    const uint32_t instanceCount,
+    const std::array<float, 24u>& frustumPlanes
+) -> void {
+    const VkDescriptorSet descriptorSet { m_descriptorSets.at(frame) };
+    const VkBuffer drawCountBuffer { m_drawCountBuffers.at(frame)->getHandle() };
+
+    const std::array<VkBuffer, m_descriptorCount> buffers {
+        instanceBuffer.getHandle(),
+        m_drawCommandBuffers.at(frame)->getHandle(),
+        drawCountBuffer
+    };
+
+    std::array<VkDescriptorBufferInfo, m_descriptorCount> descriptorBufferInfos { };
+    std::array<VkWriteDescriptorSet, m_descriptorCount> writeDescriptorSets { };
+
+    for (uint32_t i { 0u }; i < m_descriptorCount; i++) {
+        descriptorBufferInfos.at(i).buffer = buffers.at(i);
+        descriptorBufferInfos.at(i).offset = 0u;
+        descriptorBufferInfos.at(i).range = VK_WHOLE_SIZE;
+
+        writeDescriptorSets.at(i).sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writeDescriptorSets.at(i).dstSet = descriptorSet;
+        writeDescriptorSets.at(i).dstBinding = i;
+        writeDescriptorSets.at(i).descriptorCount = 1u;
+        writeDescriptorSets.at(i).descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writeDescriptorSets.at(i).pBufferInfo = &descriptorBufferInfos.at(i);
+    }
+
+    // The frame which last used the set is done with it, the in-flight fence was waited on.
+    vkUpdateDescriptorSets(
+        m_device->getLogicalDevice(),
+        m_descriptorCount,
+        writeDescriptorSets.data(),
+        0u,
+        nullptr
+    );
+
+    // The shader counts the survivors up from zero.
+    vkCmdFillBuffer(commandBuffer, drawCountBuffer, 0u, static_cast<VkDeviceSize>(sizeof(uint32_t)), 0u);
+
+    const VkMemoryBarrier fillMemoryBarrier {
+        VK_STRUCTURE_TYPE_MEMORY_BARRIER,                      // sType
+        nullptr,                                               // pNext
+        VK_ACCESS_TRANSFER_WRITE_BIT,                          // srcAccessMask
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT // dstAccessMask
+    };
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0u,
+        1u,
+        &fillMemoryBarrier,
+        0u,
+        nullptr,
+        0u,
+        nullptr
+    );
+
+    m_pipeline->bind(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE);
+
+    vkCmdBindDescriptorSets(
+        commandBuffer,
+        VK_PIPELINE_BIND_POINT_COMPUTE,
+        m_pipeline->getPipelineLayout(),
+        0u,
+        1u,
+        &descriptorSet,
+        0u,
+        nullptr
+    );
+
+    const PushConstants pushConstants {
+        frustumPlanes, // frustumPlanes
+        firstInstance, // firstInstance
+        instanceCount  // instanceCount
+    };
+
+    vkCmdPushConstants(
+        commandBuffer,
+        m_pipeline->getPipelineLayout(),
+        VK_SHADER_STAGE_COMPUTE_BIT,
+        0u,
+        static_cast<uint32_t>(sizeof(PushConstants)),
+        static_cast<const void*>(&pushConstants)
+    );
+
+    vkCmdDispatch(commandBuffer, (instanceCount + m_workgroupSize - 1u) / m_workgroupSize, 1u, 1u);
+
+    // The draw commands and the count are read by the indirect draw in the render pass.
+    const VkMemoryBarrier cullMemoryBarrier {
+        VK_STRUCTURE_TYPE_MEMORY_BARRIER,   // sType
+        nullptr,                            // pNext
+        VK_ACCESS_SHADER_WRITE_BIT,         // srcAccessMask
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT // dstAccessMask
+    };
+
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+        0u,
+        1u,
+        &cullMemoryBarrier,
+        0u,
+        nullptr,
+        0u,
+        nullptr
+    );
+}
+
+auto CullingShader::draw(
+    const VkCommandBuffer& commandBuffer,
+    const uint32_t frame,
+    const uint32_t maxDrawCount
+) const -> void {
+    vkCmdDrawIndexedIndirectCount(
+        commandBuffer,
+        m_drawCommandBuffers.at(frame)->getHandle(),
+        0u,
+        m_drawCountBuffers.at(frame)->getHandle(),
+        0u,
+        maxDrawCount,
+        static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand))
+    );
+}
+
+auto CullingShader::createPipeline() -> std::unique_ptr<Pipeline> {
+    const std::string path { "shaders/" + std::string(m_builtinCullingShaderName) + ".comp.glsl.spv" };
+    const VkShaderModule shaderModule {
+        Utils::createShaderModule(m_device->getLogicalDevice(), m_allocationCallbacks, *m_vfs, path)
+    };
+
+    if (shaderModule == VK_NULL_HANDLE) {
+        return nullptr;
+    }
+
+    const VkPipelineShaderStageCreateInfo pipelineShaderStageCreateInfo {
+        VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, // sType
+        nullptr,                                             // pNext
+        0u,                                                  // flags
+        VK_SHADER_STAGE_COMPUTE_BIT,                         // stage
+        shaderModule,                                        // module
+        "main",                                              // pName
+        nullptr                                              // pSpecializationInfo
+    };
+
+    std::unique_ptr<Pipeline> pipeline { nullptr };
+
+    // Modules are only needed to create pipelines.
+    try {
+        pipeline = std::make_unique<Pipeline>(
+            m_allocationCallbacks,
+            m_device,
+            std::vector<VkDescriptorSetLayout> { m_descriptorSetLayout },
+            pipelineShaderStageCreateInfo,
+            static_cast<uint32_t>(sizeof(PushConstants))
+        );
+    } catch (const std::exception&) {
+        vkDestroyShaderModule(m_device->getLogicalDevice(), shaderModule, m_allocationCallbacks);
+        throw;
+    }
+
+    vkDestroyShaderModule(m_device->getLogicalDevice(), shaderModule, m_allocationCallbacks);
+
+    return pipeline;
+}
+
+} // namespace vulkan
+} // namespace renderer
+} // namespace beige
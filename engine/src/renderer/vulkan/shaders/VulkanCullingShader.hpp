@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../VulkanDevice.hpp"
+#include "../VulkanPipeline.hpp"
+#include "../VulkanBuffer.hpp"
+#include "../VulkanDeletionQueue.hpp"
+#include "../../../core/Vfs.hpp"
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace beige {
+namespace renderer {
+namespace vulkan {
+
+/**
+ * Culls instance objects against the view frustum in a compute pass and compacts the visible ones into indirect draw
+ * commands, so they are drawn with one call however many there are. Keeps its output buffers per frame in flight.
+ */
+class CullingShader final {
+private:
+    static constexpr uint32_t m_descriptorCount { 3u };
+    static constexpr uint32_t m_workgroupSize { 64u }; // Matches local_size_x of the shader.
+    static constexpr std::string_view m_builtinCullingShaderName { "Builtin.CullingShader" };
+
+public:
+    CullingShader(
+        VkAllocationCallbacks* allocationCallbacks,
+        std::shared_ptr<Device> device,
+        const uint32_t frameCount,
+        const uint32_t maxInstanceCount,
+        std::shared_ptr<const core::Vfs> vfs
+    );
+    ~CullingShader();
+
+    CullingShader(const CullingShader&) = delete;
+    auto operator=(const CullingShader&) -> CullingShader& = delete;
+
+    /**
+     * Reads the SPIR-V again and rebuilds the pipeline, the previous one goes to the deletion queue.
+     * @returns True if the new pipeline is in use, false if the previous one is kept.
+     */
+    auto reload(DeletionQueue& deletionQueue) -> bool;
+
+    /**
+     * Records the culling of a range of the instance buffer, outside of a render pass.
+     * @param frame The frame in flight, picks the output buffers.
+     * @param firstInstance The first instance object to cull, draws refer to instance objects by their index.
+     * @param frustumPlanes The planes as (a, b, c, d) with normals pointing inward.
+     */
+    auto dispatch(
+        const VkCommandBuffer& commandBuffer,
+        const uint32_t frame,
+        const Buffer& instanceBuffer,
+        const uint32_t firstInstance,
+        const uint32_t instanceCount,
+        const std::array<float, 24u>& frustumPlanes
+    ) -> void;
+
+    /**
+     * Records the indirect draw of the instances which survived dispatch() in the same frame.
+     * @param maxDrawCount The number of instances which were culled.
+     */
+    auto draw(
+        const VkCommandBuffer& commandBuffer,
+        const uint32_t frame,
+        const uint32_t maxDrawCount
+    ) const -> void;
+
+private:
+    struct PushConstants {
+        std::array<float, 24u> frustumPlanes; // 96 bytes
+        uint32_t firstInstance;               // 4 bytes
+        uint32_t instanceCount;               // 4 bytes
+    };
+
+    VkAllocationCallbacks* m_allocationCallbacks;
+    std::shared_ptr<Device> m_device;
+    std::shared_ptr<const core::Vfs> m_vfs;
+
+    VkDescriptorPool m_descriptorPool;
+    VkDescriptorSetLayout m_descriptorSetLayout;
+    std::vector<VkDescriptorSet> m_descriptorSets; // One per frame in flight.
+
+    // One per frame in flight, only ever written by the device.
+    std::vector<std::unique_ptr<Buffer>> m_drawCommandBuffers;
+    std::vector<std::unique_ptr<Buffer>> m_drawCountBuffers;
+
+    std::unique_ptr<Pipeline> m_pipeline;
+
+    /**
+     * @returns The pipeline, or nullptr if the SPIR-V could not be read.
+     */
+    auto createPipeline() -> std::unique_ptr<Pipeline>;
+};
+
+} // namespace vulkan
+} // namespace renderer
+} // namespace beige
@@ -3,9 +3,10 @@
 #include "../../../core/Logger.hpp"
 #include "../VulkanDefines.hpp"
 #include "../VulkanTexture.hpp"
+#include "../VulkanUtils.hpp"
 
 #include <map>
-#include <fstream>
+#include <cstring>
 #include <algorithm>
 #include <vector>
 #include <memory>
@@ -20,12 +21,14 @@ MaterialShader::MaterialShader(
     std::shared_ptr<RenderPass> renderPass,
     std::shared_ptr<Swapchain> swapchain,
     const uint32_t framebufferWidth,
-    const uint32_t framebufferHeight
+    const uint32_t framebufferHeight,
+    std::shared_ptr<const core::Vfs> vfs
 ) :
 m_allocationCallbacks { allocationCallbacks },
 m_device { device },
 m_renderPass { renderPass },
 m_swapchain { swapchain },
+m_vfs { vfs },
 m_stages { },
 m_globalDescriptorPool { VK_NULL_HANDLE },
 m_globalDescriptorSetLayout { VK_NULL_HANDLE },
@@ -37,22 +40,12 @@ m_objectDescriptorSetLayout { VK_NULL_HANDLE },
 m_objectUniformBuffer { nullptr },
 m_objectUniformBufferIndex { 0u },
 m_objectStates { },
-m_pipeline { nullptr } {
+m_pipeline { nullptr },
+m_defaultTexture { nullptr } {
     // Shader module initialization per stage.
-    const std::array<std::string, m_stageCount> shaderTypeStrings { "vert", "frag" };
-    const std::array<VkShaderStageFlagBits, m_stageCount> shaderTypeStageFlagBits {
-        VK_SHADER_STAGE_VERTEX_BIT,
-        VK_SHADER_STAGE_FRAGMENT_BIT
-    };
-
-    for (uint32_t i { 0u }; i < m_stageCount; i++) {
-        if (!createShaderModule(m_stages.at(i), m_builtinMaterialShaderName.data(), shaderTypeStrings.at(i), shaderTypeStageFlagBits.at(i))) {
-            const std::string message {
-                "Unable to create " + shaderTypeStrings.at(i) + " shader module for " + m_builtinMaterialShaderName.data() + "!"
-            };
-
-            throw std::exception(message.c_str());
-        }
+    if (!createShaderModules(m_stages)) {
+        const std::string message { "Unable to create shader modules for " + std::string(m_builtinMaterialShaderName) + "!" };
+        throw std::exception(message.c_str());
     }
 
     // Global descriptors.
@@ -64,12 +57,26 @@ m_pipeline { nullptr } {
         nullptr                            // pImmutableSamplers
     };
 
+    // Model matrices of every object drawn this frame, indexed by the instance index of the draw.
+    const VkDescriptorSetLayoutBinding instanceObjectsDescriptorSetLayoutBinding {
+        1u,                                // binding
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, // descriptorType
+        1u,                                // descriptorCount
+        VK_SHADER_STAGE_VERTEX_BIT,        // stageFlags
+        nullptr                            // pImmutableSamplers
+    };
+
+    const std::array<VkDescriptorSetLayoutBinding, 2u> globalDescriptorSetLayoutBindings {
+        globalUniformObjectDescriptorSetLayoutBinding,
+        instanceObjectsDescriptorSetLayoutBinding
+    };
+
     const VkDescriptorSetLayoutCreateInfo globalDescriptorSetLayoutCreateInfo {
-        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO, // sType
-        nullptr,                                             // pNext
-        0u,                                                  // flags
-        1u,                                                  // bindingCount
-        &globalUniformObjectDescriptorSetLayoutBinding       // pBindings
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,             // sType
+        nullptr,                                                         // pNext
+        0u,                                                              // flags
+        static_cast<uint32_t>(globalDescriptorSetLayoutBindings.size()), // bindingCount
+        globalDescriptorSetLayoutBindings.data()                         // pBindings
     };
 
     VULKAN_CHECK(
@@ -86,18 +93,28 @@ m_pipeline { nullptr } {
         static_cast<uint32_t>(m_swapchain->getImages().size())
     };
 
-    const VkDescriptorPoolSize globalDescriptorPoolSize {
+    const VkDescriptorPoolSize globalUniformBuffersDescriptorPoolSize {
         VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, // type
         imageCount                         // descriptorCount
     };
 
+    const VkDescriptorPoolSize globalStorageBuffersDescriptorPoolSize {
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, // type
+        imageCount                         // descriptorCount
+    };
+
+    const std::array<VkDescriptorPoolSize, 2u> globalDescriptorPoolSizes {
+        globalUniformBuffersDescriptorPoolSize,
+        globalStorageBuffersDescriptorPoolSize
+    };
+
     const VkDescriptorPoolCreateInfo globalDescriptorPoolCreateInfo {
-        VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO, // sType
-        nullptr,                                       // pNext
-        0u,                                            // flags
-        imageCount,                                    // maxSets
-        1u,                                            // poolSizeCount
-        &globalDescriptorPoolSize                      // pPoolSizes
+        VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,           // sType
+        nullptr,                                                 // pNext
+        0u,                                                      // flags
+        imageCount,                                              // maxSets
+        static_cast<uint32_t>(globalDescriptorPoolSizes.size()), // poolSizeCount
+        globalDescriptorPoolSizes.data()                         // pPoolSizes
     };
 
     VULKAN_CHECK(
@@ -181,81 +198,7 @@ m_pipeline { nullptr } {
     );
 
     // Pipeline creation.
-    const VkViewport viewport {
-        0.0f,                                   // x
-        static_cast<float>(framebufferHeight),  // y
-        static_cast<float>(framebufferWidth),   // width
-        -static_cast<float>(framebufferHeight), // height
-        0.0f,                                   // minDepth
-        1.0f                                    // maxDepth
-    };
-
-    const VkOffset2D scissorOffset {
-        0, // x
-        0  // y
-    };
-
-    const VkExtent2D scissorExtent {
-        framebufferWidth, // width
-        framebufferHeight // height
-    };
-
-    const VkRect2D scissor {
-        scissorOffset, // offset
-        scissorExtent  // extent
-    };
-
-    uint32_t offset { 0u };
-
-    const uint32_t attributeCount { 2u };
-
-    const std::array<VkFormat, attributeCount> formats {
-        VK_FORMAT_R32G32B32_SFLOAT,
-        VK_FORMAT_R32G32_SFLOAT
-    };
-
-    const std::array<uint32_t, attributeCount> sizes {
-        static_cast<uint32_t>(sizeof(glm::vec3)),
-        static_cast<uint32_t>(sizeof(glm::vec2))
-    };
-
-    std::vector<VkVertexInputAttributeDescription> vertexInputAttributeDescriptions { attributeCount };
-
-    for (uint32_t i { 0u }; i < attributeCount; i++) {
-        const VkVertexInputAttributeDescription vertexInputAttributeDescription {
-            i,             // location
-            0u,            // binding
-            formats.at(i), // format
-            offset         // offset
-        };
-
-        vertexInputAttributeDescriptions.at(i) = vertexInputAttributeDescription;
-        offset += sizes.at(i);
-    }
-
-    // Descriptor set layouts.
-    const std::vector<VkDescriptorSetLayout> descriptorSetLayouts {
-        m_globalDescriptorSetLayout,
-        m_objectDescriptorSetLayout
-    };
-
-    std::vector<VkPipelineShaderStageCreateInfo> pipelineShaderStageCreateInfos { m_stageCount };
-    for (uint32_t i { 0u }; i < m_stageCount; i++) {
-        pipelineShaderStageCreateInfos.at(i).sType = m_stages.at(i).pipelineShaderStageCreateInfo.sType;
-        pipelineShaderStageCreateInfos.at(i) = m_stages.at(i).pipelineShaderStageCreateInfo;
-    }
-
-    m_pipeline = std::make_unique<Pipeline>(
-        m_allocationCallbacks,
-        m_device,
-        m_renderPass,
-        vertexInputAttributeDescriptions,
-        descriptorSetLayouts,
-        pipelineShaderStageCreateInfos,
-        viewport,
-        scissor,
-        false
-    );
+    m_pipeline = createPipeline(m_stages, framebufferWidth, framebufferHeight);
 
     // Create uniform buffer.
     const VkBufferUsageFlags globalUniformBufferUsageFlags {
@@ -369,17 +312,7 @@ MaterialShader::~MaterialShader() {
     );
 
     // Destroy shader modules.
-    std::for_each(
-        m_stages.begin(),
-        m_stages.end(),
-        [&](const Stage& stage) -> void {
-            vkDestroyShaderModule(
-                logicalDevice,
-                stage.shaderModule,
-                m_allocationCallbacks
-            );
-        }
-    );
+    destroyShaderModules(m_stages);
 }
 
 auto MaterialShader::setProjection(const glm::mat4x4& projection) -> void {
@@ -390,6 +323,47 @@ auto MaterialShader::setView(const glm::mat4x4& view) -> void {
     m_globalUniformObject.view = view;
 }
 
+auto MaterialShader::setDefaultTexture(std::shared_ptr<Texture> texture) -> void {
+    m_defaultTexture = texture;
+}
+
+auto MaterialShader::reload(
+    const uint32_t framebufferWidth,
+    const uint32_t framebufferHeight,
+    DeletionQueue& deletionQueue
+) -> bool {
+    std::array<Stage, m_stageCount> stages { };
+
+    if (!createShaderModules(stages)) {
+        core::Logger::error("Reloading " + std::string(m_builtinMaterialShaderName) + " failed, keeping the previous shaders!");
+        return false;
+    }
+
+    std::unique_ptr<Pipeline> pipeline { nullptr };
+
+    try {
+        pipeline = createPipeline(stages, framebufferWidth, framebufferHeight);
+    } catch (const std::exception& exception) {
+        destroyShaderModules(stages);
+        core::Logger::error(
+            "Reloading " + std::string(m_builtinMaterialShaderName) + " failed, keeping the previous shaders: " + exception.what()
+        );
+        return false;
+    }
+
+    // Modules are only needed to create pipelines, but frames in flight still bind the previous pipeline.
+    destroyShaderModules(m_stages);
+    m_stages = stages;
+
+    std::shared_ptr<Pipeline> previousPipeline { std::move(m_pipeline) };
+    deletionQueue.push([previousPipeline]() mutable -> void { previousPipeline.reset(); });
+    m_pipeline = std::move(pipeline);
+
+    core::Logger::info("Reloaded " + std::string(m_builtinMaterialShaderName) + ".");
+
+    return true;
+}
+
 auto MaterialShader::use(const VkCommandBuffer& commandBuffer) -> void {
     m_pipeline->bind(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS);
 }
@@ -398,6 +372,7 @@ auto MaterialShader::use(const VkCommandBuffer& commandBuffer) -> void {
 auto MaterialShader::updateGlobalState(
     const uint32_t imageIndex,
     const VkCommandBuffer& commandBuffer,
+    const Buffer& instanceBuffer,
     const float deltaTime
 ) -> void {
     const VkDescriptorSet globalDescriptorSet { m_globalDescriptorSets.at(imageIndex) };
@@ -427,6 +402,12 @@ auto MaterialShader::updateGlobalState(
         range                               // range
     };
 
+    const VkDescriptorBufferInfo instanceDescriptorBufferInfo {
+        instanceBuffer.getHandle(), // buffer
+        0u,                         // offset
+        VK_WHOLE_SIZE               // range
+    };
+
     // Update descriptor sets.
     const VkWriteDescriptorSet writeDescriptorSet {
         VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, // sType
@@ -441,10 +422,28 @@ auto MaterialShader::updateGlobalState(
         nullptr                                 // pTexelBufferView
     };
 
+    const VkWriteDescriptorSet instanceWriteDescriptorSet {
+        VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, // sType
+        nullptr,                                // pNext
+        m_globalDescriptorSets.at(imageIndex),  // dstSet
+        1u,                                     // dstBinding
+        0u,                                     // dstArrayElement
+        1u,                                     // descriptorCount
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,      // descriptorType
+        nullptr,                                // pImageInfo
+        &instanceDescriptorBufferInfo,          // pBufferInfo
+        nullptr                                 // pTexelBufferView
+    };
+
+    const std::array<VkWriteDescriptorSet, 2u> writeDescriptorSets {
+        writeDescriptorSet,
+        instanceWriteDescriptorSet
+    };
+
     vkUpdateDescriptorSets(
         m_device->getLogicalDevice(),
-        1u,
-        &writeDescriptorSet,
+        static_cast<uint32_t>(writeDescriptorSets.size()),
+        writeDescriptorSets.data(),
         0u,
         nullptr
     );
@@ -454,17 +453,9 @@ auto MaterialShader::updateObject(
     const VkCommandBuffer& commandBuffer,
     const uint32_t imageIndex,
     const GeometryRenderData& geometryRenderData,
+    const resources::TexturePool& texturePool,
     const float deltaTime // TODO: Temporary.
 ) -> void {
-    vkCmdPushConstants(
-        commandBuffer,
-        m_pipeline->getPipelineLayout(),
-        VK_SHADER_STAGE_VERTEX_BIT,
-        0u,
-        static_cast<uint32_t>(sizeof(glm::mat4x4)),
-        static_cast<const void*>(&geometryRenderData.model)
-    );
-
     // Obtain material data.
     ObjectState& objectState { m_objectStates.at(geometryRenderData.objectId) };
     const VkDescriptorSet objectDescriptorSet { objectState.descriptorSets.at(imageIndex) };
@@ -522,23 +513,21 @@ auto MaterialShader::updateObject(
     const uint32_t samplerCount { 1u };
     std::array<VkDescriptorImageInfo, 1u> descriptorImageInfos { };
     for (uint32_t samplerIndex { 0u }; samplerIndex < samplerCount; samplerIndex++) {
-        std::shared_ptr<Texture> texture {
-            std::dynamic_pointer_cast<Texture>(geometryRenderData.textures.at(samplerIndex))
+        const Texture* texture {
+            dynamic_cast<const Texture*>(texturePool.resolve(geometryRenderData.textures.at(samplerIndex)))
         };
 
         uint32_t& descriptorGeneration { objectState.descriptorStates.at(descriptorIndex).generations.at(imageIndex) };
         uint32_t& descriptorId { objectState.descriptorStates.at(descriptorIndex).ids.at(imageIndex) };
 
-        // If the texture hasn't been loaded yet, use the default.
+        // If the texture hasn't been loaded yet (e.g. it is still streaming in), use the default.
         // TODO: Determine which use the texture has and pull appropriate default based on that.
         if (texture == nullptr || texture->getGeneration() == resources::global_invalidTextureGeneration) {
-            texture = nullptr; // TODO: Refactor with texture system.
-
-            // Reset the descriptor generation if using the default texture.
-            descriptorGeneration = resources::global_invalidTextureGeneration;
+            texture = m_defaultTexture.get();
         }
 
-        // Check if the descriptor needs updating first.
+        // Check if the descriptor needs updating first. Once the real texture is uploaded its id or generation
+        // differs from the default texture's, which rewrites the descriptor.
         if (
             texture != nullptr &&
             (descriptorId != texture->getId() || descriptorGeneration != texture->getGeneration() || descriptorGeneration == resources::global_invalidTextureGeneration)
@@ -600,6 +589,11 @@ auto MaterialShader::updateObject(
 
 auto MaterialShader::acquireResources() -> std::optional<resources::ObjectId> {
     // TODO: Free list.
+    if (m_objectUniformBufferIndex >= m_maxObjectCount) {
+        core::Logger::error("MaterialShader::acquireResources - every object id is taken!");
+        return std::nullopt;
+    }
+
     const resources::ObjectId objectId { m_objectUniformBufferIndex };
     m_objectUniformBufferIndex++;
 
@@ -671,52 +665,134 @@ auto MaterialShader::releaseResources(const resources::ObjectId objectId) -> voi
     // TODO: Add the objectId to the free list.
 }
 
-auto MaterialShader::createShaderModule(
-    Stage& stage,
-    const std::string& name,
-    const std::string& type,
-    const VkShaderStageFlagBits shaderStageFlagBits
-) -> bool {
-    stage.shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+auto MaterialShader::createShaderModules(std::array<Stage, m_stageCount>& stages) -> bool {
+    const std::array<std::string, m_stageCount> shaderTypeStrings { "vert", "frag" };
+    const std::array<VkShaderStageFlagBits, m_stageCount> shaderTypeStageFlagBits {
+        VK_SHADER_STAGE_VERTEX_BIT,
+        VK_SHADER_STAGE_FRAGMENT_BIT
+    };
 
-    const std::string path { "assets/shaders/" + name + "." + type + ".glsl.spv" };
-    std::ifstream file { path, std::ios::binary | std::ios::ate };
+    for (uint32_t i { 0u }; i < m_stageCount; i++) {
+        if (!createShaderModule(stages.at(i), m_builtinMaterialShaderName.data(), shaderTypeStrings.at(i), shaderTypeStageFlagBits.at(i))) {
+            core::Logger::error(
+                "Unable to create " + shaderTypeStrings.at(i) + " shader module for " + m_builtinMaterialShaderName.data() + "!"
+            );
 
-    if (!file.good()) {
-        core::Logger::error("Shader module file error: " + path + "!");
-        return false;
+            destroyShaderModules(stages);
+            return false;
+        }
     }
 
-    std::streampos end { file.tellg() };
-    file.seekg(0, std::ios::beg);
-
-    std::size_t size { std::size_t(end - file.tellg()) };
+    return true;
+}
 
-    if (size == 0u) {
-        core::Logger::error("Shader file is empty: " + path + "!");
-        return false;
+auto MaterialShader::destroyShaderModules(std::array<Stage, m_stageCount>& stages) -> void {
+    for (Stage& stage : stages) {
+        if (stage.shaderModule != VK_NULL_HANDLE) {
+            vkDestroyShaderModule(
+                m_device->getLogicalDevice(),
+                stage.shaderModule,
+                m_allocationCallbacks
+            );
+            stage.shaderModule = VK_NULL_HANDLE;
+        }
     }
+}
+
+auto MaterialShader::createPipeline(
+    const std::array<Stage, m_stageCount>& stages,
+    const uint32_t framebufferWidth,
+    const uint32_t framebufferHeight
+) -> std::unique_ptr<Pipeline> {
+    const VkViewport viewport {
+        0.0f,                                   // x
+        static_cast<float>(framebufferHeight),  // y
+        static_cast<float>(framebufferWidth),   // width
+        -static_cast<float>(framebufferHeight), // height
+        0.0f,                                   // minDepth
+        1.0f                                    // maxDepth
+    };
 
-    std::vector<std::byte> buffer { size };
+    const VkOffset2D scissorOffset {
+        0, // x
+        0  // y
+    };
 
-    if (!file.read((char*)buffer.data(), buffer.size())) {
-        core::Logger::error("Unable to read shader module: " + path + "!");
-        return false;
+    const VkExtent2D scissorExtent {
+        framebufferWidth, // width
+        framebufferHeight // height
+    };
+
+    const VkRect2D scissor {
+        scissorOffset, // offset
+        scissorExtent  // extent
+    };
+
+    uint32_t offset { 0u };
+
+    const uint32_t attributeCount { 2u };
+
+    const std::array<VkFormat, attributeCount> formats {
+        VK_FORMAT_R32G32B32_SFLOAT,
+        VK_FORMAT_R32G32_SFLOAT
+    };
+
+    const std::array<uint32_t, attributeCount> sizes {
+        static_cast<uint32_t>(sizeof(glm::vec3)),
+        static_cast<uint32_t>(sizeof(glm::vec2))
+    };
+
+    std::vector<VkVertexInputAttributeDescription> vertexInputAttributeDescriptions { attributeCount };
+
+    for (uint32_t i { 0u }; i < attributeCount; i++) {
+        const VkVertexInputAttributeDescription vertexInputAttributeDescription {
+            i,             // location
+            0u,            // binding
+            formats.at(i), // format
+            offset         // offset
+        };
+
+        vertexInputAttributeDescriptions.at(i) = vertexInputAttributeDescription;
+        offset += sizes.at(i);
     }
 
-    stage.shaderModuleCreateInfo.codeSize = size;
-    stage.shaderModuleCreateInfo.pCode = reinterpret_cast<const uint32_t*>(buffer.data());
+    // Descriptor set layouts.
+    const std::vector<VkDescriptorSetLayout> descriptorSetLayouts {
+        m_globalDescriptorSetLayout,
+        m_objectDescriptorSetLayout
+    };
 
-    file.close();
+    std::vector<VkPipelineShaderStageCreateInfo> pipelineShaderStageCreateInfos { m_stageCount };
+    for (uint32_t i { 0u }; i < m_stageCount; i++) {
+        pipelineShaderStageCreateInfos.at(i).sType = stages.at(i).pipelineShaderStageCreateInfo.sType;
+        pipelineShaderStageCreateInfos.at(i) = stages.at(i).pipelineShaderStageCreateInfo;
+    }
 
-    VULKAN_CHECK(
-        vkCreateShaderModule(
-            m_device->getLogicalDevice(),
-            &stage.shaderModuleCreateInfo,
-            m_allocationCallbacks,
-            &stage.shaderModule
-        )
+    return std::make_unique<Pipeline>(
+        m_allocationCallbacks,
+        m_device,
+        m_renderPass,
+        vertexInputAttributeDescriptions,
+        descriptorSetLayouts,
+        pipelineShaderStageCreateInfos,
+        viewport,
+        scissor,
+        false
     );
+}
+
+auto MaterialShader::createShaderModule(
+    Stage& stage,
+    const std::string& name,
+    const std::string& type,
+    const VkShaderStageFlagBits shaderStageFlagBits
+) -> bool {
+    const std::string path { "shaders/" + name + "." + type + ".glsl.spv" };
+    stage.shaderModule = Utils::createShaderModule(m_device->getLogicalDevice(), m_allocationCallbacks, *m_vfs, path);
+
+    if (stage.shaderModule == VK_NULL_HANDLE) {
+        return false;
+    }
 
     stage.pipelineShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     stage.pipelineShaderStageCreateInfo.stage = shaderStageFlagBits;
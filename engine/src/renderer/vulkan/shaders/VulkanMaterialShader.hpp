@@ -6,6 +6,9 @@
 #include "../VulkanSwapchain.hpp"
 #include "../../RendererTypes.hpp"
 #include "../VulkanTexture.hpp"
+#include "../VulkanDeletionQueue.hpp"
+#include "../../../resources/TexturePool.hpp"
+#include "../../../core/Vfs.hpp"
 
 #include <vulkan/vulkan.h>
 
@@ -46,24 +49,41 @@ public:
         std::shared_ptr<RenderPass> renderPass,
         std::shared_ptr<Swapchain> swapchain,
         const uint32_t framebufferWidth,
-        const uint32_t framebufferHeight
+        const uint32_t framebufferHeight,
+        std::shared_ptr<const core::Vfs> vfs
     );
     ~MaterialShader();
 
     auto setProjection(const glm::mat4x4& projection) -> void;
     auto setView(const glm::mat4x4& view) -> void;
+    auto setDefaultTexture(std::shared_ptr<Texture> texture) -> void;
+
+    /**
+     * Reads the SPIR-V again and rebuilds the pipeline, the previous one goes to the deletion queue.
+     * @returns True if the new pipeline is in use, false if the previous one is kept.
+     */
+    auto reload(
+        const uint32_t framebufferWidth,
+        const uint32_t framebufferHeight,
+        DeletionQueue& deletionQueue
+    ) -> bool;
 
     auto use(const VkCommandBuffer& commandBuffer) -> void;
 
+    /**
+     * @param instanceBuffer The instance objects of the frame, drawn with their index as the first instance.
+     */
     auto updateGlobalState(
         const uint32_t imageIndex,
         const VkCommandBuffer& commandBuffer,
+        const Buffer& instanceBuffer,
         const float deltaTime
     ) -> void;
     auto updateObject(
         const VkCommandBuffer& commandBuffer,
         const uint32_t imageIndex,
         const GeometryRenderData& geometryRenderData,
+        const resources::TexturePool& texturePool,
         const float deltaTime // TODO: Temporary.
     ) -> void;
     auto acquireResources() -> std::optional<resources::ObjectId>;
@@ -71,7 +91,6 @@ public:
 
 private:
     struct Stage {
-        VkShaderModuleCreateInfo shaderModuleCreateInfo;
         VkShaderModule shaderModule;
         VkPipelineShaderStageCreateInfo pipelineShaderStageCreateInfo;
     };
@@ -80,6 +99,7 @@ private:
     std::shared_ptr<Device> m_device;
     std::shared_ptr<RenderPass> m_renderPass;
     std::shared_ptr<Swapchain> m_swapchain;
+    std::shared_ptr<const core::Vfs> m_vfs;
 
     std::array<Stage, m_stageCount> m_stages;
 
@@ -107,6 +127,16 @@ private:
 
     std::unique_ptr<Pipeline> m_pipeline;
 
+    // Bound in place of textures which are not loaded yet.
+    std::shared_ptr<Texture> m_defaultTexture;
+
+    auto createShaderModules(std::array<Stage, m_stageCount>& stages) -> bool;
+    auto destroyShaderModules(std::array<Stage, m_stageCount>& stages) -> void;
+    auto createPipeline(
+        const std::array<Stage, m_stageCount>& stages,
+        const uint32_t framebufferWidth,
+        const uint32_t framebufferHeight
+    ) -> std::unique_ptr<Pipeline>;
     auto createShaderModule(
         Stage& stage,
         const std::string& name,
@@ -0,0 +1,434 @@
+#include "BlockCompression.hpp"
+
+#include "TextureUtils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BEIGE_BLOCK_COMPRESSION_SSE2
+#endif // SSE2
+
+namespace beige {
+namespace resources {
+
+namespace {
+
+constexpr uint32_t global_texelCount { 16u };
+
+// Per channel minimum and maximum of the 16 texels of a block.
+auto computeBounds(const uint8_t* texels, std::array<uint8_t, 4u>& minimum, std::array<uint8_t, 4u>& maximum) -> void {
+#ifdef BEIGE_BLOCK_COMPRESSION_SSE2
+    const __m128i row0 { _mm_loadu_si128(reinterpret_cast<const __m128i*>(texels)) };
+    const __m128i row1 { _mm_loadu_si128(reinterpret_cast<const __m128i*>(texels + 16u)) };
+    const __m128i row2 { _mm_loadu_si128(reinterpret_cast<const __m128i*>(texels + 32u)) };
+    const __m128i row3 { _mm_loadu_si128(reinterpret_cast<const __m128i*>(texels + 48u)) };
+
+    // Reduce the four rows to four texels, then the four texels to one.
+    __m128i low { _mm_min_epu8(_mm_min_epu8(row0, row1), _mm_min_epu8(row2, row3)) };
+    __m128i high { _mm_max_epu8(_mm_max_epu8(row0, row1), _mm_max_epu8(row2, row3)) };
+    low = _mm_min_epu8(low, _mm_srli_si128(low, 8));
+    high = _mm_max_epu8(high, _mm_srli_si128(high, 8));
+    low = _mm_min_epu8(low, _mm_srli_si128(low, 4));
+    high = _mm_max_epu8(high, _mm_srli_si128(high, 4));
+
+    const uint32_t packedLow { static_cast<uint32_t>(_mm_cvtsi128_si32(low)) };
+    const uint32_t packedHigh { static_cast<uint32_t>(_mm_cvtsi128_si32(high)) };
+    std::memcpy(minimum.data(), &packedLow, 4u);
+    std::memcpy(maximum.data(), &packedHigh, 4u);
+#else
+    minimum.fill(0xFFu);
+    maximum.fill(0u);
+
+    for (uint32_t i { 0u }; i < global_texelCount; i++) {
+        for (uint32_t c { 0u }; c < 4u; c++) {
+            minimum.at(c) = std::min(minimum.at(c), texels[i * 4u + c]);
+            maximum.at(c) = std::max(maximum.at(c), texels[i * 4u + c]);
+        }
+    }
+#endif // BEIGE_BLOCK_COMPRESSION_SSE2
+}
+
+// Range fit: shrinks the bounding box slightly and orients its diagonal along the texel distribution.
+// Alpha and bounds at 0 or 255 are kept exact, cutouts need fully transparent and fully opaque texels to stay so.
+// Returns the two endpoints, each channel of endpoint0 is not necessarily above the one of endpoint1.
+auto fitEndpoints(
+    const uint8_t* texels,
+    const uint32_t channelCount,
+    std::array<int32_t, 4u>& endpoint0,
+    std::array<int32_t, 4u>& endpoint1
+) -> void {
+    std::array<uint8_t, 4u> minimum;
+    std::array<uint8_t, 4u> maximum;
+    computeBounds(texels, minimum, maximum);
+
+    std::array<int32_t, 4u> mean { 0, 0, 0, 0 };
+    uint32_t axis { 0u };
+    for (uint32_t c { 0u }; c < channelCount; c++) {
+        const int32_t inset { c == 3u ? 0 : (maximum.at(c) - minimum.at(c)) / 16 };
+        endpoint0.at(c) = maximum.at(c) == 0xFFu ? 0xFF : maximum.at(c) - inset;
+        endpoint1.at(c) = minimum.at(c) == 0u ? 0 : minimum.at(c) + inset;
+
+        for (uint32_t i { 0u }; i < global_texelCount; i++) {
+            mean.at(c) += texels[i * 4u + c];
+        }
+        mean.at(c) /= static_cast<int32_t>(global_texelCount);
+
+        if (maximum.at(c) - minimum.at(c) > maximum.at(axis) - minimum.at(axis)) {
+            axis = c;
+        }
+    }
+
+    // Channels moving against the widest one get their endpoints swapped.
+    for (uint32_t c { 0u }; c < channelCount; c++) {
+        if (c == axis) {
+            continue;
+        }
+
+        int32_t covariance { 0 };
+        for (uint32_t i { 0u }; i < global_texelCount; i++) {
+            covariance += (texels[i * 4u + axis] - mean.at(axis)) * (texels[i * 4u + c] - mean.at(c));
+        }
+
+        if (covariance < 0) {
+            std::swap(endpoint0.at(c), endpoint1.at(c));
+        }
+    }
+}
+
+auto packRgb565(const std::array<int32_t, 4u>& color) -> uint16_t {
+    const uint32_t r { static_cast<uint32_t>(color.at(0u) * 31 + 127) / 255u };
+    const uint32_t g { static_cast<uint32_t>(color.at(1u) * 63 + 127) / 255u };
+    const uint32_t b { static_cast<uint32_t>(color.at(2u) * 31 + 127) / 255u };
+    return static_cast<uint16_t>((r << 11u) | (g << 5u) | b);
+}
+
+auto unpackRgb565(const uint16_t packed) -> std::array<int32_t, 4u> {
+    const int32_t r { (packed >> 11u) & 0x1F };
+    const int32_t g { (packed >> 5u) & 0x3F };
+    const int32_t b { packed & 0x1F };
+    return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), 0xFF };
+}
+
+auto writeColorBlock(const uint8_t* texels, uint8_t* block) -> void {
+    std::array<int32_t, 4u> endpoint0;
+    std::array<int32_t, 4u> endpoint1;
+    fitEndpoints(texels, 3u, endpoint0, endpoint1);
+
+    uint16_t color0 { packRgb565(endpoint0) };
+    uint16_t color1 { packRgb565(endpoint1) };
+
+    // color0 > color1 selects the four color mode, which is the only one used here.
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+
+    uint32_t indices { 0u };
+
+    if (color0 != color1) {
+        const std::array<int32_t, 4u> decoded0 { unpackRgb565(color0) };
+        const std::array<int32_t, 4u> decoded1 { unpackRgb565(color1) };
+
+        std::array<std::array<int32_t, 4u>, 4u> palette;
+        for (uint32_t c { 0u }; c < 3u; c++) {
+            palette.at(0u).at(c) = decoded0.at(c);
+            palette.at(1u).at(c) = decoded1.at(c);
+            palette.at(2u).at(c) = (2 * decoded0.at(c) + decoded1.at(c)) / 3;
+            palette.at(3u).at(c) = (decoded0.at(c) + 2 * decoded1.at(c)) / 3;
+        }
+
+        for (uint32_t i { 0u }; i < global_texelCount; i++) {
+            uint32_t bestIndex { 0u };
+            int32_t bestError { INT32_MAX };
+
+            for (uint32_t p { 0u }; p < 4u; p++) {
+                int32_t error { 0 };
+                for (uint32_t c { 0u }; c < 3u; c++) {
+                    const int32_t difference { texels[i * 4u + c] - palette.at(p).at(c) };
+                    error += difference * difference;
+                }
+
+                if (error < bestError) {
+                    bestError = error;
+                    bestIndex = p;
+                }
+            }
+
+            indices |= bestIndex << (i * 2u);
+        }
+    }
+
+    block[0u] = static_cast<uint8_t>(color0 & 0xFFu);
+    block[1u] = static_cast<uint8_t>(color0 >> 8u);
+    block[2u] = static_cast<uint8_t>(color1 & 0xFFu);
+    block[3u] = static_cast<uint8_t>(color1 >> 8u);
+    std::memcpy(block + 4u, &indices, sizeof(indices)); // NOTE: Assumes a little endian host.
+}
+
+auto writeAlphaBlock(const uint8_t* texels, uint8_t* block) -> void {
+    uint8_t alpha0 { 0u };
+    uint8_t alpha1 { 0xFFu };
+    for (uint32_t i { 0u }; i < global_texelCount; i++) {
+        alpha0 = std::max(alpha0, texels[i * 4u + 3u]);
+        alpha1 = std::min(alpha1, texels[i * 4u + 3u]);
+    }
+
+    uint64_t indices { 0u };
+
+    // alpha0 > alpha1 selects the eight value mode.
+    if (alpha0 != alpha1) {
+        std::array<int32_t, 8u> palette;
+        palette.at(0u) = alpha0;
+        palette.at(1u) = alpha1;
+        for (int32_t p { 2 }; p < 8; p++) {
+            palette.at(p) = ((8 - p) * alpha0 + (p - 1) * alpha1) / 7;
+        }
+
+        for (uint32_t i { 0u }; i < global_texelCount; i++) {
+            uint64_t bestIndex { 0u };
+            int32_t bestError { INT32_MAX };
+
+            for (uint32_t p { 0u }; p < 8u; p++) {
+                const int32_t error { std::abs(texels[i * 4u + 3u] - palette.at(p)) };
+                if (error < bestError) {
+                    bestError = error;
+                    bestIndex = p;
+                }
+            }
+
+            indices |= bestIndex << (i * 3u);
+        }
+    }
+
+    block[0u] = alpha0;
+    block[1u] = alpha1;
+    for (uint32_t i { 0u }; i < 6u; i++) {
+        block[2u + i] = static_cast<uint8_t>(indices >> (i * 8u));
+    }
+}
+
+// Writes the low count bits of value at position, bits are laid out least significant first.
+auto writeBits(std::array<uint64_t, 2u>& bits, uint32_t& position, const uint64_t value, const uint32_t count) -> void {
+    for (uint32_t i { 0u }; i < count; i++) {
+        const uint32_t bit { position + i };
+        bits.at(bit / 64u) |= ((value >> i) & 1u) << (bit % 64u);
+    }
+
+    position += count;
+}
+
+// Quantizes an endpoint to 7 bits per channel plus a shared p-bit, picking the p-bit with the lower error.
+auto quantizeBc7Endpoint(
+    const std::array<int32_t, 4u>& endpoint,
+    std::array<int32_t, 4u>& quantized,
+    uint32_t& pBit
+) -> void {
+    int32_t bestError { INT32_MAX };
+
+    for (int32_t p { 0 }; p < 2; p++) {
+        std::array<int32_t, 4u> candidate;
+        int32_t error { 0 };
+
+        for (uint32_t c { 0u }; c < 4u; c++) {
+            candidate.at(c) = std::clamp((endpoint.at(c) - p + 1) / 2, 0, 127);
+            const int32_t difference { endpoint.at(c) - ((candidate.at(c) << 1) | p) };
+            error += difference * difference;
+        }
+
+        // Fully transparent or opaque alpha has to survive, which one of the two p-bits always allows.
+        const bool isAlphaExtreme { endpoint.at(3u) == 0 || endpoint.at(3u) == 0xFF };
+        const bool isAlphaExact { ((candidate.at(3u) << 1) | p) == endpoint.at(3u) };
+
+        if (isAlphaExtreme && !isAlphaExact) {
+            continue;
+        }
+
+        if (error < bestError) {
+            bestError = error;
+            quantized = candidate;
+            pBit = static_cast<uint32_t>(p);
+        }
+    }
+}
+
+} // namespace
+
+auto BlockCompression::selectFormat(const bool hasTransparency, const TextureQuality quality) -> TextureFormat {
+    switch (quality) {
+    case TextureQuality::Lossless:
+        return TextureFormat::Rgba8;
+    case TextureQuality::Fast:
+        return hasTransparency ? TextureFormat::Bc3 : TextureFormat::Bc1;
+    case TextureQuality::High:
+        return TextureFormat::Bc7;
+    }
+
+    return TextureFormat::Rgba8;
+}
+
+auto BlockCompression::encode(
+    const TextureFormat format,
+    const void* pixels,
+    const uint32_t width,
+    const uint32_t height,
+    const uint32_t threadCount
+) -> std::vector<std::byte> {
+    const uint64_t size { TextureUtils::getMipLevelSize(format, width, height, 0u) };
+    std::vector<std::byte> blocks(size);
+
+    if (!TextureUtils::isBlockCompressed(format)) {
+        std::memcpy(blocks.data(), pixels, size);
+        return blocks;
+    }
+
+    const uint8_t* source { reinterpret_cast<const uint8_t*>(pixels) };
+    const uint32_t blockSize { TextureUtils::getBlockSize(format) };
+    const uint32_t blockCountX { (width + 3u) / 4u };
+    const uint32_t blockCountY { (height + 3u) / 4u };
+
+    const auto encodeRows {
+        [&](const uint32_t firstRow, const uint32_t lastRow) -> void {
+            std::array<uint8_t, global_texelCount * 4u> texels;
+
+            for (uint32_t blockY { firstRow }; blockY < lastRow; blockY++) {
+                for (uint32_t blockX { 0u }; blockX < blockCountX; blockX++) {
+                    // Partial blocks at the right and bottom edges repeat the last column/row.
+                    for (uint32_t y { 0u }; y < 4u; y++) {
+                        const uint32_t sourceY { std::min(blockY * 4u + y, height - 1u) };
+                        for (uint32_t x { 0u }; x < 4u; x++) {
+                            const uint32_t sourceX { std::min(blockX * 4u + x, width - 1u) };
+                            std::memcpy(texels.data() + (y * 4u + x) * 4u, source + (sourceY * width + sourceX) * 4u, 4u);
+                        }
+                    }
+
+                    uint8_t* block {
+                        reinterpret_cast<uint8_t*>(blocks.data()) +
+                        (static_cast<uint64_t>(blockY) * blockCountX + blockX) * blockSize
+                    };
+
+                    switch (format) {
+                    case TextureFormat::Bc1:
+                        encodeBc1Block(texels.data(), block);
+                        break;
+                    case TextureFormat::Bc3:
+                        encodeBc3Block(texels.data(), block);
+                        break;
+                    case TextureFormat::Bc7:
+                        encodeBc7Block(texels.data(), block);
+                        break;
+                    default:
+                        break;
+                    }
+                }
+            }
+        }
+    };
+
+    const uint32_t hardwareThreadCount { std::max(std::thread::hardware_concurrency(), 1u) };
+    const uint32_t workerCount { std::min(threadCount != 0u ? threadCount : hardwareThreadCount, blockCountY) };
+    const uint32_t rowsPerWorker { (blockCountY + workerCount - 1u) / workerCount };
+
+    std::vector<std::thread> workers;
+    for (uint32_t i { 1u }; i < workerCount; i++) {
+        const uint32_t firstRow { i * rowsPerWorker };
+        const uint32_t lastRow { std::min(firstRow + rowsPerWorker, blockCountY) };
+        if (firstRow < lastRow) {
+            workers.emplace_back(encodeRows, firstRow, lastRow);
+        }
+    }
+
+    // The calling thread takes the first share.
+    encodeRows(0u, std::min(rowsPerWorker, blockCountY));
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    return blocks;
+}
+
+auto BlockCompression::encodeBc1Block(const uint8_t* texels, uint8_t* block) -> void {
+    writeColorBlock(texels, block);
+}
+
+auto BlockCompression::encodeBc3Block(const uint8_t* texels, uint8_t* block) -> void {
+    writeAlphaBlock(texels, block);
+    writeColorBlock(texels, block + 8u);
+}
+
+auto BlockCompression::encodeBc7Block(const uint8_t* texels, uint8_t* block) -> void {
+    // Interpolation weights for 4 bit indices, as defined by the format.
+    constexpr std::array<int32_t, 16u> weights { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    std::array<int32_t, 4u> endpoint0;
+    std::array<int32_t, 4u> endpoint1;
+    fitEndpoints(texels, 4u, endpoint0, endpoint1);
+
+    std::array<int32_t, 4u> quantized0;
+    std::array<int32_t, 4u> quantized1;
+    uint32_t pBit0 { 0u };
+    uint32_t pBit1 { 0u };
+    quantizeBc7Endpoint(endpoint0, quantized0, pBit0);
+    quantizeBc7Endpoint(endpoint1, quantized1, pBit1);
+
+    std::array<std::array<int32_t, 4u>, 16u> palette;
+    for (uint32_t c { 0u }; c < 4u; c++) {
+        const int32_t decoded0 { (quantized0.at(c) << 1) | static_cast<int32_t>(pBit0) };
+        const int32_t decoded1 { (quantized1.at(c) << 1) | static_cast<int32_t>(pBit1) };
+
+        for (uint32_t p { 0u }; p < 16u; p++) {
+            palette.at(p).at(c) = ((64 - weights.at(p)) * decoded0 + weights.at(p) * decoded1 + 32) >> 6;
+        }
+    }
+
+    std::array<uint32_t, global_texelCount> indices;
+    for (uint32_t i { 0u }; i < global_texelCount; i++) {
+        int32_t bestError { INT32_MAX };
+
+        for (uint32_t p { 0u }; p < 16u; p++) {
+            int32_t error { 0 };
+            for (uint32_t c { 0u }; c < 4u; c++) {
+                const int32_t difference { texels[i * 4u + c] - palette.at(p).at(c) };
+                error += difference * difference;
+            }
+
+            if (error < bestError) {
+                bestError = error;
+                indices.at(i) = p;
+            }
+        }
+    }
+
+    // The anchor index is stored without its top bit, swap the endpoints if it is set.
+    if ((indices.at(0u) & 8u) != 0u) {
+        std::swap(quantized0, quantized1);
+        std::swap(pBit0, pBit1);
+        for (uint32_t& index : indices) {
+            index = 15u - index;
+        }
+    }
+
+    std::array<uint64_t, 2u> bits { 0u, 0u };
+    uint32_t position { 0u };
+
+    writeBits(bits, position, 1u << 6u, 7u); // Mode 6.
+    for (uint32_t c { 0u }; c < 4u; c++) {
+        writeBits(bits, position, static_cast<uint64_t>(quantized0.at(c)), 7u);
+        writeBits(bits, position, static_cast<uint64_t>(quantized1.at(c)), 7u);
+    }
+    writeBits(bits, position, pBit0, 1u);
+    writeBits(bits, position, pBit1, 1u);
+    writeBits(bits, position, indices.at(0u), 3u);
+    for (uint32_t i { 1u }; i < global_texelCount; i++) {
+        writeBits(bits, position, indices.at(i), 4u);
+    }
+
+    std::memcpy(block, bits.data(), 16u); // NOTE: Assumes a little endian host.
+}
+
+} // namespace resources
+} // namespace beige
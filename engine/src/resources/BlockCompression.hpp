@@ -0,0 +1,65 @@
+#pragma once
+
+#include "TextureFormat.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace beige {
+namespace resources {
+
+class BlockCompression final {
+public:
+    BlockCompression() = delete;
+    ~BlockCompression() = delete;
+
+    /**
+     * Picks the format a texture should be cooked to.
+     * @param hasTransparency Indicates if any texel of the texture has an alpha below 255.
+     * @param quality The quality preset requested for the texture.
+     * @returns The format to encode the texture with.
+     */
+    static auto selectFormat(const bool hasTransparency, const TextureQuality quality) -> TextureFormat;
+
+    /**
+     * Encodes a single RGBA8 image into the given format, rows of blocks are spread over a number of threads.
+     * @param format The format to encode to, Rgba8 copies the pixels as they are.
+     * @param pixels The tightly packed RGBA8 pixels.
+     * @param width The width of the image.
+     * @param height The height of the image.
+     * @param threadCount The number of threads to use, 0 uses one per hardware thread.
+     * @returns The encoded blocks, row by row.
+     */
+    static auto encode(
+        const TextureFormat format,
+        const void* pixels,
+        const uint32_t width,
+        const uint32_t height,
+        const uint32_t threadCount
+    ) -> std::vector<std::byte>;
+
+    /**
+     * Encodes 4x4 RGBA8 texels into an opaque BC1 block with a range fit, alpha is ignored.
+     * @param texels The 16 texels of the block, row by row.
+     * @param block The 8 byte destination block.
+     */
+    static auto encodeBc1Block(const uint8_t* texels, uint8_t* block) -> void;
+
+    /**
+     * Encodes 4x4 RGBA8 texels into a BC3 block, an 8 bit alpha block followed by a BC1 color block.
+     * @param texels The 16 texels of the block, row by row.
+     * @param block The 16 byte destination block.
+     */
+    static auto encodeBc3Block(const uint8_t* texels, uint8_t* block) -> void;
+
+    /**
+     * Encodes 4x4 RGBA8 texels into a BC7 block using mode 6 (single subset, RGBA endpoints, 4 bit indices).
+     * @param texels The 16 texels of the block, row by row.
+     * @param block The 16 byte destination block.
+     */
+    static auto encodeBc7Block(const uint8_t* texels, uint8_t* block) -> void;
+};
+
+} // namespace resources
+} // namespace beige
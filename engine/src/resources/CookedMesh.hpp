@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace beige {
+namespace resources {
+
+// Layout of a cooked mesh (.bmesh) file:
+// CookedMeshHeader | CookedMeshLod[lodCount] | padding | CookedMeshVertex[vertexCount] | padding |
+// indices (16 or 32 bit)[indexCount].
+// Every level of detail indexes the same vertices, the finest level comes first. Triangles are ordered for the
+// post-transform vertex cache and vertices by first use, so loading is a single linear pass. Texture coordinates
+// keep the bottom left origin of OBJ, which the engine expects.
+
+inline constexpr uint32_t global_cookedMeshMagic { 0x48534D42u }; // "BMSH"
+inline constexpr uint32_t global_cookedMeshVersion { 2u };
+inline constexpr uint64_t global_cookedMeshDataAlignment { 16u };
+inline constexpr uint32_t global_cookedMeshMaxLodCount { 8u };
+
+struct CookedMeshHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertexCount;
+    uint32_t indexCount; // Of every level of detail together.
+    uint32_t indexSize;  // 2 if every index fits in 16 bits, otherwise 4.
+    uint32_t lodCount;
+    std::array<float, 3u> positionMin; // Bounds the quantized positions are relative to.
+    std::array<float, 3u> positionMax;
+    std::array<float, 2u> texCoordMin; // Bounds the quantized texture coordinates are relative to.
+    std::array<float, 2u> texCoordMax;
+    uint64_t vertexOffset; // From the start of the file.
+    uint64_t indexOffset;  // From the start of the file.
+};
+
+struct CookedMeshLod {
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    float error; // Largest distance from the finest level, in model units.
+};
+
+struct CookedMeshVertex {
+    std::array<uint16_t, 3u> position; // Unorm within the position bounds.
+    std::array<int8_t, 2u> normal;     // Octahedral encoded, snorm.
+    std::array<uint16_t, 2u> texCoord; // Unorm within the texture coordinate bounds.
+};
+
+static_assert(sizeof(CookedMeshHeader) == 80u, "Cooked mesh header layout changed, bump the version!");
+static_assert(sizeof(CookedMeshLod) == 12u, "Cooked mesh LOD layout changed, bump the version!");
+static_assert(sizeof(CookedMeshVertex) == 12u, "Cooked mesh vertex layout changed, bump the version!");
+
+} // namespace resources
+} // namespace beige
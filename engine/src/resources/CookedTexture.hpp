@@ -0,0 +1,41 @@
+#pragma once
+
+#include "TextureFormat.hpp"
+
+#include <cstdint>
+
+namespace beige {
+namespace resources {
+
+// Layout of a cooked texture (.btex) file:
+// CookedTextureHeader | CookedTextureMip[mipLevelCount] | padding | mip data (base level first, tightly packed).
+// Mip data is already flipped for Vulkan's texture coordinates, so it can be copied to staging memory as is.
+// Block compressed levels are stored as rows of 4x4 blocks, partial blocks at the edges are padded by clamping.
+
+inline constexpr uint32_t global_cookedTextureMagic { 0x58455442u }; // "BTEX"
+inline constexpr uint32_t global_cookedTextureVersion { 2u };
+inline constexpr uint64_t global_cookedTextureDataAlignment { 16u };
+
+struct CookedTextureHeader {
+    uint32_t magic;
+    uint32_t version;
+    TextureFormat format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channelCount;
+    uint32_t mipLevelCount;
+    uint32_t hasTransparency;
+    uint64_t dataOffset; // From the start of the file.
+    uint64_t dataSize;   // All mip levels.
+};
+
+struct CookedTextureMip {
+    uint64_t offset; // From the start of the file.
+    uint64_t size;
+};
+
+static_assert(sizeof(CookedTextureHeader) == 48u, "Cooked texture header layout changed, bump the version!");
+static_assert(sizeof(CookedTextureMip) == 16u, "Cooked texture mip layout changed, bump the version!");
+
+} // namespace resources
+} // namespace beige
@@ -0,0 +1,144 @@
+#include "FreeList.hpp"
+
+#include <algorithm>
+
+namespace beige {
+namespace resources {
+
+FreeList::FreeList(const uint64_t totalSize) :
+m_totalSize { totalSize },
+m_freeSize { 0u },
+m_freeBlocks { } {
+    reset();
+}
+
+FreeList::~FreeList() {
+
+}
+
+auto FreeList::allocate(const uint64_t size) -> std::optional<uint64_t> {
+    if (size == 0u) {
+        return std::nullopt;
+    }
+
+    std::vector<Block>::iterator bestBlock { m_freeBlocks.end() };
+
+    for (std::vector<Block>::iterator block { m_freeBlocks.begin() }; block != m_freeBlocks.end(); ++block) {
+        if (block->size >= size && (bestBlock == m_freeBlocks.end() || block->size < bestBlock->size)) {
+            bestBlock = block;
+
+            if (block->size == size) {
+                break;
+            }
+        }
+    }
+
+    if (bestBlock == m_freeBlocks.end()) {
+        return std::nullopt;
+    }
+
+    const uint64_t offset { bestBlock->offset };
+
+    if (bestBlock->size == size) {
+        m_freeBlocks.erase(bestBlock);
+    } else {
+        bestBlock->offset += size;
+        bestBlock->size -= size;
+    }
+
+    m_freeSize -= size;
+
+    return offset;
+}
+
+auto FreeList::free(const uint64_t offset, const uint64_t size) -> bool {
+    if (size == 0u || offset > m_totalSize || size > m_totalSize - offset) {
+        return false;
+    }
+
+    // First block after the range.
+    const std::vector<Block>::iterator next {
+        std::upper_bound(
+            m_freeBlocks.begin(),
+            m_freeBlocks.end(),
+            offset,
+            [](const uint64_t value, const Block& block) -> bool {
+                return value < block.offset;
+            }
+        )
+    };
+
+    const bool hasPrevious { next != m_freeBlocks.begin() };
+    const bool hasNext { next != m_freeBlocks.end() };
+
+    if (hasPrevious) {
+        const Block& previous { *(next - 1) };
+        if (previous.offset + previous.size > offset) {
+            return false;
+        }
+    }
+
+    if (hasNext && offset + size > next->offset) {
+        return false;
+    }
+
+    const bool mergesPrevious { hasPrevious && (next - 1)->offset + (next - 1)->size == offset };
+    const bool mergesNext { hasNext && offset + size == next->offset };
+
+    if (mergesPrevious && mergesNext) {
+        (next - 1)->size += size + next->size;
+        m_freeBlocks.erase(next);
+    } else if (mergesPrevious) {
+        (next - 1)->size += size;
+    } else if (mergesNext) {
+        next->offset = offset;
+        next->size += size;
+    } else {
+        const Block block {
+            offset, // offset
+            size    // size
+        };
+        m_freeBlocks.insert(next, block);
+    }
+
+    m_freeSize += size;
+
+    return true;
+}
+
+auto FreeList::reset() -> void {
+    m_freeBlocks.clear();
+
+    if (m_totalSize > 0u) {
+        const Block block {
+            0u,         // offset
+            m_totalSize // size
+        };
+        m_freeBlocks.push_back(block);
+    }
+
+    m_freeSize = m_totalSize;
+}
+
+auto FreeList::getTotalSize() const -> uint64_t {
+    return m_totalSize;
+}
+
+auto FreeList::getFreeSize() const -> uint64_t {
+    return m_freeSize;
+}
+
+auto FreeList::getLargestFreeBlockSize() const -> uint64_t {
+    uint64_t largestSize { 0u };
+
+    for (const Block& block : m_freeBlocks) {
+        if (block.size > largestSize) {
+            largestSize = block.size;
+        }
+    }
+
+    return largestSize;
+}
+
+} // namespace resources
+} // namespace beige
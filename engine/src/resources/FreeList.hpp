@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace beige {
+namespace resources {
+
+/**
+ * Hands out ranges of a fixed size space, such as the elements of a shared buffer. Free blocks are kept sorted by
+ * offset and merged with their neighbours when a range is freed, so the space only fragments while ranges between
+ * free blocks are still in use.
+ */
+class FreeList final {
+public:
+    FreeList(const uint64_t totalSize);
+    ~FreeList();
+
+    /**
+     * Takes the range from the smallest free block that fits, which keeps the large blocks for large requests.
+     * @returns The offset of the range, or nothing if no free block is large enough.
+     */
+    auto allocate(const uint64_t size) -> std::optional<uint64_t>;
+
+    /**
+     * Returns a range handed out by allocate().
+     * @returns False if the range is outside the space or overlaps a free block.
+     */
+    auto free(const uint64_t offset, const uint64_t size) -> bool;
+
+    /**
+     * Frees everything, leaving one block spanning the whole space.
+     */
+    auto reset() -> void;
+
+    auto getTotalSize() const -> uint64_t;
+    auto getFreeSize() const -> uint64_t;
+    auto getLargestFreeBlockSize() const -> uint64_t;
+
+private:
+    struct Block {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    uint64_t m_totalSize;
+    uint64_t m_freeSize;
+    std::vector<Block> m_freeBlocks; // Sorted by offset, neighbouring blocks are always merged.
+};
+
+} // namespace resources
+} // namespace beige
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+namespace beige {
+namespace resources {
+
+// Refers to a slot of the geometry pool, generations work the same way as for texture handles.
+struct GeometryHandle {
+    uint32_t index;
+    uint32_t generation;
+};
+
+inline constexpr GeometryHandle global_invalidGeometryHandle { static_cast<uint32_t>(-1), 0u };
+
+inline constexpr auto operator==(const GeometryHandle& lhs, const GeometryHandle& rhs) -> bool {
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+inline constexpr auto operator!=(const GeometryHandle& lhs, const GeometryHandle& rhs) -> bool {
+    return !(lhs == rhs);
+}
+
+} // namespace resources
+} // namespace beige
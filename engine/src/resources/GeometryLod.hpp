@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace beige {
+namespace resources {
+
+inline constexpr uint32_t global_maxGeometryLodCount { 8u };
+
+// A level of detail of a geometry, its triangles are a range of the indices of the geometry.
+struct GeometryLod {
+    uint32_t firstIndex; // Relative to the first index of the geometry.
+    uint32_t indexCount;
+    float error;         // Largest distance from the finest level, in model units.
+};
+
+} // namespace resources
+} // namespace beige
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "TextureFormat.hpp"
+
 #include <vector>
 #include <string>
 
@@ -22,26 +24,37 @@ public:
         const void* pixels,
         const bool hasTransparency
     ) :
+    m_name { name },
     m_width{ width },
     m_height{ height },
     m_channelCount{ channelCount },
     m_hasTransparency { hasTransparency },
+    m_mipLevels { 1u },
+    m_format { TextureFormat::Rgba8 },
     m_generation { global_invalidTextureGeneration },
     m_id { global_invalidObjectId } {
 
     };
     virtual ~ITexture() = default;
 
+    virtual auto getName() const -> const std::string& final { return m_name; }
+    virtual auto getWidth() const -> const int32_t final { return m_width; }
+    virtual auto getHeight() const -> const int32_t final { return m_height; }
     virtual auto getGeneration() const -> const TextureGeneration final { return m_generation; }
     virtual auto setGeneration(const TextureGeneration textureGeneration) -> void final { m_generation = textureGeneration; }
     virtual auto getId() const -> const uint32_t final { return m_id; }
     virtual auto setId(const uint32_t id) -> void final { m_id = id; }
+    virtual auto getMipLevels() const -> const uint32_t final { return m_mipLevels; }
+    virtual auto getFormat() const -> const TextureFormat final { return m_format; }
 
 protected:
+    std::string m_name;
     int32_t m_width;
     int32_t m_height;
     int32_t m_channelCount;
     bool m_hasTransparency;
+    uint32_t m_mipLevels;
+    TextureFormat m_format;
     TextureGeneration m_generation;
     ObjectId m_id;
 };
@@ -0,0 +1,208 @@
+#include "Lz4.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace beige {
+namespace resources {
+
+namespace {
+
+constexpr uint32_t global_minimumMatch { 4u };
+constexpr uint64_t global_maximumOffset { 65535u };
+constexpr uint32_t global_hashBits { 16u };
+
+// The format requires the last 5 bytes to be literals and the last match to start 12 bytes before the end.
+constexpr uint64_t global_lastLiterals { 5u };
+constexpr uint64_t global_matchSafeDistance { 12u };
+
+auto read32(const uint8_t* source) -> uint32_t {
+    uint32_t value;
+    std::memcpy(&value, source, sizeof(value));
+    return value;
+}
+
+auto hash(const uint32_t sequence) -> uint32_t {
+    return (sequence * 2654435761u) >> (32u - global_hashBits);
+}
+
+auto writeLength(std::vector<std::byte>& output, uint64_t length) -> void {
+    while (length >= 255u) {
+        output.push_back(std::byte(255u));
+        length -= 255u;
+    }
+    output.push_back(std::byte(static_cast<uint8_t>(length)));
+}
+
+auto writeSequence(
+    std::vector<std::byte>& output,
+    const uint8_t* literals,
+    const uint64_t literalLength,
+    const uint64_t offset,
+    const uint64_t matchLength
+) -> void {
+    const uint64_t matchCode { matchLength >= global_minimumMatch ? matchLength - global_minimumMatch : 0u };
+    const uint8_t token {
+        static_cast<uint8_t>((std::min<uint64_t>(literalLength, 15u) << 4u) | std::min<uint64_t>(matchCode, 15u))
+    };
+
+    output.push_back(std::byte(token));
+
+    if (literalLength >= 15u) {
+        writeLength(output, literalLength - 15u);
+    }
+
+    const std::byte* literalBytes { reinterpret_cast<const std::byte*>(literals) };
+    output.insert(output.end(), literalBytes, literalBytes + literalLength);
+
+    // The last sequence carries literals only.
+    if (matchLength == 0u) {
+        return;
+    }
+
+    output.push_back(std::byte(static_cast<uint8_t>(offset & 0xFFu)));
+    output.push_back(std::byte(static_cast<uint8_t>(offset >> 8u)));
+
+    if (matchCode >= 15u) {
+        writeLength(output, matchCode - 15u);
+    }
+}
+
+auto readLength(const uint8_t*& source, const uint8_t* sourceEnd, uint64_t& length) -> bool {
+    uint8_t value { 255u };
+
+    while (value == 255u) {
+        if (source >= sourceEnd) {
+            return false;
+        }
+
+        value = *source++;
+        length += value;
+    }
+
+    return true;
+}
+
+} // namespace
+
+auto Lz4::compress(const void* source, const uint64_t size) -> std::vector<std::byte> {
+    const uint8_t* input { static_cast<const uint8_t*>(source) };
+
+    std::vector<std::byte> output;
+    output.reserve(size + size / 255u + 16u);
+
+    std::vector<uint64_t> table(static_cast<std::size_t>(1u) << global_hashBits, 0u);
+
+    uint64_t anchor { 0u };
+    uint64_t position { 0u };
+
+    if (size > global_matchSafeDistance) {
+        const uint64_t matchLimit { size - global_lastLiterals };
+        const uint64_t searchLimit { size - global_matchSafeDistance };
+
+        // Position 0 can't be told apart from an empty slot, so it is never a candidate.
+        position = 1u;
+
+        while (position < searchLimit) {
+            const uint32_t sequence { read32(input + position) };
+            const uint32_t slot { hash(sequence) };
+            const uint64_t candidate { table.at(slot) };
+            table.at(slot) = position;
+
+            if (
+                candidate == 0u ||
+                position - candidate > global_maximumOffset ||
+                read32(input + candidate) != sequence
+            ) {
+                position++;
+                continue;
+            }
+
+            uint64_t matchLength { global_minimumMatch };
+            while (position + matchLength < matchLimit && input[candidate + matchLength] == input[position + matchLength]) {
+                matchLength++;
+            }
+
+            writeSequence(output, input + anchor, position - anchor, position - candidate, matchLength);
+
+            position += matchLength;
+            anchor = position;
+        }
+    }
+
+    writeSequence(output, input + anchor, size - anchor, 0u, 0u);
+
+    return output;
+}
+
+auto Lz4::decompress(
+    const void* source,
+    const uint64_t sourceSize,
+    void* destination,
+    const uint64_t destinationSize
+) -> bool {
+    const uint8_t* input { static_cast<const uint8_t*>(source) };
+    const uint8_t* const inputEnd { input + sourceSize };
+    uint8_t* const outputStart { static_cast<uint8_t*>(destination) };
+    uint8_t* output { outputStart };
+    uint8_t* const outputEnd { output + destinationSize };
+
+    while (input < inputEnd) {
+        const uint8_t token { *input++ };
+
+        uint64_t literalLength { static_cast<uint64_t>(token >> 4u) };
+        if (literalLength == 15u && !readLength(input, inputEnd, literalLength)) {
+            return false;
+        }
+
+        if (literalLength > static_cast<uint64_t>(inputEnd - input) || literalLength > static_cast<uint64_t>(outputEnd - output)) {
+            return false;
+        }
+
+        std::memcpy(output, input, literalLength);
+        input += literalLength;
+        output += literalLength;
+
+        // The last sequence ends after its literals.
+        if (input == inputEnd) {
+            break;
+        }
+
+        if (inputEnd - input < 2) {
+            return false;
+        }
+
+        const uint64_t offset { static_cast<uint64_t>(input[0]) | (static_cast<uint64_t>(input[1]) << 8u) };
+        input += 2;
+
+        if (offset == 0u || offset > static_cast<uint64_t>(output - outputStart)) {
+            return false;
+        }
+
+        uint64_t matchLength { static_cast<uint64_t>(token & 0x0Fu) };
+        if (matchLength == 15u && !readLength(input, inputEnd, matchLength)) {
+            return false;
+        }
+        matchLength += global_minimumMatch;
+
+        if (matchLength > static_cast<uint64_t>(outputEnd - output)) {
+            return false;
+        }
+
+        // Matches may overlap their own output (e.g. runs), so copy byte by byte unless they can't.
+        const uint8_t* match { output - offset };
+        if (offset >= matchLength) {
+            std::memcpy(output, match, matchLength);
+            output += matchLength;
+        } else {
+            for (uint64_t i { 0u }; i < matchLength; i++) {
+                *output++ = match[i];
+            }
+        }
+    }
+
+    return output == outputEnd;
+}
+
+} // namespace resources
+} // namespace beige
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace beige {
+namespace resources {
+
+/**
+ * Compression in the LZ4 block format: no frame, no checksums, the sizes are stored by whoever stores the block.
+ * Decompression runs at memory speed, which makes it cheap enough to do while streaming assets.
+ */
+class Lz4 final {
+public:
+    Lz4() = delete;
+    ~Lz4() = delete;
+
+    /**
+     * Compresses a buffer with a greedy single pass matcher.
+     * @param source The data to compress.
+     * @param size The size of the data.
+     * @returns The compressed block, possibly larger than the source for incompressible data.
+     */
+    static auto compress(const void* source, const uint64_t size) -> std::vector<std::byte>;
+
+    /**
+     * Decompresses a block, every read and write is bounds checked so corrupt data fails instead of overrunning.
+     * @param source The compressed block.
+     * @param sourceSize The size of the block.
+     * @param destination The buffer to decompress into.
+     * @param destinationSize The exact decompressed size.
+     * @returns True if the block decompressed to exactly destinationSize bytes.
+     */
+    static auto decompress(
+        const void* source,
+        const uint64_t sourceSize,
+        void* destination,
+        const uint64_t destinationSize
+    ) -> bool;
+};
+
+} // namespace resources
+} // namespace beige
@@ -0,0 +1,670 @@
+#include "MeshUtils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace beige {
+namespace resources {
+
+namespace {
+
+constexpr float global_cacheDecayPower { 1.5f };
+constexpr float global_lastTriangleScore { 0.75f };
+constexpr float global_valenceBoostScale { 2.0f };
+constexpr float global_valenceBoostPower { 0.5f };
+constexpr uint32_t global_noTriangle { std::numeric_limits<uint32_t>::max() };
+
+constexpr uint32_t global_valenceTableSize { 32u };
+
+// Favours vertices near the front of the cache and vertices with few triangles left, which finishes them off.
+auto computeVertexScore(const int32_t cachePosition, const uint32_t remainingTriangleCount) -> float {
+    if (remainingTriangleCount == 0u) {
+        return -1.0f;
+    }
+
+    float score { 0.0f };
+
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // The vertices of the last triangle get a fixed score so it is not simply repeated.
+            score = global_lastTriangleScore;
+        } else {
+            const float scaler { 1.0f / static_cast<float>(MeshUtils::m_optimizerCacheSize - 3u) };
+            score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler, global_cacheDecayPower);
+        }
+    }
+
+    score += global_valenceBoostScale * std::pow(static_cast<float>(remainingTriangleCount), -global_valenceBoostPower);
+
+    return score;
+}
+
+// Scores are looked up for the common cases, they are recomputed for every vertex in the cache per triangle.
+auto getVertexScore(const int32_t cachePosition, const uint32_t remainingTriangleCount) -> float {
+    static const std::vector<float> scores {
+        []() -> std::vector<float> {
+            std::vector<float> table((MeshUtils::m_optimizerCacheSize + 1u) * global_valenceTableSize);
+
+            for (uint32_t position { 0u }; position <= MeshUtils::m_optimizerCacheSize; position++) {
+                for (uint32_t valence { 0u }; valence < global_valenceTableSize; valence++) {
+                    table.at(position * global_valenceTableSize + valence) = computeVertexScore(static_cast<int32_t>(position) - 1, valence);
+                }
+            }
+
+            return table;
+        }()
+    };
+
+    if (remainingTriangleCount >= global_valenceTableSize) {
+        return computeVertexScore(cachePosition, remainingTriangleCount);
+    }
+
+    return scores[static_cast<uint32_t>(cachePosition + 1) * global_valenceTableSize + remainingTriangleCount];
+}
+
+auto getSign(const float value) -> float {
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+// Sum of squared distances to a set of planes, as a symmetric 4x4 matrix.
+struct Quadric {
+    std::array<double, 10u> matrix; // Upper triangle, row by row.
+    double weight;                  // Summed area of the planes, the distance is averaged by it.
+};
+
+struct Collapse {
+    uint32_t from;
+    uint32_t to;
+    float error; // Squared distance.
+};
+
+// Rejects collapses which would turn a triangle by more than about 75 degrees.
+constexpr double global_minimumNormalAlignment { 0.25 };
+
+auto getCross(
+    const std::array<float, 3u>& a,
+    const std::array<float, 3u>& b,
+    const std::array<float, 3u>& c
+) -> std::array<double, 3u> {
+    const std::array<double, 3u> ab { b.at(0u) - a.at(0u), b.at(1u) - a.at(1u), b.at(2u) - a.at(2u) };
+    const std::array<double, 3u> ac { c.at(0u) - a.at(0u), c.at(1u) - a.at(1u), c.at(2u) - a.at(2u) };
+
+    const std::array<double, 3u> cross {
+        ab.at(1u) * ac.at(2u) - ab.at(2u) * ac.at(1u),
+        ab.at(2u) * ac.at(0u) - ab.at(0u) * ac.at(2u),
+        ab.at(0u) * ac.at(1u) - ab.at(1u) * ac.at(0u)
+    };
+
+    return cross;
+}
+
+auto getDot(const std::array<double, 3u>& a, const std::array<double, 3u>& b) -> double {
+    return a.at(0u) * b.at(0u) + a.at(1u) * b.at(1u) + a.at(2u) * b.at(2u);
+}
+
+auto getPlaneQuadric(
+    const std::array<float, 3u>& a,
+    const std::array<float, 3u>& b,
+    const std::array<float, 3u>& c
+) -> Quadric {
+    const std::array<double, 3u> cross { getCross(a, b, c) };
+    const double length { std::sqrt(getDot(cross, cross)) };
+
+    if (length == 0.0) {
+        return { { }, 0.0 };
+    }
+
+    const double x { cross.at(0u) / length };
+    const double y { cross.at(1u) / length };
+    const double z { cross.at(2u) / length };
+    const double d { -(x * a.at(0u) + y * a.at(1u) + z * a.at(2u)) };
+
+    // The cross product is twice the area long.
+    const double weight { length * 0.5 };
+
+    const Quadric quadric {
+        {
+            weight * x * x, weight * x * y, weight * x * z, weight * x * d,
+            weight * y * y, weight * y * z, weight * y * d,
+            weight * z * z, weight * z * d,
+            weight * d * d
+        },
+        weight
+    };
+
+    return quadric;
+}
+
+auto addQuadric(Quadric& quadric, const Quadric& other) -> void {
+    for (std::size_t i { 0u }; i < quadric.matrix.size(); i++) {
+        quadric.matrix.at(i) += other.matrix.at(i);
+    }
+
+    quadric.weight += other.weight;
+}
+
+// Averaged squared distance of the point to the planes of the quadric.
+auto getQuadricError(const Quadric& quadric, const std::array<float, 3u>& point) -> float {
+    if (quadric.weight == 0.0) {
+        return 0.0f;
+    }
+
+    const std::array<double, 10u>& m { quadric.matrix };
+    const double x { point.at(0u) };
+    const double y { point.at(1u) };
+    const double z { point.at(2u) };
+
+    const double error {
+        m.at(0u) * x * x + 2.0 * m.at(1u) * x * y + 2.0 * m.at(2u) * x * z + 2.0 * m.at(3u) * x +
+        m.at(4u) * y * y + 2.0 * m.at(5u) * y * z + 2.0 * m.at(6u) * y +
+        m.at(7u) * z * z + 2.0 * m.at(8u) * z +
+        m.at(9u)
+    };
+
+    return static_cast<float>(std::fabs(error) / quadric.weight);
+}
+
+} // namespace
+
+auto MeshUtils::optimizeVertexCache(std::vector<uint32_t>& indices, const uint32_t vertexCount) -> void {
+    const uint32_t triangleCount { static_cast<uint32_t>(indices.size() / 3u) };
+
+    if (triangleCount == 0u) {
+        return;
+    }
+
+    for (const uint32_t index : indices) {
+        if (index >= vertexCount) {
+            return;
+        }
+    }
+
+    // Triangles using each vertex, emitted ones are swapped out of the live part of each list.
+    std::vector<uint32_t> adjacencyCounts(vertexCount, 0u);
+    std::vector<uint32_t> adjacencyOffsets(vertexCount, 0u);
+    std::vector<uint32_t> adjacency(triangleCount * 3u);
+
+    for (uint32_t i { 0u }; i < triangleCount * 3u; i++) {
+        adjacencyCounts.at(indices.at(i))++;
+    }
+
+    uint32_t offset { 0u };
+    for (uint32_t vertex { 0u }; vertex < vertexCount; vertex++) {
+        adjacencyOffsets.at(vertex) = offset;
+        offset += adjacencyCounts.at(vertex);
+        adjacencyCounts.at(vertex) = 0u;
+    }
+
+    for (uint32_t i { 0u }; i < triangleCount * 3u; i++) {
+        const uint32_t vertex { indices.at(i) };
+        adjacency.at(adjacencyOffsets.at(vertex) + adjacencyCounts.at(vertex)) = i / 3u;
+        adjacencyCounts.at(vertex)++;
+    }
+
+    std::vector<int32_t> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount, 0.0f);
+
+    for (uint32_t vertex { 0u }; vertex < vertexCount; vertex++) {
+        vertexScores.at(vertex) = getVertexScore(-1, adjacencyCounts.at(vertex));
+    }
+
+    std::vector<float> triangleScores(triangleCount, 0.0f);
+    std::vector<bool> isEmitted(triangleCount, false);
+    uint32_t bestTriangle { 0u };
+
+    for (uint32_t triangle { 0u }; triangle < triangleCount; triangle++) {
+        triangleScores.at(triangle) =
+            vertexScores.at(indices.at(triangle * 3u)) +
+            vertexScores.at(indices.at(triangle * 3u + 1u)) +
+            vertexScores.at(indices.at(triangle * 3u + 2u));
+
+        if (triangleScores.at(triangle) > triangleScores.at(bestTriangle)) {
+            bestTriangle = triangle;
+        }
+    }
+
+    std::vector<uint32_t> optimizedIndices;
+    optimizedIndices.reserve(indices.size());
+
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(m_optimizerCacheSize + 3u);
+    nextCache.reserve(m_optimizerCacheSize + 3u);
+
+    uint32_t nextUnemittedTriangle { 0u };
+
+    for (uint32_t emittedCount { 0u }; emittedCount < triangleCount; emittedCount++) {
+        // Nothing in the cache has triangles left, continue with the next one in input order.
+        if (bestTriangle == global_noTriangle) {
+            while (isEmitted.at(nextUnemittedTriangle)) {
+                nextUnemittedTriangle++;
+            }
+            bestTriangle = nextUnemittedTriangle;
+        }
+
+        isEmitted.at(bestTriangle) = true;
+        nextCache.clear();
+
+        for (uint32_t corner { 0u }; corner < 3u; corner++) {
+            const uint32_t vertex { indices.at(bestTriangle * 3u + corner) };
+            optimizedIndices.push_back(vertex);
+
+            const uint32_t begin { adjacencyOffsets.at(vertex) };
+            const uint32_t end { begin + adjacencyCounts.at(vertex) };
+
+            for (uint32_t i { begin }; i < end; i++) {
+                if (adjacency.at(i) == bestTriangle) {
+                    std::swap(adjacency.at(i), adjacency.at(end - 1u));
+                    adjacencyCounts.at(vertex)--;
+                    break;
+                }
+            }
+
+            if (std::find(nextCache.begin(), nextCache.end(), vertex) == nextCache.end()) {
+                nextCache.push_back(vertex);
+            }
+        }
+
+        for (const uint32_t vertex : cache) {
+            if (std::find(nextCache.begin(), nextCache.end(), vertex) == nextCache.end()) {
+                nextCache.push_back(vertex);
+            }
+        }
+
+        // Vertices pushed past the end are evicted, they still need their scores lowered.
+        for (uint32_t i { 0u }; i < static_cast<uint32_t>(nextCache.size()); i++) {
+            const uint32_t vertex { nextCache.at(i) };
+            cachePositions.at(vertex) = i < m_optimizerCacheSize ? static_cast<int32_t>(i) : -1;
+            vertexScores.at(vertex) = getVertexScore(cachePositions.at(vertex), adjacencyCounts.at(vertex));
+        }
+
+        bestTriangle = global_noTriangle;
+        float bestScore { -std::numeric_limits<float>::max() };
+
+        for (const uint32_t vertex : nextCache) {
+            const uint32_t begin { adjacencyOffsets.at(vertex) };
+            const uint32_t end { begin + adjacencyCounts.at(vertex) };
+
+            for (uint32_t i { begin }; i < end; i++) {
+                const uint32_t triangle { adjacency.at(i) };
+
+                triangleScores.at(triangle) =
+                    vertexScores.at(indices.at(triangle * 3u)) +
+                    vertexScores.at(indices.at(triangle * 3u + 1u)) +
+                    vertexScores.at(indices.at(triangle * 3u + 2u));
+
+                if (triangleScores.at(triangle) > bestScore) {
+                    bestScore = triangleScores.at(triangle);
+                    bestTriangle = triangle;
+                }
+            }
+        }
+
+        if (nextCache.size() > m_optimizerCacheSize) {
+            nextCache.resize(m_optimizerCacheSize);
+        }
+
+        std::swap(cache, nextCache);
+    }
+
+    indices = std::move(optimizedIndices);
+}
+
+auto MeshUtils::optimizeVertexFetch(std::vector<uint32_t>& indices, const uint32_t vertexCount) -> std::vector<uint32_t> {
+    const uint32_t unmapped { std::numeric_limits<uint32_t>::max() };
+
+    std::vector<uint32_t> remap(vertexCount, unmapped);
+    std::vector<uint32_t> order;
+    order.reserve(vertexCount);
+
+    for (uint32_t& index : indices) {
+        if (remap.at(index) == unmapped) {
+            remap.at(index) = static_cast<uint32_t>(order.size());
+            order.push_back(index);
+        }
+
+        index = remap.at(index);
+    }
+
+    return order;
+}
+
+auto MeshUtils::getAverageCacheMissRatio(const std::vector<uint32_t>& indices, const uint32_t cacheSize) -> float {
+    const uint32_t triangleCount { static_cast<uint32_t>(indices.size() / 3u) };
+
+    if (triangleCount == 0u) {
+        return 0.0f;
+    }
+
+    const uint32_t maximumIndex { *std::max_element(indices.begin(), indices.end()) };
+
+    // Only misses push vertices into a FIFO cache, so a vertex is cached until cacheSize misses after its own.
+    std::vector<uint64_t> missTimes(static_cast<uint64_t>(maximumIndex) + 1u, 0u);
+    uint64_t missCount { 0u };
+
+    for (const uint32_t index : indices) {
+        const uint64_t time { missCount + cacheSize + 1u };
+
+        if (time - missTimes.at(index) > cacheSize) {
+            missTimes.at(index) = time;
+            missCount++;
+        }
+    }
+
+    return static_cast<float>(missCount) / static_cast<float>(triangleCount);
+}
+
+auto MeshUtils::simplify(
+    const std::vector<uint32_t>& indices,
+    const std::vector<std::array<float, 3u>>& positions,
+    const uint32_t targetIndexCount,
+    const float targetError
+) -> std::pair<std::vector<uint32_t>, float> {
+    const uint32_t vertexCount { static_cast<uint32_t>(positions.size()) };
+
+    for (const uint32_t index : indices) {
+        if (index >= vertexCount) {
+            return { indices, 0.0f };
+        }
+    }
+
+    // Vertices sharing a position get one id, seams show up as ids with several vertices.
+    std::vector<uint32_t> sortedVertices(vertexCount);
+    for (uint32_t vertex { 0u }; vertex < vertexCount; vertex++) {
+        sortedVertices.at(vertex) = vertex;
+    }
+
+    std::sort(
+        sortedVertices.begin(),
+        sortedVertices.end(),
+        [&positions](const uint32_t lhs, const uint32_t rhs) -> bool {
+            return positions.at(lhs) < positions.at(rhs);
+        }
+    );
+
+    std::vector<uint32_t> positionIds(vertexCount, 0u);
+    std::vector<uint32_t> positionVertexCounts;
+
+    for (uint32_t i { 0u }; i < vertexCount; i++) {
+        if (i == 0u || positions.at(sortedVertices.at(i)) != positions.at(sortedVertices.at(i - 1u))) {
+            positionVertexCounts.push_back(0u);
+        }
+
+        positionIds.at(sortedVertices.at(i)) = static_cast<uint32_t>(positionVertexCounts.size() - 1u);
+        positionVertexCounts.back()++;
+    }
+
+    // Edges used by one triangle lie on an open border, by more than two on a non-manifold junction.
+    std::vector<uint64_t> edges;
+    edges.reserve(indices.size());
+
+    for (std::size_t i { 0u }; i + 2u < indices.size(); i += 3u) {
+        for (std::size_t corner { 0u }; corner < 3u; corner++) {
+            const uint32_t a { positionIds.at(indices.at(i + corner)) };
+            const uint32_t b { positionIds.at(indices.at(i + (corner + 1u) % 3u)) };
+            edges.push_back((static_cast<uint64_t>(std::min(a, b)) << 32u) | std::max(a, b));
+        }
+    }
+
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<bool> isPositionLocked(positionVertexCounts.size(), false);
+
+    for (std::size_t begin { 0u }; begin < edges.size();) {
+        std::size_t end { begin + 1u };
+        while (end < edges.size() && edges.at(end) == edges.at(begin)) {
+            end++;
+        }
+
+        if (end - begin != 2u) {
+            isPositionLocked.at(static_cast<uint32_t>(edges.at(begin) >> 32u)) = true;
+            isPositionLocked.at(static_cast<uint32_t>(edges.at(begin))) = true;
+        }
+
+        begin = end;
+    }
+
+    std::vector<bool> isLocked(vertexCount, false);
+    for (uint32_t vertex { 0u }; vertex < vertexCount; vertex++) {
+        const uint32_t positionId { positionIds.at(vertex) };
+        isLocked.at(vertex) = isPositionLocked.at(positionId) || positionVertexCounts.at(positionId) > 1u;
+    }
+
+    std::vector<Quadric> quadrics(vertexCount, Quadric { { }, 0.0 });
+
+    for (std::size_t i { 0u }; i + 2u < indices.size(); i += 3u) {
+        const Quadric quadric {
+            getPlaneQuadric(
+                positions.at(indices.at(i)),
+                positions.at(indices.at(i + 1u)),
+                positions.at(indices.at(i + 2u))
+            )
+        };
+
+        for (std::size_t corner { 0u }; corner < 3u; corner++) {
+            addQuadric(quadrics.at(indices.at(i + corner)), quadric);
+        }
+    }
+
+    const float targetErrorSquared { targetError * targetError };
+    float resultErrorSquared { 0.0f };
+
+    std::vector<uint32_t> result { indices };
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1u);
+    std::vector<uint32_t> adjacency;
+    std::vector<Collapse> collapses;
+    std::vector<uint32_t> collapseTargets(vertexCount);
+    std::vector<bool> isTouched(vertexCount);
+
+    // Each pass collapses the cheapest edges whose neighbourhoods do not overlap, so the costs stay exact.
+    while (result.size() > targetIndexCount) {
+        const uint32_t triangleCount { static_cast<uint32_t>(result.size() / 3u) };
+
+        std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0u);
+        for (const uint32_t index : result) {
+            adjacencyOffsets.at(index + 1u)++;
+        }
+        for (uint32_t vertex { 0u }; vertex < vertexCount; vertex++) {
+            adjacencyOffsets.at(vertex + 1u) += adjacencyOffsets.at(vertex);
+        }
+
+        adjacency.resize(result.size());
+        std::vector<uint32_t> adjacencyCounts(vertexCount, 0u);
+        for (uint32_t i { 0u }; i < static_cast<uint32_t>(result.size()); i++) {
+            const uint32_t vertex { result.at(i) };
+            adjacency.at(adjacencyOffsets.at(vertex) + adjacencyCounts.at(vertex)) = i / 3u;
+            adjacencyCounts.at(vertex)++;
+        }
+
+        // Every interior edge is listed by both of its triangles, in opposite directions, so take one of them.
+        collapses.clear();
+        for (uint32_t i { 0u }; i < static_cast<uint32_t>(result.size()); i++) {
+            const uint32_t a { result.at(i) };
+            const uint32_t b { result.at(i - i % 3u + (i + 1u) % 3u) };
+
+            if (a >= b) {
+                continue;
+            }
+
+            Quadric quadric { quadrics.at(a) };
+            addQuadric(quadric, quadrics.at(b));
+
+            if (!isLocked.at(a)) {
+                collapses.push_back({ a, b, getQuadricError(quadric, positions.at(b)) });
+            }
+            if (!isLocked.at(b)) {
+                collapses.push_back({ b, a, getQuadricError(quadric, positions.at(a)) });
+            }
+        }
+
+        std::sort(
+            collapses.begin(),
+            collapses.end(),
+            [](const Collapse& lhs, const Collapse& rhs) -> bool {
+                return lhs.error < rhs.error;
+            }
+        );
+
+        for (uint32_t vertex { 0u }; vertex < vertexCount; vertex++) {
+            collapseTargets.at(vertex) = vertex;
+        }
+        std::fill(isTouched.begin(), isTouched.end(), false);
+
+        uint32_t remainingTriangleCount { triangleCount };
+        bool hasCollapsed { false };
+
+        for (const Collapse& collapse : collapses) {
+            if (collapse.error > targetErrorSquared || remainingTriangleCount * 3u <= targetIndexCount) {
+                break;
+            }
+
+            if (isTouched.at(collapse.from) || isTouched.at(collapse.to)) {
+                continue;
+            }
+
+            const uint32_t begin { adjacencyOffsets.at(collapse.from) };
+            const uint32_t end { adjacencyOffsets.at(collapse.from + 1u) };
+            bool isFlipping { false };
+            uint32_t removedTriangleCount { 0u };
+
+            for (uint32_t i { begin }; i < end && !isFlipping; i++) {
+                const uint32_t triangle { adjacency.at(i) };
+                const std::array<uint32_t, 3u> corners {
+                    result.at(triangle * 3u),
+                    result.at(triangle * 3u + 1u),
+                    result.at(triangle * 3u + 2u)
+                };
+
+                if (corners.at(0u) == collapse.to || corners.at(1u) == collapse.to || corners.at(2u) == collapse.to) {
+                    removedTriangleCount++;
+                    continue;
+                }
+
+                std::array<std::array<float, 3u>, 3u> moved {
+                    positions.at(corners.at(0u)),
+                    positions.at(corners.at(1u)),
+                    positions.at(corners.at(2u))
+                };
+
+                const std::array<double, 3u> normal { getCross(moved.at(0u), moved.at(1u), moved.at(2u)) };
+
+                for (std::size_t corner { 0u }; corner < 3u; corner++) {
+                    if (corners.at(corner) == collapse.from) {
+                        moved.at(corner) = positions.at(collapse.to);
+                    }
+                }
+
+                const std::array<double, 3u> movedNormal { getCross(moved.at(0u), moved.at(1u), moved.at(2u)) };
+                const double lengths { std::sqrt(getDot(normal, normal) * getDot(movedNormal, movedNormal)) };
+
+                isFlipping = getDot(normal, movedNormal) <= global_minimumNormalAlignment * lengths;
+            }
+
+            if (isFlipping) {
+                continue;
+            }
+
+            for (uint32_t i { begin }; i < end; i++) {
+                const uint32_t triangle { adjacency.at(i) };
+                isTouched.at(result.at(triangle * 3u)) = true;
+                isTouched.at(result.at(triangle * 3u + 1u)) = true;
+                isTouched.at(result.at(triangle * 3u + 2u)) = true;
+            }
+
+            collapseTargets.at(collapse.from) = collapse.to;
+            addQuadric(quadrics.at(collapse.to), quadrics.at(collapse.from));
+            resultErrorSquared = std::max(resultErrorSquared, collapse.error);
+            remainingTriangleCount -= std::min(removedTriangleCount, remainingTriangleCount);
+            hasCollapsed = true;
+        }
+
+        if (!hasCollapsed) {
+            break;
+        }
+
+        std::size_t writeIndex { 0u };
+
+        for (std::size_t i { 0u }; i + 2u < result.size(); i += 3u) {
+            const uint32_t a { collapseTargets.at(result.at(i)) };
+            const uint32_t b { collapseTargets.at(result.at(i + 1u)) };
+            const uint32_t c { collapseTargets.at(result.at(i + 2u)) };
+
+            if (a != b && b != c && a != c) {
+                result.at(writeIndex++) = a;
+                result.at(writeIndex++) = b;
+                result.at(writeIndex++) = c;
+            }
+        }
+
+        result.resize(writeIndex);
+    }
+
+    return { result, std::sqrt(resultErrorSquared) };
+}
+
+auto MeshUtils::quantizeUnorm16(const float value, const float min, const float max) -> uint16_t {
+    if (max <= min) {
+        return 0u;
+    }
+
+    const float normalized { std::clamp((value - min) / (max - min), 0.0f, 1.0f) };
+
+    return static_cast<uint16_t>(std::lround(normalized * 65535.0f));
+}
+
+auto MeshUtils::dequantizeUnorm16(const uint16_t value, const float min, const float max) -> float {
+    return min + (max - min) * (static_cast<float>(value) / 65535.0f);
+}
+
+auto MeshUtils::encodeOctahedral(const std::array<float, 3u>& normal) -> std::array<int8_t, 2u> {
+    const float length { std::fabs(normal.at(0u)) + std::fabs(normal.at(1u)) + std::fabs(normal.at(2u)) };
+
+    if (length == 0.0f) {
+        return { 0, 0 };
+    }
+
+    float x { normal.at(0u) / length };
+    float y { normal.at(1u) / length };
+
+    // The lower half is folded over the diagonals onto the outer triangles of the square.
+    if (normal.at(2u) < 0.0f) {
+        const float foldedX { (1.0f - std::fabs(y)) * getSign(x) };
+        const float foldedY { (1.0f - std::fabs(x)) * getSign(y) };
+        x = foldedX;
+        y = foldedY;
+    }
+
+    const std::array<int8_t, 2u> encoded {
+        static_cast<int8_t>(std::lround(std::clamp(x, -1.0f, 1.0f) * 127.0f)),
+        static_cast<int8_t>(std::lround(std::clamp(y, -1.0f, 1.0f) * 127.0f))
+    };
+
+    return encoded;
+}
+
+auto MeshUtils::decodeOctahedral(const std::array<int8_t, 2u>& encoded) -> std::array<float, 3u> {
+    float x { std::max(static_cast<float>(encoded.at(0u)) / 127.0f, -1.0f) };
+    float y { std::max(static_cast<float>(encoded.at(1u)) / 127.0f, -1.0f) };
+    const float z { 1.0f - std::fabs(x) - std::fabs(y) };
+
+    if (z < 0.0f) {
+        const float unfoldedX { (1.0f - std::fabs(y)) * getSign(x) };
+        const float unfoldedY { (1.0f - std::fabs(x)) * getSign(y) };
+        x = unfoldedX;
+        y = unfoldedY;
+    }
+
+    const float length { std::sqrt(x * x + y * y + z * z) };
+
+    const std::array<float, 3u> normal {
+        x / length,
+        y / length,
+        z / length
+    };
+
+    return normal;
+}
+
+} // namespace resources
+} // namespace beige
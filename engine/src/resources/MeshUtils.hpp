@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace beige {
+namespace resources {
+
+class MeshUtils final {
+public:
+    MeshUtils() = delete;
+    ~MeshUtils() = delete;
+
+    // Size of the LRU cache the triangle order is optimized for, larger than most hardware caches on purpose.
+    static constexpr uint32_t m_optimizerCacheSize { 32u };
+
+    /**
+     * Reorders triangles so consecutive ones share vertices while they are still in the post-transform cache.
+     * Greedy and linear in the number of triangles, after Tom Forsyth's "Linear-Speed Vertex Cache Optimisation".
+     * @param indices The triangle list to reorder in place.
+     * @param vertexCount The number of vertices the indices refer to.
+     */
+    static auto optimizeVertexCache(std::vector<uint32_t>& indices, const uint32_t vertexCount) -> void;
+
+    /**
+     * Renumbers vertices in the order the triangles first use them, so vertex fetches walk memory linearly.
+     * Unreferenced vertices are dropped.
+     * @param indices The triangle list to rewrite in place.
+     * @param vertexCount The number of vertices the indices refer to.
+     * @returns For each new vertex, the index of the old vertex to move there.
+     */
+    static auto optimizeVertexFetch(std::vector<uint32_t>& indices, const uint32_t vertexCount) -> std::vector<uint32_t>;
+
+    /**
+     * Simulates a FIFO post-transform cache, as found in most hardware.
+     * @param indices The triangle list to measure.
+     * @param cacheSize The number of vertices the cache holds.
+     * @returns The average number of vertices transformed per triangle, between 0.5 and 3.
+     */
+    static auto getAverageCacheMissRatio(const std::vector<uint32_t>& indices, const uint32_t cacheSize) -> float;
+
+    /**
+     * Reduces the triangle count by quadric edge collapse, after Garland and Heckbert's "Surface Simplification
+     * Using Quadric Error Metrics". Vertices are only ever collapsed onto other vertices, so the result indexes the
+     * same vertices and every level of detail can share one vertex buffer. Vertices on open borders and on
+     * attribute seams (several vertices at one position) are kept in place.
+     * @param indices The triangle list to simplify.
+     * @param positions The position of every vertex the indices refer to.
+     * @param targetIndexCount The index count to stop at, the result may stay above it.
+     * @param targetError The largest distance from the original surface a collapse may introduce.
+     * @returns The simplified triangle list, and the largest distance from the original surface it introduced.
+     */
+    static auto simplify(
+        const std::vector<uint32_t>& indices,
+        const std::vector<std::array<float, 3u>>& positions,
+        const uint32_t targetIndexCount,
+        const float targetError
+    ) -> std::pair<std::vector<uint32_t>, float>;
+
+    static auto quantizeUnorm16(const float value, const float min, const float max) -> uint16_t;
+    static auto dequantizeUnorm16(const uint16_t value, const float min, const float max) -> float;
+
+    /**
+     * Folds a unit vector onto an octahedron and flattens it to two snorm components.
+     * @param normal The vector to encode, does not have to be normalized.
+     * @returns The encoded vector.
+     */
+    static auto encodeOctahedral(const std::array<float, 3u>& normal) -> std::array<int8_t, 2u>;
+    static auto decodeOctahedral(const std::array<int8_t, 2u>& encoded) -> std::array<float, 3u>;
+};
+
+} // namespace resources
+} // namespace beige
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+namespace beige {
+namespace resources {
+
+// Layout of a packed archive (.bpak) file:
+// PackedArchiveHeader | PackedArchiveEntry[entryCount] | paths | padding | blobs.
+// Paths are relative to the packed directory with '/' separators, not null terminated.
+// Every blob starts aligned, so uncompressed blobs can be used straight from the mapping.
+// Entries are sorted by path and blobs are stored in the same order, so a directory's files sit next to each other.
+
+inline constexpr uint32_t global_packedArchiveMagic { 0x4B415042u }; // "BPAK"
+inline constexpr uint32_t global_packedArchiveVersion { 1u };
+inline constexpr uint64_t global_packedArchiveDataAlignment { 64u };
+
+enum class PackedCompression : uint32_t {
+    None = 0u,
+    Lz4 = 1u // LZ4 block format, see Lz4.hpp.
+};
+
+struct PackedArchiveHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+    uint64_t pathsOffset; // From the start of the file.
+    uint64_t pathsSize;
+};
+
+struct PackedArchiveEntry {
+    uint64_t offset;           // From the start of the file.
+    uint64_t size;             // Size of the stored blob.
+    uint64_t uncompressedSize;
+    uint64_t pathOffset;       // From the start of the paths.
+    uint32_t pathLength;
+    PackedCompression compression;
+};
+
+static_assert(sizeof(PackedArchiveHeader) == 32u, "Packed archive header layout changed, bump the version!");
+static_assert(sizeof(PackedArchiveEntry) == 40u, "Packed archive entry layout changed, bump the version!");
+
+} // namespace resources
+} // namespace beige
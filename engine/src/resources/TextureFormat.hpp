@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+namespace beige {
+namespace resources {
+
+// Values are stored in cooked texture files, never reorder.
+enum class TextureFormat : uint32_t {
+    Rgba8 = 0u,
+    Bc1 = 1u, // Opaque RGB, 8 bytes per 4x4 block.
+    Bc3 = 2u, // RGBA with interpolated alpha, 16 bytes per 4x4 block.
+    Bc7 = 3u  // High quality RGB(A), 16 bytes per 4x4 block.
+};
+
+enum class TextureQuality : uint32_t {
+    Lossless = 0u, // Keeps RGBA8.
+    Fast = 1u,     // BC1 for opaque, BC3 for transparent textures.
+    High = 2u      // BC7 for every texture.
+};
+
+} // namespace resources
+} // namespace beige
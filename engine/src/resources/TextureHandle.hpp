@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+namespace beige {
+namespace resources {
+
+// Refers to a slot of the texture pool. The generation changes whenever the slot is freed, which makes handles
+// to an unloaded texture resolve to nothing instead of to whatever texture reuses the slot.
+struct TextureHandle {
+    uint32_t index;
+    uint32_t generation;
+};
+
+inline constexpr TextureHandle global_invalidTextureHandle { static_cast<uint32_t>(-1), 0u };
+
+inline constexpr auto operator==(const TextureHandle& lhs, const TextureHandle& rhs) -> bool {
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+inline constexpr auto operator!=(const TextureHandle& lhs, const TextureHandle& rhs) -> bool {
+    return !(lhs == rhs);
+}
+
+} // namespace resources
+} // namespace beige
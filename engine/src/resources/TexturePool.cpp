@@ -0,0 +1,84 @@
+#include "TexturePool.hpp"
+
+namespace beige {
+namespace resources {
+
+TexturePool::TexturePool() :
+m_textures { },
+m_generations { },
+m_lastUsedFrames { },
+m_owners { },
+m_freeIndices { } {
+
+}
+
+TexturePool::~TexturePool() {
+
+}
+
+auto TexturePool::allocate(std::shared_ptr<ITexture> texture) -> TextureHandle {
+    uint32_t index { 0u };
+
+    if (!m_freeIndices.empty()) {
+        index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+    } else {
+        index = static_cast<uint32_t>(m_textures.size());
+        m_textures.push_back(nullptr);
+        m_generations.push_back(0u);
+        m_lastUsedFrames.push_back(0u);
+        m_owners.push_back(nullptr);
+    }
+
+    // Generations of live slots are odd, so a handle can never match a free slot.
+    m_generations.at(index)++;
+    m_textures.at(index) = texture.get();
+    m_lastUsedFrames.at(index) = 0u;
+    m_owners.at(index) = texture;
+
+    const TextureHandle handle {
+        index,                  // index
+        m_generations.at(index) // generation
+    };
+
+    return handle;
+}
+
+auto TexturePool::free(const TextureHandle handle) -> void {
+    if (!isValid(handle)) {
+        return;
+    }
+
+    m_generations.at(handle.index)++;
+    m_textures.at(handle.index) = nullptr;
+    m_owners.at(handle.index).reset();
+    m_freeIndices.push_back(handle.index);
+}
+
+auto TexturePool::clear() -> std::vector<std::shared_ptr<ITexture>> {
+    std::vector<std::shared_ptr<ITexture>> textures;
+
+    for (uint32_t i { 0u }; i < static_cast<uint32_t>(m_owners.size()); i++) {
+        if (m_owners.at(i) != nullptr) {
+            textures.push_back(std::move(m_owners.at(i)));
+            free({ i, m_generations.at(i) });
+        }
+    }
+
+    return textures;
+}
+
+auto TexturePool::getLastUsedFrame(const TextureHandle handle) const -> uint64_t {
+    return isValid(handle) ? m_lastUsedFrames.at(handle.index) : 0u;
+}
+
+auto TexturePool::getTexture(const TextureHandle handle) const -> std::shared_ptr<ITexture> {
+    return isValid(handle) ? m_owners.at(handle.index) : nullptr;
+}
+
+auto TexturePool::getCount() const -> uint32_t {
+    return static_cast<uint32_t>(m_textures.size() - m_freeIndices.size());
+}
+
+} // namespace resources
+} // namespace beige
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../Defines.hpp"
+#include "ITexture.hpp"
+#include "TextureHandle.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace beige {
+namespace resources {
+
+/**
+ * Owns every texture and hands out generational handles to them. Slots are kept in parallel arrays, so the
+ * draw path only touches the pointers, generations and frame stamps it needs and never a reference count.
+ */
+class BEIGE_API TexturePool final {
+public:
+    TexturePool();
+    ~TexturePool();
+
+    /**
+     * Stores a texture in a free slot, reusing freed slots first.
+     * @returns The handle to the texture.
+     */
+    auto allocate(std::shared_ptr<ITexture> texture) -> TextureHandle;
+
+    /**
+     * Destroys the texture of a slot and invalidates every handle to it.
+     */
+    auto free(const TextureHandle handle) -> void;
+
+    /**
+     * Frees every slot, for owners which have to release the textures in a particular way.
+     * @returns The textures which were stored.
+     */
+    auto clear() -> std::vector<std::shared_ptr<ITexture>>;
+
+    auto isValid(const TextureHandle handle) const -> bool {
+        return handle.index < m_generations.size() && m_generations[handle.index] == handle.generation;
+    }
+
+    /**
+     * @returns The texture, or nullptr if the handle is stale or invalid.
+     */
+    auto resolve(const TextureHandle handle) const -> ITexture* {
+        return isValid(handle) ? m_textures[handle.index] : nullptr;
+    }
+
+    auto markUsed(const TextureHandle handle, const uint64_t frame) -> void {
+        if (isValid(handle)) {
+            m_lastUsedFrames[handle.index] = frame;
+        }
+    }
+
+    auto getLastUsedFrame(const TextureHandle handle) const -> uint64_t;
+
+    /**
+     * @returns The owning pointer, for uploads and other paths off the draw path.
+     */
+    auto getTexture(const TextureHandle handle) const -> std::shared_ptr<ITexture>;
+    auto getCount() const -> uint32_t;
+
+private:
+    std::vector<ITexture*> m_textures;
+    std::vector<uint32_t> m_generations;
+    std::vector<uint64_t> m_lastUsedFrames; // Frame each texture was last drawn in, used for residency decisions.
+    std::vector<std::shared_ptr<ITexture>> m_owners;
+    std::vector<uint32_t> m_freeIndices;
+};
+
+} // namespace resources
+} // namespace beige
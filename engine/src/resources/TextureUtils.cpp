@@ -0,0 +1,138 @@
+#include "TextureUtils.hpp"
+
+#include "../math/Simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace beige {
+namespace resources {
+
+auto TextureUtils::getMipLevelCount(const uint32_t width, const uint32_t height) -> uint32_t {
+    return static_cast<uint32_t>(std::floor(std::log2(std::max(std::max(width, height), 1u)))) + 1u;
+}
+
+auto TextureUtils::getMipLevelSize(
+    const uint32_t width,
+    const uint32_t height,
+    const uint32_t channelCount,
+    const uint32_t mipLevel
+) -> uint64_t {
+    return static_cast<uint64_t>(std::max(width >> mipLevel, 1u)) * std::max(height >> mipLevel, 1u) * channelCount;
+}
+
+auto TextureUtils::getMipLevelSize(
+    const TextureFormat format,
+    const uint32_t width,
+    const uint32_t height,
+    const uint32_t mipLevel
+) -> uint64_t {
+    const uint32_t mipWidth { std::max(width >> mipLevel, 1u) };
+    const uint32_t mipHeight { std::max(height >> mipLevel, 1u) };
+
+    if (!isBlockCompressed(format)) {
+        return static_cast<uint64_t>(mipWidth) * mipHeight * getBlockSize(format);
+    }
+
+    return static_cast<uint64_t>((mipWidth + 3u) / 4u) * ((mipHeight + 3u) / 4u) * getBlockSize(format);
+}
+
+auto TextureUtils::isBlockCompressed(const TextureFormat format) -> bool {
+    return format != TextureFormat::Rgba8;
+}
+
+auto TextureUtils::getBlockSize(const TextureFormat format) -> uint32_t {
+    switch (format) {
+    case TextureFormat::Rgba8:
+        return 4u;
+    case TextureFormat::Bc1:
+        return 8u;
+    case TextureFormat::Bc3:
+    case TextureFormat::Bc7:
+        return 16u;
+    }
+
+    return 0u;
+}
+
+auto TextureUtils::generateMipChain(
+    const void* pixels,
+    const uint32_t width,
+    const uint32_t height,
+    const uint32_t channelCount,
+    const uint32_t mipLevelCount
+) -> std::vector<std::byte> {
+    uint64_t totalSize { 0u };
+    for (uint32_t i { 0u }; i < mipLevelCount; i++) {
+        totalSize += getMipLevelSize(width, height, channelCount, i);
+    }
+
+    std::vector<std::byte> mipChain(totalSize);
+
+    uint32_t sourceWidth { width };
+    uint32_t sourceHeight { height };
+    uint64_t sourceOffset { 0u };
+    uint64_t destinationOffset { static_cast<uint64_t>(sourceWidth) * sourceHeight * channelCount };
+
+    std::memcpy(mipChain.data(), pixels, destinationOffset);
+
+    for (uint32_t level { 1u }; level < mipLevelCount; level++) {
+        const uint32_t destinationWidth { std::max(sourceWidth / 2u, 1u) };
+        const uint32_t destinationHeight { std::max(sourceHeight / 2u, 1u) };
+
+        const uint8_t* source { reinterpret_cast<const uint8_t*>(mipChain.data() + sourceOffset) };
+        uint8_t* destination { reinterpret_cast<uint8_t*>(mipChain.data() + destinationOffset) };
+
+        if (channelCount == 4u) {
+            math::Simd::downsampleBox(source, sourceWidth, sourceHeight, destination);
+        } else {
+            for (uint32_t y { 0u }; y < destinationHeight; y++) {
+                // Odd dimensions clamp to the last row/column.
+                const uint8_t* sourceRow0 { source + std::min(y * 2u, sourceHeight - 1u) * sourceWidth * channelCount };
+                const uint8_t* sourceRow1 { source + std::min(y * 2u + 1u, sourceHeight - 1u) * sourceWidth * channelCount };
+                uint8_t* destinationRow { destination + y * destinationWidth * channelCount };
+
+                for (uint32_t x { 0u }; x < destinationWidth; x++) {
+                    const uint32_t x0 { std::min(x * 2u, sourceWidth - 1u) * channelCount };
+                    const uint32_t x1 { std::min(x * 2u + 1u, sourceWidth - 1u) * channelCount };
+
+                    for (uint32_t c { 0u }; c < channelCount; c++) {
+                        const uint32_t sum {
+                            static_cast<uint32_t>(sourceRow0[x0 + c]) + sourceRow0[x1 + c] +
+                            sourceRow1[x0 + c] + sourceRow1[x1 + c]
+                        };
+                        destinationRow[x * channelCount + c] = static_cast<uint8_t>((sum + 2u) / 4u);
+                    }
+                }
+            }
+        }
+
+        sourceOffset = destinationOffset;
+        destinationOffset += static_cast<uint64_t>(destinationWidth) * destinationHeight * channelCount;
+        sourceWidth = destinationWidth;
+        sourceHeight = destinationHeight;
+    }
+
+    return mipChain;
+}
+
+auto TextureUtils::generateCheckerboard(const uint32_t dimension) -> std::vector<std::byte> {
+    const uint32_t channelCount { 4u };
+    std::vector<std::byte> pixels(static_cast<std::size_t>(dimension) * dimension * channelCount, std::byte(0xFF));
+
+    // Every other pixel is blue, starting with the first one on even rows and the second one on odd rows.
+    for (uint32_t row { 0u }; row < dimension; row++) {
+        std::byte* rowPixels { pixels.data() + static_cast<std::size_t>(row) * dimension * channelCount };
+
+        for (uint32_t col { row % 2u == 0u ? 0u : 1u }; col < dimension; col += 2u) {
+            rowPixels[col * channelCount + 0u] = std::byte(0x00);
+            rowPixels[col * channelCount + 1u] = std::byte(0x00);
+        }
+    }
+
+    return pixels;
+}
+
+} // namespace resources
+} // namespace beige
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "TextureFormat.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace beige {
+namespace resources {
+
+class TextureUtils final {
+public:
+    TextureUtils() = delete;
+    ~TextureUtils() = delete;
+
+    /**
+     * Returns the number of levels in a full mip chain, down to and including the 1x1 level.
+     * @param width The width of the base level.
+     * @param height The height of the base level.
+     * @returns The number of mip levels, including the base level.
+     */
+    static auto getMipLevelCount(const uint32_t width, const uint32_t height) -> uint32_t;
+
+    /**
+     * Returns the size of a single mip level of an uncompressed texture.
+     * @param width The width of the base level.
+     * @param height The height of the base level.
+     * @param channelCount The number of 8 bit channels per pixel.
+     * @param mipLevel The level to get the size for.
+     * @returns The size of the level in bytes.
+     */
+    static auto getMipLevelSize(
+        const uint32_t width,
+        const uint32_t height,
+        const uint32_t channelCount,
+        const uint32_t mipLevel
+    ) -> uint64_t;
+
+    /**
+     * Returns the size of a single mip level in the given format, block compressed levels are rounded up to whole blocks.
+     * @param format The format of the level.
+     * @param width The width of the base level.
+     * @param height The height of the base level.
+     * @param mipLevel The level to get the size for.
+     * @returns The size of the level in bytes.
+     */
+    static auto getMipLevelSize(
+        const TextureFormat format,
+        const uint32_t width,
+        const uint32_t height,
+        const uint32_t mipLevel
+    ) -> uint64_t;
+
+    /**
+     * Indicates if the format stores 4x4 texel blocks instead of single texels.
+     * @param format The format to check.
+     * @returns True for the BCn formats, otherwise false.
+     */
+    static auto isBlockCompressed(const TextureFormat format) -> bool;
+
+    /**
+     * Returns the size of one texel block, a single texel for uncompressed formats and 4x4 texels otherwise.
+     * @param format The format to get the block size for.
+     * @returns The size of a block in bytes.
+     */
+    static auto getBlockSize(const TextureFormat format) -> uint32_t;
+
+    /**
+     * Builds a mip chain with a 2x2 box filter, odd dimensions clamp to the last row/column.
+     * @param pixels The tightly packed base level.
+     * @param width The width of the base level.
+     * @param height The height of the base level.
+     * @param channelCount The number of 8 bit channels per pixel.
+     * @param mipLevelCount The number of levels to produce, including the base level.
+     * @returns The tightly packed chain, base level first.
+     */
+    static auto generateMipChain(
+        const void* pixels,
+        const uint32_t width,
+        const uint32_t height,
+        const uint32_t channelCount,
+        const uint32_t mipLevelCount
+    ) -> std::vector<std::byte>;
+
+    /**
+     * Builds a blue/white checkerboard of single pixels, the default texture is generated this way so it needs no asset.
+     * @param dimension The width and height of the texture.
+     * @returns The tightly packed Rgba8 pixels.
+     */
+    static auto generateCheckerboard(const uint32_t dimension) -> std::vector<std::byte>;
+};
+
+} // namespace resources
+} // namespace beige
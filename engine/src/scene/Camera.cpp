@@ -0,0 +1,104 @@
+#include "Camera.hpp"
+
+#include "../renderer/FrustumCuller.hpp"
+
+#include <cmath>
+
+namespace beige {
+namespace scene {
+
+Camera::Camera() :
+m_position { 0.0f },
+m_rotation { glm::quat(1.0f, 0.0f, 0.0f, 0.0f) },
+m_fieldOfView { glm::radians(45.0f) },
+m_aspectRatio { 1.0f },
+m_nearClip { 0.01f },
+m_isViewDirty { true },
+m_isProjectionDirty { true },
+m_view { glm::mat4x4(1.0f) },
+m_projection { glm::mat4x4(1.0f) },
+m_viewProjection { glm::mat4x4(1.0f) },
+m_frustumPlanes { } {
+    update();
+}
+
+auto Camera::setPosition(const glm::vec3& position) -> void {
+    m_position = position;
+    m_isViewDirty = true;
+}
+
+auto Camera::setRotation(const glm::quat& rotation) -> void {
+    m_rotation = rotation;
+    m_isViewDirty = true;
+}
+
+auto Camera::setPerspective(const float fieldOfView, const float nearClip) -> void {
+    m_fieldOfView = fieldOfView;
+    m_nearClip = nearClip;
+    m_isProjectionDirty = true;
+}
+
+auto Camera::setAspectRatio(const float aspectRatio) -> void {
+    if (aspectRatio != m_aspectRatio) {
+        m_aspectRatio = aspectRatio;
+        m_isProjectionDirty = true;
+    }
+}
+
+auto Camera::getPosition() const -> const glm::vec3& {
+    return m_position;
+}
+
+auto Camera::getRotation() const -> const glm::quat& {
+    return m_rotation;
+}
+
+auto Camera::update() -> bool {
+    if (!m_isViewDirty && !m_isProjectionDirty) {
+        return false;
+    }
+
+    if (m_isViewDirty) {
+        // The inverse of the rotation is its transpose, the translation is undone after it.
+        m_view = glm::transpose(glm::mat4_cast(m_rotation));
+        m_view[3] = m_view * glm::vec4(-m_position, 1.0f);
+    }
+
+    if (m_isProjectionDirty) {
+        // Clip z is the near distance and clip w the view depth, so depth = near / depth goes from 1 to 0.
+        const float focalLength { 1.0f / std::tan(m_fieldOfView * 0.5f) };
+
+        m_projection = glm::mat4x4(0.0f);
+        m_projection[0][0] = focalLength / m_aspectRatio;
+        m_projection[1][1] = focalLength;
+        m_projection[2][3] = -1.0f;
+        m_projection[3][2] = m_nearClip;
+    }
+
+    m_viewProjection = m_projection * m_view;
+    m_frustumPlanes = renderer::FrustumCuller::extractPlanes(m_viewProjection);
+
+    m_isViewDirty = false;
+    m_isProjectionDirty = false;
+
+    return true;
+}
+
+auto Camera::getView() const -> const glm::mat4x4& {
+    return m_view;
+}
+
+auto Camera::getProjection() const -> const glm::mat4x4& {
+    return m_projection;
+}
+
+auto Camera::getViewProjection() const -> const glm::mat4x4& {
+    return m_viewProjection;
+}
+
+auto Camera::getFrustumPlanes() const -> const std::array<float, 24u>& {
+    return m_frustumPlanes;
+}
+
+} // namespace scene
+} // namespace beige
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "../Defines.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace beige {
+namespace scene {
+
+/**
+ * A perspective camera, added as a component to the entity it views from. Setters only mark the matrices as out of
+ * date and update() rebuilds the changed ones, so a camera that does not move costs nothing per frame.
+ *
+ * Projects with reverse-Z and an infinite far plane: depth is 1 at the near plane and approaches 0 towards infinity,
+ * which matches the exponent of a float depth buffer and keeps precision at large distances.
+ */
+class BEIGE_API Camera final {
+public:
+    Camera();
+    ~Camera() = default; // Trivial, components are copied between chunks byte by byte.
+
+    /**
+     * @param position Where the camera is, in world space.
+     */
+    auto setPosition(const glm::vec3& position) -> void;
+
+    /**
+     * @param rotation Turns the forward axis of the camera, negative z, to the view direction.
+     */
+    auto setRotation(const glm::quat& rotation) -> void;
+
+    /**
+     * @param fieldOfView The vertical field of view, in radians.
+     * @param nearClip The distance to the near plane, there is no far plane.
+     */
+    auto setPerspective(const float fieldOfView, const float nearClip) -> void;
+    auto setAspectRatio(const float aspectRatio) -> void;
+
+    auto getPosition() const -> const glm::vec3&;
+    auto getRotation() const -> const glm::quat&;
+
+    /**
+     * Rebuilds the matrices and frustum planes which are out of date.
+     * @returns True if any of them changed since the last update.
+     */
+    auto update() -> bool;
+
+    // As of the last update.
+    auto getView() const -> const glm::mat4x4&;
+    auto getProjection() const -> const glm::mat4x4&;
+    auto getViewProjection() const -> const glm::mat4x4&;
+
+    /**
+     * @returns Six planes as (a, b, c, d) with normals pointing inward, as of the last update. The far plane is at
+     * infinity and never rejects anything.
+     */
+    auto getFrustumPlanes() const -> const std::array<float, 24u>&;
+
+private:
+    glm::vec3 m_position;
+    glm::quat m_rotation;
+    float m_fieldOfView;
+    float m_aspectRatio;
+    float m_nearClip;
+    bool m_isViewDirty;
+    bool m_isProjectionDirty;
+
+    glm::mat4x4 m_view;
+    glm::mat4x4 m_projection;
+    glm::mat4x4 m_viewProjection;
+    std::array<float, 24u> m_frustumPlanes;
+};
+
+} // namespace scene
+} // namespace beige
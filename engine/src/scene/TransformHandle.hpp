@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+namespace beige {
+namespace scene {
+
+// Refers to a node of the transform hierarchy, stays valid while the nodes are reordered.
+struct TransformHandle {
+    uint32_t index;
+    uint32_t generation;
+};
+
+inline constexpr TransformHandle global_invalidTransformHandle { static_cast<uint32_t>(-1), 0u };
+
+inline constexpr auto operator==(const TransformHandle& lhs, const TransformHandle& rhs) -> bool {
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+inline constexpr auto operator!=(const TransformHandle& lhs, const TransformHandle& rhs) -> bool {
+    return !(lhs == rhs);
+}
+
+} // namespace scene
+} // namespace beige
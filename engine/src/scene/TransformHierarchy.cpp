@@ -0,0 +1,398 @@
+#include "TransformHierarchy.hpp"
+
+#include "../ecs/Components.hpp"
+#include "../math/Simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+namespace beige {
+namespace scene {
+
+namespace {
+
+auto composeMatrix(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) -> glm::mat4x4 {
+    glm::mat4x4 matrix { glm::mat4_cast(rotation) };
+
+    matrix[0] *= scale.x;
+    matrix[1] *= scale.y;
+    matrix[2] *= scale.z;
+    matrix[3] = glm::vec4(position, 1.0f);
+
+    return matrix;
+}
+
+} // namespace
+
+TransformHierarchy::TransformHierarchy(std::shared_ptr<core::JobSystem> jobSystem) :
+m_jobSystem { jobSystem },
+m_positions { },
+m_rotations { },
+m_scales { },
+m_parents { },
+m_handleIndices { },
+m_isDirty { },
+m_isChanged { },
+m_isDestroyed { },
+m_worldMatrices { },
+m_depthOffsets { },
+m_isOrderValid { true },
+m_slots { },
+m_generations { },
+m_freeHandleIndices { } {
+
+}
+
+TransformHierarchy::~TransformHierarchy() {
+
+}
+
+auto TransformHierarchy::create(const TransformHandle parent) -> TransformHandle {
+    uint32_t parentSlot { m_invalidSlot };
+
+    if (parent != global_invalidTransformHandle) {
+        parentSlot = getSlot(parent);
+
+        if (parentSlot == m_invalidSlot) {
+            return global_invalidTransformHandle;
+        }
+    }
+
+    uint32_t handleIndex { static_cast<uint32_t>(m_slots.size()) };
+
+    if (!m_freeHandleIndices.empty()) {
+        handleIndex = m_freeHandleIndices.back();
+        m_freeHandleIndices.pop_back();
+    } else {
+        m_slots.push_back(m_invalidSlot);
+        m_generations.push_back(0u);
+    }
+
+    // Appended nodes come after their parent, the depths are sorted out on the next update.
+    const uint32_t slot { static_cast<uint32_t>(m_positions.size()) };
+
+    m_positions.push_back(glm::vec3(0.0f));
+    m_rotations.push_back(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    m_scales.push_back(glm::vec3(1.0f));
+    m_parents.push_back(parentSlot);
+    m_handleIndices.push_back(handleIndex);
+    m_isDirty.push_back(1u);
+    m_isChanged.push_back(0u);
+    m_isDestroyed.push_back(0u);
+    m_worldMatrices.push_back(glm::mat4x4(1.0f));
+
+    m_slots.at(handleIndex) = slot;
+    m_isOrderValid = false;
+
+    const TransformHandle handle {
+        handleIndex,                     // index
+        m_generations.at(handleIndex)    // generation
+    };
+
+    return handle;
+}
+
+auto TransformHierarchy::destroy(const TransformHandle handle) -> bool {
+    const uint32_t slot { getSlot(handle) };
+
+    if (slot == m_invalidSlot) {
+        return false;
+    }
+
+    // The handle goes stale right away, the descendants once the next update removes them.
+    m_isDestroyed.at(slot) = 1u;
+    m_slots.at(handle.index) = m_invalidSlot;
+    m_generations.at(handle.index)++;
+    m_freeHandleIndices.push_back(handle.index);
+    m_isOrderValid = false;
+
+    return true;
+}
+
+auto TransformHierarchy::setParent(const TransformHandle handle, const TransformHandle parent) -> bool {
+    const uint32_t slot { getSlot(handle) };
+    uint32_t parentSlot { m_invalidSlot };
+
+    if (slot == m_invalidSlot) {
+        return false;
+    }
+
+    if (parent != global_invalidTransformHandle) {
+        parentSlot = getSlot(parent);
+
+        if (parentSlot == m_invalidSlot) {
+            return false;
+        }
+    }
+
+    for (uint32_t ancestor { parentSlot }; ancestor != m_invalidSlot; ancestor = m_parents.at(ancestor)) {
+        if (ancestor == slot) {
+            return false;
+        }
+    }
+
+    m_parents.at(slot) = parentSlot;
+    m_isDirty.at(slot) = 1u;
+    m_isOrderValid = false;
+
+    return true;
+}
+
+auto TransformHierarchy::isValid(const TransformHandle handle) const -> bool {
+    return getSlot(handle) != m_invalidSlot;
+}
+
+auto TransformHierarchy::setPosition(const TransformHandle handle, const glm::vec3& position) -> void {
+    const uint32_t slot { getSlot(handle) };
+
+    if (slot != m_invalidSlot) {
+        m_positions.at(slot) = position;
+        m_isDirty.at(slot) = 1u;
+    }
+}
+
+auto TransformHierarchy::setRotation(const TransformHandle handle, const glm::quat& rotation) -> void {
+    const uint32_t slot { getSlot(handle) };
+
+    if (slot != m_invalidSlot) {
+        m_rotations.at(slot) = rotation;
+        m_isDirty.at(slot) = 1u;
+    }
+}
+
+auto TransformHierarchy::setScale(const TransformHandle handle, const glm::vec3& scale) -> void {
+    const uint32_t slot { getSlot(handle) };
+
+    if (slot != m_invalidSlot) {
+        m_scales.at(slot) = scale;
+        m_isDirty.at(slot) = 1u;
+    }
+}
+
+auto TransformHierarchy::getPosition(const TransformHandle handle) const -> glm::vec3 {
+    const uint32_t slot { getSlot(handle) };
+    return slot != m_invalidSlot ? m_positions.at(slot) : glm::vec3(0.0f);
+}
+
+auto TransformHierarchy::getRotation(const TransformHandle handle) const -> glm::quat {
+    const uint32_t slot { getSlot(handle) };
+    return slot != m_invalidSlot ? m_rotations.at(slot) : glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+}
+
+auto TransformHierarchy::getScale(const TransformHandle handle) const -> glm::vec3 {
+    const uint32_t slot { getSlot(handle) };
+    return slot != m_invalidSlot ? m_scales.at(slot) : glm::vec3(1.0f);
+}
+
+auto TransformHierarchy::getWorldMatrix(const TransformHandle handle) const -> glm::mat4x4 {
+    const uint32_t slot { getSlot(handle) };
+    return slot != m_invalidSlot ? m_worldMatrices.at(slot) : glm::mat4x4(1.0f);
+}
+
+auto TransformHierarchy::update() -> uint32_t {
+    if (!m_isOrderValid) {
+        reorder();
+    }
+
+    std::atomic<uint32_t> updatedCount { 0u };
+
+    // A depth only reads the world matrices and dirty flags of the depth before it.
+    for (uint32_t depth { 0u }; depth + 1u < static_cast<uint32_t>(m_depthOffsets.size()); depth++) {
+        const uint32_t first { m_depthOffsets.at(depth) };
+        const uint32_t last { m_depthOffsets.at(depth + 1u) };
+
+        m_jobSystem->parallelFor(
+            last - first,
+            m_nodesPerJob,
+            [&](const uint32_t begin, const uint32_t end) -> void {
+                updatedCount += updateRange(first + begin, first + end);
+            }
+        );
+    }
+
+    std::fill(m_isDirty.begin(), m_isDirty.end(), static_cast<uint8_t>(0u));
+
+    return updatedCount.load();
+}
+
+auto TransformHierarchy::writeTransforms(ecs::World& world) const -> void {
+    world.parallelForEachChunk(
+        world.getQuery<ecs::Transform, ecs::TransformNode>(),
+        [&](const ecs::ChunkView& chunk) -> void {
+            ecs::Transform* transforms { chunk.get<ecs::Transform>() };
+            const ecs::TransformNode* transformNodes { chunk.get<ecs::TransformNode>() };
+
+            for (uint32_t i { 0u }; i < chunk.getCount(); i++) {
+                const uint32_t slot { getSlot(transformNodes[i].handle) };
+
+                if (slot != m_invalidSlot && m_isChanged.at(slot) != 0u) {
+                    transforms[i].model = m_worldMatrices.at(slot);
+                }
+            }
+        }
+    );
+}
+
+auto TransformHierarchy::getCount() const -> uint32_t {
+    return static_cast<uint32_t>(m_positions.size());
+}
+
+auto TransformHierarchy::getSlot(const TransformHandle handle) const -> uint32_t {
+    if (handle.index >= m_slots.size() || m_generations.at(handle.index) != handle.generation) {
+        return m_invalidSlot;
+    }
+
+    return m_slots.at(handle.index);
+}
+
+auto TransformHierarchy::reorder() -> void {
+    const uint32_t count { static_cast<uint32_t>(m_positions.size()) };
+    std::vector<uint32_t> depths(count, m_invalidSlot);
+    std::vector<uint32_t> path;
+    uint32_t depthCount { 0u };
+
+    // Walk up to the first node with a known depth, then fill in the nodes on the way back down. Descendants of a
+    // destroyed node are destroyed as well.
+    for (uint32_t slot { 0u }; slot < count; slot++) {
+        uint32_t ancestor { slot };
+
+        while (ancestor != m_invalidSlot && depths.at(ancestor) == m_invalidSlot) {
+            path.push_back(ancestor);
+            ancestor = m_parents.at(ancestor);
+        }
+
+        uint32_t depth { ancestor == m_invalidSlot ? 0u : depths.at(ancestor) + 1u };
+        uint8_t isDestroyed { ancestor == m_invalidSlot ? static_cast<uint8_t>(0u) : m_isDestroyed.at(ancestor) };
+
+        while (!path.empty()) {
+            const uint32_t node { path.back() };
+            path.pop_back();
+
+            isDestroyed |= m_isDestroyed.at(node);
+            m_isDestroyed.at(node) = isDestroyed;
+            depths.at(node) = depth;
+            depth++;
+        }
+
+        depthCount = std::max(depthCount, depths.at(slot) + 1u);
+    }
+
+    // Counting sort by depth, stable so siblings keep their order.
+    m_depthOffsets.assign(depthCount + 1u, 0u);
+
+    for (uint32_t slot { 0u }; slot < count; slot++) {
+        if (m_isDestroyed.at(slot) == 0u) {
+            m_depthOffsets.at(depths.at(slot) + 1u)++;
+        }
+    }
+
+    for (uint32_t depth { 0u }; depth < depthCount; depth++) {
+        m_depthOffsets.at(depth + 1u) += m_depthOffsets.at(depth);
+    }
+
+    std::vector<uint32_t> nextSlots(m_depthOffsets.begin(), m_depthOffsets.end() - 1);
+    std::vector<uint32_t> order(m_depthOffsets.back());
+    std::vector<uint32_t> newSlots(count, m_invalidSlot);
+
+    for (uint32_t slot { 0u }; slot < count; slot++) {
+        const uint32_t handleIndex { m_handleIndices.at(slot) };
+
+        if (m_isDestroyed.at(slot) != 0u) {
+            // Destroyed descendants still own their handle, unless it was freed and reused in the meantime.
+            if (m_slots.at(handleIndex) == slot) {
+                m_slots.at(handleIndex) = m_invalidSlot;
+                m_generations.at(handleIndex)++;
+                m_freeHandleIndices.push_back(handleIndex);
+            }
+            continue;
+        }
+
+        const uint32_t newSlot { nextSlots.at(depths.at(slot))++ };
+        order.at(newSlot) = slot;
+        newSlots.at(slot) = newSlot;
+    }
+
+    permute(m_positions, order);
+    permute(m_rotations, order);
+    permute(m_scales, order);
+    permute(m_parents, order);
+    permute(m_handleIndices, order);
+    permute(m_isDirty, order);
+    permute(m_worldMatrices, order);
+
+    const uint32_t newCount { static_cast<uint32_t>(order.size()) };
+
+    for (uint32_t slot { 0u }; slot < newCount; slot++) {
+        const uint32_t parent { m_parents.at(slot) };
+
+        m_parents.at(slot) = parent == m_invalidSlot ? m_invalidSlot : newSlots.at(parent);
+        m_slots.at(m_handleIndices.at(slot)) = slot;
+    }
+
+    m_isChanged.assign(newCount, 0u);
+    m_isDestroyed.assign(newCount, 0u);
+    m_isOrderValid = true;
+}
+
+auto TransformHierarchy::updateRange(const uint32_t first, const uint32_t last) -> uint32_t {
+    std::array<glm::mat4x4, m_batchSize> parentMatrices;
+    std::array<glm::mat4x4, m_batchSize> localMatrices;
+    std::array<glm::mat4x4, m_batchSize> worldMatrices;
+    std::array<uint32_t, m_batchSize> slots;
+    uint32_t batchCount { 0u };
+    uint32_t updatedCount { 0u };
+
+    const auto flush = [&]() -> void {
+        math::Simd::multiplyMatrices(&parentMatrices[0][0][0], &localMatrices[0][0][0], &worldMatrices[0][0][0], batchCount);
+
+        for (uint32_t i { 0u }; i < batchCount; i++) {
+            m_worldMatrices[slots[i]] = worldMatrices[i];
+        }
+
+        updatedCount += batchCount;
+        batchCount = 0u;
+    };
+
+    for (uint32_t slot { first }; slot < last; slot++) {
+        const uint32_t parent { m_parents[slot] };
+
+        if (parent != m_invalidSlot && m_isDirty[parent] != 0u) {
+            m_isDirty[slot] = 1u;
+        }
+
+        m_isChanged[slot] = m_isDirty[slot];
+
+        if (m_isDirty[slot] == 0u) {
+            continue;
+        }
+
+        localMatrices[batchCount] = composeMatrix(m_positions[slot], m_rotations[slot], m_scales[slot]);
+        parentMatrices[batchCount] = parent == m_invalidSlot ? glm::mat4x4(1.0f) : m_worldMatrices[parent];
+        slots[batchCount] = slot;
+        batchCount++;
+
+        if (batchCount == m_batchSize) {
+            flush();
+        }
+    }
+
+    flush();
+
+    return updatedCount;
+}
+
+template<typename T>
+auto TransformHierarchy::permute(std::vector<T>& values, const std::vector<uint32_t>& order) -> void {
+    std::vector<T> permutedValues;
+    permutedValues.reserve(order.size());
+
+    for (const uint32_t slot : order) {
+        permutedValues.push_back(values.at(slot));
+    }
+
+    values = std::move(permutedValues);
+}
+
+} // namespace scene
+} // namespace beige
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "../Defines.hpp"
+#include "../core/JobSystem.hpp"
+#include "../ecs/World.hpp"
+#include "TransformHandle.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace beige {
+namespace scene {
+
+/**
+ * Keeps the local position, rotation and scale of every node in separate arrays, sorted breadth-first so parents
+ * come before their children and the nodes of one depth are contiguous. Updating walks the depths in order,
+ * recomputes the world matrices of changed nodes and their descendants only, and spreads each depth over the job
+ * system. Structural changes reorder the arrays on the next update.
+ */
+class BEIGE_API TransformHierarchy final {
+public:
+    TransformHierarchy(std::shared_ptr<core::JobSystem> jobSystem);
+    ~TransformHierarchy();
+
+    TransformHierarchy(const TransformHierarchy&) = delete;
+    auto operator=(const TransformHierarchy&) -> TransformHierarchy& = delete;
+
+    /**
+     * @param parent The parent of the node, a root node is created for the invalid handle.
+     * @returns The node, at the origin without rotation and unit scale.
+     */
+    auto create(const TransformHandle parent) -> TransformHandle;
+
+    /**
+     * Destroys the node along with its descendants.
+     * @returns False if the handle is stale.
+     */
+    auto destroy(const TransformHandle handle) -> bool;
+
+    /**
+     * Moves the node under another parent, keeping its local transform.
+     * @returns False if either handle is stale or the node would become its own ancestor.
+     */
+    auto setParent(const TransformHandle handle, const TransformHandle parent) -> bool;
+
+    auto isValid(const TransformHandle handle) const -> bool;
+
+    // Stale handles are ignored.
+    auto setPosition(const TransformHandle handle, const glm::vec3& position) -> void;
+    auto setRotation(const TransformHandle handle, const glm::quat& rotation) -> void;
+    auto setScale(const TransformHandle handle, const glm::vec3& scale) -> void;
+    auto getPosition(const TransformHandle handle) const -> glm::vec3;
+    auto getRotation(const TransformHandle handle) const -> glm::quat;
+    auto getScale(const TransformHandle handle) const -> glm::vec3;
+
+    /**
+     * @returns The world matrix as of the last update.
+     */
+    auto getWorldMatrix(const TransformHandle handle) const -> glm::mat4x4;
+
+    /**
+     * Applies structural changes and recomputes the world matrices of changed nodes and their descendants.
+     * @returns The number of recomputed world matrices.
+     */
+    auto update() -> uint32_t;
+
+    /**
+     * Copies the world matrices recomputed by the last update into the transforms of the entities referring to them.
+     */
+    auto writeTransforms(ecs::World& world) const -> void;
+
+    auto getCount() const -> uint32_t;
+
+private:
+    // Nodes per job and per batch of the matrix kernel.
+    static constexpr uint32_t m_nodesPerJob { 1024u };
+    static constexpr uint32_t m_batchSize { 64u };
+    static constexpr uint32_t m_invalidSlot { static_cast<uint32_t>(-1) };
+
+    std::shared_ptr<core::JobSystem> m_jobSystem;
+
+    // Indexed by slot, which changes whenever the nodes are reordered.
+    std::vector<glm::vec3> m_positions;
+    std::vector<glm::quat> m_rotations;
+    std::vector<glm::vec3> m_scales;
+    std::vector<uint32_t> m_parents;       // Slot of the parent, or m_invalidSlot for roots.
+    std::vector<uint32_t> m_handleIndices; // Index of the handle referring to the slot.
+    std::vector<uint8_t> m_isDirty;        // The local transform or the parent changed since the last update.
+    std::vector<uint8_t> m_isChanged;      // The world matrix was recomputed by the last update.
+    std::vector<uint8_t> m_isDestroyed;    // Removed on the next update, together with the descendants.
+    std::vector<glm::mat4x4> m_worldMatrices;
+
+    // Slot of each depth and one past the last, valid while the order is.
+    std::vector<uint32_t> m_depthOffsets;
+    bool m_isOrderValid;
+
+    // Indexed by handle index.
+    std::vector<uint32_t> m_slots;
+    std::vector<uint32_t> m_generations;
+    std::vector<uint32_t> m_freeHandleIndices;
+
+    auto getSlot(const TransformHandle handle) const -> uint32_t;
+
+    /**
+     * Removes destroyed nodes and sorts the rest by depth, keeping the relative order of the nodes of a depth.
+     */
+    auto reorder() -> void;
+    auto updateRange(const uint32_t first, const uint32_t last) -> uint32_t;
+
+    template<typename T>
+    static auto permute(std::vector<T>& values, const std::vector<uint32_t>& order) -> void;
+};
+
+} // namespace scene
+} // namespace beige
@@ -0,0 +1,289 @@
+#include "GeometrySystem.hpp"
+
+#include "../core/Logger.hpp"
+#include "../resources/CookedMesh.hpp"
+#include "../resources/MeshUtils.hpp"
+
+#include <cstring>
+
+namespace beige {
+namespace systems {
+
+Geometry::Geometry(
+    std::shared_ptr<renderer::Frontend> rendererFrontend,
+    std::shared_ptr<const core::Vfs> vfs
+) :
+m_rendererFrontend { rendererFrontend },
+m_vfs { vfs },
+m_handles { },
+m_entries { },
+m_defaultGeometry { resources::global_invalidGeometryHandle } {
+    m_defaultGeometry = createDefaultGeometry();
+
+    if (m_defaultGeometry == resources::global_invalidGeometryHandle) {
+        const std::string message { "Failed to create the default geometry!" };
+        throw std::exception(message.c_str());
+    }
+}
+
+Geometry::~Geometry() {
+    for (const std::pair<const std::string, resources::GeometryHandle>& handle : m_handles) {
+        m_rendererFrontend->destroyGeometry(handle.second);
+    }
+
+    m_rendererFrontend->destroyGeometry(m_defaultGeometry);
+}
+
+auto Geometry::acquire(
+    const std::string& name,
+    const std::vector<math::Vertex3D>& vertices,
+    const std::vector<uint32_t>& indices,
+    const bool autoRelease
+) -> resources::GeometryHandle {
+    const resources::GeometryHandle loadedHandle { findLoaded(name) };
+
+    if (loadedHandle != resources::global_invalidGeometryHandle) {
+        return loadedHandle;
+    }
+
+    return create(name, vertices, indices, { }, autoRelease);
+}
+
+auto Geometry::acquire(const std::string& name, const bool autoRelease) -> resources::GeometryHandle {
+    const resources::GeometryHandle loadedHandle { findLoaded(name) };
+
+    if (loadedHandle != resources::global_invalidGeometryHandle) {
+        return loadedHandle;
+    }
+
+    std::vector<math::Vertex3D> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<resources::GeometryLod> lods;
+
+    if (!loadCookedMesh(name, vertices, indices, lods)) {
+        return resources::global_invalidGeometryHandle;
+    }
+
+    return create(name, vertices, indices, lods, autoRelease);
+}
+
+auto Geometry::create(
+    const std::string& name,
+    const std::vector<math::Vertex3D>& vertices,
+    const std::vector<uint32_t>& indices,
+    const std::vector<resources::GeometryLod>& lods,
+    const bool autoRelease
+) -> resources::GeometryHandle {
+    const resources::GeometryHandle handle { m_rendererFrontend->createGeometry(vertices, indices, lods) };
+
+    if (handle == resources::global_invalidGeometryHandle) {
+        core::Logger::error("Geometry::acquire - failed to create geometry " + name + "!");
+        return handle;
+    }
+
+    if (handle.index >= m_entries.size()) {
+        m_entries.resize(handle.index + 1u);
+    }
+
+    const Entry entry {
+        name,       // name
+        1u,         // referenceCount
+        autoRelease // autoRelease
+    };
+
+    m_entries.at(handle.index) = entry;
+    m_handles.emplace(name, handle);
+
+    return handle;
+}
+
+auto Geometry::findLoaded(const std::string& name) -> resources::GeometryHandle {
+    if (name == m_defaultName) {
+        return m_defaultGeometry;
+    }
+
+    const std::unordered_map<std::string, resources::GeometryHandle>::const_iterator handle { m_handles.find(name) };
+
+    if (handle == m_handles.end()) {
+        return resources::global_invalidGeometryHandle;
+    }
+
+    m_entries.at(handle->second.index).referenceCount++;
+
+    return handle->second;
+}
+
+auto Geometry::release(const resources::GeometryHandle handle) -> void {
+    if (handle == m_defaultGeometry || handle.index >= m_entries.size()) {
+        return;
+    }
+
+    Entry& entry { m_entries.at(handle.index) };
+    const std::unordered_map<std::string, resources::GeometryHandle>::const_iterator loadedHandle {
+        m_handles.find(entry.name)
+    };
+
+    // Stale handles refer to a geometry which was already destroyed.
+    if (loadedHandle == m_handles.end() || loadedHandle->second != handle) {
+        return;
+    }
+
+    if (entry.referenceCount > 0u) {
+        entry.referenceCount--;
+    }
+
+    if (entry.referenceCount == 0u && entry.autoRelease) {
+        m_rendererFrontend->destroyGeometry(handle);
+        m_handles.erase(loadedHandle);
+        entry.name.clear();
+    }
+}
+
+auto Geometry::getDefaultGeometry() const -> resources::GeometryHandle {
+    return m_defaultGeometry;
+}
+
+auto Geometry::unpackCookedVertices(
+    const resources::CookedMeshHeader& header,
+    const std::byte* vertexData,
+    math::Vertex3D* vertices
+) -> void {
+    for (uint32_t i { 0u }; i < header.vertexCount; i++) {
+        resources::CookedMeshVertex cookedVertex;
+        std::memcpy(&cookedVertex, vertexData + sizeof(cookedVertex) * i, sizeof(cookedVertex));
+
+        vertices[i].position = glm::vec3(
+            resources::MeshUtils::dequantizeUnorm16(cookedVertex.position.at(0u), header.positionMin.at(0u), header.positionMax.at(0u)),
+            resources::MeshUtils::dequantizeUnorm16(cookedVertex.position.at(1u), header.positionMin.at(1u), header.positionMax.at(1u)),
+            resources::MeshUtils::dequantizeUnorm16(cookedVertex.position.at(2u), header.positionMin.at(2u), header.positionMax.at(2u))
+        );
+        vertices[i].texCoord = glm::vec2(
+            resources::MeshUtils::dequantizeUnorm16(cookedVertex.texCoord.at(0u), header.texCoordMin.at(0u), header.texCoordMax.at(0u)),
+            resources::MeshUtils::dequantizeUnorm16(cookedVertex.texCoord.at(1u), header.texCoordMin.at(1u), header.texCoordMax.at(1u))
+        );
+    }
+}
+
+auto Geometry::loadCookedMesh(
+    const std::string& name,
+    std::vector<math::Vertex3D>& vertices,
+    std::vector<uint32_t>& indices,
+    std::vector<resources::GeometryLod>& lods
+) const -> bool {
+    const std::string filePath { getCookedPath(name) };
+    const std::optional<core::Vfs::File> file { m_vfs->read(filePath) };
+
+    if (!file.has_value()) {
+        core::Logger::error("Geometry::loadCookedMesh - failed to read " + filePath + "!");
+        return false;
+    }
+
+    if (file->size < sizeof(resources::CookedMeshHeader)) {
+        core::Logger::error("Geometry::loadCookedMesh - cooked mesh " + filePath + " is truncated!");
+        return false;
+    }
+
+    resources::CookedMeshHeader header;
+    std::memcpy(&header, file->data, sizeof(header));
+
+    const uint64_t vertexDataSize { sizeof(resources::CookedMeshVertex) * static_cast<uint64_t>(header.vertexCount) };
+    const uint64_t indexDataSize { static_cast<uint64_t>(header.indexSize) * header.indexCount };
+
+    if (
+        header.magic != resources::global_cookedMeshMagic ||
+        header.version != resources::global_cookedMeshVersion ||
+        (header.indexSize != 2u && header.indexSize != 4u) ||
+        header.lodCount == 0u ||
+        header.lodCount > resources::global_maxGeometryLodCount ||
+        header.vertexCount == 0u ||
+        header.indexCount % 3u != 0u ||
+        header.vertexOffset < sizeof(header) + sizeof(resources::CookedMeshLod) * header.lodCount ||
+        header.vertexOffset > file->size ||
+        vertexDataSize > file->size - header.vertexOffset ||
+        header.indexOffset > file->size ||
+        indexDataSize > file->size - header.indexOffset
+    ) {
+        core::Logger::error("Geometry::loadCookedMesh - cooked mesh " + filePath + " is invalid or outdated!");
+        return false;
+    }
+
+    lods.resize(header.lodCount);
+
+    for (uint32_t i { 0u }; i < header.lodCount; i++) {
+        resources::CookedMeshLod cookedLod;
+        std::memcpy(&cookedLod, file->data + sizeof(header) + sizeof(cookedLod) * i, sizeof(cookedLod));
+
+        if (
+            cookedLod.indexCount == 0u ||
+            cookedLod.indexCount % 3u != 0u ||
+            cookedLod.firstIndex > header.indexCount ||
+            cookedLod.indexCount > header.indexCount - cookedLod.firstIndex
+        ) {
+            core::Logger::error("Geometry::loadCookedMesh - cooked mesh " + filePath + " has an invalid level of detail!");
+            return false;
+        }
+
+        const resources::GeometryLod lod {
+            cookedLod.firstIndex, // firstIndex
+            cookedLod.indexCount, // indexCount
+            cookedLod.error       // error
+        };
+
+        lods.at(i) = lod;
+    }
+
+    // The file is read in place, the runtime vertex has no normal and the shared index buffer is 32 bit wide.
+    vertices.resize(header.vertexCount);
+    unpackCookedVertices(header, file->data + header.vertexOffset, vertices.data());
+
+    indices.resize(header.indexCount);
+    const std::byte* indexData { file->data + header.indexOffset };
+
+    for (uint32_t i { 0u }; i < header.indexCount; i++) {
+        if (header.indexSize == 2u) {
+            uint16_t index;
+            std::memcpy(&index, indexData + sizeof(index) * i, sizeof(index));
+            indices.at(i) = index;
+        } else {
+            std::memcpy(&indices.at(i), indexData + sizeof(uint32_t) * i, sizeof(uint32_t));
+        }
+
+        if (indices.at(i) >= header.vertexCount) {
+            core::Logger::error("Geometry::loadCookedMesh - cooked mesh " + filePath + " indexes past its vertices!");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+auto Geometry::createDefaultGeometry() -> resources::GeometryHandle {
+    const float f { 10.0f };
+
+    std::vector<math::Vertex3D> vertices(4u);
+
+    vertices.at(0u).position = glm::vec3(-0.5f * f, -0.5f * f, 0.0f);
+    vertices.at(0u).texCoord = glm::vec2(0.0f, 0.0f);
+
+    vertices.at(1u).position = glm::vec3(0.5f * f, 0.5f * f, 0.0f);
+    vertices.at(1u).texCoord = glm::vec2(1.0f, 1.0f);
+
+    vertices.at(2u).position = glm::vec3(-0.5f * f, 0.5f * f, 0.0f);
+    vertices.at(2u).texCoord = glm::vec2(0.0f, 1.0f);
+
+    vertices.at(3u).position = glm::vec3(0.5f * f, -0.5f * f, 0.0f);
+    vertices.at(3u).texCoord = glm::vec2(1.0f, 0.0f);
+
+    const std::vector<uint32_t> indices {
+        0u, 1u, 2u, 0u, 3u, 1u
+    };
+
+    return m_rendererFrontend->createGeometry(vertices, indices, { });
+}
+
+auto Geometry::getCookedPath(const std::string& name) -> std::string {
+    return "meshes/" + name + ".bmesh";
+}
+
+} // namespace systems
+} // namespace beige
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "../Defines.hpp"
+#include "../core/Vfs.hpp"
+#include "../math/MathTypes.hpp"
+#include "../resources/CookedMesh.hpp"
+#include "../resources/GeometryHandle.hpp"
+#include "../resources/GeometryLod.hpp"
+#include "../renderer/RendererFrontend.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace beige {
+namespace systems {
+
+class BEIGE_API Geometry final {
+public:
+    static constexpr std::string_view m_defaultName { "default" };
+
+    Geometry(
+        std::shared_ptr<renderer::Frontend> rendererFrontend,
+        std::shared_ptr<const core::Vfs> vfs
+    );
+    ~Geometry();
+
+    /**
+     * Returns the loaded geometry with the name, or uploads the vertices and indices into the shared buffers.
+     * @returns The handle to the geometry, or an invalid handle if the buffers are full.
+     */
+    auto acquire(
+        const std::string& name,
+        const std::vector<math::Vertex3D>& vertices,
+        const std::vector<uint32_t>& indices,
+        const bool autoRelease
+    ) -> resources::GeometryHandle;
+
+    /**
+     * Returns the loaded geometry with the name, or loads it from the cooked mesh meshes/<name>.bmesh.
+     * @returns The handle to the geometry, or an invalid handle if it could not be loaded.
+     */
+    auto acquire(const std::string& name, const bool autoRelease) -> resources::GeometryHandle;
+
+    /**
+     * Drops a reference, unreferenced auto release geometries give their ranges back to the shared buffers.
+     */
+    auto release(const resources::GeometryHandle handle) -> void;
+    auto getDefaultGeometry() const -> resources::GeometryHandle;
+
+    /**
+     * Dequantizes cooked vertices into the layout of the vertex buffer, the normals are dropped.
+     * @param header The header of the cooked mesh, with the bounds the vertices are quantized within.
+     * @param vertexData The vertices of the cooked mesh, does not have to be aligned.
+     * @param vertices Receives header.vertexCount vertices.
+     */
+    static auto unpackCookedVertices(
+        const resources::CookedMeshHeader& header,
+        const std::byte* vertexData,
+        math::Vertex3D* vertices
+    ) -> void;
+
+private:
+    // Registry data of a geometry, indexed like the slots of the geometry pool.
+    struct Entry {
+        std::string name;
+        uint32_t referenceCount;
+        bool autoRelease;
+    };
+
+    std::shared_ptr<renderer::Frontend> m_rendererFrontend;
+    std::shared_ptr<const core::Vfs> m_vfs;
+
+    std::unordered_map<std::string, resources::GeometryHandle> m_handles;
+    std::vector<Entry> m_entries;
+    resources::GeometryHandle m_defaultGeometry;
+
+    auto findLoaded(const std::string& name) -> resources::GeometryHandle;
+    auto create(
+        const std::string& name,
+        const std::vector<math::Vertex3D>& vertices,
+        const std::vector<uint32_t>& indices,
+        const std::vector<resources::GeometryLod>& lods,
+        const bool autoRelease
+    ) -> resources::GeometryHandle;
+    auto loadCookedMesh(
+        const std::string& name,
+        std::vector<math::Vertex3D>& vertices,
+        std::vector<uint32_t>& indices,
+        std::vector<resources::GeometryLod>& lods
+    ) const -> bool;
+    auto createDefaultGeometry() -> resources::GeometryHandle;
+    static auto getCookedPath(const std::string& name) -> std::string;
+};
+
+} // namespace systems
+} // namespace beige
@@ -1,6 +1,15 @@
 #include "TextureSystem.hpp"
 
 #include "../core/Logger.hpp"
+#include "../core/Memory.hpp"
+#include "../math/Simd.hpp"
+#include "../resources/BlockCompression.hpp"
+#include "../resources/CookedTexture.hpp"
+#include "../resources/TextureUtils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 
 // TODO: Resource loader.
 #define STB_IMAGE_IMPLEMENTATION
@@ -9,97 +18,558 @@
 namespace beige {
 namespace systems {
 
-Texture::Texture(std::shared_ptr<renderer::Frontend> rendererFrontend) :
+Texture::Texture(
+    std::shared_ptr<renderer::Frontend> rendererFrontend,
+    std::shared_ptr<core::JobSystem> jobSystem,
+    std::shared_ptr<const core::Vfs> vfs
+) :
 m_rendererFrontend { rendererFrontend },
-m_defaultTexture { nullptr },
-m_textures { },
-m_textureIds { 0u } {
+m_jobSystem { jobSystem },
+m_vfs { vfs },
+m_texturePool { rendererFrontend->getTexturePool() },
+m_defaultTexture { resources::global_invalidTextureHandle },
+m_nameIds { },
+m_names { },
+m_handles { },
+m_entries { },
+m_textureIds { 0u },
+m_decodedTextures { },
+m_decodedTexturesMutex { },
+m_decodesFinished { },
+m_pendingDecodeCount { 0u },
+m_uploadBudget { m_defaultUploadBudget },
+m_framesInFlight { rendererFrontend->getMaxFramesInFlight() },
+m_uploadedTextures { },
+m_stats { 0u, 0u, 0u, 0u, 0u, m_defaultResidencyBudget, 0u } {
+    core::Logger::debug(std::string("Texture pixel kernels use ") + math::Simd::getLevelName(math::Simd::getLevel()) + ".");
+
     m_defaultTexture = createDefaultTexture();
+    m_rendererFrontend->setDefaultTexture(m_texturePool.getTexture(m_defaultTexture));
 }
 
 Texture::~Texture() {
+    // Decode jobs still running refer to this system.
+    std::unique_lock<std::mutex> lock { m_decodedTexturesMutex };
+    m_decodesFinished.wait(lock, [&]() -> bool { return m_pendingDecodeCount == 0u; });
+    m_decodedTextures.clear();
+
+    core::Logger::info(
+        "Texture residency: " + std::to_string(m_stats.hits) + " hits, " + std::to_string(m_stats.misses) + " misses, " +
+        std::to_string(m_stats.evictions) + " evictions, " + std::to_string(m_stats.trims) + " trims, " +
+        std::to_string(m_stats.residentBytes / (1024u * 1024u)) + " MiB resident."
+    );
+
+    for (const resources::TextureHandle handle : m_handles) {
+        if (m_texturePool.isValid(handle)) {
+            m_rendererFrontend->destroyTexture(handle);
+        }
+    }
 
+    m_rendererFrontend->setDefaultTexture(nullptr);
+    m_rendererFrontend->destroyTexture(m_defaultTexture);
 }
 
-auto Texture::acquire(const std::string& name, const bool autoRelease) -> std::shared_ptr<resources::ITexture> {
-    if (name == m_defaultName) {
-        core::Logger::warn("beige::systems::Texture::acquire() called for default texture, use getDefaultTexture() for it!");
+auto Texture::internName(const std::string& name) -> NameId {
+    const std::unordered_map<std::string, NameId>::const_iterator nameId { m_nameIds.find(name) };
+
+    if (nameId != m_nameIds.end()) {
+        return nameId->second;
+    }
+
+    const NameId newNameId { static_cast<NameId>(m_names.size()) };
+    m_nameIds.emplace(name, newNameId);
+    m_names.push_back(name);
+    m_handles.push_back(resources::global_invalidTextureHandle);
+
+    return newNameId;
+}
+
+auto Texture::acquire(const NameId nameId, const bool autoRelease) -> resources::TextureHandle {
+    const core::MemoryScope memoryScope { core::MemoryTag::Texture };
+
+    if (nameId >= m_names.size()) {
+        core::Logger::warn("beige::systems::Texture::acquire() called with unknown name id " + std::to_string(nameId) + "!");
         return m_defaultTexture;
     }
 
-    std::unordered_map<std::string, Entry>::iterator entry { m_textures.find(name) };
+    const resources::TextureHandle handle { m_handles.at(nameId) };
 
-    if (entry != m_textures.end()) {
-        return entry->second.texture;
+    if (m_texturePool.isValid(handle)) {
+        m_stats.hits++;
+        m_entries.at(handle.index).referenceCount++;
+        return handle;
     } else {
-        std::shared_ptr<resources::ITexture> newTexture { nullptr };
+        m_stats.misses++;
 
-        // Create new texture.
-        if (!loadTexture(name, newTexture)) {
-            core::Logger::fatal("Failed to load texture: " + name + "!");
-            return nullptr;
-        }
+        // Create the texture without data, the renderer draws the default texture in its place until it is uploaded.
+        const std::string& name { m_names.at(nameId) };
+        std::shared_ptr<resources::ITexture> newTexture { m_rendererFrontend->createPendingTexture(name) };
+        m_textureIds++;
+        newTexture->setId(m_textureIds);
+
+        const resources::TextureHandle newHandle { m_texturePool.allocate(newTexture) };
+        m_handles.at(nameId) = newHandle;
 
         // Update the entry.
         const Entry newEntry {
-            newTexture,
-            autoRelease
+            nameId,      // nameId
+            1u,          // referenceCount
+            autoRelease, // autoRelease
+            0u,          // residentBytes
+            0u,          // droppedMipLevels
+            false,       // isCooked
+            false        // isStreaming
         };
 
-        m_textures.emplace(name, newEntry);
-        m_textureIds++;
-        newTexture->setId(m_textureIds);
-        return newTexture;
+        if (newHandle.index >= m_entries.size()) {
+            m_entries.resize(newHandle.index + 1u);
+        }
+        m_entries.at(newHandle.index) = newEntry;
+
+        // Counts as used now, so it doesn't look like the least recently used texture once it is resident.
+        m_texturePool.markUsed(newHandle, m_rendererFrontend->getFrameCount());
+
+        streamTexture(newHandle, 0u, std::nullopt);
+
+        return newHandle;
     }
 }
 
-auto Texture::release(const std::string& name) -> void {
+auto Texture::acquire(const std::string& name, const bool autoRelease) -> resources::TextureHandle {
+    const core::MemoryScope memoryScope { core::MemoryTag::Texture };
+
     if (name == m_defaultName) {
+        core::Logger::warn("beige::systems::Texture::acquire() called for default texture, use getDefaultTexture() for it!");
+        return m_defaultTexture;
+    }
+
+    return acquire(internName(name), autoRelease);
+}
+
+auto Texture::release(const resources::TextureHandle handle) -> void {
+    const core::MemoryScope memoryScope { core::MemoryTag::Texture };
+
+    if (handle == m_defaultTexture) {
         core::Logger::warn("Tried to release default texture!");
         return;
     }
 
-    std::unordered_map<std::string, Entry>::iterator entry { m_textures.find(name) };
+    if (!m_texturePool.isValid(handle)) {
+        core::Logger::warn("Tried to release non-existent texture!");
+        return;
+    }
+
+    Entry& entry { m_entries.at(handle.index) };
+    const std::string& name { m_names.at(entry.nameId) };
 
-    if (entry != m_textures.end()) {
-        const long referenceCount { entry->second.texture.use_count() };
-        if (referenceCount == 1 && entry->second.autoRelease) {
-            m_textures.erase(name);
-            core::Logger::trace("Released texture " + name + ", texture unloaded because reference count is 0 and auto release was enabled!");
-        } else {
-            core::Logger::trace(
-                "Released texture " + name + ", now has a reference count of " + std::to_string(referenceCount) + " (auto release: " + std::to_string(entry->second.autoRelease) + ")!"
-            );
-        }
+    if (entry.referenceCount > 0u) {
+        entry.referenceCount--;
+    }
+
+    if (entry.referenceCount == 0u && entry.autoRelease) {
+        core::Logger::trace("Released texture " + name + ", texture may be evicted because reference count is 0 and auto release was enabled!");
     } else {
-        core::Logger::warn("Tried to release non-existent texture: " + name + "!");
-        return;
+        core::Logger::trace(
+            "Released texture " + name + ", now has a reference count of " + std::to_string(entry.referenceCount) + " (auto release: " + std::to_string(entry.autoRelease) + ")!"
+        );
     }
 }
 
-auto Texture::getDefaultTexture() -> std::shared_ptr<resources::ITexture> {
+auto Texture::getDefaultTexture() -> resources::TextureHandle {
     return m_defaultTexture;
 }
 
-auto Texture::loadTexture(
+auto Texture::preload(const std::vector<std::string>& names) -> PreloadStats {
+    const core::MemoryScope memoryScope { core::MemoryTag::Texture };
+
+    const std::chrono::steady_clock::time_point start { std::chrono::steady_clock::now() };
+
+    // Let the OS read the files in while the decodes are queued, packed ones in a few large reads.
+    std::vector<std::string> paths;
+    for (const std::string& name : names) {
+        paths.push_back(getCookedPath(name));
+    }
+
+    m_vfs->prefetch(paths);
+
+    // Queue every decode first so all workers are busy, the references are dropped right away to leave
+    // the textures cached like released ones.
+    for (const std::string& name : names) {
+        const resources::TextureHandle handle { acquire(name, true) };
+
+        if (handle != m_defaultTexture) {
+            m_entries.at(handle.index).referenceCount--;
+        }
+    }
+
+    PreloadStats preloadStats {
+        0u, // imageCount
+        0u, // byteCount
+        0.0 // seconds
+    };
+
+    // Upload what has been decoded so far while the workers keep decoding the rest.
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock { m_decodedTexturesMutex };
+            m_decodesFinished.wait(lock, [&]() -> bool { return !m_decodedTextures.empty() || m_pendingDecodeCount == 0u; });
+
+            if (m_decodedTextures.empty()) {
+                break;
+            }
+        }
+
+        const std::pair<uint32_t, uint64_t> uploaded { uploadDecodedTextures() };
+        preloadStats.imageCount += uploaded.first;
+        preloadStats.byteCount += uploaded.second;
+    }
+
+    finishUploads(true);
+
+    const std::chrono::duration<double> elapsed { std::chrono::steady_clock::now() - start };
+    preloadStats.seconds = elapsed.count();
+
+    const double seconds { std::max(preloadStats.seconds, 1e-6) };
+    core::Logger::info(
+        "Preloaded " + std::to_string(preloadStats.imageCount) + " textures (" + std::to_string(preloadStats.byteCount / (1024u * 1024u)) + " MiB) in " +
+        std::to_string(preloadStats.seconds * 1000.0) + " ms, " + std::to_string(static_cast<double>(preloadStats.byteCount) / (1024.0 * 1024.0) / seconds) +
+        " MiB/s, " + std::to_string(static_cast<double>(preloadStats.imageCount) / seconds) + " images/s using " +
+        std::to_string(m_jobSystem->getWorkerCount()) + " workers."
+    );
+
+    return preloadStats;
+}
+
+auto Texture::reload(const std::string& name, const bool isSourceChanged) -> void {
+    const core::MemoryScope memoryScope { core::MemoryTag::Texture };
+
+    const auto nameId { m_nameIds.find(name) };
+
+    if (nameId == m_nameIds.end()) {
+        return;
+    }
+
+    // Textures which are not loaded read the new file on their next acquire().
+    const resources::TextureHandle handle { m_handles.at(nameId->second) };
+
+    if (!m_texturePool.isValid(handle) || handle == m_defaultTexture) {
+        return;
+    }
+
+    std::optional<resources::TextureQuality> recookQuality { std::nullopt };
+
+    if (isSourceChanged) {
+        switch (m_texturePool.resolve(handle)->getFormat()) {
+        case resources::TextureFormat::Rgba8:
+            recookQuality = resources::TextureQuality::Lossless;
+            break;
+        case resources::TextureFormat::Bc1:
+        case resources::TextureFormat::Bc3:
+            recookQuality = resources::TextureQuality::Fast;
+            break;
+        case resources::TextureFormat::Bc7:
+            recookQuality = resources::TextureQuality::High;
+            break;
+        }
+    }
+
+    core::Logger::info("Reloading texture " + name + "...");
+
+    // The generation is bumped once the upload batch finished on the device, which rewrites the descriptors using it.
+    streamTexture(handle, isSourceChanged ? 0u : m_entries.at(handle.index).droppedMipLevels, recookQuality);
+}
+
+auto Texture::update() -> void {
+    const core::MemoryScope memoryScope { core::MemoryTag::Texture };
+
+    uploadDecodedTextures();
+    finishUploads(false);
+}
+
+auto Texture::uploadDecodedTextures() -> std::pair<uint32_t, uint64_t> {
+    std::vector<DecodedTexture> batch;
+    uint64_t batchSize { 0u };
+
+    {
+        std::lock_guard<std::mutex> lock { m_decodedTexturesMutex };
+
+        while (!m_decodedTextures.empty()) {
+            const uint64_t size { m_decodedTextures.front().size };
+
+            if (!batch.empty() && batchSize + size > m_uploadBudget) {
+                break;
+            }
+
+            batch.push_back(std::move(m_decodedTextures.front()));
+            m_decodedTextures.pop_front();
+            batchSize += size;
+        }
+    }
+
+    if (batch.empty()) {
+        return { 0u, 0u };
+    }
+
+    std::vector<renderer::TextureUpload> textureUploads;
+    std::vector<const DecodedTexture*> uploadedTextures;
+    textureUploads.reserve(batch.size());
+
+    for (const DecodedTexture& decodedTexture : batch) {
+        // Skip textures evicted while they were being decoded.
+        if (!m_texturePool.isValid(decodedTexture.handle)) {
+            continue;
+        }
+
+        const renderer::TextureUpload textureUpload {
+            m_texturePool.getTexture(decodedTexture.handle), // texture
+            decodedTexture.width,                            // width
+            decodedTexture.height,                           // height
+            decodedTexture.channelCount,                     // channelCount
+            decodedTexture.format,                           // format
+            decodedTexture.pixels,                           // pixels
+            decodedTexture.mipLevelCount,                    // mipLevelCount
+            decodedTexture.hasTransparency                   // hasTransparency
+        };
+
+        textureUploads.push_back(textureUpload);
+        uploadedTextures.push_back(&decodedTexture);
+    }
+
+    const uint64_t uploadBatch { m_rendererFrontend->uploadTextures(textureUploads) };
+
+    for (const DecodedTexture* decodedTexture : uploadedTextures) {
+        const UploadedTexture uploadedTexture {
+            decodedTexture->handle,           // handle
+            decodedTexture->droppedMipLevels, // droppedMipLevels
+            decodedTexture->isCooked,         // isCooked
+            uploadBatch                       // batch
+        };
+
+        m_uploadedTextures.push_back(uploadedTexture);
+    }
+
+    core::Logger::trace(
+        "Uploaded " + std::to_string(textureUploads.size()) + " streamed textures (" + std::to_string(batchSize / 1024u) + " KiB)."
+    );
+
+    return { static_cast<uint32_t>(textureUploads.size()), batchSize };
+}
+
+auto Texture::finishUploads(const bool wait) -> void {
+    if (m_uploadedTextures.empty()) {
+        return;
+    }
+
+    const uint64_t completedBatch { m_rendererFrontend->completeUploads(wait) };
+
+    while (!m_uploadedTextures.empty() && m_uploadedTextures.front().batch <= completedBatch) {
+        const UploadedTexture& uploadedTexture { m_uploadedTextures.front() };
+        resources::ITexture* texture { m_texturePool.resolve(uploadedTexture.handle) };
+
+        // Skip textures evicted while they were being uploaded.
+        if (texture != nullptr) {
+            // Bumping the generation makes the renderer switch to the uploaded image.
+            const resources::TextureGeneration currentGeneration { texture->getGeneration() };
+
+            if (currentGeneration == resources::global_invalidTextureGeneration) {
+                texture->setGeneration(0u);
+            }
+            else {
+                texture->setGeneration(currentGeneration + 1u);
+            }
+
+            Entry& entry { m_entries.at(uploadedTexture.handle.index) };
+            entry.residentBytes = getResidentBytes(*texture);
+            entry.droppedMipLevels = uploadedTexture.droppedMipLevels;
+            entry.isCooked = uploadedTexture.isCooked;
+            entry.isStreaming = false;
+        }
+
+        m_uploadedTextures.pop_front();
+    }
+
+    enforceResidencyBudget();
+}
+
+auto Texture::setUploadBudget(const uint64_t uploadBudget) -> void {
+    m_uploadBudget = uploadBudget;
+}
+
+auto Texture::setResidencyBudget(const uint64_t residencyBudget) -> void {
+    m_stats.residencyBudget = residencyBudget;
+}
+
+auto Texture::getStats() const -> const Stats& {
+    return m_stats;
+}
+
+auto Texture::streamTexture(
+    const resources::TextureHandle handle,
+    const uint32_t droppedMipLevels,
+    const std::optional<resources::TextureQuality> recookQuality
+) -> void {
+    m_entries.at(handle.index).isStreaming = true;
+
+    {
+        std::lock_guard<std::mutex> lock { m_decodedTexturesMutex };
+        m_pendingDecodeCount++;
+    }
+
+    // The job gets its own copy of the name, interned names may move while it runs.
+    m_jobSystem->submit(
+        [this, textureName = m_names.at(m_entries.at(handle.index).nameId), handle, droppedMipLevels, recookQuality]() -> void {
+            decodeTexture(textureName, handle, droppedMipLevels, recookQuality);
+        }
+    );
+}
+
+auto Texture::decodeTexture(
     const std::string& textureName,
-    std::shared_ptr<resources::ITexture>& texture
-) -> bool {
+    const resources::TextureHandle handle,
+    const uint32_t droppedMipLevels,
+    const std::optional<resources::TextureQuality> recookQuality
+) -> void {
+    // Runs on the workers, which have no scope of their own.
+    const core::MemoryScope memoryScope { core::MemoryTag::Texture };
+
+    std::optional<DecodedTexture> decodedTexture { std::nullopt };
+
+    if (recookQuality.has_value()) {
+        decodedTexture = recookSourceTexture(textureName, recookQuality.value());
+    } else {
+        // Prefer the cooked container, it needs no decoding, flipping, transparency scan or mip generation.
+        decodedTexture = decodeCookedTexture(textureName, droppedMipLevels);
+
+        if (!decodedTexture.has_value()) {
+            decodedTexture = decodeSourceTexture(textureName);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock { m_decodedTexturesMutex };
+
+    if (decodedTexture.has_value()) {
+        decodedTexture->handle = handle;
+        m_decodedTextures.push_back(std::move(decodedTexture.value()));
+    } else {
+        core::Logger::error("Failed to load texture: " + textureName + ", the default texture is used instead!");
+    }
+
+    m_pendingDecodeCount--;
+    m_decodesFinished.notify_all();
+}
+
+auto Texture::decodeCookedTexture(
+    const std::string& textureName,
+    const uint32_t droppedMipLevels
+) -> std::optional<DecodedTexture> {
+    const std::string filePath { getCookedPath(textureName) };
+    const std::optional<core::Vfs::File> file { m_vfs->read(filePath) };
+
+    if (!file.has_value()) {
+        return std::nullopt;
+    }
+
+    if (file->size < sizeof(resources::CookedTextureHeader)) {
+        core::Logger::warn("Cooked texture " + filePath + " is truncated, falling back to the source image!");
+        return std::nullopt;
+    }
+
+    resources::CookedTextureHeader header;
+    std::memcpy(&header, file->data, sizeof(header));
+
+    // The file may be truncated or half written while the cooker rewrites it, so every range is checked against
+    // the size of the file without adding up values which could overflow.
+    if (
+        header.magic != resources::global_cookedTextureMagic ||
+        header.version != resources::global_cookedTextureVersion ||
+        header.format > resources::TextureFormat::Bc7 ||
+        header.width == 0u ||
+        header.height == 0u ||
+        header.mipLevelCount == 0u ||
+        header.mipLevelCount > resources::TextureUtils::getMipLevelCount(header.width, header.height) ||
+        header.dataOffset < sizeof(header) + sizeof(resources::CookedTextureMip) * header.mipLevelCount ||
+        header.dataOffset > file->size ||
+        header.dataSize > file->size - header.dataOffset
+    ) {
+        core::Logger::warn("Cooked texture " + filePath + " is invalid or outdated, falling back to the source image!");
+        return std::nullopt;
+    }
+
+    // Levels are uploaded as one tightly packed range, so each has to follow the previous one with the size its
+    // dimensions and format imply.
+    const uint64_t dataEnd { header.dataOffset + header.dataSize };
+    uint64_t expectedOffset { header.dataOffset };
+
+    for (uint32_t i { 0u }; i < header.mipLevelCount; i++) {
+        resources::CookedTextureMip mip;
+        std::memcpy(&mip, file->data + sizeof(header) + sizeof(mip) * i, sizeof(mip));
+
+        if (
+            mip.offset != expectedOffset ||
+            mip.size != resources::TextureUtils::getMipLevelSize(header.format, header.width, header.height, i) ||
+            mip.size > dataEnd - mip.offset
+        ) {
+            core::Logger::warn("Cooked texture " + filePath + " has an invalid mip table, falling back to the source image!");
+            return std::nullopt;
+        }
+
+        expectedOffset += mip.size;
+    }
+
+    if (!m_rendererFrontend->supportsTextureFormat(header.format)) {
+        core::Logger::warn("Format of cooked texture " + filePath + " is not supported by the device, falling back to the source image!");
+        return std::nullopt;
+    }
+
+    // Dropping levels starts the upload at a smaller level, the 1x1 level is always kept.
+    const uint32_t firstMipLevel { std::min(droppedMipLevels, header.mipLevelCount - 1u) };
+
+    resources::CookedTextureMip firstMip;
+    std::memcpy(&firstMip, file->data + sizeof(header) + sizeof(firstMip) * firstMipLevel, sizeof(firstMip));
+
+    // The payload is uploaded straight from the file, it is copied into staging memory once.
+    const DecodedTexture decodedTexture {
+        resources::global_invalidTextureHandle,                             // handle
+        file->storage,                                                      // storage
+        file->data + firstMip.offset,                                       // pixels
+        header.dataOffset + header.dataSize - firstMip.offset,              // size
+        static_cast<int32_t>(std::max(header.width >> firstMipLevel, 1u)),  // width
+        static_cast<int32_t>(std::max(header.height >> firstMipLevel, 1u)), // height
+        static_cast<int32_t>(header.channelCount),                          // channelCount
+        header.format,                                                      // format
+        header.mipLevelCount - firstMipLevel,                               // mipLevelCount
+        header.hasTransparency != 0u,                                       // hasTransparency
+        firstMipLevel,                                                      // droppedMipLevels
+        true                                                                // isCooked
+    };
+
+    return decodedTexture;
+}
+
+auto Texture::decodeSourceTexture(const std::string& textureName) -> std::optional<DecodedTexture> {
     // TODO: Should be able to be located anywhere.
     const int32_t requiredChannelCount { 4 };
 
-    stbi_set_flip_vertically_on_load(true);
+    // Decoding runs on several workers at once, so only flip for this thread.
+    stbi_set_flip_vertically_on_load_thread(true);
 
     // TODO: Try different extensions.
-    const std::string filePath { "assets/textures/" + textureName + ".png" };
+    const std::string filePath { "textures/" + textureName + ".png" };
+    const std::optional<core::Vfs::File> file { m_vfs->read(filePath) };
+
+    if (!file.has_value()) {
+        core::Logger::warn("Loading texture failed to find file " + filePath + "!");
+        return std::nullopt;
+    }
 
     int32_t width { 0 };
     int32_t height { 0 };
     int32_t channelCount { 0 };
 
     stbi_uc* data {
-        stbi_load(
-            filePath.c_str(),
+        stbi_load_from_memory(
+            reinterpret_cast<const stbi_uc*>(file->data),
+            static_cast<int32_t>(file->size),
             &width,
             &height,
             &channelCount,
@@ -107,108 +577,239 @@ auto Texture::loadTexture(
         )
     };
 
-    if (data != nullptr) {
-
-        const resources::TextureGeneration currentGeneration {
-            texture != nullptr ? texture->getGeneration() : resources::global_invalidTextureGeneration
-        };
-
-        const uint64_t totalSize {
-            static_cast<uint64_t>(width * height * requiredChannelCount)
-        };
-
-        // Check for transparency.
-        bool hasTransparency { false };
-        for (uint64_t i{ 0u }; i < totalSize; i += requiredChannelCount) {
-            stbi_uc a{ data[i + 3u] };
-            if (a < 0xFFu) {
-                hasTransparency = true;
-                break;
-            }
-        }
-
+    if (data == nullptr) {
         if (stbi_failure_reason() != nullptr) {
-            const std::string message{ "Loading texture failed to load file " + filePath + ": " + stbi_failure_reason() + "!" };
+            const std::string message { "Loading texture failed to load file " + filePath + ": " + stbi_failure_reason() + "!" };
             core::Logger::warn(message);
         }
 
-        // Acquire internal texture resources and upload to GPU.
-        std::shared_ptr<resources::ITexture> temporaryTexture {
-            m_rendererFrontend->createTexture(
-                textureName,
-                width,
-                height,
-                requiredChannelCount,
-                data,
-                hasTransparency
-            )
-        };
+        return std::nullopt;
+    }
 
-        // Destroy the old texture.
-        texture.reset();
+    const uint64_t totalSize {
+        static_cast<uint64_t>(width * height * requiredChannelCount)
+    };
 
-        // Assign the temporary texture to the pointer.
-        texture = temporaryTexture;
+    // Check for transparency.
+    const bool hasTransparency { math::Simd::hasTransparency(data, static_cast<uint64_t>(width) * static_cast<uint64_t>(height)) };
+
+    // The image is freed once the upload is done.
+    const DecodedTexture decodedTexture {
+        resources::global_invalidTextureHandle,             // handle
+        std::shared_ptr<const void>(data, stbi_image_free), // storage
+        data,                                               // pixels
+        totalSize,                                          // size
+        width,                                              // width
+        height,                                             // height
+        requiredChannelCount,                               // channelCount
+        resources::TextureFormat::Rgba8,                    // format
+        1u,                                                 // mipLevelCount
+        hasTransparency,                                    // hasTransparency
+        0u,                                                 // droppedMipLevels
+        false                                               // isCooked
+    };
 
-        if (currentGeneration == resources::global_invalidTextureGeneration) {
-            texture->setGeneration(0u);
-        }
-        else {
-            texture->setGeneration(currentGeneration + 1u);
-        }
+    return decodedTexture;
+}
 
-        // Clean up data.
-        stbi_image_free(data);
+auto Texture::recookSourceTexture(
+    const std::string& textureName,
+    const resources::TextureQuality quality
+) -> std::optional<DecodedTexture> {
+    const std::optional<DecodedTexture> sourceTexture { decodeSourceTexture(textureName) };
 
-        return true;
+    if (!sourceTexture.has_value()) {
+        return std::nullopt;
     }
-    else {
-        if (stbi_failure_reason() != nullptr) {
-            const std::string message { "Loading texture failed to load file " + filePath + ": " + stbi_failure_reason() + "!" };
-            core::Logger::warn(message);
-        }
 
-        return false;
+    const resources::TextureFormat format { resources::BlockCompression::selectFormat(sourceTexture->hasTransparency, quality) };
+
+    // Uncompressed textures get their levels generated at upload, like any source image.
+    if (format == resources::TextureFormat::Rgba8 || !m_rendererFrontend->supportsTextureFormat(format)) {
+        return sourceTexture;
     }
+
+    const uint32_t width { static_cast<uint32_t>(sourceTexture->width) };
+    const uint32_t height { static_cast<uint32_t>(sourceTexture->height) };
+    const uint32_t channelCount { static_cast<uint32_t>(sourceTexture->channelCount) };
+    const uint32_t mipLevelCount { resources::TextureUtils::getMipLevelCount(width, height) };
+
+    const std::vector<std::byte> mipChain {
+        resources::TextureUtils::generateMipChain(sourceTexture->pixels, width, height, channelCount, mipLevelCount)
+    };
+
+    // Same steps as the texture cooker, on this worker only so other decodes keep going.
+    const std::shared_ptr<std::vector<std::byte>> encodedMipChain { std::make_shared<std::vector<std::byte>>() };
+    uint64_t sourceOffset { 0u };
+
+    for (uint32_t i { 0u }; i < mipLevelCount; i++) {
+        const std::vector<std::byte> level {
+            resources::BlockCompression::encode(
+                format,
+                mipChain.data() + sourceOffset,
+                std::max(width >> i, 1u),
+                std::max(height >> i, 1u),
+                1u
+            )
+        };
+
+        encodedMipChain->insert(encodedMipChain->end(), level.begin(), level.end());
+        sourceOffset += resources::TextureUtils::getMipLevelSize(width, height, channelCount, i);
+    }
+
+    // Not marked as cooked, trimming would stream the stale cooked file back in.
+    const DecodedTexture decodedTexture {
+        resources::global_invalidTextureHandle,         // handle
+        encodedMipChain,                                // storage
+        encodedMipChain->data(),                        // pixels
+        static_cast<uint64_t>(encodedMipChain->size()), // size
+        sourceTexture->width,                           // width
+        sourceTexture->height,                          // height
+        sourceTexture->channelCount,                    // channelCount
+        format,                                         // format
+        mipLevelCount,                                  // mipLevelCount
+        sourceTexture->hasTransparency,                 // hasTransparency
+        0u,                                             // droppedMipLevels
+        false                                           // isCooked
+    };
+
+    return decodedTexture;
 }
 
-auto Texture::createDefaultTexture() -> std::shared_ptr<resources::ITexture> {
+auto Texture::createDefaultTexture() -> resources::TextureHandle {
     // NOTE: Create default texture, a 256x256 blue/white checkerboard pattern.
     // This is done in code to eliminate asset dependecies.
     core::Logger::trace("Creating default texture...");
     const uint32_t textureDimension { 256u };
     const uint32_t channels { 4u };
-    const uint32_t pixelCount { textureDimension * textureDimension };
-    std::vector<std::byte> pixels { pixelCount * channels, std::byte(0xFF) };
-
-    // Each pixel.
-    for (uint32_t row { 0u }; row < textureDimension; row++) {
-        for (uint32_t col { 0u }; col < textureDimension; col++) {
-            const uint32_t index { row * textureDimension + col };
-            const uint32_t indexChannel { index * channels };
-            if (row % 2u) {
-                if (col % 2u) {
-                    pixels.at(indexChannel + 0u) = std::byte(0x00);
-                    pixels.at(indexChannel + 1u) = std::byte(0x00);
-                }
+    const std::vector<std::byte> pixels { resources::TextureUtils::generateCheckerboard(textureDimension) };
+
+    return m_texturePool.allocate(
+        m_rendererFrontend->createTexture(
+            m_defaultName.data(),
+            static_cast<int32_t>(textureDimension),
+            static_cast<int32_t>(textureDimension),
+            static_cast<int32_t>(channels),
+            resources::TextureFormat::Rgba8,
+            pixels.data(),
+            1u,
+            false
+        )
+    );
+}
+
+auto Texture::enforceResidencyBudget() -> void {
+    const uint64_t currentFrame { m_rendererFrontend->getFrameCount() };
+
+    m_stats.residentBytes = 0u;
+    m_stats.residentCount = 0u;
+    for (const resources::TextureHandle handle : m_handles) {
+        if (m_texturePool.isValid(handle)) {
+            m_stats.residentBytes += m_entries.at(handle.index).residentBytes;
+            m_stats.residentCount++;
+        }
+    }
+
+    if (m_stats.residentBytes <= m_stats.residencyBudget) {
+        // There is room again, bring back the full resolution of trimmed textures that are being drawn.
+        for (const resources::TextureHandle handle : m_handles) {
+            if (!m_texturePool.isValid(handle)) {
+                continue;
             }
-            else {
-                if (!(col % 2u)) {
-                    pixels.at(indexChannel + 0u) = std::byte(0x00);
-                    pixels.at(indexChannel + 1u) = std::byte(0x00);
-                }
+
+            const Entry& entry { m_entries.at(handle.index) };
+            const uint64_t restoredBytes { entry.residentBytes << (2u * entry.droppedMipLevels) };
+
+            if (
+                entry.droppedMipLevels > 0u &&
+                !entry.isStreaming &&
+                m_texturePool.getLastUsedFrame(handle) + m_framesInFlight >= currentFrame &&
+                m_stats.residentBytes - entry.residentBytes + restoredBytes <= m_stats.residencyBudget
+            ) {
+                m_stats.residentBytes += restoredBytes - entry.residentBytes;
+                streamTexture(handle, 0u, std::nullopt);
             }
         }
+
+        return;
     }
 
-    return m_rendererFrontend->createTexture(
-        m_defaultName.data(),
-        static_cast<int32_t>(textureDimension),
-        static_cast<int32_t>(textureDimension),
-        static_cast<int32_t>(channels),
-        pixels.data(),
-        false
+    // Textures drawn by frames still in flight can't be touched, the rest is visited least recently used first.
+    std::vector<std::pair<uint64_t, resources::TextureHandle>> candidates;
+    for (const resources::TextureHandle handle : m_handles) {
+        const uint64_t lastUsedFrame { m_texturePool.getLastUsedFrame(handle) };
+
+        if (
+            m_texturePool.isValid(handle) &&
+            !m_entries.at(handle.index).isStreaming &&
+            lastUsedFrame + m_framesInFlight < currentFrame
+        ) {
+            candidates.emplace_back(lastUsedFrame, handle);
+        }
+    }
+
+    std::sort(
+        candidates.begin(),
+        candidates.end(),
+        [](const std::pair<uint64_t, resources::TextureHandle>& lhs, const std::pair<uint64_t, resources::TextureHandle>& rhs) -> bool {
+            return lhs.first < rhs.first;
+        }
     );
+
+    for (const std::pair<uint64_t, resources::TextureHandle>& candidate : candidates) {
+        if (m_stats.residentBytes <= m_stats.residencyBudget) {
+            break;
+        }
+
+        const resources::TextureHandle handle { candidate.second };
+        Entry& entry { m_entries.at(handle.index) };
+        const resources::ITexture* texture { m_texturePool.resolve(handle) };
+        const std::string& name { m_names.at(entry.nameId) };
+
+        if (entry.autoRelease && entry.referenceCount == 0u) {
+            // Nobody holds the texture anymore, unload it. Acquiring it again streams it back in.
+            m_stats.residentBytes -= entry.residentBytes;
+            m_stats.residentCount--;
+            m_stats.evictions++;
+            core::Logger::trace("Evicted texture " + name + " to stay within the residency budget.");
+            evictTexture(handle);
+        } else if (
+            entry.isCooked &&
+            std::max(texture->getWidth(), texture->getHeight()) > m_minimumTrimmedSize
+        ) {
+            // Still referenced, drop the top level instead. That frees about three quarters of its memory.
+            const uint64_t trimmedBytes { entry.residentBytes / 4u };
+            m_stats.residentBytes -= entry.residentBytes - trimmedBytes;
+            m_stats.trims++;
+            core::Logger::trace("Dropping top mip level of texture " + name + " to stay within the residency budget.");
+            streamTexture(handle, entry.droppedMipLevels + 1u, std::nullopt);
+        }
+    }
+}
+
+auto Texture::evictTexture(const resources::TextureHandle handle) -> void {
+    // Frames in flight may still draw the texture, its image is released once they are done.
+    m_handles.at(m_entries.at(handle.index).nameId) = resources::global_invalidTextureHandle;
+    m_rendererFrontend->destroyTexture(handle);
+}
+
+auto Texture::getResidentBytes(const resources::ITexture& texture) -> uint64_t {
+    uint64_t residentBytes { 0u };
+
+    for (uint32_t i { 0u }; i < texture.getMipLevels(); i++) {
+        residentBytes += resources::TextureUtils::getMipLevelSize(
+            texture.getFormat(),
+            static_cast<uint32_t>(texture.getWidth()),
+            static_cast<uint32_t>(texture.getHeight()),
+            i
+        );
+    }
+
+    return residentBytes;
+}
+
+auto Texture::getCookedPath(const std::string& textureName) -> std::string {
+    return "textures/" + textureName + ".btex";
 }
 
 } // namespace systems
@@ -1,46 +1,211 @@
 #pragma once
 
+#include "../Defines.hpp"
 #include "../resources/ITexture.hpp"
+#include "../resources/TextureHandle.hpp"
 #include "../renderer/RendererFrontend.hpp"
+#include "../core/JobSystem.hpp"
+#include "../core/Vfs.hpp"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <unordered_map>
+#include <utility>
 
 namespace beige {
 namespace systems {
 
-class Texture final {
+class BEIGE_API Texture final {
 public:
     static constexpr std::string_view m_defaultName { "default" };
+    static constexpr uint64_t m_defaultUploadBudget { 16u * 1024u * 1024u };
+    static constexpr uint64_t m_defaultResidencyBudget { 256u * 1024u * 1024u };
 
-    Texture(std::shared_ptr<renderer::Frontend> rendererFrontend);
+    // Dropping top mip levels stops once the base level is this small.
+    static constexpr int32_t m_minimumTrimmedSize { 64 };
+
+    // Names are interned once, lookups after that index arrays instead of hashing strings.
+    using NameId = uint32_t;
+
+    struct Stats {
+        uint64_t hits;          // acquire() calls served from the registry.
+        uint64_t misses;        // acquire() calls which had to stream the texture in.
+        uint64_t evictions;     // Textures unloaded to stay within the budget.
+        uint64_t trims;         // Top mip levels dropped to stay within the budget.
+        uint64_t residentBytes; // Device memory of every texture in the registry.
+        uint64_t residencyBudget;
+        uint32_t residentCount;
+    };
+
+    struct PreloadStats {
+        uint32_t imageCount;
+        uint64_t byteCount; // Decoded data uploaded to the device.
+        double seconds;
+    };
+
+    Texture(
+        std::shared_ptr<renderer::Frontend> rendererFrontend,
+        std::shared_ptr<core::JobSystem> jobSystem,
+        std::shared_ptr<const core::Vfs> vfs
+    );
     ~Texture();
 
-    auto acquire(const std::string& name, const bool autoRelease) -> std::shared_ptr<resources::ITexture>;
-    auto release(const std::string& name) -> void;
-    auto getDefaultTexture() -> std::shared_ptr<resources::ITexture>;
+    /**
+     * @returns The id of the name, the same name always maps to the same id.
+     */
+    auto internName(const std::string& name) -> NameId;
+
+    /**
+     * Returns a handle to the texture right away. A texture acquired for the first time is decoded on a worker
+     * thread and drawn with the default texture until update() has uploaded it.
+     */
+    auto acquire(const NameId nameId, const bool autoRelease) -> resources::TextureHandle;
+    auto acquire(const std::string& name, const bool autoRelease) -> resources::TextureHandle;
+
+    /**
+     * Drops a reference. Unreferenced auto release textures stay cached, they are evicted once the residency
+     * budget is exceeded, least recently used first. Handles to an evicted texture resolve to nothing.
+     */
+    auto release(const resources::TextureHandle handle) -> void;
+    auto getDefaultTexture() -> resources::TextureHandle;
+
+    /**
+     * Decodes the textures on the worker threads and uploads them as they finish, blocking until all are
+     * resident. Meant for level loads, the textures stay cached until evicted so acquire() finds them.
+     * @param names The names of the textures to load.
+     * @returns The number of textures and bytes uploaded and the time it took.
+     */
+    auto preload(const std::vector<std::string>& names) -> PreloadStats;
+
+    /**
+     * Streams a loaded texture in again after one of its files changed. The old image is drawn until the device
+     * finished uploading the new one, nothing waits for the device unless an upload of the texture is still pending.
+     * A changed source image is cooked again on the worker to the kind of format the texture had, the cooked
+     * file on disk is stale until the next build.
+     * @param name The name of the texture, textures which are not loaded are left alone.
+     * @param isSourceChanged Indicates if the source image changed rather than the cooked file.
+     */
+    auto reload(const std::string& name, const bool isSourceChanged) -> void;
+
+    /**
+     * Uploads decoded textures in one batch, called once per frame. At most the upload budget worth of pixel data
+     * is uploaded per call, but always at least one texture so large ones still make progress. Textures are drawn
+     * once the device finished their batch, which a later call picks up without waiting.
+     */
+    auto update() -> void;
+    auto setUploadBudget(const uint64_t uploadBudget) -> void;
+    auto setResidencyBudget(const uint64_t residencyBudget) -> void;
+    auto getStats() const -> const Stats&;
 
 private:
+    // Registry data of a texture, indexed like the slots of the texture pool.
     struct Entry {
-        std::shared_ptr<resources::ITexture> texture;
+        NameId nameId;
+        uint32_t referenceCount;
         bool autoRelease;
+        uint64_t residentBytes;
+        uint32_t droppedMipLevels; // Top levels left out of the uploaded chain.
+        bool isCooked;             // Only cooked textures carry the levels needed to drop or restore mips.
+        bool isStreaming;          // A decode or upload is in flight.
+    };
+
+    // CPU side result of a decode job, waiting for upload.
+    struct DecodedTexture {
+        resources::TextureHandle handle;
+        std::shared_ptr<const void> storage; // Keeps pixels alive, either a decoded image or a file mapping.
+        const void* pixels;
+        uint64_t size;
+        int32_t width;
+        int32_t height;
+        int32_t channelCount;
+        resources::TextureFormat format;
+        uint32_t mipLevelCount;
+        bool hasTransparency;
+        uint32_t droppedMipLevels;
+        bool isCooked;
+    };
+
+    // A texture whose upload the device may still be working on, it keeps its generation until the batch is done.
+    struct UploadedTexture {
+        resources::TextureHandle handle;
+        uint32_t droppedMipLevels;
+        bool isCooked;
+        uint64_t batch;
     };
 
     std::shared_ptr<renderer::Frontend> m_rendererFrontend;
+    std::shared_ptr<core::JobSystem> m_jobSystem;
+    std::shared_ptr<const core::Vfs> m_vfs;
 
-    std::shared_ptr<resources::ITexture> m_defaultTexture;
+    resources::TexturePool& m_texturePool;
+    resources::TextureHandle m_defaultTexture;
 
-    // Hashtable for texture lookup.
-    std::unordered_map<std::string, Entry> m_textures;
+    // Only hashed when interning, name ids index the other arrays.
+    std::unordered_map<std::string, NameId> m_nameIds;
+    std::vector<std::string> m_names;
+    std::vector<resources::TextureHandle> m_handles; // Invalid while the texture is not loaded.
+
+    std::vector<Entry> m_entries;
     uint64_t m_textureIds;
 
-    auto loadTexture(
+    // Filled by workers, drained by update() on the main thread.
+    std::deque<DecodedTexture> m_decodedTextures;
+    std::mutex m_decodedTexturesMutex;
+    std::condition_variable m_decodesFinished;
+    uint32_t m_pendingDecodeCount;
+    uint64_t m_uploadBudget;
+
+    // Frames the device may still be working on after a texture was last drawn, such textures are never evicted.
+    uint64_t m_framesInFlight;
+
+    // Submitted oldest first, so finished ones are taken from the front.
+    std::deque<UploadedTexture> m_uploadedTextures;
+
+    Stats m_stats;
+
+    // Without a recook quality the cooked file is preferred over the source image.
+    auto streamTexture(
+        const resources::TextureHandle handle,
+        const uint32_t droppedMipLevels,
+        const std::optional<resources::TextureQuality> recookQuality
+    ) -> void;
+    auto decodeTexture(
+        const std::string& textureName,
+        const resources::TextureHandle handle,
+        const uint32_t droppedMipLevels,
+        const std::optional<resources::TextureQuality> recookQuality
+    ) -> void;
+    auto decodeCookedTexture(
         const std::string& textureName,
-        std::shared_ptr<resources::ITexture>& texture
-    ) -> bool;
-    auto createDefaultTexture() -> std::shared_ptr<resources::ITexture>;
+        const uint32_t droppedMipLevels
+    ) -> std::optional<DecodedTexture>;
+    auto decodeSourceTexture(const std::string& textureName) -> std::optional<DecodedTexture>;
+    auto recookSourceTexture(
+        const std::string& textureName,
+        const resources::TextureQuality quality
+    ) -> std::optional<DecodedTexture>;
+    auto createDefaultTexture() -> resources::TextureHandle;
+
+    /**
+     * Uploads decoded textures, at most the upload budget worth but always at least one texture.
+     * @returns The number of textures and bytes uploaded.
+     */
+    auto uploadDecodedTextures() -> std::pair<uint32_t, uint64_t>;
+
+    /**
+     * Bumps the generation of the textures whose upload batch finished, which makes the renderer draw them.
+     * @param wait Blocks until every submitted upload is finished.
+     */
+    auto finishUploads(const bool wait) -> void;
+    auto enforceResidencyBudget() -> void;
+    auto evictTexture(const resources::TextureHandle handle) -> void;
+    static auto getResidentBytes(const resources::ITexture& texture) -> uint64_t;
+    static auto getCookedPath(const std::string& textureName) -> std::string;
 };
 
 } // namespace systems
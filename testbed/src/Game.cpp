@@ -7,8 +7,7 @@
 #include <iostream>
 
 #include <glm/glm.hpp>
-#include <glm/ext/matrix_clip_space.hpp>
-#include <glm/ext/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/euler_angles.hpp>
 
 Game::Game() :
@@ -123,7 +122,9 @@ auto Game::recalculateView() -> void {
         m_state.cameraRight = glm::normalize(glm::cross(m_state.cameraLook, glm::vec3(0.0f, 1.0f, 0.0f)));
         m_state.cameraUp = glm::normalize(glm::cross(m_state.cameraRight, m_state.cameraLook));
 
-        m_state.view = glm::lookAt(m_state.cameraPosition, m_state.cameraPosition + m_state.cameraLook, glm::vec3(0.0f, 1.0f, 0.0f));
+        beige::scene::Camera* camera { m_world->get<beige::scene::Camera>(m_camera) };
+        camera->setPosition(m_state.cameraPosition);
+        camera->setRotation(glm::quatLookAt(m_state.cameraLook, glm::vec3(0.0f, 1.0f, 0.0f)));
 
         m_state.cameraViewDirty = false;
     }
@@ -0,0 +1,175 @@
+#include "math/Simd.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace beige::math;
+
+// Sizes around the vector widths, so the kernels run their tails on their own and after full iterations.
+constexpr uint32_t global_pixelCounts[] { 0u, 1u, 3u, 4u, 7u, 8u, 15u, 16u, 17u, 31u, 33u, 64u, 1000u };
+constexpr uint32_t global_dimensions[] { 1u, 2u, 3u, 5u, 8u, 9u, 16u, 17u, 33u, 64u };
+
+auto makeRandomBytes(const uint64_t count, const uint32_t seed) -> std::vector<uint8_t> {
+    std::mt19937 engine { seed };
+    std::uniform_int_distribution<uint32_t> distribution { 0u, 255u };
+    std::vector<uint8_t> bytes(count);
+
+    for (uint8_t& byte : bytes) {
+        byte = static_cast<uint8_t>(distribution(engine));
+    }
+
+    return bytes;
+}
+
+// Runs the test once per level the CPU supports and restores the widest one afterwards.
+class SimdTest : public ::testing::Test {
+protected:
+    auto TearDown() -> void override {
+        Simd::setLevel(Simd::getSupportedLevel());
+    }
+
+    static auto getLevels() -> std::vector<Simd::Level> {
+        std::vector<Simd::Level> levels;
+
+        for (uint32_t level { 0u }; level <= static_cast<uint32_t>(Simd::getSupportedLevel()); level++) {
+            levels.push_back(static_cast<Simd::Level>(level));
+        }
+
+        return levels;
+    }
+};
+
+TEST_F(SimdTest, SetLevelClampsToSupportedLevel) {
+    Simd::setLevel(Simd::Level::Avx2);
+    EXPECT_EQ(Simd::getLevel(), Simd::getSupportedLevel());
+
+    Simd::setLevel(Simd::Level::Scalar);
+    EXPECT_EQ(Simd::getLevel(), Simd::Level::Scalar);
+}
+
+TEST_F(SimdTest, HasTransparencyMatchesScalar) {
+    for (const uint32_t pixelCount : global_pixelCounts) {
+        std::vector<uint8_t> pixels { makeRandomBytes(pixelCount * 4ull, pixelCount) };
+
+        for (uint32_t i { 0u }; i < pixelCount; i++) {
+            pixels[i * 4u + 3u] = 255u;
+        }
+
+        for (const Simd::Level level : getLevels()) {
+            Simd::setLevel(level);
+            EXPECT_FALSE(Simd::hasTransparency(pixels.data(), pixelCount)) << Simd::getLevelName(level) << ", " << pixelCount << " pixels";
+        }
+
+        // A single transparent pixel anywhere, including the tail, has to be found.
+        for (uint32_t transparentPixel { 0u }; transparentPixel < pixelCount; transparentPixel++) {
+            pixels[transparentPixel * 4u + 3u] = 254u;
+
+            for (const Simd::Level level : getLevels()) {
+                Simd::setLevel(level);
+                EXPECT_TRUE(Simd::hasTransparency(pixels.data(), pixelCount))
+                    << Simd::getLevelName(level) << ", " << pixelCount << " pixels, pixel " << transparentPixel;
+            }
+
+            pixels[transparentPixel * 4u + 3u] = 255u;
+        }
+    }
+}
+
+TEST_F(SimdTest, ExpandRgbToRgbaMatchesScalar) {
+    for (const uint32_t pixelCount : global_pixelCounts) {
+        const std::vector<uint8_t> source { makeRandomBytes(pixelCount * 3ull, pixelCount) };
+
+        Simd::setLevel(Simd::Level::Scalar);
+        std::vector<uint8_t> expected(pixelCount * 4ull);
+        Simd::expandRgbToRgba(source.data(), expected.data(), pixelCount);
+
+        for (uint32_t i { 0u }; i < pixelCount; i++) {
+            ASSERT_EQ(expected[i * 4u + 0u], source[i * 3u + 0u]);
+            ASSERT_EQ(expected[i * 4u + 1u], source[i * 3u + 1u]);
+            ASSERT_EQ(expected[i * 4u + 2u], source[i * 3u + 2u]);
+            ASSERT_EQ(expected[i * 4u + 3u], 255u);
+        }
+
+        for (const Simd::Level level : getLevels()) {
+            Simd::setLevel(level);
+            std::vector<uint8_t> destination(pixelCount * 4ull);
+            Simd::expandRgbToRgba(source.data(), destination.data(), pixelCount);
+
+            EXPECT_EQ(destination, expected) << Simd::getLevelName(level) << ", " << pixelCount << " pixels";
+        }
+    }
+}
+
+TEST_F(SimdTest, FlipVerticallyMatchesScalar) {
+    for (const uint32_t rowSize : global_pixelCounts) {
+        for (const uint32_t rowCount : global_dimensions) {
+            const std::vector<uint8_t> pixels { makeRandomBytes(static_cast<uint64_t>(rowSize) * rowCount, rowSize + rowCount) };
+
+            std::vector<uint8_t> expected(pixels.size());
+            for (uint32_t row { 0u }; row < rowCount; row++) {
+                std::copy_n(pixels.begin() + row * rowSize, rowSize, expected.begin() + (rowCount - 1u - row) * rowSize);
+            }
+
+            for (const Simd::Level level : getLevels()) {
+                Simd::setLevel(level);
+                std::vector<uint8_t> flipped { pixels };
+                Simd::flipVertically(flipped.data(), rowSize, rowCount);
+
+                EXPECT_EQ(flipped, expected) << Simd::getLevelName(level) << ", " << rowSize << " by " << rowCount;
+            }
+        }
+    }
+}
+
+TEST_F(SimdTest, PremultiplyAlphaMatchesScalar) {
+    for (const uint32_t pixelCount : global_pixelCounts) {
+        const std::vector<uint8_t> pixels { makeRandomBytes(pixelCount * 4ull, pixelCount) };
+
+        Simd::setLevel(Simd::Level::Scalar);
+        std::vector<uint8_t> expected { pixels };
+        Simd::premultiplyAlpha(expected.data(), pixelCount);
+
+        for (uint32_t i { 0u }; i < pixelCount * 4u; i++) {
+            const uint32_t alpha { pixels[i / 4u * 4u + 3u] };
+            const uint32_t value { i % 4u == 3u ? alpha : (2u * pixels[i] * alpha + 255u) / 510u };
+            ASSERT_EQ(expected[i], value) << "byte " << i;
+        }
+
+        for (const Simd::Level level : getLevels()) {
+            Simd::setLevel(level);
+            std::vector<uint8_t> premultiplied { pixels };
+            Simd::premultiplyAlpha(premultiplied.data(), pixelCount);
+
+            EXPECT_EQ(premultiplied, expected) << Simd::getLevelName(level) << ", " << pixelCount << " pixels";
+        }
+    }
+}
+
+TEST_F(SimdTest, DownsampleBoxMatchesScalar) {
+    for (const uint32_t width : global_dimensions) {
+        for (const uint32_t height : global_dimensions) {
+            const std::vector<uint8_t> source { makeRandomBytes(static_cast<uint64_t>(width) * height * 4u, width * 100u + height) };
+            const uint64_t destinationSize { static_cast<uint64_t>(std::max(width / 2u, 1u)) * std::max(height / 2u, 1u) * 4u };
+
+            Simd::setLevel(Simd::Level::Scalar);
+            std::vector<uint8_t> expected(destinationSize);
+            Simd::downsampleBox(source.data(), width, height, expected.data());
+
+            for (const Simd::Level level : getLevels()) {
+                Simd::setLevel(level);
+                std::vector<uint8_t> destination(destinationSize);
+                Simd::downsampleBox(source.data(), width, height, destination.data());
+
+                EXPECT_EQ(destination, expected) << Simd::getLevelName(level) << ", " << width << " by " << height;
+            }
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,158 @@
+#include <resources/Lz4.hpp>
+#include <resources/PackedArchive.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace br = beige::resources;
+namespace fs = std::filesystem;
+
+// Compressed blobs have to save at least this fraction to be kept, decompressing the rest isn't worth it.
+constexpr uint64_t global_minimumSavingsDivisor { 8u };
+
+auto alignUp(const uint64_t value, const uint64_t alignment) -> uint64_t {
+    return (value + alignment - 1u) / alignment * alignment;
+}
+
+auto readFile(const fs::path& path, std::vector<std::byte>& data) -> bool {
+    std::ifstream file { path, std::ios::binary };
+
+    if (!file.good()) {
+        return false;
+    }
+
+    const std::vector<char> contents { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    const std::byte* bytes { reinterpret_cast<const std::byte*>(contents.data()) };
+    data.assign(bytes, bytes + contents.size());
+
+    return !file.bad();
+}
+
+auto packDirectory(
+    const std::string& inputPath,
+    const std::string& outputPath,
+    const bool compress
+) -> bool {
+    std::error_code errorCode;
+    if (!fs::is_directory(inputPath, errorCode)) {
+        std::cerr << inputPath << " is not a directory!\n";
+        return false;
+    }
+
+    // Sorted so files of a directory are stored next to each other and the output doesn't depend on the OS.
+    std::vector<std::string> paths;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(inputPath)) {
+        if (entry.is_regular_file()) {
+            paths.push_back(fs::relative(entry.path(), inputPath).generic_string());
+        }
+    }
+
+    std::sort(paths.begin(), paths.end());
+
+    std::vector<br::PackedArchiveEntry> entries(paths.size());
+    std::vector<std::vector<std::byte>> blobs(paths.size());
+    std::string pathData;
+    uint64_t uncompressedTotal { 0u };
+
+    for (std::size_t i { 0u }; i < paths.size(); i++) {
+        std::vector<std::byte> data;
+        if (!readFile(fs::path(inputPath) / paths.at(i), data)) {
+            std::cerr << "Failed to read " << paths.at(i) << "!\n";
+            return false;
+        }
+
+        br::PackedArchiveEntry& entry { entries.at(i) };
+        entry.uncompressedSize = data.size();
+        entry.pathOffset = pathData.size();
+        entry.pathLength = static_cast<uint32_t>(paths.at(i).size());
+        entry.compression = br::PackedCompression::None;
+        pathData += paths.at(i);
+        uncompressedTotal += data.size();
+
+        if (compress && !data.empty()) {
+            std::vector<std::byte> compressed { br::Lz4::compress(data.data(), data.size()) };
+
+            if (compressed.size() <= data.size() - data.size() / global_minimumSavingsDivisor) {
+                entry.compression = br::PackedCompression::Lz4;
+                data = std::move(compressed);
+            }
+        }
+
+        entry.size = data.size();
+        blobs.at(i) = std::move(data);
+    }
+
+    const uint64_t pathsOffset { sizeof(br::PackedArchiveHeader) + sizeof(br::PackedArchiveEntry) * entries.size() };
+    uint64_t offset { pathsOffset + pathData.size() };
+
+    for (br::PackedArchiveEntry& entry : entries) {
+        offset = alignUp(offset, br::global_packedArchiveDataAlignment);
+        entry.offset = offset;
+        offset += entry.size;
+    }
+
+    const br::PackedArchiveHeader header {
+        br::global_packedArchiveMagic,         // magic
+        br::global_packedArchiveVersion,       // version
+        static_cast<uint32_t>(entries.size()), // entryCount
+        0u,                                    // reserved
+        pathsOffset,                           // pathsOffset
+        static_cast<uint64_t>(pathData.size()) // pathsSize
+    };
+
+    std::ofstream file { outputPath, std::ios::binary | std::ios::trunc };
+
+    if (!file.good()) {
+        std::cerr << "Failed to open " << outputPath << " for writing!\n";
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()), sizeof(br::PackedArchiveEntry) * entries.size());
+    file.write(pathData.data(), pathData.size());
+
+    uint64_t position { pathsOffset + pathData.size() };
+    for (std::size_t i { 0u }; i < entries.size(); i++) {
+        const std::vector<char> padding(entries.at(i).offset - position, 0);
+        file.write(padding.data(), padding.size());
+        file.write(reinterpret_cast<const char*>(blobs.at(i).data()), blobs.at(i).size());
+        position = entries.at(i).offset + entries.at(i).size;
+    }
+
+    if (!file.good()) {
+        std::cerr << "Failed to write " << outputPath << "!\n";
+        return false;
+    }
+
+    std::cout << "Packed " << entries.size() << " files of " << inputPath << " -> " << outputPath << " ("
+              << uncompressedTotal << " -> " << position << " bytes)\n";
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    bool compress { false };
+    std::vector<std::string> paths;
+
+    for (int i { 1 }; i < argc; i++) {
+        const std::string argument { argv[i] };
+
+        if (argument == "--compress") {
+            compress = true;
+        } else {
+            paths.push_back(argument);
+        }
+    }
+
+    if (paths.size() != 2u) {
+        std::cerr << "Usage: asset-packer [--compress] <directory> <output.bpak>\n";
+        return 1;
+    }
+
+    return packDirectory(paths.at(0u), paths.at(1u), compress) ? 0 : 2;
+}
@@ -0,0 +1,568 @@
+#include "GltfImporter.hpp"
+
+#include "Json.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t global_glbMagic { 0x46546C67u };           // "glTF"
+constexpr uint32_t global_glbJsonChunkType { 0x4E4F534Au };   // "JSON"
+constexpr uint32_t global_glbBinaryChunkType { 0x004E4942u }; // "BIN"
+constexpr uint32_t global_trianglesMode { 4u };
+
+constexpr uint32_t global_componentTypeByte { 5120u };
+constexpr uint32_t global_componentTypeUnsignedByte { 5121u };
+constexpr uint32_t global_componentTypeShort { 5122u };
+constexpr uint32_t global_componentTypeUnsignedShort { 5123u };
+constexpr uint32_t global_componentTypeUnsignedInt { 5125u };
+constexpr uint32_t global_componentTypeFloat { 5126u };
+
+// Elements of an accessor, resolved to memory inside one of the buffers.
+struct Accessor {
+    const std::byte* data;
+    uint64_t stride;
+    uint64_t count;
+    uint32_t componentType;
+    uint32_t componentCount;
+    bool normalized;
+};
+
+auto readFile(const fs::path& path, std::vector<std::byte>& data) -> bool {
+    std::ifstream file { path, std::ios::binary };
+
+    if (!file.good()) {
+        return false;
+    }
+
+    const std::vector<char> contents { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    const std::byte* bytes { reinterpret_cast<const std::byte*>(contents.data()) };
+    data.assign(bytes, bytes + contents.size());
+
+    return !file.bad();
+}
+
+auto decodeBase64(const std::string_view text) -> std::optional<std::vector<std::byte>> {
+    std::vector<std::byte> data;
+    data.reserve(text.size() / 4u * 3u);
+
+    uint32_t bits { 0u };
+    uint32_t bitCount { 0u };
+
+    for (const char c : text) {
+        uint32_t value { 0u };
+
+        if (c >= 'A' && c <= 'Z') {
+            value = static_cast<uint32_t>(c - 'A');
+        } else if (c >= 'a' && c <= 'z') {
+            value = static_cast<uint32_t>(c - 'a' + 26);
+        } else if (c >= '0' && c <= '9') {
+            value = static_cast<uint32_t>(c - '0' + 52);
+        } else if (c == '+') {
+            value = 62u;
+        } else if (c == '/') {
+            value = 63u;
+        } else if (c == '=') {
+            break;
+        } else {
+            return std::nullopt;
+        }
+
+        bits = (bits << 6u) | value;
+        bitCount += 6u;
+
+        if (bitCount >= 8u) {
+            bitCount -= 8u;
+            data.push_back(static_cast<std::byte>((bits >> bitCount) & 0xFFu));
+        }
+    }
+
+    return data;
+}
+
+auto getComponentSize(const uint32_t componentType) -> uint32_t {
+    switch (componentType) {
+    case global_componentTypeByte:
+    case global_componentTypeUnsignedByte:
+        return 1u;
+    case global_componentTypeShort:
+    case global_componentTypeUnsignedShort:
+        return 2u;
+    case global_componentTypeUnsignedInt:
+    case global_componentTypeFloat:
+        return 4u;
+    }
+
+    return 0u;
+}
+
+auto getComponentCount(const std::string& type) -> uint32_t {
+    if (type == "SCALAR") {
+        return 1u;
+    }
+    if (type == "VEC2") {
+        return 2u;
+    }
+    if (type == "VEC3") {
+        return 3u;
+    }
+    if (type == "VEC4") {
+        return 4u;
+    }
+
+    return 0u;
+}
+
+// Negative and out of range values turn into sizes the bounds checks reject.
+auto getUnsigned(const JsonValue& value, const std::string_view key, const uint64_t fallback) -> uint64_t {
+    const double number { value.getNumber(key, static_cast<double>(fallback)) };
+
+    if (!(number >= 0.0) || number > static_cast<double>(std::numeric_limits<uint32_t>::max())) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+
+    return static_cast<uint64_t>(number);
+}
+
+auto getElement(const JsonValue& document, const std::string_view arrayName, const uint64_t index) -> const JsonValue* {
+    const JsonValue* array { document.find(arrayName) };
+
+    if (array == nullptr || array->type != JsonValue::Type::Array || index >= array->elements.size()) {
+        return nullptr;
+    }
+
+    return &array->elements.at(static_cast<std::size_t>(index));
+}
+
+auto getAccessor(
+    const JsonValue& document,
+    const std::vector<std::vector<std::byte>>& buffers,
+    const uint64_t accessorIndex
+) -> std::optional<Accessor> {
+    const JsonValue* accessor { getElement(document, "accessors", accessorIndex) };
+
+    if (accessor == nullptr || accessor->find("sparse") != nullptr) {
+        return std::nullopt;
+    }
+
+    const JsonValue* bufferView { getElement(document, "bufferViews", getUnsigned(*accessor, "bufferView", std::numeric_limits<uint64_t>::max())) };
+
+    if (bufferView == nullptr) {
+        return std::nullopt;
+    }
+
+    const uint64_t bufferIndex { getUnsigned(*bufferView, "buffer", std::numeric_limits<uint64_t>::max()) };
+
+    if (bufferIndex >= buffers.size()) {
+        return std::nullopt;
+    }
+
+    const std::vector<std::byte>& buffer { buffers.at(static_cast<std::size_t>(bufferIndex)) };
+
+    const uint32_t componentType { static_cast<uint32_t>(getUnsigned(*accessor, "componentType", 0u)) };
+    const uint32_t componentCount { getComponentCount(accessor->getString("type")) };
+    const uint64_t elementSize { static_cast<uint64_t>(getComponentSize(componentType)) * componentCount };
+    const uint64_t count { getUnsigned(*accessor, "count", 0u) };
+    const uint64_t viewOffset { getUnsigned(*bufferView, "byteOffset", 0u) };
+    const uint64_t viewLength { getUnsigned(*bufferView, "byteLength", 0u) };
+    const uint64_t accessorOffset { getUnsigned(*accessor, "byteOffset", 0u) };
+    const uint64_t stride { getUnsigned(*bufferView, "byteStride", elementSize) };
+    const JsonValue* normalized { accessor->find("normalized") };
+
+    if (elementSize == 0u || viewOffset > buffer.size() || viewLength > buffer.size() - viewOffset) {
+        return std::nullopt;
+    }
+
+    if (stride < elementSize || stride > viewLength || count > viewLength) {
+        return std::nullopt;
+    }
+
+    if (count > 0u && (accessorOffset > viewLength || (count - 1u) * stride + elementSize > viewLength - accessorOffset)) {
+        return std::nullopt;
+    }
+
+    const Accessor resolvedAccessor {
+        buffer.data() + viewOffset + accessorOffset, // data
+        stride,                                      // stride
+        count,                                       // count
+        componentType,                               // componentType
+        componentCount,                              // componentCount
+        normalized != nullptr && normalized->boolean // normalized
+    };
+
+    return resolvedAccessor;
+}
+
+// Converts every component to float, normalized integers are mapped to [0, 1] or [-1, 1].
+auto readFloats(const Accessor& accessor) -> std::vector<float> {
+    std::vector<float> values;
+    values.reserve(accessor.count * accessor.componentCount);
+
+    for (uint64_t i { 0u }; i < accessor.count; i++) {
+        const std::byte* element { accessor.data + i * accessor.stride };
+
+        for (uint32_t component { 0u }; component < accessor.componentCount; component++) {
+            float value { 0.0f };
+
+            switch (accessor.componentType) {
+            case global_componentTypeFloat: {
+                std::memcpy(&value, element + component * 4u, 4u);
+                break;
+            }
+            case global_componentTypeUnsignedByte: {
+                const uint8_t raw { static_cast<uint8_t>(element[component]) };
+                value = accessor.normalized ? static_cast<float>(raw) / 255.0f : static_cast<float>(raw);
+                break;
+            }
+            case global_componentTypeByte: {
+                const int8_t raw { static_cast<int8_t>(element[component]) };
+                value = accessor.normalized ? static_cast<float>(raw) / 127.0f : static_cast<float>(raw);
+                value = value < -1.0f && accessor.normalized ? -1.0f : value;
+                break;
+            }
+            case global_componentTypeUnsignedShort: {
+                uint16_t raw { 0u };
+                std::memcpy(&raw, element + component * 2u, 2u);
+                value = accessor.normalized ? static_cast<float>(raw) / 65535.0f : static_cast<float>(raw);
+                break;
+            }
+            case global_componentTypeShort: {
+                int16_t raw { 0 };
+                std::memcpy(&raw, element + component * 2u, 2u);
+                value = accessor.normalized ? static_cast<float>(raw) / 32767.0f : static_cast<float>(raw);
+                value = value < -1.0f && accessor.normalized ? -1.0f : value;
+                break;
+            }
+            case global_componentTypeUnsignedInt: {
+                uint32_t raw { 0u };
+                std::memcpy(&raw, element + component * 4u, 4u);
+                value = static_cast<float>(raw);
+                break;
+            }
+            }
+
+            values.push_back(value);
+        }
+    }
+
+    return values;
+}
+
+auto readIndices(const Accessor& accessor) -> std::optional<std::vector<uint32_t>> {
+    if (accessor.componentCount != 1u) {
+        return std::nullopt;
+    }
+
+    std::vector<uint32_t> indices;
+    indices.reserve(accessor.count);
+
+    for (uint64_t i { 0u }; i < accessor.count; i++) {
+        const std::byte* element { accessor.data + i * accessor.stride };
+
+        switch (accessor.componentType) {
+        case global_componentTypeUnsignedByte: {
+            indices.push_back(static_cast<uint32_t>(element[0u]));
+            break;
+        }
+        case global_componentTypeUnsignedShort: {
+            uint16_t index { 0u };
+            std::memcpy(&index, element, 2u);
+            indices.push_back(index);
+            break;
+        }
+        case global_componentTypeUnsignedInt: {
+            uint32_t index { 0u };
+            std::memcpy(&index, element, 4u);
+            indices.push_back(index);
+            break;
+        }
+        default:
+            return std::nullopt;
+        }
+    }
+
+    return indices;
+}
+
+// Splits a binary glTF file into its JSON text and binary chunk.
+auto parseGlb(
+    const std::vector<std::byte>& file,
+    std::string& json,
+    std::vector<std::byte>& binaryChunk
+) -> bool {
+    if (file.size() < 20u) {
+        return false;
+    }
+
+    uint32_t header[3];
+    std::memcpy(header, file.data(), sizeof(header));
+
+    if (header[0] != global_glbMagic || header[1] != 2u || header[2] > file.size()) {
+        return false;
+    }
+
+    uint64_t offset { sizeof(header) };
+
+    while (offset + 8u <= header[2]) {
+        uint32_t chunkHeader[2];
+        std::memcpy(chunkHeader, file.data() + offset, sizeof(chunkHeader));
+        offset += sizeof(chunkHeader);
+
+        if (chunkHeader[0] > header[2] - offset) {
+            return false;
+        }
+
+        const std::byte* chunk { file.data() + offset };
+
+        if (chunkHeader[1] == global_glbJsonChunkType && json.empty()) {
+            json.assign(reinterpret_cast<const char*>(chunk), chunkHeader[0]);
+        } else if (chunkHeader[1] == global_glbBinaryChunkType && binaryChunk.empty()) {
+            binaryChunk.assign(chunk, chunk + chunkHeader[0]);
+        }
+
+        // Chunks are padded to 4 bytes.
+        offset += (static_cast<uint64_t>(chunkHeader[0]) + 3u) / 4u * 4u;
+    }
+
+    return !json.empty();
+}
+
+auto loadBuffers(
+    const JsonValue& document,
+    const fs::path& directory,
+    std::vector<std::byte>& binaryChunk,
+    std::vector<std::vector<std::byte>>& buffers
+) -> bool {
+    const JsonValue* bufferArray { document.find("buffers") };
+
+    if (bufferArray == nullptr || bufferArray->type != JsonValue::Type::Array) {
+        return false;
+    }
+
+    for (std::size_t i { 0u }; i < bufferArray->elements.size(); i++) {
+        const JsonValue& buffer { bufferArray->elements.at(i) };
+        const std::string uri { buffer.getString("uri") };
+        std::vector<std::byte> data;
+
+        if (uri.empty()) {
+            // Only the first buffer of a binary file may refer to the binary chunk.
+            if (i != 0u || binaryChunk.empty()) {
+                std::cerr << "Buffer " << i << " has no data!\n";
+                return false;
+            }
+            data = std::move(binaryChunk);
+        } else if (uri.rfind("data:", 0u) == 0u) {
+            const std::size_t comma { uri.find(',') };
+
+            if (comma == std::string::npos || uri.substr(0u, comma).find(";base64") == std::string::npos) {
+                std::cerr << "Buffer " << i << " is not base64 encoded!\n";
+                return false;
+            }
+
+            std::optional<std::vector<std::byte>> decoded { decodeBase64(std::string_view(uri).substr(comma + 1u)) };
+
+            if (!decoded.has_value()) {
+                std::cerr << "Buffer " << i << " is not valid base64!\n";
+                return false;
+            }
+
+            data = std::move(decoded.value());
+        } else if (!readFile(directory / fs::u8path(uri), data)) {
+            std::cerr << "Failed to read buffer " << uri << "!\n";
+            return false;
+        }
+
+        if (static_cast<double>(data.size()) < buffer.getNumber("byteLength", 0.0)) {
+            std::cerr << "Buffer " << i << " is shorter than its byteLength!\n";
+            return false;
+        }
+
+        buffers.push_back(std::move(data));
+    }
+
+    return true;
+}
+
+auto appendPrimitive(
+    const JsonValue& document,
+    const std::vector<std::vector<std::byte>>& buffers,
+    const JsonValue& primitive,
+    ImportedMesh& mesh
+) -> bool {
+    const JsonValue* attributes { primitive.find("attributes") };
+
+    if (attributes == nullptr) {
+        return false;
+    }
+
+    const std::optional<Accessor> positionAccessor { getAccessor(document, buffers, getUnsigned(*attributes, "POSITION", std::numeric_limits<uint64_t>::max())) };
+
+    if (!positionAccessor.has_value() || positionAccessor->componentCount != 3u) {
+        std::cerr << "Primitive without valid positions!\n";
+        return false;
+    }
+
+    const uint64_t vertexCount { positionAccessor->count };
+    const std::vector<float> positions { readFloats(positionAccessor.value()) };
+
+    std::vector<float> normals;
+    if (attributes->find("NORMAL") != nullptr) {
+        const std::optional<Accessor> normalAccessor { getAccessor(document, buffers, getUnsigned(*attributes, "NORMAL", std::numeric_limits<uint64_t>::max())) };
+
+        if (!normalAccessor.has_value() || normalAccessor->componentCount != 3u || normalAccessor->count != vertexCount) {
+            std::cerr << "Primitive with invalid normals!\n";
+            return false;
+        }
+
+        normals = readFloats(normalAccessor.value());
+    }
+
+    std::vector<float> texCoords;
+    if (attributes->find("TEXCOORD_0") != nullptr) {
+        const std::optional<Accessor> texCoordAccessor { getAccessor(document, buffers, getUnsigned(*attributes, "TEXCOORD_0", std::numeric_limits<uint64_t>::max())) };
+
+        if (!texCoordAccessor.has_value() || texCoordAccessor->componentCount != 2u || texCoordAccessor->count != vertexCount) {
+            std::cerr << "Primitive with invalid texture coordinates!\n";
+            return false;
+        }
+
+        texCoords = readFloats(texCoordAccessor.value());
+    }
+
+    std::vector<uint32_t> indices;
+    if (primitive.find("indices") != nullptr) {
+        const std::optional<Accessor> indexAccessor { getAccessor(document, buffers, getUnsigned(primitive, "indices", std::numeric_limits<uint64_t>::max())) };
+        std::optional<std::vector<uint32_t>> readIndexList {
+            indexAccessor.has_value() ? readIndices(indexAccessor.value()) : std::nullopt
+        };
+
+        if (!readIndexList.has_value()) {
+            std::cerr << "Primitive with invalid indices!\n";
+            return false;
+        }
+
+        indices = std::move(readIndexList.value());
+    } else {
+        for (uint64_t i { 0u }; i < vertexCount; i++) {
+            indices.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    for (const uint32_t index : indices) {
+        if (index >= vertexCount) {
+            std::cerr << "Primitive with indices out of range!\n";
+            return false;
+        }
+    }
+
+    const uint32_t baseVertex { static_cast<uint32_t>(mesh.vertices.size()) };
+
+    for (uint64_t i { 0u }; i < vertexCount; i++) {
+        ImportedVertex vertex {
+            { positions.at(i * 3u), positions.at(i * 3u + 1u), positions.at(i * 3u + 2u) }, // position
+            { 0.0f, 0.0f, 0.0f },                                                           // normal
+            { 0.0f, 0.0f }                                                                  // texCoord
+        };
+
+        if (!normals.empty()) {
+            vertex.normal = { normals.at(i * 3u), normals.at(i * 3u + 1u), normals.at(i * 3u + 2u) };
+        }
+
+        // glTF puts the origin of texture coordinates at the top left.
+        if (!texCoords.empty()) {
+            vertex.texCoord = { texCoords.at(i * 2u), 1.0f - texCoords.at(i * 2u + 1u) };
+        }
+
+        mesh.vertices.push_back(vertex);
+    }
+
+    // Incomplete triangles at the end are dropped.
+    for (std::size_t i { 0u }; i + 2u < indices.size(); i += 3u) {
+        mesh.indices.push_back(baseVertex + indices.at(i));
+        mesh.indices.push_back(baseVertex + indices.at(i + 1u));
+        mesh.indices.push_back(baseVertex + indices.at(i + 2u));
+    }
+
+    mesh.hasNormals = mesh.hasNormals && !normals.empty();
+
+    return true;
+}
+
+} // namespace
+
+auto GltfImporter::load(const std::string& path) -> std::optional<ImportedMesh> {
+    std::vector<std::byte> file;
+
+    if (!readFile(path, file)) {
+        std::cerr << "Failed to open " << path << "!\n";
+        return std::nullopt;
+    }
+
+    std::string json;
+    std::vector<std::byte> binaryChunk;
+    uint32_t magic { 0u };
+
+    if (file.size() >= sizeof(magic)) {
+        std::memcpy(&magic, file.data(), sizeof(magic));
+    }
+
+    if (magic == global_glbMagic) {
+        if (!parseGlb(file, json, binaryChunk)) {
+            std::cerr << path << " is not a valid binary glTF file!\n";
+            return std::nullopt;
+        }
+    } else {
+        json.assign(reinterpret_cast<const char*>(file.data()), file.size());
+    }
+
+    const std::optional<JsonValue> document { Json::parse(json) };
+
+    if (!document.has_value()) {
+        std::cerr << path << " is not valid JSON!\n";
+        return std::nullopt;
+    }
+
+    std::vector<std::vector<std::byte>> buffers;
+
+    if (!loadBuffers(document.value(), fs::path(path).parent_path(), binaryChunk, buffers)) {
+        return std::nullopt;
+    }
+
+    const JsonValue* meshes { document->find("meshes") };
+
+    if (meshes == nullptr || meshes->type != JsonValue::Type::Array) {
+        std::cerr << path << " contains no meshes!\n";
+        return std::nullopt;
+    }
+
+    ImportedMesh mesh { { }, { }, true };
+
+    for (const JsonValue& gltfMesh : meshes->elements) {
+        const JsonValue* primitives { gltfMesh.find("primitives") };
+
+        if (primitives == nullptr || primitives->type != JsonValue::Type::Array) {
+            continue;
+        }
+
+        for (const JsonValue& primitive : primitives->elements) {
+            if (getUnsigned(primitive, "mode", global_trianglesMode) != global_trianglesMode) {
+                std::cerr << "Skipping a primitive which is not a triangle list.\n";
+                continue;
+            }
+
+            if (!appendPrimitive(document.value(), buffers, primitive, mesh)) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    return mesh;
+}
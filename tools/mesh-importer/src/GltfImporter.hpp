@@ -0,0 +1,21 @@
+#pragma once
+
+#include "ImportedMesh.hpp"
+
+#include <optional>
+#include <string>
+
+class GltfImporter final {
+public:
+    GltfImporter() = delete;
+    ~GltfImporter() = delete;
+
+    /**
+     * Reads the triangle primitives of every mesh in a glTF 2.0 file (.gltf or .glb). Buffers may be embedded,
+     * stored next to the file or in the binary chunk. Node transforms, materials and sparse accessors are not
+     * supported, meshes are merged as they are stored.
+     * @param path The path of the file.
+     * @returns The mesh, or nothing if the file could not be read or uses unsupported features.
+     */
+    static auto load(const std::string& path) -> std::optional<ImportedMesh>;
+};
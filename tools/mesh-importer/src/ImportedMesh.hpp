@@ -0,0 +1,18 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+struct ImportedVertex {
+    std::array<float, 3u> position;
+    std::array<float, 3u> normal;
+    std::array<float, 2u> texCoord; // With v pointing up, as in OBJ files and the engine.
+};
+
+// Indexed triangle list, every importer merges all meshes of a file into one.
+struct ImportedMesh {
+    std::vector<ImportedVertex> vertices;
+    std::vector<uint32_t> indices;
+    bool hasNormals; // False if any vertex lacks a normal, they are generated for the whole mesh then.
+};
@@ -0,0 +1,327 @@
+#include "Json.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+
+// Deeper documents are rejected instead of overflowing the stack.
+constexpr uint32_t global_maximumDepth { 64u };
+
+class Parser final {
+public:
+    Parser(const std::string_view text) :
+    m_text { text },
+    m_position { 0u } {
+
+    }
+
+    auto parseDocument() -> std::optional<JsonValue> {
+        std::optional<JsonValue> value { parseValue(0u) };
+        skipWhitespace();
+
+        if (!value.has_value() || m_position != m_text.size()) {
+            return std::nullopt;
+        }
+
+        return value;
+    }
+
+private:
+    std::string_view m_text;
+    std::size_t m_position;
+
+    auto skipWhitespace() -> void {
+        while (m_position < m_text.size()) {
+            const char c { m_text[m_position] };
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                break;
+            }
+            m_position++;
+        }
+    }
+
+    auto consume(const char expected) -> bool {
+        skipWhitespace();
+
+        if (m_position < m_text.size() && m_text[m_position] == expected) {
+            m_position++;
+            return true;
+        }
+
+        return false;
+    }
+
+    auto consumeLiteral(const std::string_view literal) -> bool {
+        if (m_text.substr(m_position, literal.size()) == literal) {
+            m_position += literal.size();
+            return true;
+        }
+
+        return false;
+    }
+
+    auto parseValue(const uint32_t depth) -> std::optional<JsonValue> {
+        if (depth > global_maximumDepth) {
+            return std::nullopt;
+        }
+
+        skipWhitespace();
+
+        if (m_position >= m_text.size()) {
+            return std::nullopt;
+        }
+
+        JsonValue value { JsonValue::Type::Null, false, 0.0, { }, { }, { } };
+        const char c { m_text[m_position] };
+
+        if (c == '{') {
+            m_position++;
+            value.type = JsonValue::Type::Object;
+
+            if (consume('}')) {
+                return value;
+            }
+
+            do {
+                skipWhitespace();
+                std::optional<std::string> key { parseString() };
+                if (!key.has_value() || !consume(':')) {
+                    return std::nullopt;
+                }
+
+                std::optional<JsonValue> element { parseValue(depth + 1u) };
+                if (!element.has_value()) {
+                    return std::nullopt;
+                }
+
+                value.keys.push_back(std::move(key.value()));
+                value.elements.push_back(std::move(element.value()));
+            } while (consume(','));
+
+            return consume('}') ? std::optional<JsonValue>(std::move(value)) : std::nullopt;
+        }
+
+        if (c == '[') {
+            m_position++;
+            value.type = JsonValue::Type::Array;
+
+            if (consume(']')) {
+                return value;
+            }
+
+            do {
+                std::optional<JsonValue> element { parseValue(depth + 1u) };
+                if (!element.has_value()) {
+                    return std::nullopt;
+                }
+
+                value.elements.push_back(std::move(element.value()));
+            } while (consume(','));
+
+            return consume(']') ? std::optional<JsonValue>(std::move(value)) : std::nullopt;
+        }
+
+        if (c == '"') {
+            std::optional<std::string> string { parseString() };
+            if (!string.has_value()) {
+                return std::nullopt;
+            }
+
+            value.type = JsonValue::Type::String;
+            value.string = std::move(string.value());
+            return value;
+        }
+
+        if (consumeLiteral("true") || consumeLiteral("false")) {
+            value.type = JsonValue::Type::Boolean;
+            value.boolean = c == 't';
+            return value;
+        }
+
+        if (consumeLiteral("null")) {
+            return value;
+        }
+
+        return parseNumber();
+    }
+
+    auto parseNumber() -> std::optional<JsonValue> {
+        const std::size_t start { m_position };
+
+        while (m_position < m_text.size()) {
+            const char c { m_text[m_position] };
+            if ((c < '0' || c > '9') && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') {
+                break;
+            }
+            m_position++;
+        }
+
+        const std::string number { m_text.substr(start, m_position - start) };
+        if (number.empty()) {
+            return std::nullopt;
+        }
+
+        char* end { nullptr };
+        const double parsed { std::strtod(number.c_str(), &end) };
+
+        if (end != number.c_str() + number.size()) {
+            return std::nullopt;
+        }
+
+        const JsonValue value { JsonValue::Type::Number, false, parsed, { }, { }, { } };
+        return value;
+    }
+
+    auto parseHexDigits() -> std::optional<uint32_t> {
+        if (m_position + 4u > m_text.size()) {
+            return std::nullopt;
+        }
+
+        uint32_t codePoint { 0u };
+
+        for (uint32_t i { 0u }; i < 4u; i++) {
+            const char c { m_text[m_position++] };
+            codePoint <<= 4u;
+
+            if (c >= '0' && c <= '9') {
+                codePoint |= static_cast<uint32_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                codePoint |= static_cast<uint32_t>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                codePoint |= static_cast<uint32_t>(c - 'A' + 10);
+            } else {
+                return std::nullopt;
+            }
+        }
+
+        return codePoint;
+    }
+
+    static auto appendUtf8(std::string& string, const uint32_t codePoint) -> void {
+        if (codePoint < 0x80u) {
+            string += static_cast<char>(codePoint);
+        } else if (codePoint < 0x800u) {
+            string += static_cast<char>(0xC0u | (codePoint >> 6u));
+            string += static_cast<char>(0x80u | (codePoint & 0x3Fu));
+        } else if (codePoint < 0x10000u) {
+            string += static_cast<char>(0xE0u | (codePoint >> 12u));
+            string += static_cast<char>(0x80u | ((codePoint >> 6u) & 0x3Fu));
+            string += static_cast<char>(0x80u | (codePoint & 0x3Fu));
+        } else {
+            string += static_cast<char>(0xF0u | (codePoint >> 18u));
+            string += static_cast<char>(0x80u | ((codePoint >> 12u) & 0x3Fu));
+            string += static_cast<char>(0x80u | ((codePoint >> 6u) & 0x3Fu));
+            string += static_cast<char>(0x80u | (codePoint & 0x3Fu));
+        }
+    }
+
+    auto parseString() -> std::optional<std::string> {
+        if (m_position >= m_text.size() || m_text[m_position] != '"') {
+            return std::nullopt;
+        }
+
+        m_position++;
+        std::string string;
+
+        while (m_position < m_text.size()) {
+            const char c { m_text[m_position++] };
+
+            if (c == '"') {
+                return string;
+            }
+
+            if (c != '\\') {
+                string += c;
+                continue;
+            }
+
+            if (m_position >= m_text.size()) {
+                return std::nullopt;
+            }
+
+            const char escape { m_text[m_position++] };
+
+            switch (escape) {
+            case '"':
+            case '\\':
+            case '/':
+                string += escape;
+                break;
+            case 'b':
+                string += '\b';
+                break;
+            case 'f':
+                string += '\f';
+                break;
+            case 'n':
+                string += '\n';
+                break;
+            case 'r':
+                string += '\r';
+                break;
+            case 't':
+                string += '\t';
+                break;
+            case 'u': {
+                std::optional<uint32_t> codePoint { parseHexDigits() };
+                if (!codePoint.has_value()) {
+                    return std::nullopt;
+                }
+
+                // Characters outside the basic plane come as a surrogate pair.
+                if (codePoint.value() >= 0xD800u && codePoint.value() < 0xDC00u) {
+                    if (!consumeLiteral("\\u")) {
+                        return std::nullopt;
+                    }
+
+                    const std::optional<uint32_t> lowSurrogate { parseHexDigits() };
+                    if (!lowSurrogate.has_value() || lowSurrogate.value() < 0xDC00u || lowSurrogate.value() >= 0xE000u) {
+                        return std::nullopt;
+                    }
+
+                    codePoint = 0x10000u + ((codePoint.value() - 0xD800u) << 10u) + (lowSurrogate.value() - 0xDC00u);
+                }
+
+                appendUtf8(string, codePoint.value());
+                break;
+            }
+            default:
+                return std::nullopt;
+            }
+        }
+
+        return std::nullopt;
+    }
+};
+
+} // namespace
+
+auto JsonValue::find(const std::string_view key) const -> const JsonValue* {
+    if (type != Type::Object) {
+        return nullptr;
+    }
+
+    for (std::size_t i { 0u }; i < keys.size(); i++) {
+        if (keys.at(i) == key) {
+            return &elements.at(i);
+        }
+    }
+
+    return nullptr;
+}
+
+auto JsonValue::getNumber(const std::string_view key, const double fallback) const -> double {
+    const JsonValue* value { find(key) };
+    return value != nullptr && value->type == Type::Number ? value->number : fallback;
+}
+
+auto JsonValue::getString(const std::string_view key) const -> std::string {
+    const JsonValue* value { find(key) };
+    return value != nullptr && value->type == Type::String ? value->string : std::string();
+}
+
+auto Json::parse(const std::string_view text) -> std::optional<JsonValue> {
+    Parser parser { text };
+    return parser.parseDocument();
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Just enough JSON for glTF files, numbers are kept as doubles.
+struct JsonValue {
+    enum class Type {
+        Null,
+        Boolean,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    Type type;
+    bool boolean;
+    double number;
+    std::string string;
+    std::vector<JsonValue> elements; // Array elements, or object values in the order of keys.
+    std::vector<std::string> keys;   // Object keys.
+
+    /**
+     * @returns The value of the key, or nullptr if this is not an object or the key is missing.
+     */
+    auto find(const std::string_view key) const -> const JsonValue*;
+
+    /**
+     * @returns The number stored under the key, or the fallback if it is missing or not a number.
+     */
+    auto getNumber(const std::string_view key, const double fallback) const -> double;
+
+    /**
+     * @returns The string stored under the key, or an empty string if it is missing or not a string.
+     */
+    auto getString(const std::string_view key) const -> std::string;
+};
+
+class Json final {
+public:
+    Json() = delete;
+    ~Json() = delete;
+
+    /**
+     * @returns The parsed document, or nothing if the text is not valid JSON.
+     */
+    static auto parse(const std::string_view text) -> std::optional<JsonValue>;
+};
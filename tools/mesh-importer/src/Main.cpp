@@ -0,0 +1,315 @@
+#include "GltfImporter.hpp"
+#include "ObjImporter.hpp"
+
+#include <resources/CookedMesh.hpp>
+#include <resources/MeshUtils.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace br = beige::resources;
+namespace fs = std::filesystem;
+
+// FIFO cache size the reported miss ratios are measured with, typical of current hardware.
+constexpr uint32_t global_reportedCacheSize { 16u };
+
+// Each level of detail aims for this fraction of the triangles of the previous one.
+constexpr float global_lodReduction { 0.5f };
+
+// Levels which cannot get below this fraction of the previous one are not worth their memory.
+constexpr float global_minimumLodReduction { 0.9f };
+
+// Largest simplification error of any level, relative to the size of the mesh.
+constexpr float global_maximumLodError { 0.05f };
+
+auto alignUp(const uint64_t value, const uint64_t alignment) -> uint64_t {
+    return (value + alignment - 1u) / alignment * alignment;
+}
+
+auto importMesh(const std::string& path) -> std::optional<ImportedMesh> {
+    std::string extension { fs::path(path).extension().string() };
+    std::transform(
+        extension.begin(),
+        extension.end(),
+        extension.begin(),
+        [](const unsigned char c) -> char {
+            return static_cast<char>(std::tolower(c));
+        }
+    );
+
+    if (extension == ".obj") {
+        return ObjImporter::load(path);
+    }
+    if (extension == ".gltf" || extension == ".glb") {
+        return GltfImporter::load(path);
+    }
+
+    std::cerr << "Unknown mesh format " << extension << ", expected .obj, .gltf or .glb!\n";
+    return std::nullopt;
+}
+
+// Area weighted vertex normals, for meshes which come without any.
+auto generateNormals(ImportedMesh& mesh) -> void {
+    for (ImportedVertex& vertex : mesh.vertices) {
+        vertex.normal = { 0.0f, 0.0f, 0.0f };
+    }
+
+    for (std::size_t i { 0u }; i + 2u < mesh.indices.size(); i += 3u) {
+        const std::array<float, 3u>& a { mesh.vertices.at(mesh.indices.at(i)).position };
+        const std::array<float, 3u>& b { mesh.vertices.at(mesh.indices.at(i + 1u)).position };
+        const std::array<float, 3u>& c { mesh.vertices.at(mesh.indices.at(i + 2u)).position };
+
+        const std::array<float, 3u> ab { b.at(0u) - a.at(0u), b.at(1u) - a.at(1u), b.at(2u) - a.at(2u) };
+        const std::array<float, 3u> ac { c.at(0u) - a.at(0u), c.at(1u) - a.at(1u), c.at(2u) - a.at(2u) };
+
+        // The cross product is twice the area long, so larger triangles weigh more.
+        const std::array<float, 3u> normal {
+            ab.at(1u) * ac.at(2u) - ab.at(2u) * ac.at(1u),
+            ab.at(2u) * ac.at(0u) - ab.at(0u) * ac.at(2u),
+            ab.at(0u) * ac.at(1u) - ab.at(1u) * ac.at(0u)
+        };
+
+        for (std::size_t corner { 0u }; corner < 3u; corner++) {
+            std::array<float, 3u>& vertexNormal { mesh.vertices.at(mesh.indices.at(i + corner)).normal };
+            vertexNormal.at(0u) += normal.at(0u);
+            vertexNormal.at(1u) += normal.at(1u);
+            vertexNormal.at(2u) += normal.at(2u);
+        }
+    }
+}
+
+auto getExtent(const ImportedMesh& mesh) -> float {
+    float extent { 0.0f };
+
+    for (std::size_t i { 0u }; i < 3u; i++) {
+        float min { std::numeric_limits<float>::max() };
+        float max { std::numeric_limits<float>::lowest() };
+
+        for (const ImportedVertex& vertex : mesh.vertices) {
+            min = std::min(min, vertex.position.at(i));
+            max = std::max(max, vertex.position.at(i));
+        }
+
+        extent = std::max(extent, max - min);
+    }
+
+    return extent;
+}
+
+// Simplifies every level from the full detail triangles, so the errors are exact. The levels are concatenated into
+// the indices of the mesh and optimized for the vertex cache one by one.
+auto generateLods(ImportedMesh& mesh) -> std::vector<br::CookedMeshLod> {
+    const uint32_t vertexCount { static_cast<uint32_t>(mesh.vertices.size()) };
+    const float maximumError { getExtent(mesh) * global_maximumLodError };
+
+    std::vector<std::array<float, 3u>> positions;
+    positions.reserve(mesh.vertices.size());
+    for (const ImportedVertex& vertex : mesh.vertices) {
+        positions.push_back(vertex.position);
+    }
+
+    const std::vector<uint32_t> finestIndices { mesh.indices };
+    br::MeshUtils::optimizeVertexCache(mesh.indices, vertexCount);
+
+    const br::CookedMeshLod finestLod {
+        0u,                                         // firstIndex
+        static_cast<uint32_t>(mesh.indices.size()), // indexCount
+        0.0f                                        // error
+    };
+
+    std::vector<br::CookedMeshLod> lods { finestLod };
+    float targetIndexCount { static_cast<float>(mesh.indices.size()) };
+
+    while (lods.size() < br::global_cookedMeshMaxLodCount) {
+        targetIndexCount *= global_lodReduction;
+
+        std::pair<std::vector<uint32_t>, float> simplified {
+            br::MeshUtils::simplify(finestIndices, positions, static_cast<uint32_t>(targetIndexCount), maximumError)
+        };
+
+        if (simplified.first.empty() || simplified.first.size() > lods.back().indexCount * global_minimumLodReduction) {
+            break;
+        }
+
+        br::MeshUtils::optimizeVertexCache(simplified.first, vertexCount);
+
+        const br::CookedMeshLod lod {
+            static_cast<uint32_t>(mesh.indices.size()),     // firstIndex
+            static_cast<uint32_t>(simplified.first.size()), // indexCount
+            std::max(simplified.second, lods.back().error)  // error
+        };
+
+        mesh.indices.insert(mesh.indices.end(), simplified.first.begin(), simplified.first.end());
+        lods.push_back(lod);
+    }
+
+    return lods;
+}
+
+auto cookMesh(const std::string& inputPath, const std::string& outputPath) -> bool {
+    std::optional<ImportedMesh> mesh { importMesh(inputPath) };
+
+    if (!mesh.has_value()) {
+        return false;
+    }
+
+    if (mesh->indices.empty()) {
+        std::cerr << inputPath << " contains no triangles!\n";
+        return false;
+    }
+
+    if (!mesh->hasNormals) {
+        generateNormals(mesh.value());
+    }
+
+    const uint32_t importedVertexCount { static_cast<uint32_t>(mesh->vertices.size()) };
+    const float sourceCacheMissRatio { br::MeshUtils::getAverageCacheMissRatio(mesh->indices, global_reportedCacheSize) };
+
+    const std::vector<br::CookedMeshLod> lods { generateLods(mesh.value()) };
+
+    // The vertices are laid out in the order the levels use them, the finest level first.
+    const std::vector<uint32_t> vertexOrder { br::MeshUtils::optimizeVertexFetch(mesh->indices, importedVertexCount) };
+
+    const std::vector<uint32_t> finestIndices(mesh->indices.begin(), mesh->indices.begin() + lods.front().indexCount);
+    const float cookedCacheMissRatio { br::MeshUtils::getAverageCacheMissRatio(finestIndices, global_reportedCacheSize) };
+
+    std::vector<ImportedVertex> vertices;
+    vertices.reserve(vertexOrder.size());
+    for (const uint32_t vertex : vertexOrder) {
+        vertices.push_back(mesh->vertices.at(vertex));
+    }
+
+    std::array<float, 3u> positionMin;
+    std::array<float, 3u> positionMax;
+    std::array<float, 2u> texCoordMin;
+    std::array<float, 2u> texCoordMax;
+    positionMin.fill(std::numeric_limits<float>::max());
+    positionMax.fill(std::numeric_limits<float>::lowest());
+    texCoordMin.fill(std::numeric_limits<float>::max());
+    texCoordMax.fill(std::numeric_limits<float>::lowest());
+
+    for (const ImportedVertex& vertex : vertices) {
+        for (std::size_t i { 0u }; i < 3u; i++) {
+            positionMin.at(i) = std::min(positionMin.at(i), vertex.position.at(i));
+            positionMax.at(i) = std::max(positionMax.at(i), vertex.position.at(i));
+        }
+
+        for (std::size_t i { 0u }; i < 2u; i++) {
+            texCoordMin.at(i) = std::min(texCoordMin.at(i), vertex.texCoord.at(i));
+            texCoordMax.at(i) = std::max(texCoordMax.at(i), vertex.texCoord.at(i));
+        }
+    }
+
+    std::vector<br::CookedMeshVertex> cookedVertices;
+    cookedVertices.reserve(vertices.size());
+
+    for (const ImportedVertex& vertex : vertices) {
+        const std::array<uint16_t, 3u> position {
+            br::MeshUtils::quantizeUnorm16(vertex.position.at(0u), positionMin.at(0u), positionMax.at(0u)),
+            br::MeshUtils::quantizeUnorm16(vertex.position.at(1u), positionMin.at(1u), positionMax.at(1u)),
+            br::MeshUtils::quantizeUnorm16(vertex.position.at(2u), positionMin.at(2u), positionMax.at(2u))
+        };
+
+        const std::array<uint16_t, 2u> texCoord {
+            br::MeshUtils::quantizeUnorm16(vertex.texCoord.at(0u), texCoordMin.at(0u), texCoordMax.at(0u)),
+            br::MeshUtils::quantizeUnorm16(vertex.texCoord.at(1u), texCoordMin.at(1u), texCoordMax.at(1u))
+        };
+
+        const br::CookedMeshVertex cookedVertex {
+            position,                                       // position
+            br::MeshUtils::encodeOctahedral(vertex.normal), // normal
+            texCoord                                        // texCoord
+        };
+        cookedVertices.push_back(cookedVertex);
+    }
+
+    const uint32_t vertexCount { static_cast<uint32_t>(cookedVertices.size()) };
+    const uint32_t indexCount { static_cast<uint32_t>(mesh->indices.size()) };
+    const uint32_t indexSize { vertexCount <= 65536u ? 2u : 4u };
+
+    const uint32_t lodCount { static_cast<uint32_t>(lods.size()) };
+
+    const uint64_t lodOffset { sizeof(br::CookedMeshHeader) };
+    const uint64_t vertexOffset { alignUp(lodOffset + sizeof(br::CookedMeshLod) * lodCount, br::global_cookedMeshDataAlignment) };
+    const uint64_t indexOffset { alignUp(vertexOffset + sizeof(br::CookedMeshVertex) * vertexCount, br::global_cookedMeshDataAlignment) };
+    const uint64_t fileSize { alignUp(indexOffset + static_cast<uint64_t>(indexSize) * indexCount, br::global_cookedMeshDataAlignment) };
+
+    const br::CookedMeshHeader header {
+        br::global_cookedMeshMagic,   // magic
+        br::global_cookedMeshVersion, // version
+        vertexCount,                  // vertexCount
+        indexCount,                   // indexCount
+        indexSize,                    // indexSize
+        lodCount,                     // lodCount
+        positionMin,                  // positionMin
+        positionMax,                  // positionMax
+        texCoordMin,                  // texCoordMin
+        texCoordMax,                  // texCoordMax
+        vertexOffset,                 // vertexOffset
+        indexOffset                   // indexOffset
+    };
+
+    // Assembled in memory so the padding between the sections is zeroed.
+    std::vector<char> data(fileSize, 0);
+    std::memcpy(data.data(), &header, sizeof(header));
+    std::memcpy(data.data() + lodOffset, lods.data(), sizeof(br::CookedMeshLod) * lodCount);
+    std::memcpy(data.data() + vertexOffset, cookedVertices.data(), sizeof(br::CookedMeshVertex) * vertexCount);
+
+    for (uint32_t i { 0u }; i < indexCount; i++) {
+        const uint32_t index { mesh->indices.at(i) };
+
+        if (indexSize == 2u) {
+            const uint16_t shortIndex { static_cast<uint16_t>(index) };
+            std::memcpy(data.data() + indexOffset + i * 2u, &shortIndex, 2u);
+        } else {
+            std::memcpy(data.data() + indexOffset + i * 4u, &index, 4u);
+        }
+    }
+
+    std::ofstream file { outputPath, std::ios::binary | std::ios::trunc };
+
+    if (!file.good()) {
+        std::cerr << "Failed to open " << outputPath << " for writing!\n";
+        return false;
+    }
+
+    file.write(data.data(), data.size());
+
+    if (!file.good()) {
+        std::cerr << "Failed to write " << outputPath << "!\n";
+        return false;
+    }
+
+    const uint64_t sourceSize { (sizeof(float) * 8u) * importedVertexCount + sizeof(uint32_t) * lods.front().indexCount };
+
+    std::cout << "Cooked " << inputPath << " -> " << outputPath << " (" << vertexCount << " vertices, "
+              << lods.front().indexCount / 3u << " triangles, " << indexSize * 8u << " bit indices, ACMR "
+              << sourceCacheMissRatio << " -> " << cookedCacheMissRatio << ", " << sourceSize << " -> " << fileSize
+              << " bytes)\n";
+
+    for (uint32_t i { 1u }; i < lodCount; i++) {
+        std::cout << "  LOD " << i << ": " << lods.at(i).indexCount / 3u << " triangles, error " << lods.at(i).error
+                  << "\n";
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: mesh-importer <input.obj|input.gltf|input.glb> <output.bmesh>\n";
+        return 1;
+    }
+
+    return cookMesh(argv[1], argv[2]) ? 0 : 2;
+}
@@ -0,0 +1,153 @@
+#include "ObjImporter.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace {
+
+// Indices of a face corner into the position, texture coordinate and normal lists, 0 if the corner has none.
+using Corner = std::array<uint32_t, 3u>;
+
+// Parses "v", "v/vt", "v//vn" or "v/vt/vn", negative indices count back from the end of each list.
+auto parseCorner(const char*& cursor, const std::array<std::size_t, 3u>& counts, Corner& corner) -> bool {
+    corner = { 0u, 0u, 0u };
+
+    for (uint32_t i { 0u }; i < 3u; i++) {
+        if (i > 0u) {
+            if (*cursor != '/') {
+                break;
+            }
+            cursor++;
+
+            // Empty texture coordinate, as in "v//vn".
+            if (*cursor == '/') {
+                continue;
+            }
+        }
+
+        char* end { nullptr };
+        const long index { std::strtol(cursor, &end, 10) };
+
+        if (end == cursor) {
+            return false;
+        }
+
+        cursor = end;
+        const long count { static_cast<long>(counts.at(i)) };
+        const long resolvedIndex { index < 0 ? count + index + 1 : index };
+
+        if (resolvedIndex < 1 || resolvedIndex > count) {
+            return false;
+        }
+
+        corner.at(i) = static_cast<uint32_t>(resolvedIndex);
+    }
+
+    return true;
+}
+
+auto parseFloats(const char* cursor, float* values, const uint32_t count) -> void {
+    for (uint32_t i { 0u }; i < count; i++) {
+        char* end { nullptr };
+        values[i] = std::strtof(cursor, &end);
+        cursor = end;
+    }
+}
+
+} // namespace
+
+auto ObjImporter::load(const std::string& path) -> std::optional<ImportedMesh> {
+    std::ifstream file { path };
+
+    if (!file.good()) {
+        std::cerr << "Failed to open " << path << "!\n";
+        return std::nullopt;
+    }
+
+    std::vector<std::array<float, 3u>> positions;
+    std::vector<std::array<float, 2u>> texCoords;
+    std::vector<std::array<float, 3u>> normals;
+
+    ImportedMesh mesh { { }, { }, true };
+    std::map<Corner, uint32_t> vertexIndices;
+    std::vector<uint32_t> face;
+    std::string line;
+    uint32_t lineNumber { 0u };
+
+    while (std::getline(file, line)) {
+        lineNumber++;
+        const char* cursor { line.c_str() };
+
+        while (*cursor == ' ' || *cursor == '\t') {
+            cursor++;
+        }
+
+        if (cursor[0] == 'v' && cursor[1] == ' ') {
+            std::array<float, 3u> position { 0.0f, 0.0f, 0.0f };
+            parseFloats(cursor + 2, position.data(), 3u);
+            positions.push_back(position);
+        } else if (cursor[0] == 'v' && cursor[1] == 't' && cursor[2] == ' ') {
+            std::array<float, 2u> texCoord { 0.0f, 0.0f };
+            parseFloats(cursor + 3, texCoord.data(), 2u);
+            texCoords.push_back(texCoord);
+        } else if (cursor[0] == 'v' && cursor[1] == 'n' && cursor[2] == ' ') {
+            std::array<float, 3u> normal { 0.0f, 0.0f, 0.0f };
+            parseFloats(cursor + 3, normal.data(), 3u);
+            normals.push_back(normal);
+        } else if (cursor[0] == 'f' && cursor[1] == ' ') {
+            const std::array<std::size_t, 3u> counts { positions.size(), texCoords.size(), normals.size() };
+            cursor += 2;
+            face.clear();
+
+            while (true) {
+                while (*cursor == ' ' || *cursor == '\t' || *cursor == '\r') {
+                    cursor++;
+                }
+
+                if (*cursor == '\0') {
+                    break;
+                }
+
+                Corner corner;
+                if (!parseCorner(cursor, counts, corner)) {
+                    std::cerr << path << ":" << lineNumber << ": invalid face corner!\n";
+                    return std::nullopt;
+                }
+
+                const std::map<Corner, uint32_t>::const_iterator vertexIndex { vertexIndices.find(corner) };
+
+                if (vertexIndex != vertexIndices.end()) {
+                    face.push_back(vertexIndex->second);
+                    continue;
+                }
+
+                const std::array<float, 3u> noNormal { 0.0f, 0.0f, 0.0f };
+                const std::array<float, 2u> noTexCoord { 0.0f, 0.0f };
+
+                const ImportedVertex vertex {
+                    positions.at(corner.at(0u) - 1u),                                  // position
+                    corner.at(2u) > 0u ? normals.at(corner.at(2u) - 1u) : noNormal,    // normal
+                    corner.at(1u) > 0u ? texCoords.at(corner.at(1u) - 1u) : noTexCoord // texCoord
+                };
+
+                mesh.hasNormals = mesh.hasNormals && corner.at(2u) > 0u;
+
+                const uint32_t newIndex { static_cast<uint32_t>(mesh.vertices.size()) };
+                vertexIndices.emplace(corner, newIndex);
+                mesh.vertices.push_back(vertex);
+                face.push_back(newIndex);
+            }
+
+            for (std::size_t i { 2u }; i < face.size(); i++) {
+                mesh.indices.push_back(face.at(0u));
+                mesh.indices.push_back(face.at(i - 1u));
+                mesh.indices.push_back(face.at(i));
+            }
+        }
+    }
+
+    return mesh;
+}
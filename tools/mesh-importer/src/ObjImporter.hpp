@@ -0,0 +1,20 @@
+#pragma once
+
+#include "ImportedMesh.hpp"
+
+#include <optional>
+#include <string>
+
+class ObjImporter final {
+public:
+    ObjImporter() = delete;
+    ~ObjImporter() = delete;
+
+    /**
+     * Reads the positions, texture coordinates and normals of a Wavefront OBJ file, faces are triangulated as
+     * fans and corners with the same attributes share a vertex. Groups and materials are ignored.
+     * @param path The path of the file.
+     * @returns The mesh, or nothing if the file could not be read or refers to missing attributes.
+     */
+    static auto load(const std::string& path) -> std::optional<ImportedMesh>;
+};
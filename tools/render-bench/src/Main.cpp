@@ -0,0 +1,423 @@
+#include <core/FrameStats.hpp>
+#include <core/JobSystem.hpp>
+#include <core/Memory.hpp>
+#include <core/Vfs.hpp>
+#include <math/MathTypes.hpp>
+#include <renderer/RendererFrontend.hpp>
+#include <renderer/RendererTypes.hpp>
+#include <renderer/vulkan/VulkanBackend.hpp>
+#include <resources/TextureFormat.hpp>
+#include <scene/Camera.hpp>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bc = beige::core;
+namespace br = beige::renderer;
+namespace bres = beige::resources;
+
+struct Options {
+    uint32_t frameCount { 500u };
+    uint32_t objectCount { 1000u };
+    uint32_t textureCount { 16u };
+    uint32_t materialCount { 64u };
+    uint32_t width { 1280u };
+    uint32_t height { 720u };
+    std::string reportPath;
+    std::string capturePath;
+    bool isInstanced { false }; // Draws every object with the first material and texture as culled instances.
+};
+
+// Every texture gets its own color, tiled with white so sampling and filtering have something to do.
+auto generateTexture(const uint32_t index, const uint32_t dimension) -> std::vector<std::byte> {
+    const uint32_t channelCount { 4u };
+    const uint32_t tileSize { 16u };
+    const std::array<uint8_t, 3u> color {
+        static_cast<uint8_t>(64u + index * 97u % 192u),
+        static_cast<uint8_t>(64u + index * 57u % 192u),
+        static_cast<uint8_t>(64u + index * 31u % 192u)
+    };
+
+    std::vector<std::byte> pixels(static_cast<std::size_t>(dimension) * dimension * channelCount, std::byte(0xFF));
+
+    for (uint32_t row { 0u }; row < dimension; row++) {
+        for (uint32_t col { 0u }; col < dimension; col++) {
+            if ((row / tileSize + col / tileSize) % 2u == 0u) {
+                continue;
+            }
+
+            std::byte* pixel { pixels.data() + (static_cast<std::size_t>(row) * dimension + col) * channelCount };
+            pixel[0] = std::byte(color.at(0));
+            pixel[1] = std::byte(color.at(1));
+            pixel[2] = std::byte(color.at(2));
+        }
+    }
+
+    return pixels;
+}
+
+// A unit cube with its own vertices per face, counter-clockwise seen from outside.
+auto generateCube(std::vector<beige::math::Vertex3D>& vertices, std::vector<uint32_t>& indices) -> void {
+    // Normal, then the axes along the face whose cross product is the normal.
+    const std::array<std::array<glm::vec3, 3u>, 6u> faces {{
+        {{ { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } }},
+        {{ { 0.0f, 0.0f, -1.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } }},
+        {{ { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f, 0.0f } }},
+        {{ { -1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f } }},
+        {{ { 0.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f } }},
+        {{ { 0.0f, -1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } }}
+    }};
+
+    const std::array<glm::vec2, 4u> corners {{
+        { 0.0f, 0.0f },
+        { 1.0f, 0.0f },
+        { 1.0f, 1.0f },
+        { 0.0f, 1.0f }
+    }};
+
+    for (const std::array<glm::vec3, 3u>& face : faces) {
+        const uint32_t firstVertex { static_cast<uint32_t>(vertices.size()) };
+
+        for (const glm::vec2& corner : corners) {
+            const glm::vec3 position {
+                0.5f * face.at(0) + (corner.x - 0.5f) * face.at(1) + (corner.y - 0.5f) * face.at(2)
+            };
+            vertices.push_back({ position, corner });
+        }
+
+        for (const uint32_t index : { 0u, 1u, 2u, 0u, 2u, 3u }) {
+            indices.push_back(firstVertex + index);
+        }
+    }
+}
+
+// Binary PPM, rows top first like the pixels, alpha is dropped.
+auto writeImage(
+    const std::string& path,
+    const std::vector<std::byte>& pixels,
+    const uint32_t width,
+    const uint32_t height
+) -> bool {
+    std::ofstream file { path, std::ios::binary };
+
+    if (!file) {
+        std::cerr << "Failed to open " << path << " for writing!\n";
+        return false;
+    }
+
+    file << "P6\n" << width << " " << height << "\n255\n";
+
+    std::vector<std::byte> row(static_cast<std::size_t>(width) * 3u);
+
+    for (uint32_t y { 0u }; y < height; y++) {
+        const std::byte* source { pixels.data() + static_cast<std::size_t>(y) * width * 4u };
+
+        for (uint32_t x { 0u }; x < width; x++) {
+            row[x * 3u + 0u] = source[x * 4u + 0u];
+            row[x * 3u + 1u] = source[x * 4u + 1u];
+            row[x * 3u + 2u] = source[x * 4u + 2u];
+        }
+
+        file.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+    }
+
+    if (!file) {
+        std::cerr << "Failed to write " << path << "!\n";
+        return false;
+    }
+
+    return true;
+}
+
+auto parseOptions(int argc, char** argv) -> std::optional<Options> {
+    Options options;
+
+    for (int i { 1 }; i < argc; i++) {
+        const std::string argument { argv[i] };
+
+        if (argument == "--instanced") {
+            options.isInstanced = true;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            return std::nullopt;
+        }
+
+        const std::string value { argv[++i] };
+
+        if (argument == "--frames") {
+            options.frameCount = static_cast<uint32_t>(std::stoul(value));
+        } else if (argument == "--objects") {
+            options.objectCount = static_cast<uint32_t>(std::stoul(value));
+        } else if (argument == "--textures") {
+            options.textureCount = static_cast<uint32_t>(std::stoul(value));
+        } else if (argument == "--materials") {
+            options.materialCount = static_cast<uint32_t>(std::stoul(value));
+        } else if (argument == "--width") {
+            options.width = static_cast<uint32_t>(std::stoul(value));
+        } else if (argument == "--height") {
+            options.height = static_cast<uint32_t>(std::stoul(value));
+        } else if (argument == "--report") {
+            options.reportPath = value;
+        } else if (argument == "--capture") {
+            options.capturePath = value;
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    const bool isValid {
+        options.frameCount > 0u &&
+        options.objectCount > 0u &&
+        options.textureCount > 0u &&
+        options.materialCount > 0u &&
+        options.width > 0u &&
+        options.height > 0u
+    };
+
+    if (!isValid) {
+        return std::nullopt;
+    }
+
+    return options;
+}
+
+auto run(const Options& options) -> bool {
+    // Same lookup as the app, loose files in assets first, then the packed archive.
+    const std::shared_ptr<bc::Vfs> vfs { std::make_shared<bc::Vfs>() };
+    vfs->mountDirectory("assets");
+    vfs->mountArchive("assets.bpak");
+
+    const std::shared_ptr<bc::JobSystem> jobSystem { std::make_shared<bc::JobSystem>() };
+
+    // Without a platform the backend needs no display and renders into offscreen images.
+    std::unique_ptr<br::vulkan::Backend> backend {
+        std::make_unique<br::vulkan::Backend>("render-bench", options.width, options.height, nullptr, vfs)
+    };
+    br::vulkan::Backend* vulkanBackend { backend.get() };
+
+    const std::shared_ptr<br::Frontend> frontend {
+        std::make_shared<br::Frontend>(std::move(backend), options.height, jobSystem)
+    };
+
+    const uint32_t textureDimension { 256u };
+    std::vector<bres::TextureHandle> textures(options.textureCount);
+
+    for (uint32_t i { 0u }; i < options.textureCount; i++) {
+        const std::vector<std::byte> pixels { generateTexture(i, textureDimension) };
+
+        textures[i] = frontend->getTexturePool().allocate(
+            frontend->createTexture(
+                "render-bench/texture_" + std::to_string(i),
+                static_cast<int32_t>(textureDimension),
+                static_cast<int32_t>(textureDimension),
+                4,
+                bres::TextureFormat::Rgba8,
+                pixels.data(),
+                1u,
+                false
+            )
+        );
+    }
+
+    frontend->setDefaultTexture(frontend->getTexturePool().getTexture(textures.front()));
+
+    std::vector<beige::math::Vertex3D> vertices;
+    std::vector<uint32_t> indices;
+    generateCube(vertices, indices);
+
+    const bres::GeometryHandle cube { frontend->createGeometry(vertices, indices, { }) };
+
+    if (cube == bres::global_invalidGeometryHandle) {
+        std::cerr << "Failed to create the cube geometry!\n";
+        return false;
+    }
+
+    // Objects drawn with the same id share the uniforms and descriptor sets of a material.
+    std::vector<bres::ObjectId> materials(options.materialCount);
+
+    for (uint32_t i { 0u }; i < options.materialCount; i++) {
+        const std::optional<bres::ObjectId> objectId { frontend->acquireObjectResources() };
+
+        if (!objectId.has_value()) {
+            std::cerr << "Failed to acquire the resources of material " << i << "!\n";
+            return false;
+        }
+
+        materials[i] = objectId.value();
+    }
+
+    // A square grid in the z = 0 plane, the camera backs off until all of it is in view.
+    const uint32_t gridSize { static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(options.objectCount)))) };
+    const float spacing { 2.0f };
+    const float gridExtent { static_cast<float>(gridSize) * spacing };
+
+    std::vector<br::GeometryRenderData> geometries(options.objectCount);
+
+    for (uint32_t i { 0u }; i < options.objectCount; i++) {
+        const glm::vec3 position {
+            (static_cast<float>(i % gridSize) + 0.5f) * spacing - gridExtent * 0.5f,
+            (static_cast<float>(i / gridSize) + 0.5f) * spacing - gridExtent * 0.5f,
+            0.0f
+        };
+
+        glm::mat4x4 model { 1.0f };
+        model[3] = glm::vec4(position, 1.0f);
+
+        const uint32_t material { options.isInstanced ? 0u : i % options.materialCount };
+
+        geometries[i] = {
+            { i, 0u },                                    // entity
+            materials[material],                          // objectId
+            cube,                                         // geometry
+            0u,                                           // lod
+            model,                                        // model
+            { textures[material % options.textureCount] } // textures
+        };
+    }
+
+    beige::scene::Camera camera;
+    camera.setAspectRatio(static_cast<float>(options.width) / static_cast<float>(options.height));
+    camera.setPosition(glm::vec3(0.0f, 0.0f, gridExtent * 1.5f + 2.0f));
+    camera.update();
+    frontend->setCamera(camera);
+
+    bc::FrameStats frameStats { options.frameCount };
+    double submitTimeSum { 0.0 };
+    double gpuTimeSum { 0.0 };
+    double cullTimeSum { 0.0 };
+    uint64_t visibleCountSum { 0u };
+    uint64_t instanceCountSum { 0u };
+    double lastFrameStartTime { 0.0 };
+    const auto startTime { std::chrono::steady_clock::now() };
+
+    for (uint32_t frame { 0u }; frame < options.frameCount; frame++) {
+        br::Packet packet {
+            1.0f / 60.0f, // deltaTime
+            { },          // geometries
+            { },          // visibleGeometries
+            { },          // cullingStats
+            { }           // instances
+        };
+
+        if (options.isInstanced) {
+            packet.instances = geometries;
+        } else {
+            packet.geometries = geometries;
+        }
+
+        const double frameStartTime { std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() };
+        const uint64_t frameStartAllocationCount { bc::Memory::getAllocationCount() };
+
+        if (!frontend->drawFrame(packet)) {
+            std::cerr << "Frame " << frame << " failed!\n";
+            return false;
+        }
+
+        const double frameEndTime { std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() };
+        const br::FrameTimings frameTimings { frontend->getFrameTimings() };
+        const uint64_t allocationCount { bc::Memory::getAllocationCount() - frameStartAllocationCount };
+
+        // The first frame has no previous one to measure from.
+        const double frameTime { frame > 0u ? frameStartTime - lastFrameStartTime : frameEndTime - frameStartTime };
+
+        // The host waits for the device and the frames in flight are not part of the cost of submitting.
+        const float submitTime { static_cast<float>((frameEndTime - frameStartTime) * 1000.0) - frameTimings.presentWaitTime };
+
+        frameStats.add(
+            bc::FrameSample {
+                static_cast<float>(frameTime * 1000.0), // frameTime
+                submitTime,                             // cpuTime
+                frameTimings.gpuTime,                   // gpuTime
+                frameTimings.presentWaitTime,           // presentWaitTime
+                packet.cullingStats.cullTime,           // cullTime
+                static_cast<uint32_t>(allocationCount), // allocationCount
+                packet.cullingStats.objectCount,        // objectCount
+                packet.cullingStats.visibleCount,       // visibleCount
+                packet.cullingStats.instanceCount       // instanceCount
+            }
+        );
+
+        submitTimeSum += submitTime;
+        gpuTimeSum += frameTimings.gpuTime;
+        cullTimeSum += packet.cullingStats.cullTime;
+        visibleCountSum += packet.cullingStats.visibleCount;
+        instanceCountSum += packet.cullingStats.instanceCount;
+        lastFrameStartTime = frameStartTime;
+    }
+
+    const double totalTime { std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() };
+
+    std::cout << "Rendered " << options.frameCount << " frames of " << options.objectCount << " objects, "
+        << options.materialCount << " materials and " << options.textureCount << " textures at "
+        << options.width << "x" << options.height << (options.isInstanced ? " as instances" : "") << " in "
+        << totalTime << " s\n"
+        << "Mean CPU submit time: " << submitTimeSum / options.frameCount << " ms\n"
+        << "Mean GPU time: " << gpuTimeSum / options.frameCount << " ms\n"
+        << "Mean cull time: " << cullTimeSum / options.frameCount << " ms, "
+        << visibleCountSum / options.frameCount << " visible objects, "
+        << instanceCountSum / options.frameCount << " instances culled on the device\n";
+
+    const bc::MemoryStats driverStats { bc::Memory::getStats(bc::MemoryTag::VulkanDriver) };
+    std::cout << "Driver host memory: " << driverStats.liveBytes << " B live, " << driverStats.peakBytes << " B peak\n";
+
+    const bc::MemoryStats bufferStats { bc::Memory::getStats(bc::MemoryTag::DeviceBuffer) };
+    const bc::MemoryStats imageStats { bc::Memory::getStats(bc::MemoryTag::DeviceImage) };
+    std::cout << "Device memory: " << bufferStats.peakBytes << " B peak in buffers, " << imageStats.peakBytes
+        << " B peak in images\n";
+
+    if (!options.reportPath.empty() && !frameStats.writeJson(options.reportPath)) {
+        std::cerr << "Failed to write the report to " << options.reportPath << "!\n";
+        return false;
+    }
+
+    if (!options.capturePath.empty()) {
+        std::vector<std::byte> pixels;
+
+        if (!vulkanBackend->readFramebuffer(pixels)) {
+            std::cerr << "Failed to read back the last frame!\n";
+            return false;
+        }
+
+        if (!writeImage(options.capturePath, pixels, options.width, options.height)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const std::optional<Options> options { parseOptions(argc, argv) };
+
+    if (!options.has_value()) {
+        std::cerr << "Usage: render-bench [--frames count] [--objects count] [--textures count] [--materials count] "
+            "[--width pixels] [--height pixels] [--report <stats.json>] [--capture <frame.ppm>] [--instanced]\n";
+        return 1;
+    }
+
+    try {
+        if (!run(options.value())) {
+            return 1;
+        }
+    } catch (const std::exception& exception) {
+        std::cerr << "render-bench failed: " << exception.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+#include <math/Simd.hpp>
+#include <resources/BlockCompression.hpp>
+#include <resources/CookedTexture.hpp>
+#include <resources/TextureUtils.hpp>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <external/stb/stb_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace br = beige::resources;
+
+auto alignUp(const uint64_t value, const uint64_t alignment) -> uint64_t {
+    return (value + alignment - 1u) / alignment * alignment;
+}
+
+auto parseQuality(const std::string& name) -> std::optional<br::TextureQuality> {
+    if (name == "lossless") {
+        return br::TextureQuality::Lossless;
+    }
+    if (name == "fast") {
+        return br::TextureQuality::Fast;
+    }
+    if (name == "high") {
+        return br::TextureQuality::High;
+    }
+
+    return std::nullopt;
+}
+
+auto getFormatName(const br::TextureFormat format) -> std::string {
+    switch (format) {
+    case br::TextureFormat::Rgba8:
+        return "RGBA8";
+    case br::TextureFormat::Bc1:
+        return "BC1";
+    case br::TextureFormat::Bc3:
+        return "BC3";
+    case br::TextureFormat::Bc7:
+        return "BC7";
+    }
+
+    return "unknown";
+}
+
+auto cookTexture(
+    const std::string& inputPath,
+    const std::string& outputPath,
+    const br::TextureQuality quality,
+    const uint32_t threadCount
+) -> bool {
+    const int32_t requiredChannelCount { 4 };
+
+    // Flip once here so the runtime never has to.
+    stbi_set_flip_vertically_on_load(true);
+
+    int32_t width { 0 };
+    int32_t height { 0 };
+    int32_t channelCount { 0 };
+
+    stbi_uc* data {
+        stbi_load(
+            inputPath.c_str(),
+            &width,
+            &height,
+            &channelCount,
+            requiredChannelCount
+        )
+    };
+
+    if (data == nullptr) {
+        std::cerr << "Failed to load " << inputPath << ": " << stbi_failure_reason() << "!\n";
+        return false;
+    }
+
+    const uint64_t pixelCount { static_cast<uint64_t>(width) * static_cast<uint64_t>(height) };
+
+    const bool hasTransparency { beige::math::Simd::hasTransparency(data, pixelCount) };
+
+    const uint32_t mipLevelCount {
+        br::TextureUtils::getMipLevelCount(static_cast<uint32_t>(width), static_cast<uint32_t>(height))
+    };
+
+    const std::vector<std::byte> mipChain {
+        br::TextureUtils::generateMipChain(
+            data,
+            static_cast<uint32_t>(width),
+            static_cast<uint32_t>(height),
+            static_cast<uint32_t>(requiredChannelCount),
+            mipLevelCount
+        )
+    };
+
+    stbi_image_free(data);
+
+    // Levels are filtered uncompressed and encoded one by one, each level on all threads.
+    const br::TextureFormat format { br::BlockCompression::selectFormat(hasTransparency, quality) };
+    const auto encodeStart { std::chrono::steady_clock::now() };
+
+    std::vector<std::byte> encodedMipChain;
+    std::vector<br::CookedTextureMip> mips(mipLevelCount);
+    uint64_t sourceOffset { 0u };
+
+    for (uint32_t i { 0u }; i < mipLevelCount; i++) {
+        const uint32_t mipWidth { std::max(static_cast<uint32_t>(width) >> i, 1u) };
+        const uint32_t mipHeight { std::max(static_cast<uint32_t>(height) >> i, 1u) };
+
+        const std::vector<std::byte> level {
+            br::BlockCompression::encode(format, mipChain.data() + sourceOffset, mipWidth, mipHeight, threadCount)
+        };
+
+        mips.at(i).offset = encodedMipChain.size(); // Relative to the data for now.
+        mips.at(i).size = level.size();
+        encodedMipChain.insert(encodedMipChain.end(), level.begin(), level.end());
+
+        sourceOffset += br::TextureUtils::getMipLevelSize(mipWidth, mipHeight, static_cast<uint32_t>(requiredChannelCount), 0u);
+    }
+
+    const std::chrono::duration<double, std::milli> encodeTime { std::chrono::steady_clock::now() - encodeStart };
+
+    const uint64_t tableSize { sizeof(br::CookedTextureHeader) + sizeof(br::CookedTextureMip) * mipLevelCount };
+    const uint64_t dataOffset { alignUp(tableSize, br::global_cookedTextureDataAlignment) };
+
+    const br::CookedTextureHeader header {
+        br::global_cookedTextureMagic,               // magic
+        br::global_cookedTextureVersion,             // version
+        format,                                      // format
+        static_cast<uint32_t>(width),                // width
+        static_cast<uint32_t>(height),               // height
+        static_cast<uint32_t>(requiredChannelCount), // channelCount
+        mipLevelCount,                               // mipLevelCount
+        hasTransparency ? 1u : 0u,                   // hasTransparency
+        dataOffset,                                  // dataOffset
+        static_cast<uint64_t>(encodedMipChain.size()) // dataSize
+    };
+
+    for (br::CookedTextureMip& mip : mips) {
+        mip.offset += dataOffset;
+    }
+
+    std::ofstream file { outputPath, std::ios::binary | std::ios::trunc };
+
+    if (!file.good()) {
+        std::cerr << "Failed to open " << outputPath << " for writing!\n";
+        return false;
+    }
+
+    const std::vector<char> padding(dataOffset - tableSize, 0);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(mips.data()), sizeof(br::CookedTextureMip) * mips.size());
+    file.write(padding.data(), padding.size());
+    file.write(reinterpret_cast<const char*>(encodedMipChain.data()), encodedMipChain.size());
+
+    if (!file.good()) {
+        std::cerr << "Failed to write " << outputPath << "!\n";
+        return false;
+    }
+
+    std::cout << "Cooked " << inputPath << " -> " << outputPath << " (" << width << "x" << height << ", "
+              << mipLevelCount << " mips, " << getFormatName(format) << (hasTransparency ? ", transparent" : "")
+              << ", encoded in " << encodeTime.count() << " ms)\n";
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    br::TextureQuality quality { br::TextureQuality::Fast };
+    uint32_t threadCount { 0u };
+    std::vector<std::string> paths;
+
+    for (int i { 1 }; i < argc; i++) {
+        const std::string argument { argv[i] };
+
+        if (argument == "--quality" && i + 1 < argc) {
+            const std::optional<br::TextureQuality> parsedQuality { parseQuality(argv[++i]) };
+            if (!parsedQuality.has_value()) {
+                std::cerr << "Unknown quality " << argv[i] << ", expected lossless, fast or high!\n";
+                return 1;
+            }
+            quality = parsedQuality.value();
+        } else if (argument == "--threads" && i + 1 < argc) {
+            threadCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else {
+            paths.push_back(argument);
+        }
+    }
+
+    if (paths.size() != 2u) {
+        std::cerr << "Usage: texture-cooker [--quality lossless|fast|high] [--threads count] <input.png> <output.btex>\n";
+        return 1;
+    }
+
+    return cookTexture(paths.at(0u), paths.at(1u), quality, threadCount) ? 0 : 2;
+}